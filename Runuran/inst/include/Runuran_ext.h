@@ -28,3 +28,44 @@ RUNURAN_EXT_FUNCT_INIT Runuran_ext_cont_init;
 /*---------------------------------------------------------------------------*/
 /* Create and initialize UNU.RAN object for continuous distribution.         */
 /*---------------------------------------------------------------------------*/
+
+
+/*****************************************************************************/
+/* Batch routines for generator objects.                                     */
+
+typedef void RUNURAN_EXT_FUNCT_SAMPLE_ARRAY
+( UNUR_GEN *gen, double *X, int n );
+
+RUNURAN_EXT_FUNCT_SAMPLE_ARRAY Runuran_ext_sample_array;
+
+/*---------------------------------------------------------------------------*/
+/* Draw sample of size n from generator object for univariate distribution.  */
+/* Random variates of discrete distributions are stored as doubles.          */
+/*---------------------------------------------------------------------------*/
+
+typedef void RUNURAN_EXT_FUNCT_QUANTILE_ARRAY
+( UNUR_GEN *gen, const double *U, double *X, int n );
+
+RUNURAN_EXT_FUNCT_QUANTILE_ARRAY Runuran_ext_quantile_array;
+
+/*---------------------------------------------------------------------------*/
+/* Evaluate approximate quantile function for an array of u-values.          */
+/*---------------------------------------------------------------------------*/
+
+typedef void RUNURAN_EXT_FUNCT_PDF_ARRAY
+( const UNUR_GEN *gen, const double *x, double *y, int n, int islog );
+
+RUNURAN_EXT_FUNCT_PDF_ARRAY Runuran_ext_pdf_array;
+
+/*---------------------------------------------------------------------------*/
+/* Evaluate (log-)PDF or PMF for an array of points.                         */
+/*---------------------------------------------------------------------------*/
+
+typedef void RUNURAN_EXT_FUNCT_CDF_ARRAY
+( const UNUR_GEN *gen, const double *x, double *y, int n );
+
+RUNURAN_EXT_FUNCT_CDF_ARRAY Runuran_ext_cdf_array;
+
+/*---------------------------------------------------------------------------*/
+/* Evaluate CDF for an array of points.                                      */
+/*---------------------------------------------------------------------------*/
@@ -51,3 +51,59 @@ unur_distr_cont_get_pdfparams ( const UNUR_DISTR *distr, const double **params )
 }
 
 /*---------------------------------------------------------------------------*/
+
+void attribute_hidden
+Runuran_ext_sample_array ( UNUR_GEN *gen, double *X, int n )
+{
+  static RUNURAN_EXT_FUNCT_SAMPLE_ARRAY *funct = NULL;
+
+  if (funct == NULL)
+    funct = (RUNURAN_EXT_FUNCT_SAMPLE_ARRAY*)
+      R_GetCCallable("Runuran", "sample_array");
+
+  funct(gen, X, n);
+}
+
+/*---------------------------------------------------------------------------*/
+
+void attribute_hidden
+Runuran_ext_quantile_array ( UNUR_GEN *gen, const double *U, double *X, int n )
+{
+  static RUNURAN_EXT_FUNCT_QUANTILE_ARRAY *funct = NULL;
+
+  if (funct == NULL)
+    funct = (RUNURAN_EXT_FUNCT_QUANTILE_ARRAY*)
+      R_GetCCallable("Runuran", "quantile_array");
+
+  funct(gen, U, X, n);
+}
+
+/*---------------------------------------------------------------------------*/
+
+void attribute_hidden
+Runuran_ext_pdf_array ( const UNUR_GEN *gen, const double *x, double *y, int n, int islog )
+{
+  static RUNURAN_EXT_FUNCT_PDF_ARRAY *funct = NULL;
+
+  if (funct == NULL)
+    funct = (RUNURAN_EXT_FUNCT_PDF_ARRAY*)
+      R_GetCCallable("Runuran", "pdf_array");
+
+  funct(gen, x, y, n, islog);
+}
+
+/*---------------------------------------------------------------------------*/
+
+void attribute_hidden
+Runuran_ext_cdf_array ( const UNUR_GEN *gen, const double *x, double *y, int n )
+{
+  static RUNURAN_EXT_FUNCT_CDF_ARRAY *funct = NULL;
+
+  if (funct == NULL)
+    funct = (RUNURAN_EXT_FUNCT_CDF_ARRAY*)
+      R_GetCCallable("Runuran", "cdf_array");
+
+  funct(gen, x, y, n);
+}
+
+/*---------------------------------------------------------------------------*/
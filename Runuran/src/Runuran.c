@@ -67,31 +67,26 @@ Runuran_init (SEXP sexp_obj, SEXP sexp_distr, SEXP sexp_method)
   /* get method string */
   method = CHAR(STRING_ELT(sexp_method,0));
 
-  /* create generator object */
+  /* check distribution */
   switch (TYPEOF(sexp_distr)) {
   case STRSXP:
-    {
-      const char *distr = CHAR(STRING_ELT(sexp_distr,0));
-      gen = unur_makegen_ssu( distr, method, NULL );
-    }
-    break;
-
   case EXTPTRSXP:
-    {
-      struct unur_distr *distr = R_ExternalPtrAddr(sexp_distr);
-      gen = unur_makegen_dsu( distr, method, NULL );
-    }
     break;
-
   default:
     Rf_errorcall(R_NilValue,"[UNU.RAN - error] invalid argument 'distribution'");
   }
 
+  /* create generator object (or get a copy from the registry) */
+  gen = _Runuran_registry_makegen( sexp_distr, method );
+
   /* 'gen' must not be a NULL pointer */
   if (gen == NULL) {
     Rf_errorcall(R_NilValue,"[UNU.RAN - error] cannot create UNU.RAN object");
   }
 
+  /* method GIBBS: warm starts for conditional generators */
+  _Runuran_gibbs_warm_start(gen);
+
   /* set slot 'inversion' to true when 'gen' implements an inversion method. */
   PROTECT(sexp_is_inversion = Rf_allocVector(LGLSXP, 1));
   LOGICAL(sexp_is_inversion)[0] = unur_gen_is_inversion(gen);
@@ -117,7 +112,7 @@ Runuran_sample (SEXP sexp_unur, SEXP sexp_n)
      /* Sample from UNU.RAN generator object.                                */
      /*                                                                      */
      /* Parameters:                                                          */
-     /*   unur ... 'Runuran' object (S4 class)                               */ 
+     /*   unur ... 'Runuran' object (S4 class) or stream object              */ 
      /*   n    ... sample size (positive integer)                            */
      /*                                                                      */
      /* Return:                                                              */
@@ -129,8 +124,8 @@ Runuran_sample (SEXP sexp_unur, SEXP sexp_n)
   SEXP sexp_data;
   struct unur_gen *gen;
 
-  /* first argument must be S4 class */
-  if (!Rf_isS4(sexp_unur))
+  /* first argument must be S4 class (or stream object) */
+  if (!Rf_isS4(sexp_unur) && !_Runuran_is_stream(sexp_unur))
     Rf_error("[UNU.RAN - error] argument invalid: 'unr' must be UNU.RAN object");
 
   /* Extract and check sample size */
@@ -139,6 +134,10 @@ Runuran_sample (SEXP sexp_unur, SEXP sexp_n)
     Rf_error("sample size 'n' must be positive integer");
   }
 
+  /* Streaming sampler: next n random variates */
+  if (_Runuran_is_stream(sexp_unur))
+    return _Runuran_stream_sample(sexp_unur,n);
+
   /* Extract pointer to UNU.RAN generator */
   sexp_gen = R_do_slot(sexp_unur, Rf_install("unur"));
   if (! Rf_isNull(sexp_gen)) {
@@ -152,7 +151,7 @@ Runuran_sample (SEXP sexp_unur, SEXP sexp_n)
   /* Extract data list */
   sexp_data = R_do_slot(sexp_unur, Rf_install("data"));
   if (! Rf_isNull(sexp_data)) {
-    return _Runuran_sample_data(sexp_data,n);
+    return _Runuran_sample_data(sexp_data,n,sexp_unur);
   }
 
   /* Neither the UNU.RAN object nor the packed data list exists */
@@ -162,6 +161,128 @@ Runuran_sample (SEXP sexp_unur, SEXP sexp_n)
 
 /*---------------------------------------------------------------------------*/
 
+SEXP
+Runuran_sample_vr (SEXP sexp_unur, SEXP sexp_n, SEXP sexp_antithetic, SEXP sexp_strata)
+     /*----------------------------------------------------------------------*/
+     /* Sample from UNU.RAN generator object that implements an inversion    */
+     /* method using antithetic variates and/or stratified sampling.         */
+     /*                                                                      */
+     /* Parameters:                                                          */
+     /*   unur       ... 'Runuran' object (S4 class)                         */ 
+     /*   n          ... sample size (positive integer)                      */
+     /*   antithetic ... whether antithetic variates are used (logical)      */
+     /*   strata     ... number of strata (positive integer or NULL)         */
+     /*                                                                      */
+     /* Return:                                                              */
+     /*   random sample of size 'n'                                          */
+     /*                                                                      */
+     /* Remark:                                                              */
+     /*   The u-values are generated in blocks of 'strata' numbers. Each     */
+     /*   block contains one u-value from each of the intervals              */
+     /*   [j/strata,(j+1)/strata) in random order (i.e., Latin hypercube     */
+     /*   sampling in dimension 1). When 'antithetic' is TRUE then each      */
+     /*   u-value U is followed by 1-U.                                      */
+     /*   The u-values are then transformed by the (approximate) inverse     */
+     /*   CDF in a single batch.                                             */
+     /*----------------------------------------------------------------------*/
+{
+  SEXP sexp_gen, sexp_U, sexp_res;
+  struct unur_gen *gen = NULL;
+  const char *class;
+  double *U;
+  int *perm;
+  int n, m, antithetic, strata;
+  int i, j, k, tmp;
+
+  /* first argument must be S4 class "unuran" */
+  if (!Rf_isS4(sexp_unur))
+    Rf_error("[UNU.RAN - error] argument invalid: 'unr' must be UNU.RAN object");
+  class = Rf_translateChar(STRING_ELT( Rf_getAttrib(sexp_unur, R_ClassSymbol), 0));
+  if (strcmp(class,"unuran")) {
+    Rf_error("[UNU.RAN - error] argument invalid: 'unr' must be UNU.RAN object");
+  }
+
+  /* Extract and check sample size */
+  n = *(INTEGER (Rf_coerceVector(sexp_n, INTSXP)));
+  if (n<=0) {
+    Rf_error("sample size 'n' must be positive integer");
+  }
+
+  /* Extract and check parameters for variance reduction */
+  antithetic = *(LOGICAL (Rf_coerceVector(sexp_antithetic, LGLSXP)));
+  if (antithetic == NA_LOGICAL)
+    Rf_error("[UNU.RAN - error] invalid argument 'antithetic'");
+  strata = (Rf_isNull(sexp_strata)) ? 1 : *(INTEGER (Rf_coerceVector(sexp_strata, INTSXP)));
+  if (strata == NA_INTEGER || strata < 1)
+    Rf_error("[UNU.RAN - error] number of strata must be positive integer");
+
+  /* variance reduction requires inversion method */
+  if ( ! LOGICAL(R_do_slot(sexp_unur, Rf_install("inversion")))[0]) {
+    Rf_error("[UNU.RAN - error] invalid UNU.RAN object: inversion method required!\n\
+\tUse methods 'HINV', 'NINV', 'PINV'; or 'DGT'");
+  }
+
+  /* Extract pointer to UNU.RAN generator (NULL for packed objects) */
+  sexp_gen = R_do_slot(sexp_unur, Rf_install("unur"));
+  if (! Rf_isNull(sexp_gen)) {
+    CHECK_UNUR_PTR(sexp_gen);
+    gen = R_ExternalPtrAddr(sexp_gen);
+  }
+
+  /* generate u-values */
+  PROTECT(sexp_U = Rf_allocVector(REALSXP, n));
+  U = REAL(sexp_U);
+
+  /* number of u-values that are drawn */
+  m = (antithetic) ? (n+1)/2 : n;
+
+  GetRNGstate();
+  if (strata > 1) {
+    /* stratified sampling (blocks of size 'strata') */
+    perm = (int *) R_alloc(strata, sizeof(int));
+    for (i=0; i<m; i+=strata) {
+      /* random permutation of strata */
+      for (j=0; j<strata; j++) perm[j] = j;
+      for (j=strata-1; j>0; j--) {
+	k = (int) (unif_rand() * (j+1));
+	if (k > j) k = j;
+	tmp = perm[j]; perm[j] = perm[k]; perm[k] = tmp;
+      }
+      for (j=0; j<strata && i+j<m; j++)
+	U[i+j] = (perm[j] + unif_rand()) / strata;
+    }
+  }
+  else {
+    for (i=0; i<m; i++)
+      U[i] = unif_rand();
+  }
+  PutRNGstate();
+
+  if (antithetic) {
+    /* antithetic pairs (U, 1-U); run backwards as we work in place */
+    for (i=m-1; i>=0; i--) {
+      if (2*i+1 < n) U[2*i+1] = 1. - U[i];
+      U[2*i] = U[i];
+    }
+  }
+
+  /* compute quantiles */
+  if (gen != NULL) {
+    _Runuran_quantile_array(gen, U, U, n);
+    sexp_res = sexp_U;
+  }
+  else {
+    /* packed object */
+    sexp_res = Runuran_quantile(sexp_unur, sexp_U);
+  }
+
+  UNPROTECT(1);
+  return sexp_res;
+
+} /* end of Runuran_sample_vr() */
+
+/*---------------------------------------------------------------------------*/
+
 SEXP
 _Runuran_sample_unur (struct unur_gen *gen, int n)
      /*----------------------------------------------------------------------*/
@@ -188,15 +309,9 @@ _Runuran_sample_unur (struct unur_gen *gen, int n)
 
   case UNUR_DISTR_CONT:   /* univariate continuous distribution */
   case UNUR_DISTR_CEMP:   /* empirical continuous univariate distribution */
-    PROTECT(sexp_res = Rf_allocVector(REALSXP, n));
-    for (i=0; i<n; i++) {
-      REAL(sexp_res)[i] = unur_sample_cont(gen); }
-    break;
-
   case UNUR_DISTR_DISCR:  /* discrete univariate distribution */
     PROTECT(sexp_res = Rf_allocVector(REALSXP, n));
-    for (i=0; i<n; i++) {
-      REAL(sexp_res)[i] = (double) unur_sample_discr(gen); }
+    _Runuran_sample_array(gen, REAL(sexp_res), n);
     break;
 
   case UNUR_DISTR_CVEC:   /* continuous mulitvariate distribution */
@@ -205,17 +320,46 @@ _Runuran_sample_unur (struct unur_gen *gen, int n)
       double *x = (double*) R_alloc(dim, sizeof(double) );
       PROTECT(sexp_res = Rf_allocMatrix(REALSXP, n, dim));
       res = REAL(sexp_res);
-      for (i=0; i<n; i++) {
-	if (unur_sample_vec(gen,x)!=UNUR_SUCCESS)
-	  for (k=0; k<dim; k++) res[i + n*k] = NA_REAL;
-	else
-	  for (k=0; k<dim; k++) res[i + n*k] = x[k];
+      if (unur_get_method(gen) == UNUR_METH_VNROU && n > 1)
+	/* ratio-of-uniforms: test blocks of candidates */
+	_Runuran_vnrou_sample_array(gen, res, n);
+      else if (unur_get_method(gen) == UNUR_METH_HITRO && n > 1)
+	/* hit-and-run sampler: test blocks of candidates */
+	_Runuran_hitro_sample_array(gen, res, n);
+      else
+	for (i=0; i<n; i++) {
+	  if (unur_sample_vec(gen,x)!=UNUR_SUCCESS)
+	    for (k=0; k<dim; k++) res[i + n*k] = NA_REAL;
+	  else
+	    for (k=0; k<dim; k++) res[i + n*k] = x[k];
+	}
+    }
+    break;
+
+  case UNUR_DISTR_MATR:   /* matrix distribution */
+    {
+      int nrow, ncol;
+      double *x;
+      unur_distr_matr_get_dim(unur_get_distr(gen), &nrow, &ncol);
+      PROTECT(sexp_res = Rf_alloc3DArray(REALSXP, nrow, ncol, n));
+      res = REAL(sexp_res);
+      if (unur_get_method(gen) == UNUR_METH_MCORR)
+	/* random correlation matrices: write into array directly */
+	_Runuran_mcorr_sample_array(gen, res, n);
+      else {
+	x = (double*) R_alloc(nrow*ncol, sizeof(double) );
+	for (i=0; i<n; i++) {
+	  /* UNU.RAN stores matrices row-wise */
+	  if (unur_sample_matr(gen,x)!=UNUR_SUCCESS)
+	    for (k=0; k<nrow*ncol; k++) res[k + i*nrow*ncol] = NA_REAL;
+	  else
+	    for (k=0; k<nrow*ncol; k++) res[(k/ncol) + nrow*(k%ncol) + i*nrow*ncol] = x[k];
+	}
       }
     }
     break;
 
   case UNUR_DISTR_CVEMP:  /* empirical continuous multivariate distribution */
-  case UNUR_DISTR_MATR:   /* matrix distribution */
   default:
     Rf_error("[UNU.RAN - error] '%s': Distribution type not support",
 	     unur_distr_get_name(unur_get_distr(gen)) );
@@ -224,6 +368,9 @@ _Runuran_sample_unur (struct unur_gen *gen, int n)
   /* update state for the R built-in URNG */
   PutRNGstate();
 
+  /* print number of suppressed repetitions of warnings */
+  _Runuran_errlog_flush();
+
   /* return result to R */
   UNPROTECT(1);
   return sexp_res;
@@ -232,14 +379,71 @@ _Runuran_sample_unur (struct unur_gen *gen, int n)
 
 /*---------------------------------------------------------------------------*/
 
+void
+_Runuran_sample_array (struct unur_gen *gen, double *X, int n)
+     /*----------------------------------------------------------------------*/
+     /* Draw sample from generator object for univariate distribution.       */
+     /* Random variates of discrete distributions are stored as doubles.     */
+     /* The state of the R built-in URNG must be handled by the caller.      */
+     /*                                                                      */
+     /* Parameters:                                                          */
+     /*   gen ... pointer to UNU.RAN generator object                        */
+     /*   X   ... array for storing random sample                            */
+     /*   n   ... sample size                                                */
+     /*----------------------------------------------------------------------*/
+{
+  int i;
+
+  switch (unur_distr_get_type(unur_get_distr(gen))) {
+
+  case UNUR_DISTR_CONT:   /* univariate continuous distribution */
+  case UNUR_DISTR_CEMP:   /* empirical continuous univariate distribution */
+    if (unur_get_method(gen) == UNUR_METH_NINV && n > 1)
+      /* numerical inversion: use warm starts */
+      _Runuran_ninv_sample_array(gen, X, n);
+    else if (unur_get_method(gen) == UNUR_METH_ARS && n > 1)
+      /* adaptive rejection sampling: use guide table */
+      _Runuran_ars_sample_array(gen, X, n);
+    else if ((unur_get_method(gen) == UNUR_METH_HRB ||
+	      unur_get_method(gen) == UNUR_METH_HRD ||
+	      unur_get_method(gen) == UNUR_METH_HRI) && n > 1)
+      /* hazard rate methods: thinning of blocks of random variates */
+      _Runuran_hr_sample_array(gen, X, n);
+    else if (_Runuran_is_cext(gen) && n > 1)
+      /* external generator: single call of array-sampling callback */
+      _Runuran_cext_sample_array(gen, X, n);
+    else
+      for (i=0; i<n; i++) {
+	X[i] = unur_sample_cont(gen); }
+    break;
+
+  case UNUR_DISTR_DISCR:  /* discrete univariate distribution */
+    if (_Runuran_is_cext(gen) && n > 1)
+      /* external generator: single call of array-sampling callback */
+      _Runuran_cext_sample_array(gen, X, n);
+    else
+      for (i=0; i<n; i++) {
+	X[i] = (double) unur_sample_discr(gen); }
+    break;
+
+  default:
+    Rf_error("[UNU.RAN - error] '%s': Distribution type not support",
+	     unur_distr_get_name(unur_get_distr(gen)) );
+  }
+
+} /* end of _Runuran_sample_array() */
+
+/*---------------------------------------------------------------------------*/
+
 SEXP
-_Runuran_sample_data (SEXP sexp_data, int n)
+_Runuran_sample_data (SEXP sexp_data, int n, SEXP sexp_unur)
      /*----------------------------------------------------------------------*/
      /* Sample from generator object: use R data list (packed object)        */
      /*                                                                      */
      /* Parameters:                                                          */
      /*   data ... data for generation method (R list)                       */
      /*   n    ... sample size (positive integer)                            */
+     /*   unur ... 'Runuran' object (S4 class)                               */
      /*                                                                      */
      /* Return:                                                              */
      /*   random sample of size 'n'                                          */
@@ -255,6 +459,9 @@ _Runuran_sample_data (SEXP sexp_data, int n)
   case UNUR_METH_PINV:
     PROTECT(sexp_res = _Runuran_sample_pinv(sexp_data,n));
     break;
+  case UNUR_METH_HINV:
+    PROTECT(sexp_res = _Runuran_sample_hinv(sexp_data,n,sexp_unur));
+    break;
   default:
     Rf_errorcall(R_NilValue,"[UNU.RAN - error] broken UNU.RAN object");
   }
@@ -347,26 +554,18 @@ _Runuran_quantile_unur (struct unur_gen *gen, SEXP sexp_U)
      /*   (approximate) quantiles for given 'U' values                       */
      /*----------------------------------------------------------------------*/
 {
-  double *U;
-  int n = 1;
-  int i;
   SEXP sexp_res = R_NilValue;
-
-  /* Extract U */
-  U = REAL(sexp_U);
-  n = Rf_length(sexp_U);
+  int n;
 
   /* evaluate inverse CDF */
+  n = Rf_length(sexp_U);
   PROTECT(sexp_res = Rf_allocVector(REALSXP, n));
-  for (i=0; i<n; i++) {
-    if (ISNAN(U[i]))
-      /* if NA or NaN is given then we simply return the same value */
-      REAL(sexp_res)[i] = U[i];
-    else 
-      REAL(sexp_res)[i] = unur_quantile(gen,U[i]); 
-  }
+  _Runuran_quantile_array(gen, REAL(sexp_U), REAL(sexp_res), n);
   UNPROTECT(1);
 
+  /* print number of suppressed repetitions of warnings */
+  _Runuran_errlog_flush();
+
   /* return result to R */
   return sexp_res;
  
@@ -374,6 +573,54 @@ _Runuran_quantile_unur (struct unur_gen *gen, SEXP sexp_U)
 
 /*---------------------------------------------------------------------------*/
 
+void
+_Runuran_quantile_array (struct unur_gen *gen, const double *U, double *X, int n)
+     /*----------------------------------------------------------------------*/
+     /* Evaluate approximate quantile function for an array of u-values.     */
+     /* 'U' and 'X' may point to the same array.                             */
+     /*                                                                      */
+     /* Parameters:                                                          */
+     /*   gen ... pointer to UNU.RAN generator object                        */
+     /*   U   ... array of u-values                                          */
+     /*   X   ... array for storing quantiles                                */
+     /*   n   ... length of arrays 'U' and 'X'                               */
+     /*----------------------------------------------------------------------*/
+{
+  int i;
+
+  if (unur_get_method(gen) == UNUR_METH_NINV && n > 1) {
+    /* numerical inversion: use warm starts */
+    _Runuran_ninv_eval_array(gen, U, X, n);
+  }
+  else if (_Runuran_pinv_is_lazy(gen)) {
+    /* method PINV with lazy setup */
+    for (i=0; i<n; i++)
+      X[i] = (ISNAN(U[i])) ? U[i] : _Runuran_pinv_lazy_eval_approxinvcdf(gen,U[i]);
+  }
+  else if (_Runuran_pinv_is_truncated(gen)) {
+    /* method PINV with truncated domain */
+    for (i=0; i<n; i++)
+      X[i] = (ISNAN(U[i])) ? U[i] : _Runuran_pinv_trunc_eval_approxinvcdf(gen,U[i]);
+  }
+  else if (_Runuran_is_dinv(gen)) {
+    /* method DINV */
+    for (i=0; i<n; i++)
+      X[i] = (ISNAN(U[i])) ? U[i] : (double) _Runuran_dinv_eval_invcdf(gen,U[i]);
+  }
+  else {
+    for (i=0; i<n; i++) {
+      if (ISNAN(U[i]))
+	/* if NA or NaN is given then we simply return the same value */
+	X[i] = U[i];
+      else 
+	X[i] = unur_quantile(gen,U[i]); 
+    }
+  }
+
+} /* end of _Runuran_quantile_array() */
+
+/*---------------------------------------------------------------------------*/
+
 SEXP
 _Runuran_quantile_data (SEXP sexp_data, SEXP sexp_U, SEXP sexp_unur)
      /*----------------------------------------------------------------------*/
@@ -395,6 +642,9 @@ _Runuran_quantile_data (SEXP sexp_data, SEXP sexp_U, SEXP sexp_unur)
   case UNUR_METH_PINV:
     return _Runuran_quantile_pinv(sexp_data,sexp_U,sexp_unur);
     break;
+  case UNUR_METH_HINV:
+    return _Runuran_quantile_hinv(sexp_data,sexp_U,sexp_unur);
+    break;
   default:
     Rf_errorcall(R_NilValue,"[UNU.RAN - error] broken UNU.RAN object");
   }
@@ -507,44 +757,12 @@ Runuran_PDF (SEXP sexp_obj, SEXP sexp_x, SEXP sexp_islog)
   /* allocate memory for result */
   PROTECT(sexp_res = Rf_allocVector(REALSXP, n));
 
-  /* evaluate CDF */
-  for (i=0; i<n; i++) {
-
-    if (funct_missing) {
-      /* function not implemented */
-      REAL(sexp_res)[i] = NA_REAL;
-      continue;
-    }
-
-    if (ISNAN(x[i])) {
-      /* if NA or NaN is given then we simply return the same value */
-      REAL(sexp_res)[i] = x[i];
-      continue;
-    }
-
-    /* switch (unur_distr_get_type(distr)) { */
-    switch (distr->type) {
-    case UNUR_DISTR_CONT:
-      /* univariate continuous distribution  --> evaluate PDF */
-      REAL(sexp_res)[i] = (islog)
-	? unur_distr_cont_eval_logpdf(x[i], distr)
-	: unur_distr_cont_eval_pdf(x[i], distr);
-      break;
-
-    case UNUR_DISTR_DISCR:
-      /* discrete univariate distribution  --> evaluate PMF */
-      if (x[i] < INT_MIN || x[i] > INT_MAX) 
-	REAL(sexp_res)[i] = 0.;
-      else
-	REAL(sexp_res)[i] = unur_distr_discr_eval_pmf ((int) x[i], distr);
-      /* remark: logPMF yet not implemented */
-      break;
-
-    default:
-      /* this code should not be reachable */
-      Rf_error("[UNU.RAN - error] internal error");
-    }
-  }
+  /* evaluate PDF */
+  if (funct_missing)
+    /* function not implemented */
+    for (i=0; i<n; i++) REAL(sexp_res)[i] = NA_REAL;
+  else
+    _Runuran_pdf_array(distr, x, REAL(sexp_res), n, islog);
   
   /* return result to R */
   UNPROTECT(2);
@@ -575,7 +793,6 @@ Runuran_CDF (SEXP sexp_obj, SEXP sexp_x)
   const char *class;               /* class name of 'obj' */ 
   double *x;                       /* pointer to array arguments for PDF */
   int n = 1;
-  int i;
 
   /* first argument must be S4 class */
   if (!Rf_isS4(sexp_obj))
@@ -644,10 +861,89 @@ Runuran_CDF (SEXP sexp_obj, SEXP sexp_x)
   PROTECT(sexp_res = Rf_allocVector(REALSXP, n));
 
   /* evaluate CDF */
+  _Runuran_cdf_array(gen, distr, x, REAL(sexp_res), n);
+
+  /* return result to R */
+  UNPROTECT(2);
+  return sexp_res;
+
+} /* end of Runuran_CDF() */
+
+/*---------------------------------------------------------------------------*/
+
+void
+_Runuran_pdf_array (const struct unur_distr *distr, const double *x, double *y,
+		    int n, int islog)
+     /*----------------------------------------------------------------------*/
+     /* Evaluate PDF or PMF for an array of points.                          */
+     /*                                                                      */
+     /* Parameters:                                                          */
+     /*   distr ... pointer to UNU.RAN distribution object                   */
+     /*   x     ... array of n points                                        */
+     /*   y     ... array for storing values of PDF                          */
+     /*   n     ... number of points                                         */
+     /*   islog ... boolean: if TRUE then the log-density is computed        */
+     /*----------------------------------------------------------------------*/
+{
+  int i;
+
   for (i=0; i<n; i++) {
+
     if (ISNAN(x[i])) {
       /* if NA or NaN is given then we simply return the same value */
-      REAL(sexp_res)[i] = x[i];
+      y[i] = x[i];
+      continue;
+    }
+
+    switch (distr->type) {
+    case UNUR_DISTR_CONT:
+      /* univariate continuous distribution  --> evaluate PDF */
+      y[i] = (islog)
+	? unur_distr_cont_eval_logpdf(x[i], distr)
+	: unur_distr_cont_eval_pdf(x[i], distr);
+      break;
+
+    case UNUR_DISTR_DISCR:
+      /* discrete univariate distribution  --> evaluate PMF */
+      if (x[i] < INT_MIN || x[i] > INT_MAX) 
+	y[i] = 0.;
+      else
+	y[i] = unur_distr_discr_eval_pmf ((int) x[i], distr);
+      /* remark: logPMF yet not implemented */
+      break;
+
+    default:
+      /* this code should not be reachable */
+      Rf_error("[UNU.RAN - error] internal error");
+    }
+  }
+
+} /* end of _Runuran_pdf_array() */
+
+/*---------------------------------------------------------------------------*/
+
+void
+_Runuran_cdf_array (const struct unur_gen *gen, const struct unur_distr *distr,
+		    const double *x, double *y, int n)
+     /*----------------------------------------------------------------------*/
+     /* Evaluate CDF for an array of points.                                 */
+     /* If the continuous distribution has no CDF then the approximate CDF   */
+     /* of generator object 'gen' (method PINV) is used.                     */
+     /*                                                                      */
+     /* Parameters:                                                          */
+     /*   gen   ... pointer to UNU.RAN generator object (or NULL)            */
+     /*   distr ... pointer to UNU.RAN distribution object                   */
+     /*   x     ... array of n points                                        */
+     /*   y     ... array for storing values of CDF                          */
+     /*   n     ... number of points                                         */
+     /*----------------------------------------------------------------------*/
+{
+  int i;
+
+  for (i=0; i<n; i++) {
+    if (ISNAN(x[i])) {
+      /* if NA or NaN is given then we simply return the same value */
+      y[i] = x[i];
       continue;
     }
 
@@ -655,19 +951,19 @@ Runuran_CDF (SEXP sexp_obj, SEXP sexp_x)
     case UNUR_DISTR_CONT:
       /* univariate continuous distribution */
       if (distr->data.cont.cdf != NULL)
-	REAL(sexp_res)[i] = unur_distr_cont_eval_cdf(x[i], distr);
+	y[i] = unur_distr_cont_eval_cdf(x[i], distr);
       else
-	REAL(sexp_res)[i] = unur_pinv_eval_approxcdf(gen, x[i]);
+	y[i] = unur_pinv_eval_approxcdf(gen, x[i]);
       break;
 
     case UNUR_DISTR_DISCR:
       /* discrete univariate distribution */
       if (x[i] < INT_MIN) 
-	REAL(sexp_res)[i] = 0.;
+	y[i] = 0.;
       else if (x[i] > INT_MAX) 
-	REAL(sexp_res)[i] = 1.;
+	y[i] = 1.;
       else
-	REAL(sexp_res)[i] = unur_distr_discr_eval_cdf ((int) x[i], distr);
+	y[i] = unur_distr_discr_eval_cdf ((int) x[i], distr);
       break;
 
     default:
@@ -676,11 +972,7 @@ Runuran_CDF (SEXP sexp_obj, SEXP sexp_x)
     }
   }
 
-  /* return result to R */
-  UNPROTECT(2);
-  return sexp_res;
-
-} /* end of Runuran_CDF() */
+} /* end of _Runuran_cdf_array() */
 
 /*---------------------------------------------------------------------------*/
 
@@ -802,12 +1094,14 @@ _Runuran_free (SEXP sexp_gen)
 /*---------------------------------------------------------------------------*/
 
 SEXP
-Runuran_pack (SEXP sexp_unur)
+Runuran_pack (SEXP sexp_unur, SEXP sexp_compact)
      /*----------------------------------------------------------------------*/
      /* Pack Runuran generator object into R list                            */
      /*                                                                      */
      /* Parameters:                                                          */
-     /*   unur ... 'Runuran' object (S4 class)                               */ 
+     /*   unur    ... 'Runuran' object (S4 class)                            */ 
+     /*   compact ... whether coefficients are stored in single precision    */
+     /*               (boolean)                                              */
      /*                                                                      */
      /* Return:                                                              */
      /*   data for generation method (R list)                                */
@@ -816,11 +1110,15 @@ Runuran_pack (SEXP sexp_unur)
   struct unur_gen *gen;
   SEXP sexp_gen;
   SEXP sexp_data;
+  int compact;
 
   /* argument must be S4 class */
   if (!Rf_isS4(sexp_unur))
     Rf_error("[UNU.RAN - error] argument invalid: 'unr' must be UNU.RAN object");
 
+  /* compact mode */
+  compact = (LOGICAL(Rf_coerceVector(sexp_compact, LGLSXP))[0] == TRUE);
+
   /* Extract data list */
   sexp_data = R_do_slot(sexp_unur, Rf_install("data"));
   if (! Rf_isNull(sexp_data)) {
@@ -838,7 +1136,11 @@ Runuran_pack (SEXP sexp_unur)
   /* call packing subroutine for given generator object */
   switch (unur_get_method(gen)) {
   case UNUR_METH_PINV:
-    _Runuran_pack_pinv(gen, sexp_unur);
+    _Runuran_pack_pinv(gen, sexp_unur, compact);
+    break;
+
+  case UNUR_METH_HINV:
+    _Runuran_pack_hinv(gen, sexp_unur, compact);
     break;
 
   default:
@@ -972,6 +1274,10 @@ _Runuran_error_handler_print( const char *objid     ATTRIBUTE__UNUSED,
      /*   (void)                                                             */
      /*----------------------------------------------------------------------*/
 {
+  /* store message (repetitions are printed only a few times) */
+  if (! _Runuran_errlog_add(objid, errortype, errorcode, reason, TRUE))
+    return;
+
   /* print warning or error message */
   Rprintf("[UNU.RAN - %s] %s",errortype,unur_get_strerror(errorcode));
   if (reason && strlen(reason))
@@ -1021,6 +1327,7 @@ _Runuran_error_handler_warning( const char *objid     ATTRIBUTE__UNUSED,
     switch (errorcode) {
       /* we do not print warnings for the following codes: */
     case UNUR_ERR_DISTR_REQUIRED:
+      _Runuran_errlog_add(objid, errortype, errorcode, reason, FALSE);
       return;
 
     default:
@@ -1060,6 +1367,7 @@ _Runuran_error_handler_error( const char *objid     ATTRIBUTE__UNUSED,
 {
   /* we suppress some warnings */
   if (errortype[0] == 'w') {
+      _Runuran_errlog_add(objid, errortype, errorcode, reason, FALSE);
       return;
   }
 
@@ -1071,12 +1379,12 @@ _Runuran_error_handler_error( const char *objid     ATTRIBUTE__UNUSED,
 /*---------------------------------------------------------------------------*/
 
 void
-_Runuran_error_handler_suppress( const char *objid     ATTRIBUTE__UNUSED,
+_Runuran_error_handler_suppress( const char *objid,
 				 const char *file      ATTRIBUTE__UNUSED,
 				 int line              ATTRIBUTE__UNUSED,
-				 const char *errortype ATTRIBUTE__UNUSED,
-				 int errorcode         ATTRIBUTE__UNUSED,
-				 const char *reason    ATTRIBUTE__UNUSED )
+				 const char *errortype,
+				 int errorcode,
+				 const char *reason )
      /*----------------------------------------------------------------------*/
      /* Error handler that suppresses all warnings/errors.                   */
      /* Error handler for UNU.RAN routines                                   */
@@ -1093,7 +1401,8 @@ _Runuran_error_handler_suppress( const char *objid     ATTRIBUTE__UNUSED,
      /*   (void)                                                             */
      /*----------------------------------------------------------------------*/
 {
-  ; /* nothing to do */
+  /* store message only */
+  _Runuran_errlog_add(objid, errortype, errorcode, reason, FALSE);
 } /* end of _Runuran_error_handler_suppress() */
 
 /*---------------------------------------------------------------------------*/
@@ -53,17 +53,32 @@ SEXP Runuran_init (SEXP sexp_obj, SEXP sexp_distr, SEXP sexp_method);
 /* Create and initialize UNU.RAN generator object.                           */
 /*---------------------------------------------------------------------------*/
 
+SEXP Runuran_autotune (SEXP sexp_obj, SEXP sexp_distr, SEXP sexp_n, SEXP sexp_memory);
+/*---------------------------------------------------------------------------*/
+/* Create generator object with the method of lowest projected total cost.   */
+/*---------------------------------------------------------------------------*/
+
 SEXP Runuran_sample (SEXP sexp_unur, SEXP sexp_n);
 /*---------------------------------------------------------------------------*/
 /* Sample from UNU.RAN generator object.                                     */
 /*---------------------------------------------------------------------------*/
 
+SEXP Runuran_sample_vr (SEXP sexp_unur, SEXP sexp_n, SEXP sexp_antithetic, SEXP sexp_strata);
+/*---------------------------------------------------------------------------*/
+/* Sample using antithetic variates and/or stratified sampling (inversion).  */
+/*---------------------------------------------------------------------------*/
+
 SEXP _Runuran_sample_unur (struct unur_gen *gen, int n);
 /*---------------------------------------------------------------------------*/
 /* Sample from generator object: use UNU.RAN object                          */
 /*---------------------------------------------------------------------------*/
 
-SEXP _Runuran_sample_data (SEXP sexp_data, int n);
+void _Runuran_sample_array (struct unur_gen *gen, double *X, int n);
+/*---------------------------------------------------------------------------*/
+/* Draw sample from generator object for univariate distribution.           */
+/*---------------------------------------------------------------------------*/
+
+SEXP _Runuran_sample_data (SEXP sexp_data, int n, SEXP sexp_unur);
 /*---------------------------------------------------------------------------*/
 /* Sample from generator object: use R data list (packed object)             */
 /*---------------------------------------------------------------------------*/
@@ -78,6 +93,11 @@ SEXP _Runuran_quantile_unur (struct unur_gen *gen, SEXP sexp_U);
 /* Evaluate approximate quantile function: use UNU.RAN object                */
 /*---------------------------------------------------------------------------*/
 
+void _Runuran_quantile_array (struct unur_gen *gen, const double *U, double *X, int n);
+/*---------------------------------------------------------------------------*/
+/* Evaluate approximate quantile function for an array of u-values.          */
+/*---------------------------------------------------------------------------*/
+
 SEXP _Runuran_quantile_data (SEXP sexp_data, SEXP sexp_U, SEXP sexp_unur);
 /*---------------------------------------------------------------------------*/
 /* Evaluate approximate quantile function:  use R data list (packed object)  */
@@ -93,12 +113,24 @@ SEXP Runuran_CDF (SEXP sexp_obj, SEXP sexp_x);
 /* Evaluate CDF for UNU.RAN distribution or generator object.                */
 /*---------------------------------------------------------------------------*/
 
+void _Runuran_pdf_array (const struct unur_distr *distr, const double *x, double *y,
+			 int n, int islog);
+/*---------------------------------------------------------------------------*/
+/* Evaluate PDF or PMF for an array of points.                               */
+/*---------------------------------------------------------------------------*/
+
+void _Runuran_cdf_array (const struct unur_gen *gen, const struct unur_distr *distr,
+			 const double *x, double *y, int n);
+/*---------------------------------------------------------------------------*/
+/* Evaluate CDF (or approximate CDF of method PINV) for an array of points.  */
+/*---------------------------------------------------------------------------*/
+
 SEXP Runuran_print (SEXP sexp_unur, SEXP sexp_help);
 /*---------------------------------------------------------------------------*/
 /* Print information about UNU.RAN generator object.                         */
 /*---------------------------------------------------------------------------*/
 
-SEXP Runuran_pack (SEXP sexp_unur);
+SEXP Runuran_pack (SEXP sexp_unur, SEXP sexp_compact);
 /*---------------------------------------------------------------------------*/
 /* Pack Runuran objects into R lists                                         */
 /*---------------------------------------------------------------------------*/
@@ -118,6 +150,37 @@ SEXP Runuran_set_error_level (SEXP sexp_level);
 /* Set verbosity level of UNU.RAN error handler.                             */
 /*---------------------------------------------------------------------------*/
 
+SEXP Runuran_sample_std (SEXP sexp_type, SEXP sexp_name, SEXP sexp_params,
+			 SEXP sexp_domain, SEXP sexp_method, SEXP sexp_n);
+/*---------------------------------------------------------------------------*/
+/* Sample from special distribution (use cache of generator objects).        */
+/*---------------------------------------------------------------------------*/
+
+SEXP Runuran_sample_str (SEXP sexp_distr, SEXP sexp_method, SEXP sexp_n);
+/*---------------------------------------------------------------------------*/
+/* Sample from distribution given by string (use cache of generator objects).*/
+/*---------------------------------------------------------------------------*/
+
+SEXP Runuran_set_registry_memory (SEXP sexp_memory);
+/*---------------------------------------------------------------------------*/
+/* Set memory budget for registry of generator objects.                      */
+/*---------------------------------------------------------------------------*/
+
+SEXP Runuran_registry_info (void);
+/*---------------------------------------------------------------------------*/
+/* Get some informations about registry of generator objects.                */
+/*---------------------------------------------------------------------------*/
+
+SEXP Runuran_chg_params (SEXP sexp_unur, SEXP sexp_params);
+/*---------------------------------------------------------------------------*/
+/* Change parameters of distribution in generator object (CSTD and DSTD).    */
+/*---------------------------------------------------------------------------*/
+
+SEXP Runuran_chg_truncated (SEXP sexp_unur, SEXP sexp_lb, SEXP sexp_ub);
+/*---------------------------------------------------------------------------*/
+/* Change truncated domain of distribution in generator object.              */
+/*---------------------------------------------------------------------------*/
+
 
 /*****************************************************************************/
 /* Meta methods                                                              */
@@ -133,11 +196,29 @@ SEXP Runuran_mixt (SEXP sexp_obj, SEXP sexp_prob, SEXP sexp_comp, SEXP sexp_inve
 SEXP Runuran_cont_init (SEXP sexp_obj, SEXP sexp_env, 
 			SEXP sexp_cdf, SEXP sexp_pdf, SEXP sexp_dpdf, SEXP sexp_islog,
 			SEXP sexp_mode, SEXP sexp_center, SEXP sexp_domain, 
-			SEXP sexp_area, SEXP sexp_name);
+			SEXP sexp_area, SEXP sexp_name, SEXP sexp_hr);
 /*---------------------------------------------------------------------------*/
 /* Create and initialize UNU.RAN object for continuous distribution.         */
 /*---------------------------------------------------------------------------*/
 
+void _Runuran_cont_eval_hr_array (const double *x, int n, double *hx,
+				  const struct unur_distr *distr);
+/*---------------------------------------------------------------------------*/
+/* Evaluate hazard rate of continuous distribution for an array of points.   */
+/*---------------------------------------------------------------------------*/
+
+void _Runuran_cont_eval_cdf_array (const double *x, int n, double *Fx,
+				   const struct unur_distr *distr);
+/*---------------------------------------------------------------------------*/
+/* Evaluate CDF of continuous distribution for an array of points.           */
+/*---------------------------------------------------------------------------*/
+
+void _Runuran_cont_eval_pdf_array (const double *x, int n, double *fx,
+				   const struct unur_distr *distr);
+/*---------------------------------------------------------------------------*/
+/* Evaluate PDF of continuous distribution for an array of points.           */
+/*---------------------------------------------------------------------------*/
+
 SEXP Runuran_discr_init (SEXP sexp_obj, SEXP sexp_env,
 			 SEXP sexp_cdf, SEXP sexp_pv, SEXP sexp_pmf,
 			 SEXP sexp_mode, SEXP sexp_domain,
@@ -147,13 +228,19 @@ SEXP Runuran_discr_init (SEXP sexp_obj, SEXP sexp_env,
 /*---------------------------------------------------------------------------*/
 
 SEXP Runuran_cmv_init (SEXP sexp_obj, SEXP sexp_env, 
-		       SEXP sexp_dim, SEXP sexp_pdf, 
+		       SEXP sexp_dim, SEXP sexp_pdf, SEXP sexp_pdf_array,
 		       SEXP sexp_mode, SEXP sexp_center, 
 		       SEXP sexp_ll, SEXP sexp_ur, SEXP sexp_name);
 /*---------------------------------------------------------------------------*/
 /* Create and initialize UNU.RAN object for cont. multivariate distribution. */
 /*---------------------------------------------------------------------------*/
 
+void _Runuran_cvec_eval_pdf_array (const double *X, int n, double *fx,
+				   struct unur_distr *distr);
+/*---------------------------------------------------------------------------*/
+/* Evaluate PDF of cont. multivariate distribution for an array of points.   */
+/*---------------------------------------------------------------------------*/
+
 
 SEXP Runuran_std_cont (SEXP sexp_obj, SEXP sexp_name, SEXP sexp_params, SEXP sexp_domain);
 /*---------------------------------------------------------------------------*/
@@ -220,6 +307,23 @@ void _Runuran_error_handler_suppress (
 /* Error handlers for UNU.RAN routines.                                       */
 /*---------------------------------------------------------------------------*/
 
+int _Runuran_errlog_add (const char *objid, const char *errortype,
+			 int errorcode, const char *reason, int print);
+/*---------------------------------------------------------------------------*/
+/* Store warning or error message in ring buffer.                            */
+/* Returns TRUE if message should be printed.                                */
+/*---------------------------------------------------------------------------*/
+
+void _Runuran_errlog_flush (void);
+/*---------------------------------------------------------------------------*/
+/* Print number of suppressed repetitions of last message.                   */
+/*---------------------------------------------------------------------------*/
+
+SEXP Runuran_errlog (SEXP sexp_clear);
+/*---------------------------------------------------------------------------*/
+/* Get list of stored warnings and error messages.                           */
+/*---------------------------------------------------------------------------*/
+
 void _Runuran_free(SEXP sexp_gen);
 /*---------------------------------------------------------------------------*/
 /* Free UNU.RAN generator object.                                            */
@@ -268,7 +372,7 @@ SEXP _Runuran_distr_tag(void);
 /*****************************************************************************/
 /* Special packing functions                                                 */
 
-void _Runuran_pack_pinv (struct unur_gen *gen, SEXP sexp_unur);
+void _Runuran_pack_pinv (struct unur_gen *gen, SEXP sexp_unur, int compact);
 /*---------------------------------------------------------------------------*/
 /* Pack Runuran generator object for method PINV into R list                 */
 /*---------------------------------------------------------------------------*/
@@ -283,6 +387,435 @@ SEXP _Runuran_quantile_pinv (SEXP sexp_data, SEXP sexp_U, SEXP sexp_unur);
 /* Evaluate approximate quantile function:  use R data list (packed object)  */
 /*---------------------------------------------------------------------------*/
 
+void _Runuran_pack_hinv (struct unur_gen *gen, SEXP sexp_unur, int compact);
+/*---------------------------------------------------------------------------*/
+/* Pack Runuran generator object for method HINV into R list                 */
+/*---------------------------------------------------------------------------*/
+
+SEXP _Runuran_sample_hinv (SEXP sexp_data, int n, SEXP sexp_unur);
+/*---------------------------------------------------------------------------*/
+/* Sample from generator object: use R data list (packed object)             */
+/*---------------------------------------------------------------------------*/
+
+SEXP _Runuran_quantile_hinv (SEXP sexp_data, SEXP sexp_U, SEXP sexp_unur);
+/*---------------------------------------------------------------------------*/
+/* Evaluate approximate quantile function:  use R data list (packed object)  */
+/*---------------------------------------------------------------------------*/
+
+SEXP _Runuran_performance_packed (SEXP sexp_data);
+/*---------------------------------------------------------------------------*/
+/* Get some informations about packed generator object in an R list.         */
+/*---------------------------------------------------------------------------*/
+
+int _Runuran_float_to_int (double x);
+/*---------------------------------------------------------------------------*/
+/* Round x to single precision and store bit pattern as integer.             */
+/*---------------------------------------------------------------------------*/
+
+double _Runuran_int_to_float (int i);
+/*---------------------------------------------------------------------------*/
+/* Convert bit pattern created by _Runuran_float_to_int() into number.       */
+/*---------------------------------------------------------------------------*/
+
+
+/*****************************************************************************/
+/* Batch routines for method NINV                                            */
+
+void _Runuran_ninv_eval_array (const struct unur_gen *gen,
+			       const double *U, double *X, int n);
+/*---------------------------------------------------------------------------*/
+/* Evaluate approximate inverse CDF for an array of u-values                 */
+/* (sort u-values and use previous root as starting point).                  */
+/*---------------------------------------------------------------------------*/
+
+void _Runuran_ninv_sample_array (struct unur_gen *gen, double *X, int n);
+/*---------------------------------------------------------------------------*/
+/* Sample from generator object with method NINV (batch version).            */
+/*---------------------------------------------------------------------------*/
+
+
+/*****************************************************************************/
+/* Eager table for method DARI                                               */
+
+SEXP Runuran_dari_eager (SEXP sexp_unur);
+/*---------------------------------------------------------------------------*/
+/* Compute table for method DARI at once.                                    */
+/*---------------------------------------------------------------------------*/
+
+int _Runuran_dari_make_table (struct unur_gen *gen);
+/*---------------------------------------------------------------------------*/
+/* Compute table for method DARI and use sampling routine that does not      */
+/* change the generator object.                                              */
+/*---------------------------------------------------------------------------*/
+
+int _Runuran_dari_is_eager (const struct unur_gen *gen);
+/*---------------------------------------------------------------------------*/
+/* Check whether generator object uses method DARI with eager table.         */
+/*---------------------------------------------------------------------------*/
+
+int _Runuran_dari_sample_urng (const struct unur_gen *gen, struct unur_urng *urng);
+/*---------------------------------------------------------------------------*/
+/* Sample from generator object with method DARI using given URNG            */
+/* (read-only; the generator object can be shared between threads).         */
+/*---------------------------------------------------------------------------*/
+
+
+/*****************************************************************************/
+/* Tables of generator objects in a single memory block                      */
+
+struct unur_gen *_Runuran_arena_compact (struct unur_gen *gen);
+/*---------------------------------------------------------------------------*/
+/* Move tables of generator object into a single memory block (PINV).        */
+/* Generator objects of other methods are not changed.                       */
+/*---------------------------------------------------------------------------*/
+
+int _Runuran_arena_is_compact (const struct unur_gen *gen);
+/*---------------------------------------------------------------------------*/
+/* Check whether tables of generator object are in a single memory block.    */
+/*---------------------------------------------------------------------------*/
+
+double *_Runuran_arena_pinv_urange (const struct unur_gen *gen);
+/*---------------------------------------------------------------------------*/
+/* Get pointer to u-values of boundaries of truncated domain (Umin, Umax)    */
+/* that are stored in the memory block (PINV).                               */
+/*---------------------------------------------------------------------------*/
+
+
+/*****************************************************************************/
+/* Batch routines for hazard rate methods HRB, HRD, and HRI                  */
+
+void _Runuran_hr_sample_array (struct unur_gen *gen, double *X, int n);
+/*---------------------------------------------------------------------------*/
+/* Draw sample of size n by thinning blocks of random variates.              */
+/*---------------------------------------------------------------------------*/
+
+
+/*****************************************************************************/
+/* Batch routines for method ARS                                             */
+
+void _Runuran_ars_sample_array (struct unur_gen *gen, double *X, int n);
+/*---------------------------------------------------------------------------*/
+/* Sample from generator object with method ARS (batch version using a       */
+/* guide table).                                                             */
+/*---------------------------------------------------------------------------*/
+
+
+/*****************************************************************************/
+/* Batch routines for methods VNROU and HITRO                                */
+
+int _Runuran_vnrou_sample_array (struct unur_gen *gen, double *res, int n);
+/*---------------------------------------------------------------------------*/
+/* Sample from generator object with method VNROU (batch version).           */
+/* The sample is stored as n x dim matrix (column-major order).              */
+/* In verifying mode the number of violations of the hat is returned.        */
+/*---------------------------------------------------------------------------*/
+
+void _Runuran_hitro_sample_array (struct unur_gen *gen, double *res, int n);
+/*---------------------------------------------------------------------------*/
+/* Sample from generator object with method HITRO (batch version).           */
+/* The sample is stored as n x dim matrix (column-major order).              */
+/*---------------------------------------------------------------------------*/
+
+
+/*****************************************************************************/
+/* Registry of generator objects                                             */
+
+struct unur_gen *_Runuran_registry_makegen (SEXP sexp_distr, const char *method);
+/*---------------------------------------------------------------------------*/
+/* Create generator object for given distribution and method.                */
+/* Reuse generator object from registry if possible.                         */
+/*---------------------------------------------------------------------------*/
+
+void _Runuran_registry_clear (void);
+/*---------------------------------------------------------------------------*/
+/* Remove all entries from registry.                                         */
+/*---------------------------------------------------------------------------*/
+
+double _Runuran_gen_memory (const struct unur_gen *gen);
+/*---------------------------------------------------------------------------*/
+/* Estimate memory used by generator object.                                 */
+/*---------------------------------------------------------------------------*/
+
+void _Runuran_cache_clear (void);
+/*---------------------------------------------------------------------------*/
+/* Remove all generator objects from cache for ur<distribution>() wrappers.  */
+/*---------------------------------------------------------------------------*/
+
+struct Runuran_key {
+  unsigned char *buf;           /* byte string */
+  size_t len;                   /* length of byte string */
+  size_t size;                  /* size of allocated buffer */
+};
+/*---------------------------------------------------------------------------*/
+/* Key for registry and cache of generator objects.                          */
+/*---------------------------------------------------------------------------*/
+
+void _Runuran_key_add (struct Runuran_key *key, const void *data, size_t len);
+/*---------------------------------------------------------------------------*/
+/* Append data to key.                                                       */
+/*---------------------------------------------------------------------------*/
+
+unsigned long _Runuran_key_hash (const struct Runuran_key *key);
+/*---------------------------------------------------------------------------*/
+/* Compute hash value for key.                                               */
+/*---------------------------------------------------------------------------*/
+
+
+/*****************************************************************************/
+/* Change parameters for methods CSTD and DSTD                               */
+
+int _Runuran_cstd_chg_params (struct unur_gen *gen, const double *params, int n_params);
+/*---------------------------------------------------------------------------*/
+/* Change parameters of distribution in generator object (method CSTD).      */
+/*---------------------------------------------------------------------------*/
+
+int _Runuran_dstd_chg_params (struct unur_gen *gen, const double *params, int n_params);
+/*---------------------------------------------------------------------------*/
+/* Change parameters of distribution in generator object (method DSTD).      */
+/*---------------------------------------------------------------------------*/
+
+
+/*****************************************************************************/
+/* Truncated domain for method PINV                                          */
+
+int _Runuran_pinv_chg_truncated (struct unur_gen *gen, double left, double right);
+/*---------------------------------------------------------------------------*/
+/* Change truncated domain of generator object without new setup (PINV).     */
+/*---------------------------------------------------------------------------*/
+
+int _Runuran_pinv_is_truncated (const struct unur_gen *gen);
+/*---------------------------------------------------------------------------*/
+/* Check whether PINV generator object has a truncated domain.               */
+/*---------------------------------------------------------------------------*/
+
+double _Runuran_pinv_trunc_eval_approxinvcdf (const struct unur_gen *gen, double u);
+/*---------------------------------------------------------------------------*/
+/* Evaluate approximate inverse CDF of truncated distribution (PINV).        */
+/*---------------------------------------------------------------------------*/
+
+
+/*****************************************************************************/
+/* Method GIBBS                                                              */
+
+void _Runuran_gibbs_warm_start (struct unur_gen *gen);
+/*---------------------------------------------------------------------------*/
+/* Use warm starts for reinitializing the generators for the conditional     */
+/* distributions of a GIBBS generator object.                                */
+/*---------------------------------------------------------------------------*/
+
+
+/*****************************************************************************/
+/* Method MCORR                                                              */
+
+SEXP Runuran_mcorr (SEXP sexp_obj, SEXP sexp_dim, SEXP sexp_eigenvalues);
+/*---------------------------------------------------------------------------*/
+/* Create UNU.RAN generator object for random correlation matrices.          */
+/*---------------------------------------------------------------------------*/
+
+void _Runuran_mcorr_sample_array (struct unur_gen *gen, double *res, int n);
+/*---------------------------------------------------------------------------*/
+/* Sample random correlation matrices (batch version).                       */
+/* The sample is stored as dim x dim x n array.                              */
+/*---------------------------------------------------------------------------*/
+
+
+/*****************************************************************************/
+/* Method PINV with lazy setup                                               */
+
+SEXP Runuran_pinv_lazy (SEXP sexp_obj, SEXP sexp_distr, SEXP sexp_ures, SEXP sexp_smooth);
+/*---------------------------------------------------------------------------*/
+/* Create UNU.RAN generator object for method PINV with lazy setup.          */
+/*---------------------------------------------------------------------------*/
+
+int _Runuran_pinv_is_lazy (const struct unur_gen *gen);
+/*---------------------------------------------------------------------------*/
+/* Check whether generator object uses lazy setup for method PINV.           */
+/*---------------------------------------------------------------------------*/
+
+double _Runuran_pinv_lazy_eval_approxinvcdf (struct unur_gen *gen, double u);
+/*---------------------------------------------------------------------------*/
+/* Evaluate approximate inverse CDF (segments are created when required).    */
+/*---------------------------------------------------------------------------*/
+
+
+/*****************************************************************************/
+/* Method HINV with incremental setup                                        */
+
+SEXP Runuran_hinv_adapt (SEXP sexp_obj, SEXP sexp_distr, SEXP sexp_order,
+			 SEXP sexp_ures, SEXP sexp_time, SEXP sexp_memory);
+/*---------------------------------------------------------------------------*/
+/* Create UNU.RAN generator object for method HINV with incremental setup    */
+/* (error-driven refinement with time and memory budget).                    */
+/*---------------------------------------------------------------------------*/
+
+
+/*****************************************************************************/
+/* Inversion for discrete distributions with large support (DINV)           */
+
+SEXP Runuran_dinv (SEXP sexp_obj, SEXP sexp_distr, SEXP sexp_ures, SEXP sexp_head);
+/*---------------------------------------------------------------------------*/
+/* Create UNU.RAN generator object for method DINV.                          */
+/*---------------------------------------------------------------------------*/
+
+int _Runuran_is_dinv (const struct unur_gen *gen);
+/*---------------------------------------------------------------------------*/
+/* Check whether generator object implements method DINV.                    */
+/*---------------------------------------------------------------------------*/
+
+int _Runuran_dinv_eval_invcdf (const struct unur_gen *gen, double u);
+/*---------------------------------------------------------------------------*/
+/* Evaluate approximate inverse CDF of DINV generator.                       */
+/*---------------------------------------------------------------------------*/
+
+
+/*****************************************************************************/
+/* External generators with buffered array sampling (CEXT, DEXT)             */
+
+typedef int Runuran_sample_array (double *X, int n, void *data);
+/*---------------------------------------------------------------------------*/
+/* Array-sampling callback: store n random variates in X.                    */
+/* Returns UNUR_SUCCESS on success.                                          */
+/*---------------------------------------------------------------------------*/
+
+struct unur_gen *_Runuran_cext_new (int discrete, Runuran_sample_array *sample_array,
+				    void *data, int blocksize);
+/*---------------------------------------------------------------------------*/
+/* Create external generator (CEXT or DEXT) with buffered array-sampling     */
+/* callback.                                                                 */
+/*---------------------------------------------------------------------------*/
+
+SEXP Runuran_cext (SEXP sexp_obj, SEXP sexp_sample, SEXP sexp_discrete, SEXP sexp_blocksize);
+/*---------------------------------------------------------------------------*/
+/* Create UNU.RAN generator object for vectorized R sampling function.       */
+/*---------------------------------------------------------------------------*/
+
+int _Runuran_is_cext (const struct unur_gen *gen);
+/*---------------------------------------------------------------------------*/
+/* Check whether generator object has buffered array-sampling callback.      */
+/*---------------------------------------------------------------------------*/
+
+int _Runuran_cext_sample_array (struct unur_gen *gen, double *X, int n);
+/*---------------------------------------------------------------------------*/
+/* Sample from external generator (batch version).                           */
+/*---------------------------------------------------------------------------*/
+
+
+/*****************************************************************************/
+/* Streaming sampler                                                         */
+
+SEXP Runuran_stream (SEXP sexp_unur, SEXP sexp_buffer, SEXP sexp_seed);
+/*---------------------------------------------------------------------------*/
+/* Create streaming sampler (with background thread) for generator object.   */
+/*---------------------------------------------------------------------------*/
+
+int _Runuran_is_stream (SEXP sexp_obj);
+/*---------------------------------------------------------------------------*/
+/* Check whether R object is a UNU.RAN stream object.                        */
+/*---------------------------------------------------------------------------*/
+
+SEXP _Runuran_stream_sample (SEXP sexp_stream, int n);
+/*---------------------------------------------------------------------------*/
+/* Get next n random variates from stream object.                            */
+/*---------------------------------------------------------------------------*/
+
+int _Runuran_stream_drop_message (void);
+/*---------------------------------------------------------------------------*/
+/* Check whether messages of error handler must be dropped (i.e., whether    */
+/* we are in the producer thread of a stream object).                        */
+/*---------------------------------------------------------------------------*/
+
+
+/*****************************************************************************/
+/* Tables for Gauss-Lobatto integration                                      */
+
+struct Runuran_lobatto {
+  double tol;                   /* tolerance used for integration */
+  int n;                        /* number of subintervals */
+  int size;                     /* size of allocated arrays */
+  double *x;                    /* boundaries of subintervals [n+1] */
+  double *u;                    /* integrals over subintervals [n] */
+  double *err;                  /* error estimates for subintervals [n] */
+  double *fx;                   /* values of integrand at boundaries [n+1] */
+  double *fc;                   /* values of integrand at centers [n] */
+};
+/*---------------------------------------------------------------------------*/
+/* Table for Lobatto integration (kept in distribution object).              */
+/*---------------------------------------------------------------------------*/
+
+struct Runuran_lobatto *
+_Runuran_lobatto_new (const struct Runuran_lobatto *old,
+		      double (*funct)(double, struct unur_gen *), struct unur_gen *gen,
+		      double left, double center, double right, double tol);
+/*---------------------------------------------------------------------------*/
+/* Compute table for Gauss-Lobatto integration over [left,right].            */
+/* Subintervals of table 'old' are reused (if possible).                     */
+/*---------------------------------------------------------------------------*/
+
+double _Runuran_lobatto_integral (const struct Runuran_lobatto *tab);
+/*---------------------------------------------------------------------------*/
+/* Get integral over whole domain of table.                                  */
+/*---------------------------------------------------------------------------*/
+
+void _Runuran_lobatto_free (struct Runuran_lobatto *tab);
+/*---------------------------------------------------------------------------*/
+/* Free table.                                                               */
+/*---------------------------------------------------------------------------*/
+
+void _Runuran_lobatto_store (const struct unur_distr *distr, struct Runuran_lobatto *tab);
+/*---------------------------------------------------------------------------*/
+/* Store table in distribution object (or free it).                          */
+/*---------------------------------------------------------------------------*/
+
+struct Runuran_lobatto **_Runuran_cont_lobatto_slot (const struct unur_distr *distr);
+/*---------------------------------------------------------------------------*/
+/* Get slot for table in distribution object (NULL if not available).        */
+/*---------------------------------------------------------------------------*/
+
+SEXP Runuran_get_lobatto (SEXP sexp_distr);
+/*---------------------------------------------------------------------------*/
+/* Get table for Gauss-Lobatto integration stored in distribution object.    */
+/*---------------------------------------------------------------------------*/
+
+SEXP Runuran_set_lobatto (SEXP sexp_distr, SEXP sexp_tab);
+/*---------------------------------------------------------------------------*/
+/* Store table for Gauss-Lobatto integration in distribution object.         */
+/*---------------------------------------------------------------------------*/
+
+
+/*****************************************************************************/
+/* Quasi-random number generators                                            */
+
+#define RUNURAN_QRNG_SOBOL   (1)    /* Sobol sequence */
+#define RUNURAN_QRNG_HALTON  (2)    /* Halton sequence */
+
+UNUR_URNG *_Runuran_qrng_new (int type, int dim, UNUR_URNG *srng);
+/*---------------------------------------------------------------------------*/
+/* Create URNG object for quasi-random sequence (randomized when 'srng' is   */
+/* not NULL).                                                                */
+/*---------------------------------------------------------------------------*/
+
+int _Runuran_qrng_skip (UNUR_URNG *urng, double n);
+/*---------------------------------------------------------------------------*/
+/* Skip the first 'n' points of the sequence.                                */
+/*---------------------------------------------------------------------------*/
+
+void _Runuran_qrng_fill (UNUR_URNG *urng, double *X, int n);
+/*---------------------------------------------------------------------------*/
+/* Store the next 'n' points in n x dim matrix 'X' (column-major order).     */
+/*---------------------------------------------------------------------------*/
+
+SEXP Runuran_qrng (SEXP sexp_n, SEXP sexp_dim, SEXP sexp_type,
+		   SEXP sexp_randomize, SEXP sexp_skip);
+/*---------------------------------------------------------------------------*/
+/* Create QMC point set.                                                     */
+/*---------------------------------------------------------------------------*/
+
+SEXP Runuran_qmc (SEXP sexp_unrs, SEXP sexp_n, SEXP sexp_type,
+		  SEXP sexp_randomize, SEXP sexp_skip);
+/*---------------------------------------------------------------------------*/
+/* Map QMC point set through inversion methods (column-wise).                */
+/*---------------------------------------------------------------------------*/
+
 
 /*****************************************************************************/
 /* Auxiliary URNG                                                            */
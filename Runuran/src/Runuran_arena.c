@@ -0,0 +1,339 @@
+/*****************************************************************************
+ *                                                                           *
+ *          UNU.RAN -- Universal Non-Uniform Random number generator         *
+ *                                                                           *
+ *****************************************************************************
+ *                                                                           *
+ *   FILE: Runuran_arena.c                                                   *
+ *                                                                           *
+ *   PURPOSE:                                                                *
+ *         Tables of generator objects in a single memory block              *
+ *                                                                           *
+ *****************************************************************************
+ *                                                                           *
+ *   Copyright (c) 2026 Wolfgang Hoermann and Josef Leydold                  *
+ *   Dept. for Statistics, University of Economics, Vienna, Austria          *
+ *                                                                           *
+ *   This program is free software; you can redistribute it and/or modify    *
+ *   it under the terms of the GNU General Public License as published by    *
+ *   the Free Software Foundation; either version 2 of the License, or       *
+ *   (at your option) any later version.                                     *
+ *                                                                           *
+ *   This program is distributed in the hope that it will be useful,         *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of          *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the           *
+ *   GNU General Public License for more details.                            *
+ *                                                                           *
+ *   You should have received a copy of the GNU General Public License       *
+ *   along with this program; if not, write to the                           *
+ *   Free Software Foundation, Inc.,                                         *
+ *   59 Temple Place, Suite 330, Boston, MA 02111-1307, USA                  *
+ *                                                                           *
+ *****************************************************************************
+ *                                                                           *
+ *   The setup of method PINV allocates the coefficients of the              *
+ *   interpolating polynomials ('ui' and 'zi') separately for every          *
+ *   interval, and the array of intervals for the maximal number of          *
+ *   intervals. Thus a generator object with 10^4 intervals requires 2*10^4  *
+ *   calls to malloc() and free() for each clone, and the tables are         *
+ *   scattered in memory.                                                    *
+ *                                                                           *
+ *   After the setup we move all tables into a single memory block           *
+ *   ("arena"):                                                              *
+ *                                                                           *
+ *     [ intervals (n_ivs+1) | coefficients 2*order*(n_ivs+1) |              *
+ *       Umin, Umax | guide ]                                                *
+ *                                                                           *
+ *   'Umin' and 'Umax' are the u-values of the boundaries of a truncated     *
+ *   domain (see _Runuran_pinv_chg_truncated() in Runuran_pinv.c). The       *
+ *   library's PINV generator object has no fields for them. As part of the  *
+ *   block they are copied together with the tables.                         *
+ *                                                                           *
+ *   The block starts with the array of intervals, i.e., GEN->iv points to   *
+ *   the block. The routines for destroying and cloning the generator        *
+ *   object are replaced: destroying frees the block at once, cloning        *
+ *   copies it by a single memcpy() and recomputes the pointers into the     *
+ *   block (which only depend on the index of the interval). Unlike the      *
+ *   library routine it also copies the table for the approximate CDF        *
+ *   (variant 'keepcdf'), which is required by up().                         *
+ *   Generator objects are cloned whenever they are taken from the           *
+ *   registry and for the segments of PINV with lazy setup.                  *
+ *                                                                           *
+ *   The setup itself is done by the UNU.RAN library which cannot be         *
+ *   changed here. Methods that store their intervals in linked lists that   *
+ *   grow during sampling (TDR, ARS) are left unchanged.                     *
+ *                                                                           *
+ *****************************************************************************/
+
+/*---------------------------------------------------------------------------*/
+
+#include "Runuran.h"
+
+/* internal header files for UNU.RAN */
+#include <unur_source.h>
+#include <methods/x_gen_source.h>
+#include <methods/pinv_struct.h>
+#include <utils/lobatto_source.h>
+#include <utils/lobatto_struct.h>
+
+/*---------------------------------------------------------------------------*/
+
+static void _arena_pinv_compact (struct unur_gen *gen);
+/*---------------------------------------------------------------------------*/
+/* Move tables of PINV generator object into a single memory block.          */
+/*---------------------------------------------------------------------------*/
+
+static size_t _arena_pinv_layout (const struct unur_gen *gen, size_t *offset_guide);
+/*---------------------------------------------------------------------------*/
+/* Compute size of memory block and offset of guide table.                   */
+/*---------------------------------------------------------------------------*/
+
+static void _arena_pinv_rebase (struct unur_gen *gen, size_t offset_guide);
+/*---------------------------------------------------------------------------*/
+/* Set pointers to coefficients and guide table in memory block.             */
+/*---------------------------------------------------------------------------*/
+
+static void _arena_pinv_free (struct unur_gen *gen);
+/*---------------------------------------------------------------------------*/
+/* Destroy PINV generator object with tables in memory block.                */
+/*---------------------------------------------------------------------------*/
+
+static struct unur_gen *_arena_pinv_clone (const struct unur_gen *gen);
+/*---------------------------------------------------------------------------*/
+/* Copy PINV generator object with tables in memory block.                   */
+/*---------------------------------------------------------------------------*/
+
+/* original routine of method PINV */
+static void (*_pinv_free)(struct unur_gen *gen) = NULL;
+
+/*---------------------------------------------------------------------------*/
+
+#define GEN       ((struct unur_pinv_gen*)gen->datap)
+
+/*****************************************************************************/
+
+struct unur_gen *
+_Runuran_arena_compact (struct unur_gen *gen)
+     /*----------------------------------------------------------------------*/
+     /* Move tables of generator object into a single memory block.          */
+     /* Generator objects of other methods are not changed.                  */
+     /*                                                                      */
+     /* Parameters:                                                          */
+     /*   gen ... pointer to UNU.RAN generator object (or NULL)              */
+     /*                                                                      */
+     /* Return:                                                              */
+     /*   pointer to (the same) generator object                             */
+     /*----------------------------------------------------------------------*/
+{
+  if (gen == NULL || _Runuran_arena_is_compact(gen))
+    return gen;
+
+  switch (gen->method) {
+  case UNUR_METH_PINV:
+    _arena_pinv_compact(gen);
+    break;
+  default:
+    break;
+  }
+
+  return gen;
+} /* end of _Runuran_arena_compact() */
+
+/*---------------------------------------------------------------------------*/
+
+int
+_Runuran_arena_is_compact (const struct unur_gen *gen)
+     /*----------------------------------------------------------------------*/
+     /* Check whether tables of generator object are in a single block.      */
+     /*                                                                      */
+     /* Parameters:                                                          */
+     /*   gen ... pointer to UNU.RAN generator object                        */
+     /*                                                                      */
+     /* Return:                                                              */
+     /*   TRUE if tables are stored in a single block, FALSE otherwise       */
+     /*----------------------------------------------------------------------*/
+{
+  return (gen->destroy == _arena_pinv_free);
+} /* end of _Runuran_arena_is_compact() */
+
+/*---------------------------------------------------------------------------*/
+
+double *
+_Runuran_arena_pinv_urange (const struct unur_gen *gen)
+     /*----------------------------------------------------------------------*/
+     /* Get pointer to u-values of boundaries of (truncated) domain that     */
+     /* are stored in the memory block (Umin and Umax).                      */
+     /*                                                                      */
+     /* Parameters:                                                          */
+     /*   gen ... pointer to PINV generator object                           */
+     /*                                                                      */
+     /* Return:                                                              */
+     /*   pointer to array of size 2                                         */
+     /*   NULL if tables are not stored in a single block                    */
+     /*----------------------------------------------------------------------*/
+{
+  if (! _Runuran_arena_is_compact(gen))
+    return NULL;
+
+  /* Umin and Umax are stored immediately before the guide table */
+  return ((double *) GEN->guide) - 2;
+} /* end of _Runuran_arena_pinv_urange() */
+
+/*---------------------------------------------------------------------------*/
+
+void
+_arena_pinv_compact (struct unur_gen *gen)
+     /*----------------------------------------------------------------------*/
+     /* Move tables of PINV generator object into a single memory block.     */
+     /*                                                                      */
+     /* Parameters:                                                          */
+     /*   gen ... pointer to PINV generator object                           */
+     /*----------------------------------------------------------------------*/
+{
+  struct unur_pinv_interval *block;
+  double *coeff, *urange;
+  size_t offset_guide;
+  int order = GEN->order;
+  int i;
+
+  if (GEN->iv == NULL || GEN->n_ivs < 0 || GEN->guide == NULL)
+    /* this should not happen */
+    return;
+
+  /* copy intervals into new block */
+  block = _unur_xmalloc(_arena_pinv_layout(gen, &offset_guide));
+  memcpy(block, GEN->iv, (GEN->n_ivs+1) * sizeof(struct unur_pinv_interval));
+
+  /* copy coefficients and guide table */
+  coeff = (double *) (block + GEN->n_ivs+1);
+  for (i=0; i<=GEN->n_ivs; i++) {
+    memcpy(coeff + 2*order*i, GEN->iv[i].ui, order * sizeof(double));
+    memcpy(coeff + 2*order*i + order, GEN->iv[i].zi, order * sizeof(double));
+    free(GEN->iv[i].ui);
+    free(GEN->iv[i].zi);
+  }
+  memcpy((char *) block + offset_guide, GEN->guide, GEN->guide_size * sizeof(int));
+
+  /* u-values for boundaries of domain (not truncated) */
+  urange = (double *) ((char *) block + offset_guide) - 2;
+  urange[0] = 0.;
+  urange[1] = 1.;
+
+  /* replace old tables */
+  free(GEN->guide);
+  free(GEN->iv);
+  GEN->iv = block;
+  _arena_pinv_rebase(gen, offset_guide);
+  GEN->max_ivs = GEN->n_ivs+1;
+
+  /* replace routines for destroying and cloning */
+  _pinv_free = gen->destroy;
+  gen->destroy = _arena_pinv_free;
+  gen->clone = _arena_pinv_clone;
+
+} /* end of _arena_pinv_compact() */
+
+/*---------------------------------------------------------------------------*/
+
+size_t
+_arena_pinv_layout (const struct unur_gen *gen, size_t *offset_guide)
+     /*----------------------------------------------------------------------*/
+     /* Compute size of memory block and offset of guide table.              */
+     /*                                                                      */
+     /* Parameters:                                                          */
+     /*   gen          ... pointer to PINV generator object                  */
+     /*   offset_guide ... pointer for storing offset of guide table         */
+     /*                                                                      */
+     /* Return:                                                              */
+     /*   size of memory block in bytes                                      */
+     /*----------------------------------------------------------------------*/
+{
+  size_t n = (size_t) (GEN->n_ivs+1);
+
+  *offset_guide = n * sizeof(struct unur_pinv_interval) + (2 * GEN->order * n + 2) * sizeof(double);
+  return *offset_guide + GEN->guide_size * sizeof(int);
+} /* end of _arena_pinv_layout() */
+
+/*---------------------------------------------------------------------------*/
+
+void
+_arena_pinv_rebase (struct unur_gen *gen, size_t offset_guide)
+     /*----------------------------------------------------------------------*/
+     /* Set pointers to coefficients and guide table in memory block.        */
+     /*                                                                      */
+     /* Parameters:                                                          */
+     /*   gen          ... pointer to PINV generator object                  */
+     /*   offset_guide ... offset of guide table                             */
+     /*----------------------------------------------------------------------*/
+{
+  double *coeff = (double *) (GEN->iv + GEN->n_ivs+1);
+  int order = GEN->order;
+  int i;
+
+  for (i=0; i<=GEN->n_ivs; i++) {
+    GEN->iv[i].ui = coeff + 2*order*i;
+    GEN->iv[i].zi = coeff + 2*order*i + order;
+  }
+  GEN->guide = (int *) ((char *) GEN->iv + offset_guide);
+} /* end of _arena_pinv_rebase() */
+
+/*---------------------------------------------------------------------------*/
+
+void
+_arena_pinv_free (struct unur_gen *gen)
+     /*----------------------------------------------------------------------*/
+     /* Destroy PINV generator object with tables in memory block.           */
+     /*                                                                      */
+     /* Parameters:                                                          */
+     /*   gen ... pointer to generator object                                */
+     /*----------------------------------------------------------------------*/
+{
+  /* free block and let UNU.RAN free the remaining parts */
+  free(GEN->iv);
+  GEN->iv = NULL;
+  GEN->guide = NULL;
+  _pinv_free(gen);
+} /* end of _arena_pinv_free() */
+
+/*---------------------------------------------------------------------------*/
+
+struct unur_gen *
+_arena_pinv_clone (const struct unur_gen *gen)
+     /*----------------------------------------------------------------------*/
+     /* Copy PINV generator object with tables in memory block.              */
+     /* (adapted from _unur_pinv_clone() in methods/pinv_init.ch)            */
+     /*                                                                      */
+     /* Parameters:                                                          */
+     /*   gen ... pointer to generator object                                */
+     /*                                                                      */
+     /* Return:                                                              */
+     /*   pointer to clone of generator object                               */
+     /*----------------------------------------------------------------------*/
+{
+#define CLONE  ((struct unur_pinv_gen*)clone->datap)
+  struct unur_gen *clone;
+  size_t size, offset_guide;
+
+  clone = _unur_generic_clone(gen, "PINV");
+
+  /* table for approximate CDF (keepcdf): up() requires a deep copy */
+  CLONE->aCDF = NULL;
+  if (GEN->aCDF) {
+    CLONE->aCDF = _unur_xmalloc(sizeof(struct unur_lobatto_table));
+    memcpy(CLONE->aCDF, GEN->aCDF, sizeof(struct unur_lobatto_table));
+    CLONE->aCDF->values = _unur_xmalloc(_unur_max(1, GEN->aCDF->size) * sizeof(struct unur_lobatto_nodes));
+    memcpy(CLONE->aCDF->values, GEN->aCDF->values,
+	   GEN->aCDF->n_values * sizeof(struct unur_lobatto_nodes));
+    CLONE->aCDF->gen = clone;
+  }
+
+  size = _arena_pinv_layout(gen, &offset_guide);
+  CLONE->iv = _unur_xmalloc(size);
+  memcpy(CLONE->iv, GEN->iv, size);
+  _arena_pinv_rebase(clone, offset_guide);
+
+  return clone;
+#undef CLONE
+} /* end of _arena_pinv_clone() */
+
+/*---------------------------------------------------------------------------*/
@@ -0,0 +1,371 @@
+/*****************************************************************************
+ *                                                                           *
+ *          UNU.RAN -- Universal Non-Uniform Random number generator         *
+ *                                                                           *
+ *****************************************************************************
+ *                                                                           *
+ *   FILE: Runuran_ars.c                                                     *
+ *                                                                           *
+ *   PURPOSE:                                                                *
+ *         Batch sampling for method ARS                                     *
+ *                                                                           *
+ *****************************************************************************
+ *                                                                           *
+ *   Copyright (c) 2026 Wolfgang Hoermann and Josef Leydold                  *
+ *   Dept. for Statistics, University of Economics, Vienna, Austria          *
+ *                                                                           *
+ *   This program is free software; you can redistribute it and/or modify    *
+ *   it under the terms of the GNU General Public License as published by    *
+ *   the Free Software Foundation; either version 2 of the License, or       *
+ *   (at your option) any later version.                                     *
+ *                                                                           *
+ *   This program is distributed in the hope that it will be useful,         *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of          *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the           *
+ *   GNU General Public License for more details.                            *
+ *                                                                           *
+ *   You should have received a copy of the GNU General Public License       *
+ *   along with this program; if not, write to the                           *
+ *   Free Software Foundation, Inc.,                                         *
+ *   59 Temple Place, Suite 330, Boston, MA 02111-1307, USA                  *
+ *                                                                           *
+ *****************************************************************************
+ *                                                                           *
+ *   Method ARS searches the interval for the next draw by walking through   *
+ *   the linked list of intervals. It does not use a guide table, so the     *
+ *   cost of a draw grows linearly with the number of construction points.   *
+ *   This matters because ARS adds construction points during sampling.      *
+ *                                                                           *
+ *   When a sample of size n > 1 is requested, we build a guide table for    *
+ *   the intervals and use it to sample. The hat of the generator object     *
+ *   can only change when the squeeze test fails and the maximum number      *
+ *   of intervals has not been reached yet. In this case we let the          *
+ *   sampling routine of UNU.RAN repeat this trial (including the            *
+ *   adaptive step) by means of a URNG that replays the two uniform random   *
+ *   numbers of this trial. The guide table is then rebuilt lazily before    *
+ *   the next draw.                                                          *
+ *   Thus the generated random variates coincide with those produced by      *
+ *   repeated calls to unur_sample_cont().                                   *
+ *                                                                           *
+ *   The PDF is an R function which may raise an error (or the user may      *
+ *   interrupt). Thus the sampling loop runs inside R_UnwindProtect(): the   *
+ *   cleanup routine restores the URNG of the generator object and frees     *
+ *   the guide table and the replaying URNG also when R unwinds the stack.   *
+ *                                                                           *
+ *****************************************************************************/
+
+/*---------------------------------------------------------------------------*/
+
+#include "Runuran.h"
+
+/* internal header files for UNU.RAN */
+#include <unur_source.h>
+#include <distr/distr_source.h>
+#include <methods/ars_struct.h>
+
+/*---------------------------------------------------------------------------*/
+
+#define GUIDE_FACTOR  (2)
+/* relative size of guide table */
+
+/* variant flag (copied from methods/ars.c) */
+#define ARS_VARFLAG_VERIFY    0x0100u
+
+/*---------------------------------------------------------------------------*/
+
+#define GEN       ((struct unur_ars_gen*)gen->datap)
+#define DISTR     gen->distr->data.cont
+#define logPDF(x) _unur_cont_logPDF((x),(gen->distr))
+
+#define scaled_area(iv)     (exp((iv)->logAhat - GEN->logAmax))
+#define rescaled_logf(logf) ((logf) - GEN->logAmax)
+
+/*---------------------------------------------------------------------------*/
+
+struct Runuran_ars_replay {
+  double u[2];                  /* uniform random numbers to be replayed */
+  int k;                        /* number of replayed numbers */
+  UNUR_URNG *urng;              /* URNG of generator object */
+};
+/*---------------------------------------------------------------------------*/
+/* State of URNG that replays a trial.                                       */
+/*---------------------------------------------------------------------------*/
+
+struct Runuran_ars_batch {
+  struct unur_gen *gen;         /* pointer to generator object */
+  double *X;                    /* array for storing random sample */
+  int n;                        /* sample size */
+  UNUR_URNG *urng;              /* URNG of generator object */
+  UNUR_URNG *urng_replay;       /* URNG that replays a trial */
+  struct Runuran_ars_replay replay;  /* state of replaying URNG */
+  struct unur_ars_interval **guide;  /* guide table */
+  int guide_size;               /* size of guide table */
+};
+/*---------------------------------------------------------------------------*/
+/* Data for sampling loop (shared with cleanup routine).                     */
+/*---------------------------------------------------------------------------*/
+
+static SEXP _ars_sample_loop (void *data);
+/*---------------------------------------------------------------------------*/
+/* Sampling loop of batch version.                                           */
+/*---------------------------------------------------------------------------*/
+
+static void _ars_sample_cleanup (void *data, Rboolean jump);
+/*---------------------------------------------------------------------------*/
+/* Restore URNG of generator object and free working space.                  */
+/*---------------------------------------------------------------------------*/
+
+static double _ars_replay (void *state);
+/*---------------------------------------------------------------------------*/
+/* Replay stored uniform random numbers, then continue with URNG.            */
+/*---------------------------------------------------------------------------*/
+
+static int _ars_make_guide_table (struct unur_gen *gen,
+				  struct unur_ars_interval ***guide, int *guide_size);
+/*---------------------------------------------------------------------------*/
+/* Make guide table for intervals of hat.                                    */
+/*---------------------------------------------------------------------------*/
+
+/*****************************************************************************/
+
+void
+_Runuran_ars_sample_array (struct unur_gen *gen, double *X, int n)
+     /*----------------------------------------------------------------------*/
+     /* Sample from generator object with method ARS (batch version).        */
+     /*                                                                      */
+     /* Parameters:                                                          */
+     /*   gen ... pointer to generator object                                */
+     /*   X   ... array for storing random sample                            */
+     /*   n   ... sample size                                                */
+     /*----------------------------------------------------------------------*/
+{
+  struct Runuran_ars_batch batch;
+  SEXP cont;
+  int i;
+
+  /* verifying mode or invalid generator object: use UNU.RAN routine */
+  if ((gen->variant & ARS_VARFLAG_VERIFY) || GEN->iv == NULL) {
+    for (i=0; i<n; i++)
+      X[i] = unur_sample_cont(gen);
+    return;
+  }
+
+  batch.gen = gen;
+  batch.X = X;
+  batch.n = n;
+  batch.urng = gen->urng;
+  batch.replay.urng = gen->urng;
+  batch.replay.k = 2;
+  batch.guide = NULL;
+  batch.guide_size = 0;
+  batch.urng_replay = unur_urng_new(_ars_replay, &(batch.replay));
+
+  /* the PDF may raise an R error: restore URNG and free working space */
+  PROTECT(cont = R_MakeUnwindCont());
+  R_UnwindProtect(_ars_sample_loop, &batch, _ars_sample_cleanup, &batch, cont);
+  UNPROTECT(1);
+
+} /* end of _Runuran_ars_sample_array() */
+
+/*---------------------------------------------------------------------------*/
+
+SEXP
+_ars_sample_loop (void *data)
+     /*----------------------------------------------------------------------*/
+     /* Sampling loop of batch version.                                      */
+     /*                                                                      */
+     /* Parameters:                                                          */
+     /*   data ... pointer to data for sampling loop                         */
+     /*                                                                      */
+     /* Return:                                                              */
+     /*   R_NilValue                                                         */
+     /*----------------------------------------------------------------------*/
+{
+  struct Runuran_ars_batch *batch = data;
+  struct unur_gen *gen = batch->gen;
+  struct unur_ars_interval *iv, *cp;
+  int is_stale = TRUE;
+  double U, V, x, logV;
+  double logfx, logsqx, loghx;
+  double x0, logfx0, dlogfx0, fx0, t;
+  int i, j, n_trials;
+
+  for (i=0; i<batch->n; i++) {
+
+    for (n_trials=0; ; ++n_trials) {
+
+      if (n_trials >= GEN->max_iter) {
+	_unur_warning(gen->genid,UNUR_ERR_GEN_SAMPLING,"max number of iterations exceeded");
+	x = UNUR_INFINITY;
+	break;
+      }
+
+      /* (re-) build guide table after hat has been changed */
+      if (is_stale) {
+	if (_ars_make_guide_table(gen, &(batch->guide), &(batch->guide_size)) != UNUR_SUCCESS) {
+	  /* this should not happen */
+	  x = unur_sample_cont(gen);
+	  break;
+	}
+	is_stale = FALSE;
+      }
+
+      /* sample from U(0,1) and find interval */
+      U = _unur_call_urng(batch->urng);
+      j = (int) (U * batch->guide_size);
+      iv = batch->guide[(j < batch->guide_size) ? j : batch->guide_size-1];
+      t = U * GEN->Atotal;
+      while (iv->Acum < t)
+	iv = iv->next;
+
+      /* left or right part of interval (same as _unur_ars_sample()) */
+      t -= iv->Acum;
+      if (-t < (scaled_area(iv) * iv->Ahatr_fract)) {
+	cp = iv->next;
+      }
+      else {
+	cp = iv;
+	t += scaled_area(iv);
+      }
+
+      /* generate from hat */
+      x0 = cp->x;
+      logfx0 = cp->logfx;
+      dlogfx0 = cp->dlogfx;
+      fx0 = exp(rescaled_logf(logfx0));
+      if (_unur_iszero(dlogfx0))
+	x = x0 + t / fx0;
+      else {
+	double s = dlogfx0 * t / fx0;
+	if (fabs(s) > 1.e-6)
+	  x = x0 + log(s + 1.) * t / (fx0 * s);
+	else if (fabs(s) > 1.e-8)
+	  x = x0 + t / fx0 * (1 - s/2. + s*s/3.);
+	else
+	  x = x0 + t / fx0 * (1 - s/2.);
+      }
+
+      /* squeeze acceptance */
+      V = _unur_call_urng(batch->urng);
+      loghx = rescaled_logf(logfx0) + dlogfx0*(x - x0);
+      logV = log(V) + loghx;
+      logsqx = rescaled_logf(iv->logfx) + iv->sq*(x - iv->x);
+      if (logV <= logsqx)
+	break;
+
+      /* hat may be improved: let UNU.RAN repeat this trial */
+      if (GEN->n_ivs < GEN->max_ivs) {
+	batch->replay.u[0] = U;
+	batch->replay.u[1] = V;
+	batch->replay.k = 0;
+	gen->urng = batch->urng_replay;
+	x = unur_sample_cont(gen);
+	gen->urng = batch->urng;
+	is_stale = TRUE;
+	break;
+      }
+
+      /* acceptance test */
+      logfx = logPDF(x);
+      if (logV <= rescaled_logf(logfx))
+	break;
+    }
+
+    batch->X[i] = x;
+  }
+
+  return R_NilValue;
+
+} /* end of _ars_sample_loop() */
+
+/*---------------------------------------------------------------------------*/
+
+void
+_ars_sample_cleanup (void *data, Rboolean jump)
+     /*----------------------------------------------------------------------*/
+     /* Restore URNG of generator object and free working space.             */
+     /* Called on return of the sampling loop and when R unwinds the stack.  */
+     /*                                                                      */
+     /* Parameters:                                                          */
+     /*   data ... pointer to data for sampling loop                         */
+     /*   jump ... TRUE when R unwinds the stack (error or interrupt)        */
+     /*----------------------------------------------------------------------*/
+{
+  struct Runuran_ars_batch *batch = data;
+
+  batch->gen->urng = batch->urng;
+  free(batch->guide);
+  batch->guide = NULL;
+  unur_urng_free(batch->urng_replay);
+  batch->urng_replay = NULL;
+
+} /* end of _ars_sample_cleanup() */
+
+/*---------------------------------------------------------------------------*/
+
+double
+_ars_replay (void *state)
+     /*----------------------------------------------------------------------*/
+     /* Replay stored uniform random numbers, then continue with URNG.       */
+     /*                                                                      */
+     /* Parameters:                                                          */
+     /*   state ... pointer to state of replaying URNG                       */
+     /*                                                                      */
+     /* Return:                                                              */
+     /*   uniform random number                                              */
+     /*----------------------------------------------------------------------*/
+{
+  struct Runuran_ars_replay *replay = state;
+
+  return ( (replay->k < 2)
+	   ? replay->u[replay->k++]
+	   : _unur_call_urng(replay->urng) );
+
+} /* end of _ars_replay() */
+
+/*---------------------------------------------------------------------------*/
+
+int
+_ars_make_guide_table (struct unur_gen *gen,
+		       struct unur_ars_interval ***guide, int *guide_size)
+     /*----------------------------------------------------------------------*/
+     /* Make guide table for intervals of hat.                               */
+     /*                                                                      */
+     /* Parameters:                                                          */
+     /*   gen        ... pointer to generator object                         */
+     /*   guide      ... pointer to guide table (reallocated if necessary)   */
+     /*   guide_size ... pointer to size of guide table                      */
+     /*                                                                      */
+     /* Return:                                                              */
+     /*   UNUR_SUCCESS ... on success                                        */
+     /*   error code   ... otherwise                                         */
+     /*----------------------------------------------------------------------*/
+{
+  struct unur_ars_interval *iv;
+  double Acum;
+  int j, size;
+
+  if (GEN->iv == NULL || !(GEN->Atotal > 0.))
+    return UNUR_ERR_GEN_DATA;
+
+  size = GUIDE_FACTOR * GEN->n_ivs;
+  if (size <= 0) size = 1;
+  if (size != *guide_size) {
+    *guide = _unur_xrealloc(*guide, size * sizeof(struct unur_ars_interval *));
+    *guide_size = size;
+  }
+
+  /* guide[j] points to the first interval with Acum >= j/size * Atotal. */
+  /* (We use a slightly smaller bound to compensate round-off errors.)  */
+  iv = GEN->iv;
+  for (j=0; j<size; j++) {
+    Acum = GEN->Atotal * ((double) j / size) * (1. - 4.*DBL_EPSILON);
+    while (iv->Acum < Acum && iv->next != NULL)
+      iv = iv->next;
+    (*guide)[j] = iv;
+  }
+
+  return UNUR_SUCCESS;
+} /* end of _ars_make_guide_table() */
+
+/*---------------------------------------------------------------------------*/
@@ -0,0 +1,279 @@
+/*****************************************************************************
+ *                                                                           *
+ *          UNU.RAN -- Universal Non-Uniform Random number generator         *
+ *                                                                           *
+ *****************************************************************************
+ *                                                                           *
+ *   FILE: Runuran_autotune.c                                                *
+ *                                                                           *
+ *   PURPOSE:                                                                *
+ *         Select method with lowest cost for expected sample size           *
+ *                                                                           *
+ *****************************************************************************
+ *                                                                           *
+ *   Copyright (c) 2026 Wolfgang Hoermann and Josef Leydold                  *
+ *   Dept. for Statistics, University of Economics, Vienna, Austria          *
+ *                                                                           *
+ *   This program is free software; you can redistribute it and/or modify    *
+ *   it under the terms of the GNU General Public License as published by    *
+ *   the Free Software Foundation; either version 2 of the License, or       *
+ *   (at your option) any later version.                                     *
+ *                                                                           *
+ *   This program is distributed in the hope that it will be useful,         *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of          *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the           *
+ *   GNU General Public License for more details.                            *
+ *                                                                           *
+ *   You should have received a copy of the GNU General Public License       *
+ *   along with this program; if not, write to the                           *
+ *   Free Software Foundation, Inc.,                                         *
+ *   59 Temple Place, Suite 330, Boston, MA 02111-1307, USA                  *
+ *                                                                           *
+ *****************************************************************************
+ *                                                                           *
+ *   Method "auto" of the UNU.RAN library selects a generation method by a   *
+ *   fixed list of rules. It does not take into account how many random      *
+ *   variates are required. However, for a few hundred draws a method with   *
+ *   fast setup (e.g., a rejection method) is preferable while for huge      *
+ *   samples a method with fast marginal generation times (e.g., PINV) is    *
+ *   the better choice.                                                      *
+ *                                                                           *
+ *   Thus we run the setup for each method of a short list of candidates     *
+ *   and draw a trial sample. From the measured (CPU) times we estimate the  *
+ *   total cost for a sample of the expected size                            *
+ *                                                                           *
+ *        cost = time for setup + n * (marginal generation time)             *
+ *                                                                           *
+ *   and return the generator object with the lowest cost. Candidates that   *
+ *   cannot be created for the given distribution or that require more       *
+ *   memory than the given budget are skipped.                               *
+ *                                                                           *
+ *   The generator objects are created by means of the registry, i.e., the   *
+ *   setup is not repeated when the same distribution is tuned again.        *
+ *   The trial samples are drawn from a private uniform random number        *
+ *   generator. Thus the state of the R built-in URNG is not changed.        *
+ *                                                                           *
+ *****************************************************************************/
+
+/*---------------------------------------------------------------------------*/
+
+#include <time.h>
+#include "Runuran.h"
+
+/* internal header files for UNU.RAN */
+#include <unur_source.h>
+
+/*---------------------------------------------------------------------------*/
+
+#define AUTOTUNE_TRIAL_TIME  (2.e-3)
+/* minimal time (in seconds) spent for drawing the trial sample              */
+
+#define AUTOTUNE_TRIAL_SIZE  (100000.)
+/* maximal size of trial sample                                              */
+
+/* candidates for continuous univariate distributions */
+static const char *autotune_cont[] = { "pinv", "tdr", "arou", "ars", "cstd", NULL };
+
+/* candidates for discrete univariate distributions */
+static const char *autotune_discr[] = { "dgt", "dau", "dari", "dstd", NULL };
+
+/*---------------------------------------------------------------------------*/
+
+static double _autotune_trial (struct unur_gen *gen, double n);
+/*---------------------------------------------------------------------------*/
+/* Draw trial sample and return marginal generation time.                    */
+/*---------------------------------------------------------------------------*/
+
+static double _autotune_urng (void *state);
+/*---------------------------------------------------------------------------*/
+/* Uniform random number generator for trial samples (xorshift32).           */
+/*---------------------------------------------------------------------------*/
+
+/*---------------------------------------------------------------------------*/
+
+SEXP
+Runuran_autotune (SEXP sexp_obj, SEXP sexp_distr, SEXP sexp_n, SEXP sexp_memory)
+     /*----------------------------------------------------------------------*/
+     /* Create generator object with the method of lowest projected total    */
+     /* cost for drawing a sample of size 'n'.                               */
+     /*                                                                      */
+     /* Parameters:                                                          */
+     /*   obj    ... S4 class that contains 'Runuran' generator object       */ 
+     /*   distr  ... distribution (string or S4 object)                      */
+     /*   n      ... expected sample size                                    */
+     /*   memory ... memory budget for generator object (in MB)              */
+     /*                                                                      */
+     /* Return:                                                              */
+     /*   pointer to UNU.RAN generator object                                */
+     /*----------------------------------------------------------------------*/
+{
+  SEXP sexp_gen;
+  SEXP sexp_is_inversion;
+  struct unur_distr *distr;
+  struct unur_gen *gen, *best = NULL;
+  const char **methods;
+  const char *best_method = NULL;
+  double n, memory;
+  double cost, best_cost = 0.;
+  clock_t start;
+  int type;
+  int i;
+
+  /* check arguments */
+  n = Rf_asReal(sexp_n);
+  if (ISNAN(n) || n < 1.)
+    Rf_errorcall(R_NilValue,"[UNU.RAN - error] expected sample size 'n' must be positive");
+  memory = Rf_asReal(sexp_memory);
+  if (ISNAN(memory) || memory < 0.)
+    Rf_errorcall(R_NilValue,"[UNU.RAN - error] invalid argument 'memory'");
+  memory *= 1048576.;
+
+  /* get type of distribution */
+  switch (TYPEOF(sexp_distr)) {
+  case STRSXP:
+    distr = unur_str2distr(CHAR(STRING_ELT(sexp_distr,0)));
+    if (distr == NULL)
+      Rf_errorcall(R_NilValue,"[UNU.RAN - error] cannot create UNU.RAN distribution object");
+    type = unur_distr_get_type(distr);
+    unur_distr_free(distr);
+    break;
+  case EXTPTRSXP:
+    distr = R_ExternalPtrAddr(sexp_distr);
+    if (distr == NULL)
+      Rf_errorcall(R_NilValue,"[UNU.RAN - error] invalid NULL pointer");
+    type = unur_distr_get_type(distr);
+    break;
+  default:
+    Rf_errorcall(R_NilValue,"[UNU.RAN - error] invalid argument 'distribution'");
+  }
+
+  switch (type) {
+  case UNUR_DISTR_CONT:
+    methods = autotune_cont;
+    break;
+  case UNUR_DISTR_DISCR:
+    methods = autotune_discr;
+    break;
+  default:
+    Rf_errorcall(R_NilValue,"[UNU.RAN - error] auto-tuning requires univariate distribution");
+  }
+
+  /* run setup and trial sample for all candidates */
+  for (i=0; methods[i] != NULL; i++) {
+    start = clock();
+    gen = _Runuran_registry_makegen( sexp_distr, methods[i] );
+    if (gen == NULL) continue;
+    cost = (double)(clock() - start) / CLOCKS_PER_SEC;
+    cost += n * _autotune_trial(gen, n);
+
+    /* memory is checked after the trial sample as the tables of */
+    /* adaptive methods (TDR, ARS) grow during sampling.         */
+    if (_Runuran_gen_memory(gen) > memory || (best && cost >= best_cost)) {
+      unur_free(gen);
+      continue;
+    }
+
+    if (best) unur_free(best);
+    best = gen;
+    best_cost = cost;
+    best_method = methods[i];
+  }
+
+  if (best == NULL)
+    Rf_errorcall(R_NilValue,"[UNU.RAN - error] cannot create UNU.RAN object within memory budget");
+
+  /* store selected method and whether it is an inversion method */
+  PROTECT(sexp_is_inversion = Rf_allocVector(LGLSXP, 1));
+  LOGICAL(sexp_is_inversion)[0] = unur_gen_is_inversion(best);
+  R_do_slot_assign(sexp_obj, Rf_install("inversion"), sexp_is_inversion);
+  R_do_slot_assign(sexp_obj, Rf_install("method.str"), Rf_mkString(best_method));
+
+  /* make R external pointer and store pointer to structure */
+  PROTECT(sexp_gen = R_MakeExternalPtr(best, _Runuran_tag(), sexp_obj));
+  
+  /* register destructor as C finalizer */
+  R_RegisterCFinalizer(sexp_gen, _Runuran_free);
+
+  /* return pointer to R */
+  UNPROTECT(2);
+  return (sexp_gen);
+
+} /* end of Runuran_autotune() */
+
+/*---------------------------------------------------------------------------*/
+
+double
+_autotune_trial (struct unur_gen *gen, double n)
+     /*----------------------------------------------------------------------*/
+     /* Draw trial sample and return marginal generation time.               */
+     /* The size of the sample is doubled until the elapsed time exceeds     */
+     /* AUTOTUNE_TRIAL_TIME or 'n' random variates have been drawn.          */
+     /*                                                                      */
+     /* Parameters:                                                          */
+     /*   gen ... pointer to generator object                                */
+     /*   n   ... expected sample size                                       */
+     /*                                                                      */
+     /* Return:                                                              */
+     /*   time for generating one random variate (in seconds)                */
+     /*----------------------------------------------------------------------*/
+{
+  UNUR_URNG *urng, *urng_old, *urng_aux_old;
+  unsigned long state = 2463534242UL;
+  double m = 0.;            /* size of trial sample so far */
+  double batch = 16.;       /* size of next batch */
+  double time = 0.;
+  clock_t start;
+  int k;
+  int is_discr;
+
+  is_discr = (unur_distr_get_type(unur_get_distr(gen)) == UNUR_DISTR_DISCR);
+
+  /* use private URNG */
+  urng = unur_urng_new(_autotune_urng, &state);
+  urng_aux_old = gen->urng_aux;
+  urng_old = unur_chg_urng(gen, urng);
+
+  start = clock();
+  while (m < n && m < AUTOTUNE_TRIAL_SIZE) {
+    batch = _unur_min(batch, _unur_min(n - m, AUTOTUNE_TRIAL_SIZE - m));
+    if (is_discr)
+      for (k=0; k<batch; k++) unur_sample_discr(gen);
+    else
+      for (k=0; k<batch; k++) unur_sample_cont(gen);
+    m += batch;
+    time = (double)(clock() - start) / CLOCKS_PER_SEC;
+    if (time >= AUTOTUNE_TRIAL_TIME) break;
+    batch *= 2.;
+  }
+
+  /* restore URNGs */
+  unur_chg_urng(gen, urng_old);
+  if (urng_aux_old) unur_chg_urng_aux(gen, urng_aux_old);
+  unur_urng_free(urng);
+
+  return time / m;
+} /* end of _autotune_trial() */
+
+/*---------------------------------------------------------------------------*/
+
+double
+_autotune_urng (void *state)
+     /*----------------------------------------------------------------------*/
+     /* Uniform random number generator for trial samples (xorshift32).      */
+     /*                                                                      */
+     /* Parameters:                                                          */
+     /*   state ... pointer to state (unsigned long)                         */
+     /*                                                                      */
+     /* Return:                                                              */
+     /*   uniform random number in (0,1)                                     */
+     /*----------------------------------------------------------------------*/
+{
+  unsigned long *x = state;
+
+  *x ^= (*x << 13) & 0xffffffffUL;
+  *x ^= *x >> 17;
+  *x ^= (*x << 5) & 0xffffffffUL;
+  return (*x + 0.5) / 4294967296.;
+} /* end of _autotune_urng() */
+
+/*---------------------------------------------------------------------------*/
@@ -0,0 +1,594 @@
+/*****************************************************************************
+ *                                                                           *
+ *          UNU.RAN -- Universal Non-Uniform Random number generator         *
+ *                                                                           *
+ *****************************************************************************
+ *                                                                           *
+ *   FILE: Runuran_cache.c                                                   *
+ *                                                                           *
+ *   PURPOSE:                                                                *
+ *         Cache of generator objects for the ur<distribution>() wrappers    *
+ *                                                                           *
+ *****************************************************************************
+ *                                                                           *
+ *   Copyright (c) 2026 Wolfgang Hoermann and Josef Leydold                  *
+ *   Dept. for Statistics, University of Economics, Vienna, Austria          *
+ *                                                                           *
+ *   This program is free software; you can redistribute it and/or modify    *
+ *   it under the terms of the GNU General Public License as published by    *
+ *   the Free Software Foundation; either version 2 of the License, or       *
+ *   (at your option) any later version.                                     *
+ *                                                                           *
+ *   This program is distributed in the hope that it will be useful,         *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of          *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the           *
+ *   GNU General Public License for more details.                            *
+ *                                                                           *
+ *   You should have received a copy of the GNU General Public License       *
+ *   along with this program; if not, write to the                           *
+ *   Free Software Foundation, Inc.,                                         *
+ *   59 Temple Place, Suite 330, Boston, MA 02111-1307, USA                  *
+ *                                                                           *
+ *****************************************************************************
+ *                                                                           *
+ *   The wrappers urgamma(), urt(), ... create a generator object, draw a    *
+ *   (often small) sample and drop the object. So the costs for creating     *
+ *   the R object and for the setup exceed the costs for sampling by far.    *
+ *                                                                           *
+ *   Thus the wrappers call Runuran_sample_std() and Runuran_sample_str()    *
+ *   which keep the generator objects in a small cache. The key of an entry  *
+ *   is given by name, parameters and domain of the distribution (or the     *
+ *   distribution string) and the method string. When the cache is full,     *
+ *   the least recently used generator object is destroyed.                  *
+ *                                                                           *
+ *   For methods CSTD and DSTD with an inversion variant neither the         *
+ *   parameters nor the domain are part of the key. Instead the parameters   *
+ *   of the cached generator object are changed by                           *
+ *   _Runuran_cstd_chg_params() (see Runuran_std.c) and the truncated        *
+ *   domain by unur_cstd_chg_truncated() (and the corresponding functions    *
+ *   for method DSTD).                                                       *
+ *                                                                           *
+ *   Adaptive methods (TDR, ARS, AROU) add construction points during        *
+ *   sampling. So the cached generator object is never used for sampling.    *
+ *   Instead each sample is drawn from a clone of it. Thus the result of a   *
+ *   wrapper only depends on the seed and not on previous calls.             *
+ *                                                                           *
+ *****************************************************************************/
+
+/*---------------------------------------------------------------------------*/
+
+#include "Runuran.h"
+
+/* internal header files for UNU.RAN */
+#include <unur_source.h>
+
+/*---------------------------------------------------------------------------*/
+
+#define CACHE_SIZE  (64)
+/* maximal number of generator objects in cache */
+
+/*---------------------------------------------------------------------------*/
+
+struct Runuran_cache_entry {
+  struct Runuran_key key;       /* key of entry */
+  unsigned long hash;           /* hash value of key */
+  struct unur_gen *gen;         /* generator object */
+  double params[UNUR_DISTR_MAXPARAMS];  /* current parameters */
+  int n_params;                 /* number of parameters */
+  double domain[2];             /* current (truncated) domain */
+  unsigned long last_used;      /* time stamp of last usage */
+};
+
+static struct Runuran_cache_entry cache[CACHE_SIZE];
+/* cache of generator objects */
+
+static unsigned long cache_clock = 0;
+/* clock for time stamps */
+
+/*---------------------------------------------------------------------------*/
+
+static struct Runuran_cache_entry *_cache_lookup (const struct Runuran_key *key,
+						  unsigned long hash);
+/*---------------------------------------------------------------------------*/
+/* Search entry for key.                                                     */
+/*---------------------------------------------------------------------------*/
+
+static struct Runuran_cache_entry *_cache_insert (struct Runuran_key *key,
+						  unsigned long hash,
+						  struct unur_gen *gen);
+/*---------------------------------------------------------------------------*/
+/* Store generator object in cache.                                          */
+/*---------------------------------------------------------------------------*/
+
+static int _cache_chg_domain (struct unur_gen *gen, int is_discr, const double *domain);
+/*---------------------------------------------------------------------------*/
+/* Change truncated domain of generator object (methods CSTD and DSTD).      */
+/*---------------------------------------------------------------------------*/
+
+static int _cache_chg_params (struct Runuran_cache_entry *entry, int is_discr,
+			      const double *params, int n_params);
+/*---------------------------------------------------------------------------*/
+/* Change parameters of generator object (methods CSTD and DSTD).            */
+/*---------------------------------------------------------------------------*/
+
+static int _cache_get_n (SEXP sexp_n);
+/*---------------------------------------------------------------------------*/
+/* Extract and check sample size.                                            */
+/*---------------------------------------------------------------------------*/
+
+static SEXP _cache_sample (struct unur_gen *gen, int n);
+/*---------------------------------------------------------------------------*/
+/* Draw sample from cached generator object without changing its state.      */
+/*---------------------------------------------------------------------------*/
+
+/*****************************************************************************/
+
+SEXP
+Runuran_sample_std (SEXP sexp_type, SEXP sexp_name, SEXP sexp_params,
+		    SEXP sexp_domain, SEXP sexp_method, SEXP sexp_n)
+     /*----------------------------------------------------------------------*/
+     /* Sample from special distribution.                                    */
+     /* The generator object is taken from the cache if possible.            */
+     /*                                                                      */
+     /* Parameters:                                                          */
+     /*   type   ... type of distribution ("cont" or "discr")                */
+     /*   name   ... name of special distribution                            */
+     /*   params ... vector of parameter values                              */
+     /*   domain ... domain of distribution                                  */
+     /*   method ... method (string)                                         */
+     /*   n      ... sample size (positive integer)                          */
+     /*                                                                      */
+     /* Return:                                                              */
+     /*   random sample of size 'n'                                          */
+     /*----------------------------------------------------------------------*/
+{
+  struct Runuran_cache_entry *entry;
+  struct Runuran_key key = {NULL, 0, 0};
+  struct unur_distr *distr;
+  struct unur_gen *gen;
+  unsigned long hash;
+  const char *name, *method;
+  const double *params, *domain;
+  int n_params, n;
+  int is_discr, chg_domain;
+  size_t key_len;
+  char tag;
+  SEXP sexp_res;
+
+  /* check arguments */
+  if (! (sexp_type && TYPEOF(sexp_type) == STRSXP && Rf_length(sexp_type) == 1))
+    Rf_errorcall(R_NilValue,"[UNU.RAN - error] invalid argument 'type'");
+  is_discr = (strcmp(CHAR(STRING_ELT(sexp_type,0)), "discr") == 0);
+
+  if (! (sexp_name && TYPEOF(sexp_name) == STRSXP && Rf_length(sexp_name) == 1))
+    Rf_errorcall(R_NilValue,"[UNU.RAN - error] invalid argument 'name'");
+  name = CHAR(STRING_ELT(sexp_name,0));
+
+  if (! (sexp_method && TYPEOF(sexp_method) == STRSXP))
+    Rf_errorcall(R_NilValue,"[UNU.RAN - error] invalid argument 'method'");
+  method = CHAR(STRING_ELT(sexp_method,0));
+
+  PROTECT(sexp_params = Rf_coerceVector(sexp_params, REALSXP));
+  params = REAL(sexp_params);
+  n_params = Rf_length(sexp_params);
+
+  PROTECT(sexp_domain = Rf_coerceVector(sexp_domain, REALSXP));
+  if (Rf_length(sexp_domain) != 2)
+    Rf_errorcall(R_NilValue,"[UNU.RAN - error] invalid argument 'domain'");
+  domain = REAL(sexp_domain);
+
+  n = _cache_get_n(sexp_n);
+
+  /* key without parameters and domain */
+  tag = (is_discr) ? 'd' : 'c';
+  _Runuran_key_add(&key, &tag, 1);
+  _Runuran_key_add(&key, name, strlen(name)+1);
+  _Runuran_key_add(&key, method, strlen(method)+1);
+  key_len = key.len;
+
+  /* (1) generator object where we can change parameters and domain */
+  hash = _Runuran_key_hash(&key);
+  entry = _cache_lookup(&key, hash);
+  if (entry && _cache_chg_params(entry, is_discr, params, n_params) != UNUR_SUCCESS)
+    /* we have to create a new generator object */
+    entry = NULL;
+  if (entry && (entry->domain[0] != domain[0] || entry->domain[1] != domain[1])) {
+    if (_cache_chg_domain(entry->gen, is_discr, domain) == UNUR_SUCCESS) {
+      entry->domain[0] = domain[0]; entry->domain[1] = domain[1];
+    }
+    else
+      entry = NULL;
+  }
+
+  /* (2) otherwise parameters and domain are part of the key */
+  if (entry == NULL) {
+    _Runuran_key_add(&key, &n_params, sizeof(int));
+    _Runuran_key_add(&key, params, n_params * sizeof(double));
+    tag = 'D';
+    _Runuran_key_add(&key, &tag, 1);
+    _Runuran_key_add(&key, domain, 2 * sizeof(double));
+    hash = _Runuran_key_hash(&key);
+    entry = _cache_lookup(&key, hash);
+  }
+
+  /* (3) create new generator object */
+  if (entry == NULL) {
+    /* methods CSTD and DSTD: setup for untruncated distribution */
+    chg_domain = ( !strcmp(method, "cstd") || !strcmp(method, "CSTD") ||
+		   !strcmp(method, "dstd") || !strcmp(method, "DSTD") );
+
+    gen = NULL;
+    if (chg_domain) {
+      distr = (is_discr)
+	? _Runuran_get_std_discr( name, params, n_params )
+	: _Runuran_get_std_cont( name, params, n_params );
+      if (distr == NULL) { free(key.buf); _Runuran_fatal(); }
+      gen = unur_makegen_dsu( distr, method, NULL );
+      unur_distr_free(distr);
+
+      if (gen != NULL && unur_gen_is_inversion(gen) &&
+	  n_params <= UNUR_DISTR_MAXPARAMS &&
+	  _cache_chg_domain(gen, is_discr, domain) == UNUR_SUCCESS) {
+	/* remove parameters and domain from key */
+	key.len = key_len;
+	hash = _Runuran_key_hash(&key);
+      }
+      else {
+	if (gen) unur_free(gen);
+	gen = NULL;
+      }
+    }
+
+    if (gen == NULL) {
+      distr = (is_discr)
+	? _Runuran_get_std_discr( name, params, n_params )
+	: _Runuran_get_std_cont( name, params, n_params );
+      if (distr == NULL) { free(key.buf); _Runuran_fatal(); }
+
+      if (is_discr) {
+	int lb = (domain[0] < (double) INT_MIN) ? INT_MIN : (int) domain[0];
+	int ub = (domain[1] > (double) INT_MAX) ? INT_MAX : (int) domain[1];
+	if (unur_distr_discr_set_domain( distr, lb, ub ) != UNUR_SUCCESS) {
+	  unur_distr_free(distr); free(key.buf); _Runuran_fatal();
+	}
+      }
+      else {
+	if (unur_distr_cont_set_domain( distr, domain[0], domain[1] ) != UNUR_SUCCESS) {
+	  unur_distr_free(distr); free(key.buf); _Runuran_fatal();
+	}
+      }
+
+      gen = unur_makegen_dsu( distr, method, NULL );
+      unur_distr_free(distr);
+    }
+
+    if (gen == NULL) {
+      free(key.buf);
+      Rf_errorcall(R_NilValue,"[UNU.RAN - error] cannot create UNU.RAN object");
+    }
+
+    entry = _cache_insert(&key, hash, gen);
+    entry->n_params = (n_params <= UNUR_DISTR_MAXPARAMS) ? n_params : 0;
+    memcpy(entry->params, params, entry->n_params * sizeof(double));
+    entry->domain[0] = domain[0]; entry->domain[1] = domain[1];
+  }
+
+  if (key.buf) free(key.buf);
+
+  /* draw sample */
+  PROTECT(sexp_res = _cache_sample(entry->gen, n));
+  UNPROTECT(3);
+  return sexp_res;
+
+} /* end of Runuran_sample_std() */
+
+/*---------------------------------------------------------------------------*/
+
+SEXP
+Runuran_sample_str (SEXP sexp_distr, SEXP sexp_method, SEXP sexp_n)
+     /*----------------------------------------------------------------------*/
+     /* Sample from distribution given by a string.                          */
+     /* The generator object is taken from the cache if possible.            */
+     /*                                                                      */
+     /* Parameters:                                                          */
+     /*   distr  ... distribution (string)                                   */
+     /*   method ... method (string)                                         */
+     /*   n      ... sample size (positive integer)                          */
+     /*                                                                      */
+     /* Return:                                                              */
+     /*   random sample of size 'n'                                          */
+     /*----------------------------------------------------------------------*/
+{
+  struct Runuran_cache_entry *entry;
+  struct Runuran_key key = {NULL, 0, 0};
+  struct unur_gen *gen;
+  unsigned long hash;
+  const char *distr, *method;
+  int n;
+  char tag = 's';
+
+  /* check arguments */
+  if (! (sexp_distr && TYPEOF(sexp_distr) == STRSXP))
+    Rf_errorcall(R_NilValue,"[UNU.RAN - error] invalid argument 'distribution'");
+  distr = CHAR(STRING_ELT(sexp_distr,0));
+
+  if (! (sexp_method && TYPEOF(sexp_method) == STRSXP))
+    Rf_errorcall(R_NilValue,"[UNU.RAN - error] invalid argument 'method'");
+  method = CHAR(STRING_ELT(sexp_method,0));
+
+  n = _cache_get_n(sexp_n);
+
+  /* key */
+  _Runuran_key_add(&key, &tag, 1);
+  _Runuran_key_add(&key, distr, strlen(distr)+1);
+  _Runuran_key_add(&key, method, strlen(method)+1);
+  hash = _Runuran_key_hash(&key);
+
+  /* search cache */
+  entry = _cache_lookup(&key, hash);
+
+  /* create new generator object (or get a copy from the registry) */
+  if (entry == NULL) {
+    gen = _Runuran_registry_makegen( sexp_distr, method );
+    if (gen == NULL) {
+      free(key.buf);
+      Rf_errorcall(R_NilValue,"[UNU.RAN - error] cannot create UNU.RAN object");
+    }
+    entry = _cache_insert(&key, hash, gen);
+  }
+
+  if (key.buf) free(key.buf);
+
+  /* draw sample */
+  return _cache_sample(entry->gen, n);
+
+} /* end of Runuran_sample_str() */
+
+/*---------------------------------------------------------------------------*/
+
+void
+_Runuran_cache_clear (void)
+     /*----------------------------------------------------------------------*/
+     /* Remove all generator objects from cache.                             */
+     /*----------------------------------------------------------------------*/
+{
+  int i;
+
+  for (i=0; i<CACHE_SIZE; i++) {
+    if (cache[i].gen) {
+      unur_free(cache[i].gen);
+      free(cache[i].key.buf);
+    }
+    memset(&(cache[i]), 0, sizeof(struct Runuran_cache_entry));
+  }
+} /* end of _Runuran_cache_clear() */
+
+/*****************************************************************************/
+
+struct Runuran_cache_entry *
+_cache_lookup (const struct Runuran_key *key, unsigned long hash)
+     /*----------------------------------------------------------------------*/
+     /* Search entry for key.                                                */
+     /*                                                                      */
+     /* Parameters:                                                          */
+     /*   key  ... pointer to key                                            */
+     /*   hash ... hash value of key                                         */
+     /*                                                                      */
+     /* Return:                                                              */
+     /*   pointer to entry                                                   */
+     /*   NULL if the cache does not contain the key                         */
+     /*----------------------------------------------------------------------*/
+{
+  int i;
+
+  for (i=0; i<CACHE_SIZE; i++) {
+    if (cache[i].gen && cache[i].hash == hash && cache[i].key.len == key->len &&
+	memcmp(cache[i].key.buf, key->buf, key->len) == 0) {
+      cache[i].last_used = ++cache_clock;
+      return &(cache[i]);
+    }
+  }
+
+  return NULL;
+} /* end of _cache_lookup() */
+
+/*---------------------------------------------------------------------------*/
+
+struct Runuran_cache_entry *
+_cache_insert (struct Runuran_key *key, unsigned long hash, struct unur_gen *gen)
+     /*----------------------------------------------------------------------*/
+     /* Store generator object in cache.                                     */
+     /* The least recently used entry is replaced if the cache is full.      */
+     /*                                                                      */
+     /* Parameters:                                                          */
+     /*   key  ... pointer to key (the buffer is moved into the cache)       */
+     /*   hash ... hash value of key                                         */
+     /*   gen  ... pointer to generator object                               */
+     /*                                                                      */
+     /* Return:                                                              */
+     /*   pointer to entry                                                   */
+     /*----------------------------------------------------------------------*/
+{
+  struct Runuran_cache_entry *entry;
+  int i;
+
+  /* find empty or least recently used entry */
+  entry = &(cache[0]);
+  for (i=0; i<CACHE_SIZE; i++) {
+    if (cache[i].gen == NULL) {
+      entry = &(cache[i]);
+      break;
+    }
+    if (cache[i].last_used < entry->last_used)
+      entry = &(cache[i]);
+  }
+
+  /* remove old generator object */
+  if (entry->gen) {
+    unur_free(entry->gen);
+    free(entry->key.buf);
+  }
+
+  /* store new generator object */
+  entry->key = *key;
+  key->buf = NULL; key->len = key->size = 0;
+  entry->hash = hash;
+  entry->gen = gen;
+  entry->last_used = ++cache_clock;
+
+  return entry;
+} /* end of _cache_insert() */
+
+/*---------------------------------------------------------------------------*/
+
+int
+_cache_chg_domain (struct unur_gen *gen, int is_discr, const double *domain)
+     /*----------------------------------------------------------------------*/
+     /* Change truncated domain of generator object (methods CSTD and DSTD). */
+     /*                                                                      */
+     /* Parameters:                                                          */
+     /*   gen      ... pointer to generator object                           */
+     /*   is_discr ... TRUE for discrete distributions                       */
+     /*   domain   ... new domain                                            */
+     /*                                                                      */
+     /* Return:                                                              */
+     /*   UNUR_SUCCESS ... on success                                        */
+     /*   error code   ... otherwise                                         */
+     /*----------------------------------------------------------------------*/
+{
+  const double *dom;
+  int lb, ub;
+
+  switch (unur_get_method(gen)) {
+  case UNUR_METH_CSTD:
+    /* we must not extend the domain of the distribution */
+    dom = gen->distr->data.cont.domain;
+    if (is_discr || domain[0] < dom[0] || domain[1] > dom[1])
+      return UNUR_ERR_GEN_DATA;
+    return unur_cstd_chg_truncated(gen, domain[0], domain[1]);
+
+  case UNUR_METH_DSTD:
+    lb = (domain[0] < (double) INT_MIN) ? INT_MIN : (int) domain[0];
+    ub = (domain[1] > (double) INT_MAX) ? INT_MAX : (int) domain[1];
+    if (!is_discr ||
+	lb < gen->distr->data.discr.domain[0] || ub > gen->distr->data.discr.domain[1])
+      return UNUR_ERR_GEN_DATA;
+    return unur_dstd_chg_truncated(gen, lb, ub);
+
+  default:
+    return UNUR_ERR_GEN_DATA;
+  }
+} /* end of _cache_chg_domain() */
+
+/*---------------------------------------------------------------------------*/
+
+int
+_cache_chg_params (struct Runuran_cache_entry *entry, int is_discr,
+		   const double *params, int n_params)
+     /*----------------------------------------------------------------------*/
+     /* Change parameters of generator object (methods CSTD and DSTD).       */
+     /*                                                                      */
+     /* Parameters:                                                          */
+     /*   entry    ... pointer to cache entry                                */
+     /*   is_discr ... TRUE for discrete distributions                       */
+     /*   params   ... new parameters                                        */
+     /*   n_params ... number of parameters                                  */
+     /*                                                                      */
+     /* Return:                                                              */
+     /*   UNUR_SUCCESS ... on success                                        */
+     /*   error code   ... otherwise                                         */
+     /*----------------------------------------------------------------------*/
+{
+  int rcode;
+
+  if (n_params == entry->n_params &&
+      memcmp(params, entry->params, n_params * sizeof(double)) == 0)
+    /* nothing to do */
+    return UNUR_SUCCESS;
+
+  if (n_params > UNUR_DISTR_MAXPARAMS)
+    return UNUR_ERR_DISTR_NPARAMS;
+
+  rcode = (is_discr)
+    ? _Runuran_dstd_chg_params(entry->gen, params, n_params)
+    : _Runuran_cstd_chg_params(entry->gen, params, n_params);
+
+  if (rcode == UNUR_SUCCESS) {
+    entry->n_params = n_params;
+    memcpy(entry->params, params, n_params * sizeof(double));
+  }
+
+  return rcode;
+} /* end of _cache_chg_params() */
+
+/*---------------------------------------------------------------------------*/
+
+int
+_cache_get_n (SEXP sexp_n)
+     /*----------------------------------------------------------------------*/
+     /* Extract and check sample size.                                       */
+     /*                                                                      */
+     /* Parameters:                                                          */
+     /*   n ... sample size                                                  */
+     /*                                                                      */
+     /* Return:                                                              */
+     /*   sample size                                                        */
+     /*----------------------------------------------------------------------*/
+{
+  int n;
+
+  n = *(INTEGER (Rf_coerceVector(sexp_n, INTSXP)));
+  if (n<=0) {
+    Rf_error("sample size 'n' must be positive integer");
+  }
+
+  return n;
+} /* end of _cache_get_n() */
+
+/*---------------------------------------------------------------------------*/
+
+SEXP
+_cache_sample (struct unur_gen *gen, int n)
+     /*----------------------------------------------------------------------*/
+     /* Draw sample from cached generator object without changing its state. */
+     /* Adaptive methods (TDR, ARS, AROU) improve their hat while sampling.  */
+     /* Then we sample from a clone of the cached generator object, such     */
+     /* that the result only depends on the state of the R built-in URNG     */
+     /* and not on previous calls.                                           */
+     /*                                                                      */
+     /* Parameters:                                                          */
+     /*   gen ... pointer to cached generator object                         */
+     /*   n   ... sample size (positive integer)                             */
+     /*                                                                      */
+     /* Return:                                                              */
+     /*   random sample of size 'n'                                          */
+     /*----------------------------------------------------------------------*/
+{
+  SEXP sexp_gen, sexp_res;
+  struct unur_gen *clone;
+
+  switch (unur_get_method(gen)) {
+  case UNUR_METH_TDR:
+  case UNUR_METH_ARS:
+  case UNUR_METH_AROU:
+    break;
+  default:
+    /* state of generator object does not change */
+    return _Runuran_sample_unur(gen, n);
+  }
+
+  /* clone is freed by the garbage collector in case of an R error */
+  clone = unur_gen_clone(gen);
+  if (clone == NULL)
+    Rf_errorcall(R_NilValue,"[UNU.RAN - error] cannot create UNU.RAN object");
+  PROTECT(sexp_gen = R_MakeExternalPtr(clone, _Runuran_tag(), R_NilValue));
+  R_RegisterCFinalizer(sexp_gen, _Runuran_free);
+
+  PROTECT(sexp_res = _Runuran_sample_unur(clone, n));
+  _Runuran_free(sexp_gen);
+
+  UNPROTECT(2);
+  return sexp_res;
+} /* end of _cache_sample() */
+
+/*---------------------------------------------------------------------------*/
@@ -0,0 +1,525 @@
+/*****************************************************************************
+ *                                                                           *
+ *          UNU.RAN -- Universal Non-Uniform Random number generator         *
+ *                                                                           *
+ *****************************************************************************
+ *                                                                           *
+ *   FILE: Runuran_cext.c                                                    *
+ *                                                                           *
+ *   PURPOSE:                                                                *
+ *         External generators with buffered array sampling (CEXT, DEXT)     *
+ *                                                                           *
+ *****************************************************************************
+ *                                                                           *
+ *   Copyright (c) 2026 Wolfgang Hoermann and Josef Leydold                  *
+ *   Dept. for Statistics, University of Economics, Vienna, Austria          *
+ *                                                                           *
+ *   This program is free software; you can redistribute it and/or modify    *
+ *   it under the terms of the GNU General Public License as published by    *
+ *   the Free Software Foundation; either version 2 of the License, or       *
+ *   (at your option) any later version.                                     *
+ *                                                                           *
+ *   This program is distributed in the hope that it will be useful,         *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of          *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the           *
+ *   GNU General Public License for more details.                            *
+ *                                                                           *
+ *   You should have received a copy of the GNU General Public License       *
+ *   along with this program; if not, write to the                           *
+ *   Free Software Foundation, Inc.,                                         *
+ *   59 Temple Place, Suite 330, Boston, MA 02111-1307, USA                  *
+ *                                                                           *
+ *****************************************************************************
+ *                                                                           *
+ *   Methods CEXT and DEXT turn a user supplied routine for generating a     *
+ *   single random variate into a UNU.RAN generator object. Thus every call  *
+ *   of the sampling routine of such a generator requires one call of the    *
+ *   external routine. When this routine is an R function, the overhead of   *
+ *   the R interpreter for each single draw is huge.                         *
+ *                                                                           *
+ *   Here we use a routine that generates an array of random variates        *
+ *   instead (array-sampling callback). The generator object stores a        *
+ *   buffer of 'blocksize' random variates which is refilled by a single     *
+ *   call of the callback when it is exhausted. The sampling routines of     *
+ *   CEXT and DEXT just return the next value from this buffer. When a       *
+ *   sample of size n is requested, the buffer is drained first and the      *
+ *   remaining random variates are generated by a single call of the         *
+ *   callback.                                                               *
+ *                                                                           *
+ *   The callback is either a C function or an R function with the sample    *
+ *   size as its only argument. In the latter case the R function is         *
+ *   protected by R_PreserveObject() as long as the generator object or a    *
+ *   clone of it (e.g., a component of a mixture) exists. The R built-in     *
+ *   uniform random number generator is synchronized before and after the    *
+ *   R function is called.                                                   *
+ *                                                                           *
+ *   The generator object is a wrapper for an external generator (method     *
+ *   CEXT or DEXT). The routines for destroying and cloning the wrapper are  *
+ *   replaced such that the buffer is freed and created as well. A clone     *
+ *   starts with an empty buffer.                                            *
+ *                                                                           *
+ *****************************************************************************/
+
+/*---------------------------------------------------------------------------*/
+
+#include "Runuran.h"
+
+/* internal header files for UNU.RAN */
+#include <unur_source.h>
+#include <methods/cext_struct.h>
+#include <methods/dext_struct.h>
+
+/*---------------------------------------------------------------------------*/
+
+/* maximal size of buffer */
+#define CEXT_MAX_BLOCKSIZE  (1048576)
+
+/*---------------------------------------------------------------------------*/
+
+struct Runuran_cext {
+  Runuran_sample_array *sample_array; /* array-sampling callback             */
+  void   *data;           /* data for callback                               */
+  SEXP   fun;             /* R function (or NULL)                            */
+  int    discrete;        /* whether random variates are integers            */
+  int    size;            /* size of buffer (blocksize)                      */
+  int    pos;             /* position of next value in buffer                */
+  int    n;               /* number of values in buffer                      */
+  double *buffer;         /* buffer for random variates [size]               */
+};
+
+/*---------------------------------------------------------------------------*/
+
+static double _cext_sample (struct unur_gen *gen);
+/*---------------------------------------------------------------------------*/
+/* Sample from generator (sampling routine for method CEXT).                 */
+/*---------------------------------------------------------------------------*/
+
+static int _dext_sample (struct unur_gen *gen);
+/*---------------------------------------------------------------------------*/
+/* Sample from generator (sampling routine for method DEXT).                 */
+/*---------------------------------------------------------------------------*/
+
+static int _cext_refill (struct unur_gen *gen, struct Runuran_cext *cext);
+/*---------------------------------------------------------------------------*/
+/* Refill buffer by a single call of the array-sampling callback.            */
+/*---------------------------------------------------------------------------*/
+
+static int _cext_eval_R (double *X, int n, void *data);
+/*---------------------------------------------------------------------------*/
+/* Array-sampling callback that calls an R function.                         */
+/*---------------------------------------------------------------------------*/
+
+static void _cext_free (struct unur_gen *gen);
+/*---------------------------------------------------------------------------*/
+/* Destroy generator object (including buffer).                              */
+/*---------------------------------------------------------------------------*/
+
+static struct unur_gen *_cext_clone (const struct unur_gen *gen);
+/*---------------------------------------------------------------------------*/
+/* Copy generator object (with empty buffer).                                */
+/*---------------------------------------------------------------------------*/
+
+/* original routines of methods CEXT and DEXT */
+static void (*_cext_orig_free)(struct unur_gen *gen) = NULL;
+static struct unur_gen *(*_cext_orig_clone)(const struct unur_gen *gen) = NULL;
+static void (*_dext_orig_free)(struct unur_gen *gen) = NULL;
+static struct unur_gen *(*_dext_orig_clone)(const struct unur_gen *gen) = NULL;
+
+/*---------------------------------------------------------------------------*/
+
+#define CEXT(gen) \
+  ((struct Runuran_cext*) (((gen)->method == UNUR_METH_CEXT) \
+			   ? ((struct unur_cext_gen*)(gen)->datap)->param \
+			   : ((struct unur_dext_gen*)(gen)->datap)->param))
+
+/*****************************************************************************/
+
+struct unur_gen *
+_Runuran_cext_new (int discrete, Runuran_sample_array *sample_array,
+		   void *data, int blocksize)
+     /*----------------------------------------------------------------------*/
+     /* Create external generator with buffered array-sampling callback.     */
+     /*                                                                      */
+     /* Parameters:                                                          */
+     /*   discrete     ... TRUE for integer valued random variates (DEXT)    */
+     /*   sample_array ... routine for generating array of random variates   */
+     /*   data         ... data passed to 'sample_array'                     */
+     /*   blocksize    ... size of buffer                                    */
+     /*                                                                      */
+     /* Return:                                                              */
+     /*   pointer to generator object                                        */
+     /*                                                                      */
+     /* error:                                                               */
+     /*   return NULL                                                        */
+     /*----------------------------------------------------------------------*/
+{
+  struct unur_par *par;
+  struct unur_gen *gen;
+  struct Runuran_cext *cext;
+
+  if (sample_array == NULL || blocksize < 1 || blocksize > CEXT_MAX_BLOCKSIZE) {
+    _unur_error("CEXT",UNUR_ERR_PAR_SET,"invalid callback or blocksize");
+    return NULL;
+  }
+
+  /* create wrapper (method CEXT or DEXT) */
+  if (discrete) {
+    par = unur_dext_new(NULL);
+    unur_dext_set_sample(par, _dext_sample);
+  }
+  else {
+    par = unur_cext_new(NULL);
+    unur_cext_set_sample(par, _cext_sample);
+  }
+  gen = unur_init(par);
+  if (gen == NULL) return NULL;
+
+  /* replace routines for destroying and cloning the generator object */
+  if (discrete) {
+    _dext_orig_free = gen->destroy;
+    _dext_orig_clone = gen->clone;
+  }
+  else {
+    _cext_orig_free = gen->destroy;
+    _cext_orig_clone = gen->clone;
+  }
+  gen->destroy = _cext_free;
+  gen->clone = _cext_clone;
+
+  /* parameters */
+  cext = (discrete)
+    ? unur_dext_get_params(gen, sizeof(struct Runuran_cext))
+    : unur_cext_get_params(gen, sizeof(struct Runuran_cext));
+  cext->sample_array = sample_array;
+  cext->data = data;
+  cext->fun = NULL;
+  cext->discrete = discrete;
+  cext->size = blocksize;
+  cext->pos = 0;
+  cext->n = 0;
+  cext->buffer = _unur_xmalloc(blocksize * sizeof(double));
+
+  return gen;
+} /* end of _Runuran_cext_new() */
+
+/*---------------------------------------------------------------------------*/
+
+SEXP
+Runuran_cext (SEXP sexp_obj, SEXP sexp_sample, SEXP sexp_discrete, SEXP sexp_blocksize)
+     /*----------------------------------------------------------------------*/
+     /* Create UNU.RAN generator object for external generator given by a    */
+     /* vectorized R function.                                               */
+     /*                                                                      */
+     /* Parameters:                                                          */
+     /*   obj       ... S4 class that contains 'Runuran' generator object    */
+     /*   sample    ... R function: sample(n) returns n random variates      */
+     /*   discrete  ... TRUE for discrete distributions (boolean)            */
+     /*   blocksize ... number of random variates generated in one call      */
+     /*                                                                      */
+     /* Return:                                                              */
+     /*   pointer to UNU.RAN generator object                                */
+     /*----------------------------------------------------------------------*/
+{
+  struct unur_gen *gen;
+  struct Runuran_cext *cext;
+  int discrete;
+  int blocksize;
+  SEXP sexp_gen;
+
+  /* check arguments */
+  if (! Rf_isFunction(sexp_sample))
+    Rf_errorcall(R_NilValue,"[UNU.RAN - error] invalid argument 'sample'");
+  discrete = Rf_asLogical(sexp_discrete);
+  if (discrete == NA_LOGICAL)
+    Rf_errorcall(R_NilValue,"[UNU.RAN - error] invalid argument 'discrete'");
+  blocksize = Rf_asInteger(sexp_blocksize);
+  if (blocksize == NA_INTEGER || blocksize < 1 || blocksize > CEXT_MAX_BLOCKSIZE)
+    Rf_errorcall(R_NilValue,"[UNU.RAN - error] invalid argument 'blocksize'");
+
+  /* create generator object */
+  gen = _Runuran_cext_new(discrete, _cext_eval_R, NULL, blocksize);
+  if (gen == NULL)
+    Rf_errorcall(R_NilValue,"[UNU.RAN - error] cannot create UNU.RAN object");
+
+  /* store R function: the callback gets the parameters as its data */
+  cext = CEXT(gen);
+  cext->data = cext;
+  cext->fun = sexp_sample;
+  R_PreserveObject(sexp_sample);
+
+  /* make R external pointer and store pointer to structure */
+  PROTECT(sexp_gen = R_MakeExternalPtr(gen, _Runuran_tag(), sexp_obj));
+  
+  /* register destructor as C finalizer */
+  R_RegisterCFinalizer(sexp_gen, _Runuran_free);
+
+  /* return pointer to R */
+  UNPROTECT(1);
+  return (sexp_gen);
+
+} /* end of Runuran_cext() */
+
+/*---------------------------------------------------------------------------*/
+
+int
+_Runuran_is_cext (const struct unur_gen *gen)
+     /*----------------------------------------------------------------------*/
+     /* Check whether generator object is an external generator with         */
+     /* buffered array-sampling callback.                                    */
+     /*                                                                      */
+     /* Parameters:                                                          */
+     /*   gen ... pointer to UNU.RAN generator object                        */
+     /*                                                                      */
+     /* Return:                                                              */
+     /*   TRUE if 'gen' is such a generator, FALSE otherwise                 */
+     /*----------------------------------------------------------------------*/
+{
+  return ( (gen->method == UNUR_METH_CEXT && gen->sample.cont == _cext_sample) ||
+	   (gen->method == UNUR_METH_DEXT && gen->sample.discr == _dext_sample) );
+} /* end of _Runuran_is_cext() */
+
+/*---------------------------------------------------------------------------*/
+
+int
+_Runuran_cext_sample_array (struct unur_gen *gen, double *X, int n)
+     /*----------------------------------------------------------------------*/
+     /* Sample from external generator (batch version).                      */
+     /*                                                                      */
+     /* Parameters:                                                          */
+     /*   gen ... pointer to generator object                                */
+     /*   X   ... array for storing random sample                            */
+     /*   n   ... sample size                                                */
+     /*                                                                      */
+     /* Return:                                                              */
+     /*   UNUR_SUCCESS on success                                            */
+     /*   error code otherwise                                               */
+     /*----------------------------------------------------------------------*/
+{
+  struct Runuran_cext *cext = CEXT(gen);
+  int k, m;
+
+  /* drain buffer */
+  k = (n < cext->n) ? n : cext->n;
+  memcpy(X, cext->buffer + cext->pos, k * sizeof(double));
+  cext->pos += k;
+  cext->n -= k;
+
+  /* generate remaining random variates */
+  while (k < n) {
+    m = n - k;
+    if (m >= cext->size) {
+      /* a single call of the callback */
+      if (cext->sample_array(X+k, m, cext->data) != UNUR_SUCCESS)
+	break;
+      return UNUR_SUCCESS;
+    }
+    /* refill buffer and copy the required number of values */
+    if (_cext_refill(gen, cext) != UNUR_SUCCESS)
+      break;
+    memcpy(X+k, cext->buffer, m * sizeof(double));
+    cext->pos = m;
+    cext->n -= m;
+    return UNUR_SUCCESS;
+  }
+
+  /* callback has failed */
+  _unur_error(gen->genid,UNUR_ERR_GEN_SAMPLING,"external sampling routine failed");
+  for (; k<n; k++)
+    X[k] = UNUR_INFINITY;
+  return UNUR_ERR_GEN_SAMPLING;
+
+} /* end of _Runuran_cext_sample_array() */
+
+/*---------------------------------------------------------------------------*/
+
+double
+_cext_sample (struct unur_gen *gen)
+     /*----------------------------------------------------------------------*/
+     /* Sample from generator (sampling routine for method CEXT).            */
+     /*                                                                      */
+     /* Parameters:                                                          */
+     /*   gen ... pointer to generator object                                */
+     /*                                                                      */
+     /* Return:                                                              */
+     /*   double (sample from random variate)                                */
+     /*                                                                      */
+     /* error:                                                               */
+     /*   return UNUR_INFINITY                                               */
+     /*----------------------------------------------------------------------*/
+{
+  struct Runuran_cext *cext = CEXT(gen);
+
+  if (cext->n <= 0 && _cext_refill(gen, cext) != UNUR_SUCCESS) {
+    _unur_error(gen->genid,UNUR_ERR_GEN_SAMPLING,"external sampling routine failed");
+    return UNUR_INFINITY;
+  }
+
+  --(cext->n);
+  return cext->buffer[(cext->pos)++];
+} /* end of _cext_sample() */
+
+/*---------------------------------------------------------------------------*/
+
+int
+_dext_sample (struct unur_gen *gen)
+     /*----------------------------------------------------------------------*/
+     /* Sample from generator (sampling routine for method DEXT).            */
+     /*                                                                      */
+     /* Parameters:                                                          */
+     /*   gen ... pointer to generator object                                */
+     /*                                                                      */
+     /* Return:                                                              */
+     /*   integer (sample from random variate)                               */
+     /*                                                                      */
+     /* error:                                                               */
+     /*   return INT_MAX                                                     */
+     /*----------------------------------------------------------------------*/
+{
+  struct Runuran_cext *cext = CEXT(gen);
+
+  if (cext->n <= 0 && _cext_refill(gen, cext) != UNUR_SUCCESS) {
+    _unur_error(gen->genid,UNUR_ERR_GEN_SAMPLING,"external sampling routine failed");
+    return INT_MAX;
+  }
+
+  --(cext->n);
+  return (int) cext->buffer[(cext->pos)++];
+} /* end of _dext_sample() */
+
+/*---------------------------------------------------------------------------*/
+
+int
+_cext_refill (struct unur_gen *gen, struct Runuran_cext *cext)
+     /*----------------------------------------------------------------------*/
+     /* Refill buffer by a single call of the array-sampling callback.       */
+     /*                                                                      */
+     /* Parameters:                                                          */
+     /*   gen  ... pointer to generator object                               */
+     /*   cext ... parameters of generator object                            */
+     /*                                                                      */
+     /* Return:                                                              */
+     /*   UNUR_SUCCESS on success                                            */
+     /*   error code otherwise                                               */
+     /*----------------------------------------------------------------------*/
+{
+  /* the buffer is empty while the callback is running */
+  cext->pos = 0;
+  cext->n = 0;
+
+  if (cext->sample_array(cext->buffer, cext->size, cext->data) != UNUR_SUCCESS)
+    return UNUR_ERR_GEN_SAMPLING;
+
+  cext->n = cext->size;
+  return UNUR_SUCCESS;
+} /* end of _cext_refill() */
+
+/*---------------------------------------------------------------------------*/
+
+int
+_cext_eval_R (double *X, int n, void *data)
+     /*----------------------------------------------------------------------*/
+     /* Array-sampling callback that calls an R function.                    */
+     /*                                                                      */
+     /* Parameters:                                                          */
+     /*   X    ... array for storing random sample                           */
+     /*   n    ... sample size                                               */
+     /*   data ... parameters of generator object                            */
+     /*                                                                      */
+     /* Return:                                                              */
+     /*   UNUR_SUCCESS                                                       */
+     /*   (an R error is raised when the R function returns invalid values)  */
+     /*----------------------------------------------------------------------*/
+{
+  struct Runuran_cext *cext = data;
+  SEXP R_fcall, arg, val;
+  const double *x;
+  int i;
+
+  /* the R function may use the R built-in URNG: synchronize state */
+  PutRNGstate();
+
+  PROTECT(arg = Rf_ScalarInteger(n));
+  PROTECT(R_fcall = Rf_lang2(cext->fun, arg));
+  PROTECT(val = Rf_eval(R_fcall, R_GlobalEnv));
+  PROTECT(val = Rf_coerceVector(val, REALSXP));
+
+  GetRNGstate();
+
+  if (Rf_length(val) != n) {
+    UNPROTECT(4);
+    Rf_errorcall(R_NilValue,"[UNU.RAN - error] 'sample' must return a numeric vector of length 'n'");
+  }
+
+  x = REAL(val);
+  if (cext->discrete) {
+    for (i=0; i<n; i++)
+      if (! (x[i] == floor(x[i]) && fabs(x[i]) < INT_MAX)) {
+	UNPROTECT(4);
+	Rf_errorcall(R_NilValue,"[UNU.RAN - error] 'sample' must return integers");
+      }
+  }
+  memcpy(X, x, n * sizeof(double));
+
+  UNPROTECT(4);
+  return UNUR_SUCCESS;
+} /* end of _cext_eval_R() */
+
+/*---------------------------------------------------------------------------*/
+
+void
+_cext_free (struct unur_gen *gen)
+     /*----------------------------------------------------------------------*/
+     /* Destroy generator object (including buffer).                         */
+     /*                                                                      */
+     /* Parameters:                                                          */
+     /*   gen ... pointer to generator object                                */
+     /*----------------------------------------------------------------------*/
+{
+  struct Runuran_cext *cext = CEXT(gen);
+
+  if (cext) {
+    if (cext->buffer) free(cext->buffer);
+    if (cext->fun) R_ReleaseObject(cext->fun);
+  }
+
+  if (gen->method == UNUR_METH_CEXT)
+    _cext_orig_free(gen);
+  else
+    _dext_orig_free(gen);
+} /* end of _cext_free() */
+
+/*---------------------------------------------------------------------------*/
+
+struct unur_gen *
+_cext_clone (const struct unur_gen *gen)
+     /*----------------------------------------------------------------------*/
+     /* Copy generator object (with empty buffer).                           */
+     /*                                                                      */
+     /* Parameters:                                                          */
+     /*   gen ... pointer to generator object                                */
+     /*                                                                      */
+     /* Return:                                                              */
+     /*   pointer to clone of generator object                               */
+     /*----------------------------------------------------------------------*/
+{
+  struct unur_gen *clone;
+  struct Runuran_cext *cext;
+
+  clone = (gen->method == UNUR_METH_CEXT) ? _cext_orig_clone(gen) : _dext_orig_clone(gen);
+
+  /* the buffer is not shared: otherwise both objects return the same values */
+  cext = CEXT(clone);
+  cext->buffer = _unur_xmalloc(cext->size * sizeof(double));
+  cext->pos = 0;
+  cext->n = 0;
+
+  /* R function */
+  if (cext->fun) {
+    cext->data = cext;
+    R_PreserveObject(cext->fun);
+  }
+
+  return clone;
+} /* end of _cext_clone() */
+
+/*---------------------------------------------------------------------------*/
@@ -0,0 +1,326 @@
+/*****************************************************************************
+ *                                                                           *
+ *          UNU.RAN -- Universal Non-Uniform Random number generator         *
+ *                                                                           *
+ *****************************************************************************
+ *                                                                           *
+ *   FILE: Runuran_dari.c                                                    *
+ *                                                                           *
+ *   PURPOSE:                                                                *
+ *         Eager table for method DARI                                       *
+ *                                                                           *
+ *****************************************************************************
+ *                                                                           *
+ *   Copyright (c) 2026 Wolfgang Hoermann and Josef Leydold                  *
+ *   Dept. for Statistics, University of Economics, Vienna, Austria          *
+ *                                                                           *
+ *   This program is free software; you can redistribute it and/or modify    *
+ *   it under the terms of the GNU General Public License as published by    *
+ *   the Free Software Foundation; either version 2 of the License, or       *
+ *   (at your option) any later version.                                     *
+ *                                                                           *
+ *   This program is distributed in the hope that it will be useful,         *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of          *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the           *
+ *   GNU General Public License for more details.                            *
+ *                                                                           *
+ *   You should have received a copy of the GNU General Public License       *
+ *   along with this program; if not, write to the                           *
+ *   Free Software Foundation, Inc.,                                         *
+ *   59 Temple Place, Suite 330, Boston, MA 02111-1307, USA                  *
+ *                                                                           *
+ *****************************************************************************
+ *                                                                           *
+ *   Method DARI stores the values of the hat minus the PMF for the points   *
+ *   in a window of 'size' points around the mode (array 'hp'). These        *
+ *   values are computed when a point is visited for the first time during   *
+ *   sampling (flags in array 'hb'). Thus the first draws are slow and the   *
+ *   sampling routine writes into the generator object.                      *
+ *                                                                           *
+ *   Here we compute the whole table at once. The table is then only read    *
+ *   by our sampling routine which replaces that of UNU.RAN. It has the      *
+ *   same structure as _unur_dari_sample() but never changes the generator   *
+ *   object. Points outside the window (or outside the domain) are handled   *
+ *   by evaluating the PMF as in the original routine.                       *
+ *   The core routine takes the URNG as argument. Thus the generator         *
+ *   object can be shared by several threads, each with its own URNG,        *
+ *   provided that the PMF can be called concurrently.                       *
+ *                                                                           *
+ *   unur_reinit() recomputes the hat and restores the sampling routine of   *
+ *   UNU.RAN. Thus we also replace the reinit routine such that the table    *
+ *   is recomputed afterwards. The replaced reinit routine marks generator   *
+ *   objects with eager table (it is copied by unur_gen_clone()).            *
+ *                                                                           *
+ *   The values in the table are (copied from methods/dari.c):               *
+ *     center part (s[0] <= k <= s[1]):   0.5 - PMF(k)/pm                    *
+ *     tail part i:                       sign[i]*F(H(k+sign[i]/2))/ys[i]    *
+ *                                          - PMF(k)                         *
+ *   A point in the center part that is drawn in the tail part (this can     *
+ *   happen due to rounding) is not looked up in the table.                  *
+ *                                                                           *
+ *****************************************************************************/
+
+/*---------------------------------------------------------------------------*/
+
+#include "Runuran.h"
+
+/* internal header files for UNU.RAN */
+#include <unur_source.h>
+#include <distr/distr_source.h>
+#include <methods/dari_struct.h>
+
+/*---------------------------------------------------------------------------*/
+
+/* variant flag (copied from methods/dari.c) */
+#define DARI_VARFLAG_VERIFY   0x01u
+
+/*---------------------------------------------------------------------------*/
+
+static int _dari_sample (struct unur_gen *gen);
+/*---------------------------------------------------------------------------*/
+/* Sample from generator (replaces sampling routine of UNU.RAN).             */
+/*---------------------------------------------------------------------------*/
+
+static int _dari_reinit (struct unur_gen *gen);
+/*---------------------------------------------------------------------------*/
+/* Reinitialize generator and recompute table (replaces reinit of UNU.RAN).  */
+/*---------------------------------------------------------------------------*/
+
+/* original reinit routine of method DARI */
+static int (*_dari_orig_reinit)(struct unur_gen *gen) = NULL;
+
+/*---------------------------------------------------------------------------*/
+
+#define GEN       ((struct unur_dari_gen*)gen->datap)
+#define DISTR     gen->distr->data.discr
+#define PMF(x)    _unur_discr_PMF((x),(gen->distr))
+
+/* transformation and its inverse (copied from methods/dari.c) */
+#define F(x)      (-1./(x))
+#define FM(x)     (-1./(x))
+#define N0        (GEN->n[0])
+
+/*****************************************************************************/
+
+SEXP
+Runuran_dari_eager (SEXP sexp_unur)
+     /*----------------------------------------------------------------------*/
+     /* Compute table for method DARI at once.                               */
+     /*                                                                      */
+     /* Parameters:                                                          */
+     /*   unur ... 'Runuran' object (S4 class)                               */ 
+     /*                                                                      */
+     /* Return:                                                              */
+     /*   R NULL object                                                      */
+     /*----------------------------------------------------------------------*/
+{
+  SEXP sexp_gen;
+  struct unur_gen *gen = NULL;
+  const char *class;
+
+  /* first argument must be S4 class "unuran" */
+  if (!Rf_isS4(sexp_unur))
+    Rf_error("[UNU.RAN - error] argument invalid: 'unr' must be UNU.RAN object");
+  class = Rf_translateChar(STRING_ELT( Rf_getAttrib(sexp_unur, R_ClassSymbol), 0));
+  if (strcmp(class,"unuran")) {
+    Rf_error("[UNU.RAN - error] argument invalid: 'unr' must be UNU.RAN object");
+  }
+
+  /* Extract pointer to UNU.RAN generator */
+  sexp_gen = R_do_slot(sexp_unur, Rf_install("unur"));
+  if (! Rf_isNull(sexp_gen)) {
+    CHECK_UNUR_PTR(sexp_gen);
+    gen = R_ExternalPtrAddr(sexp_gen);
+  }
+  if (gen == NULL || unur_get_method(gen) != UNUR_METH_DARI)
+    Rf_error("[UNU.RAN - error] invalid UNU.RAN object: method DARI required");
+
+  /* compute table */
+  if (_Runuran_dari_make_table(gen) != UNUR_SUCCESS)
+    Rf_error("[UNU.RAN - error] cannot compute table for method DARI");
+
+  return R_NilValue;
+} /* end of Runuran_dari_eager() */
+
+/*---------------------------------------------------------------------------*/
+
+int
+_Runuran_dari_make_table (struct unur_gen *gen)
+     /*----------------------------------------------------------------------*/
+     /* Compute all entries of table 'hp' and replace sampling routine.      */
+     /*                                                                      */
+     /* Parameters:                                                          */
+     /*   gen ... pointer to generator object with method DARI               */
+     /*                                                                      */
+     /* Return:                                                              */
+     /*   UNUR_SUCCESS ... on success                                        */
+     /*   error code   ... on error                                          */
+     /*----------------------------------------------------------------------*/
+{
+  static const int sign[2] = {-1,1};
+  int k, k0, k1, i;
+
+  _unur_check_NULL("DARI", gen, UNUR_ERR_NULL);
+  if (gen->method != UNUR_METH_DARI) {
+    _unur_error(gen->genid,UNUR_ERR_GEN_INVALID,"");
+    return UNUR_ERR_GEN_INVALID;
+  }
+
+  /* points in window that belong to domain */
+  k0 = _unur_max(GEN->n[0], DISTR.domain[0]);
+  k1 = _unur_min(GEN->n[1], DISTR.domain[1]);
+
+  for (k=k0; GEN->size > 0 && k<=k1; k++) {
+    if (GEN->s[0] <= k && k <= GEN->s[1]) {
+      /* center part */
+      GEN->hp[k-N0] = 0.5 - PMF(k)/GEN->pm;
+    }
+    else {
+      /* tail part */
+      i = (k < GEN->s[0]) ? 0 : 1;
+      GEN->hp[k-N0] = ( sign[i] * F(GEN->y[i]+GEN->ys[i]*(k+sign[i]*0.5-GEN->x[i])) / GEN->ys[i]
+			- PMF(k) );
+    }
+    if (!_unur_isfinite(GEN->hp[k-N0])) {
+      _unur_error(gen->genid,UNUR_ERR_GEN_DATA,"PMF not valid");
+      return UNUR_ERR_GEN_DATA;
+    }
+    GEN->hb[k-N0] = 1;
+  }
+
+  /* use our sampling routine (unless hat is verified) */
+  if (! (gen->variant & DARI_VARFLAG_VERIFY))
+    gen->sample.discr = _dari_sample;
+
+  /* recompute table after reinit */
+  if (gen->reinit != _dari_reinit) {
+    _dari_orig_reinit = gen->reinit;
+    gen->reinit = _dari_reinit;
+  }
+
+  return UNUR_SUCCESS;
+} /* end of _Runuran_dari_make_table() */
+
+/*---------------------------------------------------------------------------*/
+
+int
+_Runuran_dari_is_eager (const struct unur_gen *gen)
+     /*----------------------------------------------------------------------*/
+     /* Check whether generator object uses method DARI with eager table.    */
+     /*                                                                      */
+     /* Parameters:                                                          */
+     /*   gen ... pointer to UNU.RAN generator object                        */
+     /*                                                                      */
+     /* Return:                                                              */
+     /*   TRUE if table is computed eagerly, FALSE otherwise                 */
+     /*----------------------------------------------------------------------*/
+{
+  return (gen->method == UNUR_METH_DARI && gen->reinit == _dari_reinit);
+} /* end of _Runuran_dari_is_eager() */
+
+/*---------------------------------------------------------------------------*/
+
+int
+_dari_reinit (struct unur_gen *gen)
+     /*----------------------------------------------------------------------*/
+     /* Reinitialize generator object with method DARI and recompute table.  */
+     /*                                                                      */
+     /* Parameters:                                                          */
+     /*   gen ... pointer to generator object                                */
+     /*                                                                      */
+     /* Return:                                                              */
+     /*   UNUR_SUCCESS ... on success                                        */
+     /*   error code   ... on error                                          */
+     /*----------------------------------------------------------------------*/
+{
+  int rcode;
+
+  if ((rcode = _dari_orig_reinit(gen)) != UNUR_SUCCESS)
+    return rcode;
+
+  return _Runuran_dari_make_table(gen);
+} /* end of _dari_reinit() */
+
+/*---------------------------------------------------------------------------*/
+
+int
+_Runuran_dari_sample_urng (const struct unur_gen *gen, struct unur_urng *urng)
+     /*----------------------------------------------------------------------*/
+     /* Sample from generator object with method DARI using given URNG.      */
+     /* The generator object is not changed.                                 */
+     /* (adapted from _unur_dari_sample() in methods/dari.c)                 */
+     /*                                                                      */
+     /* Parameters:                                                          */
+     /*   gen  ... pointer to generator object with method DARI              */
+     /*   urng ... pointer to uniform random number generator                */
+     /*                                                                      */
+     /* Return:                                                              */
+     /*   integer (sample from random variate)                               */
+     /*----------------------------------------------------------------------*/
+{
+  static const int sign[2] = {-1,1};
+  double U, h;
+  double X = 0.;
+  int k,i;
+
+  while (1) {
+    U = _unur_call_urng(urng) * GEN->vt;
+
+    if (U<=GEN->vc) {
+      /* center part */
+      X = U * (GEN->ac[1]-GEN->ac[0]) / GEN->vc + GEN->ac[0]; 
+      k = (int)(X+0.5);
+      i = (k<GEN->m) ? 0 : 1;
+      if (GEN->squeeze && sign[i]*(GEN->ac[i]-GEN->s[i]) > sign[i]*(X-k))
+	return k;
+      if (sign[i]*k <= sign[i]*GEN->n[i] && GEN->hb[k-N0])
+	h = GEN->hp[k-N0];
+      else
+	h = 0.5-PMF(k)/GEN->pm;
+      if (h <= sign[i]*(k-X))
+	return k;
+    }
+
+    else {
+      /* tail parts */
+      if (U<= GEN->vcr) {
+	i = 1;
+	U -= GEN->vc;
+      } 
+      else {
+	i = 0;
+	U -= GEN->vcr;
+      }
+      U = GEN->Hat[i] + sign[i]*U; 
+      X = GEN->x[i] + (FM(U*GEN->ys[i])-GEN->y[i]) / GEN->ys[i];
+      k = (int)(X+0.5);
+      if (GEN->squeeze && (sign[i]*k <= sign[i]*GEN->x[i]+1) && (GEN->xsq[i] <= sign[i]*(X-k))) 
+	return k;
+      if (sign[i]*k <= sign[i]*GEN->n[i] && sign[i]*k > sign[i]*GEN->s[i] && GEN->hb[k-N0])
+	h = GEN->hp[k-N0];
+      else
+	h = sign[i] * F(GEN->y[i]+GEN->ys[i]*(k+sign[i]*0.5-GEN->x[i])) / GEN->ys[i]-PMF(k);
+      if (sign[i]*U >= h)
+	return k;
+    }
+  }
+} /* end of _Runuran_dari_sample_urng() */
+
+/*---------------------------------------------------------------------------*/
+
+int
+_dari_sample (struct unur_gen *gen)
+     /*----------------------------------------------------------------------*/
+     /* Sample from generator object with method DARI (table computed).      */
+     /*                                                                      */
+     /* Parameters:                                                          */
+     /*   gen ... pointer to generator object                                */
+     /*                                                                      */
+     /* Return:                                                              */
+     /*   integer (sample from random variate)                               */
+     /*----------------------------------------------------------------------*/
+{
+  return _Runuran_dari_sample_urng(gen, gen->urng);
+} /* end of _dari_sample() */
+
+/*---------------------------------------------------------------------------*/
@@ -0,0 +1,899 @@
+/*****************************************************************************
+ *                                                                           *
+ *          UNU.RAN -- Universal Non-Uniform Random number generator         *
+ *                                                                           *
+ *****************************************************************************
+ *                                                                           *
+ *   FILE: Runuran_dinv.c                                                    *
+ *                                                                           *
+ *   PURPOSE:                                                                *
+ *         Inversion for discrete distributions with large support           *
+ *                                                                           *
+ *****************************************************************************
+ *                                                                           *
+ *   Copyright (c) 2026 Wolfgang Hoermann and Josef Leydold                  *
+ *   Dept. for Statistics, University of Economics, Vienna, Austria          *
+ *                                                                           *
+ *   This program is free software; you can redistribute it and/or modify    *
+ *   it under the terms of the GNU General Public License as published by    *
+ *   the Free Software Foundation; either version 2 of the License, or       *
+ *   (at your option) any later version.                                     *
+ *                                                                           *
+ *   This program is distributed in the hope that it will be useful,         *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of          *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the           *
+ *   GNU General Public License for more details.                            *
+ *                                                                           *
+ *   You should have received a copy of the GNU General Public License       *
+ *   along with this program; if not, write to the                           *
+ *   Free Software Foundation, Inc.,                                         *
+ *   59 Temple Place, Suite 330, Boston, MA 02111-1307, USA                  *
+ *                                                                           *
+ *****************************************************************************
+ *                                                                           *
+ *   Inversion for discrete distributions requires the cumulative            *
+ *   probabilities. Method DGT stores all of them in a table. This is not    *
+ *   possible for distributions with huge support (e.g., Zipf distributions  *
+ *   with 10^9 keys) and methods for the PMF (DARI, DSROU) need several      *
+ *   evaluations of the PMF for every random point.                          *
+ *                                                                           *
+ *   Thus we use a compressed table of cumulative probabilities:             *
+ *                                                                           *
+ *    - Head: the first 'head' points of the support with their exact        *
+ *      cumulative probabilities and a guide table (as in method DGT).       *
+ *                                                                           *
+ *    - Tail: the remaining support is split into blocks of integers.        *
+ *      In each block the PMF is approximated by an analytic model           *
+ *      f(x) which is either a power function, f(x) = f_a (x'/a')^beta       *
+ *      (x' = x-lb+1), or an exponential function,                           *
+ *      f(x) = f_a exp(beta (x-a)). It interpolates the PMF at both ends     *
+ *      of the block and the model that fits better at the midpoint is       *
+ *      used. Blocks are split until the error in the midpoint (multiplied   *
+ *      by the probability of the block) is small enough. Blocks with only   *
+ *      one integer are stored exactly.                                      *
+ *      Partial sums of the model in a block are computed by the midpoint    *
+ *      rule with Euler-Maclaurin correction,                                *
+ *        sum_{i=a}^{k} f(i) = int_{a-1/2}^{k+1/2} f(x) dx                   *
+ *                             - (f'(k+1/2) - f'(a-1/2)) / 24 ,              *
+ *      which can be computed and inverted in closed form.                   *
+ *      For sampling the equation for the integral is solved and the         *
+ *      result is rounded to an integer. This integer is then corrected      *
+ *      by the partial sums above (usually not more than one step).          *
+ *                                                                           *
+ *   The total probability is estimated in a first rough pass over the       *
+ *   tail which determines the tolerance for the second pass. Blocks grow    *
+ *   geometrically (the mode, if known, is a boundary of a block). For an    *
+ *   unbounded support the tail is cut off when the tail of the model of     *
+ *   the last block is negligible.                                           *
+ *                                                                           *
+ *   The memory is bounded by the size of the head table and the number of   *
+ *   blocks, and sampling requires no evaluation of the PMF.                 *
+ *                                                                           *
+ *   The generator object is a wrapper for an external generator (method     *
+ *   DEXT). The routines for destroying and cloning the wrapper are          *
+ *   replaced such that the tables are freed and copied as well.             *
+ *                                                                           *
+ *****************************************************************************/
+
+/*---------------------------------------------------------------------------*/
+
+#include "Runuran.h"
+
+/* internal header files for UNU.RAN */
+#include <unur_source.h>
+#include <distr/distr_source.h>
+#include <methods/dext_struct.h>
+
+/*---------------------------------------------------------------------------*/
+
+/* maximal and minimal u-resolution */
+#define DINV_MAX_URESOLUTION  (1.e-5)
+#define DINV_MIN_URESOLUTION  (1.e-14)
+
+/* relative tolerance for first (rough) pass */
+#define DINV_TOL_PASS1        (1.e-4)
+
+/* fraction of u-resolution used for cutting off tail */
+#define DINV_TAILCUTOFF       (0.1)
+
+/* maximal number of blocks */
+#define DINV_MAX_BLOCKS       (100000)
+
+/* types of models for PMF in block */
+#define DINV_EXACT  (0)    /* single point */
+#define DINV_POWER  (1)    /* power function */
+#define DINV_EXPON  (2)    /* exponential function */
+
+/*---------------------------------------------------------------------------*/
+
+struct Runuran_dinv {
+  double u_resolution;    /* maximal u-error                                 */
+  int    head;            /* maximal number of points in head                */
+  int    lb;              /* left boundary of domain                         */
+  int    kmax;            /* largest point with positive probability         */
+  int    n_head;          /* number of points in head                        */
+  double *cdf_head;       /* cumulated probabilities in head [n_head]        */
+  int    *guide_head;     /* guide table for head [n_head]                   */
+  int    n_blk;           /* number of blocks in tail                        */
+  int    size_blk;        /* size of allocated arrays for blocks             */
+  double *ka;             /* left boundaries of blocks [n_blk+1]             */
+  int    *type;           /* type of model for PMF in block [n_blk]          */
+  double *fa;             /* model: PMF at left boundary [n_blk]             */
+  double *beta;           /* model: exponent or rate [n_blk]                 */
+  double *cdf_blk;        /* cumulated probabilities at end of block [n_blk] */
+  int    *guide_blk;      /* guide table for blocks [n_blk]                  */
+  double total;           /* sum of all probabilities                        */
+};
+
+/*---------------------------------------------------------------------------*/
+
+static int _dinv_sample (struct unur_gen *gen);
+/*---------------------------------------------------------------------------*/
+/* Sample from generator (sampling routine for method DEXT).                 */
+/*---------------------------------------------------------------------------*/
+
+static int _dinv_setup (struct unur_gen *gen);
+/*---------------------------------------------------------------------------*/
+/* Compute table for head and blocks for tail.                               */
+/*---------------------------------------------------------------------------*/
+
+static int _dinv_tail (struct unur_gen *gen, double tol_rel, double tol_abs,
+		       double tol_tail);
+/*---------------------------------------------------------------------------*/
+/* Split tail into blocks.                                                   */
+/*---------------------------------------------------------------------------*/
+
+static int _dinv_block (struct unur_gen *gen, int a, int e, double pa, double pe,
+			double tol_rel, double tol_abs);
+/*---------------------------------------------------------------------------*/
+/* Compute model for PMF in block [a,e] (split block if necessary).          */
+/*---------------------------------------------------------------------------*/
+
+static int _dinv_append (struct Runuran_dinv *dinv, int a, int e,
+			 int type, double fa, double beta);
+/*---------------------------------------------------------------------------*/
+/* Append block [a,e] to list of blocks.                                     */
+/*---------------------------------------------------------------------------*/
+
+static double _dinv_blk_f (const struct Runuran_dinv *dinv, int j, double x);
+static double _dinv_blk_int (const struct Runuran_dinv *dinv, int j, double x);
+static double _dinv_blk_psum (const struct Runuran_dinv *dinv, int j, int k);
+static double _dinv_blk_invint (const struct Runuran_dinv *dinv, int j, double t);
+static double _dinv_blk_tail (const struct Runuran_dinv *dinv, int j);
+/*---------------------------------------------------------------------------*/
+/* Model for PMF in block j: PMF, integral from a-1/2 to x, partial sum      */
+/* from a to k, inverse of integral, integral from end of block to infinity. */
+/*---------------------------------------------------------------------------*/
+
+static double _dinv_eval_pmf (struct unur_gen *gen, int k);
+/*---------------------------------------------------------------------------*/
+/* Evaluate PMF.                                                             */
+/*---------------------------------------------------------------------------*/
+
+static void _dinv_free (struct unur_gen *gen);
+/*---------------------------------------------------------------------------*/
+/* Destroy generator object (including tables).                              */
+/*---------------------------------------------------------------------------*/
+
+static struct unur_gen *_dinv_clone (const struct unur_gen *gen);
+/*---------------------------------------------------------------------------*/
+/* Copy generator object (including tables).                                 */
+/*---------------------------------------------------------------------------*/
+
+/* original routines of method DEXT */
+static void (*_dext_free)(struct unur_gen *gen) = NULL;
+static struct unur_gen *(*_dext_clone)(const struct unur_gen *gen) = NULL;
+
+/*---------------------------------------------------------------------------*/
+
+#define GEN       ((struct unur_dext_gen*)gen->datap)
+#define DINV      ((struct Runuran_dinv*)GEN->param)
+#define DISTR     gen->distr->data.discr
+#define PMF(k)    (_dinv_eval_pmf((gen),(k)))
+
+/* shifted variable for power function */
+#define XS(x)     ((x) - dinv->lb + 1.)
+
+/*****************************************************************************/
+
+SEXP
+Runuran_dinv (SEXP sexp_obj, SEXP sexp_distr, SEXP sexp_ures, SEXP sexp_head)
+     /*----------------------------------------------------------------------*/
+     /* Create UNU.RAN generator object for inversion with compressed table  */
+     /* of cumulative probabilities.                                         */
+     /*                                                                      */
+     /* Parameters:                                                          */
+     /*   obj    ... S4 class that contains 'Runuran' generator object       */
+     /*   distr  ... pointer to UNU.RAN distribution object                  */
+     /*   ures   ... maximal tolerated u-error                               */
+     /*   head   ... maximal number of points in head table                  */
+     /*                                                                      */
+     /* Return:                                                              */
+     /*   pointer to UNU.RAN generator object                                */
+     /*----------------------------------------------------------------------*/
+{
+  struct unur_distr *distr;
+  struct unur_par *par;
+  struct unur_gen *gen;
+  struct Runuran_dinv *dinv;
+  double ures;
+  int head;
+  SEXP sexp_gen;
+  SEXP sexp_is_inversion;
+
+  /* check arguments */
+  CHECK_DISTR_PTR(sexp_distr);
+  distr = R_ExternalPtrAddr(sexp_distr);
+  if (distr == NULL || unur_distr_get_type(distr) != UNUR_DISTR_DISCR)
+    Rf_errorcall(R_NilValue,"[UNU.RAN - error] invalid argument 'distr'");
+  if (distr->data.discr.pmf == NULL)
+    Rf_errorcall(R_NilValue,"[UNU.RAN - error] method DINV requires PMF");
+  if (distr->data.discr.domain[0] <= INT_MIN)
+    Rf_errorcall(R_NilValue,"[UNU.RAN - error] method DINV requires domain bounded from below");
+
+  ures = Rf_asReal(sexp_ures);
+  if (! (ures <= DINV_MAX_URESOLUTION * 1.001)) {
+    Rf_warningcall(R_NilValue,"[UNU.RAN - warning] u-resolution too large --> use 1.e-5 instead");
+    ures = DINV_MAX_URESOLUTION;
+  }
+  if (ures < 0.999 * DINV_MIN_URESOLUTION) {
+    Rf_warningcall(R_NilValue,"[UNU.RAN - warning] u-resolution too small --> use 1.e-14 instead");
+    ures = DINV_MIN_URESOLUTION;
+  }
+
+  head = Rf_asInteger(sexp_head);
+  if (head == NA_INTEGER || head < 1)
+    Rf_errorcall(R_NilValue,"[UNU.RAN - error] invalid argument 'head'");
+
+  /* create wrapper (method DEXT) */
+  par = unur_dext_new(distr);
+  unur_dext_set_sample(par, _dinv_sample);
+  gen = unur_init(par);
+  if (gen == NULL)
+    Rf_errorcall(R_NilValue,"[UNU.RAN - error] cannot create UNU.RAN object");
+
+  /* replace routines for destroying and cloning the generator object */
+  _dext_free = gen->destroy;
+  _dext_clone = gen->clone;
+  gen->destroy = _dinv_free;
+  gen->clone = _dinv_clone;
+
+  /* parameters */
+  dinv = unur_dext_get_params(gen, sizeof(struct Runuran_dinv));
+  memset(dinv, 0, sizeof(struct Runuran_dinv));
+  dinv->u_resolution = ures;
+  dinv->head = head;
+
+  /* compute tables */
+  if (_dinv_setup(gen) != UNUR_SUCCESS) {
+    unur_free(gen);
+    Rf_errorcall(R_NilValue,"[UNU.RAN - error] cannot create UNU.RAN object");
+  }
+
+  /* we have an inversion method */
+  PROTECT(sexp_is_inversion = Rf_allocVector(LGLSXP, 1));
+  LOGICAL(sexp_is_inversion)[0] = TRUE;
+  R_do_slot_assign(sexp_obj, Rf_install("inversion"), sexp_is_inversion);
+
+  /* make R external pointer and store pointer to structure */
+  PROTECT(sexp_gen = R_MakeExternalPtr(gen, _Runuran_tag(), sexp_obj));
+  
+  /* register destructor as C finalizer */
+  R_RegisterCFinalizer(sexp_gen, _Runuran_free);
+
+  /* return pointer to R */
+  UNPROTECT(2);
+  return (sexp_gen);
+
+} /* end of Runuran_dinv() */
+
+/*---------------------------------------------------------------------------*/
+
+int
+_Runuran_is_dinv (const struct unur_gen *gen)
+     /*----------------------------------------------------------------------*/
+     /* Check whether generator object implements method DINV.               */
+     /*                                                                      */
+     /* Parameters:                                                          */
+     /*   gen ... pointer to UNU.RAN generator object                        */
+     /*                                                                      */
+     /* Return:                                                              */
+     /*   TRUE if 'gen' is a DINV generator, FALSE otherwise                 */
+     /*----------------------------------------------------------------------*/
+{
+  return (gen->method == UNUR_METH_DEXT && gen->sample.discr == _dinv_sample);
+} /* end of _Runuran_is_dinv() */
+
+/*---------------------------------------------------------------------------*/
+
+int
+_Runuran_dinv_eval_invcdf (const struct unur_gen *gen, double u)
+     /*----------------------------------------------------------------------*/
+     /* Evaluate approximate inverse CDF.                                    */
+     /*                                                                      */
+     /* Parameters:                                                          */
+     /*   gen ... pointer to DINV generator object                           */
+     /*   u   ... argument for inverse CDF (0<=u<=1)                         */
+     /*                                                                      */
+     /* Return:                                                              */
+     /*   integer (approximate inverse CDF)                                  */
+     /*----------------------------------------------------------------------*/
+{
+  const struct Runuran_dinv *dinv = DINV;
+  double t, h, x;
+  int j, k, a, e;
+
+  /* boundary of domain */
+  if ( ! (u>0. && u<1.)) {
+    if ( ! (u>=0. && u<=1.)) {
+      _unur_warning(gen->genid,UNUR_ERR_DOMAIN,"U not in [0,1]");
+    }
+    return (u>=1.) ? dinv->kmax : dinv->lb;
+  }
+
+  t = u * dinv->total;
+  h = dinv->cdf_head[dinv->n_head-1];
+
+  if (t <= h) {
+    /* head: use guide table (as in method DGT) */
+    j = dinv->guide_head[_unur_min((int) (t / h * dinv->n_head), dinv->n_head-1)];
+    while (j < dinv->n_head-1 && dinv->cdf_head[j] < t) j++;
+    return dinv->lb + j;
+  }
+
+  /* tail: find block using guide table */
+  x = (t - h) / (dinv->total - h) * dinv->n_blk;
+  j = dinv->guide_blk[_unur_min((int) x, dinv->n_blk-1)];
+  while (j < dinv->n_blk-1 && dinv->cdf_blk[j] < t) j++;
+
+  /* position in block */
+  a = (int) dinv->ka[j];
+  e = (int) (dinv->ka[j+1] - 1.);
+  t -= (j > 0) ? dinv->cdf_blk[j-1] : h;
+  if (dinv->type[j] == DINV_EXACT)
+    return a;
+
+  /* solve equation for integral and round */
+  x = _dinv_blk_invint(dinv, j, t);
+  if (x - 0.5 >= e)
+    k = e;
+  else if (x - 0.5 <= a)
+    k = a;
+  else
+    k = (int) ceil(x - 0.5);
+
+  /* correction using partial sums */
+  while (k > a && _dinv_blk_psum(dinv, j, k-1) >= t) --k;
+  while (k < e && _dinv_blk_psum(dinv, j, k) < t) ++k;
+
+  return k;
+} /* end of _Runuran_dinv_eval_invcdf() */
+
+/*---------------------------------------------------------------------------*/
+
+int
+_dinv_sample (struct unur_gen *gen)
+     /*----------------------------------------------------------------------*/
+     /* Sample from DINV generator.                                          */
+     /*                                                                      */
+     /* Parameters:                                                          */
+     /*   gen ... pointer to generator object                                */
+     /*                                                                      */
+     /* Return:                                                              */
+     /*   integer (sample from random variate)                               */
+     /*----------------------------------------------------------------------*/
+{
+  return _Runuran_dinv_eval_invcdf(gen, _unur_call_urng(gen->urng));
+} /* end of _dinv_sample() */
+
+/*---------------------------------------------------------------------------*/
+
+int
+_dinv_setup (struct unur_gen *gen)
+     /*----------------------------------------------------------------------*/
+     /* Compute table for head and blocks for tail.                          */
+     /*                                                                      */
+     /* Parameters:                                                          */
+     /*   gen ... pointer to generator object                                */
+     /*                                                                      */
+     /* Return:                                                              */
+     /*   UNUR_SUCCESS ... on success                                        */
+     /*   error code   ... on error                                          */
+     /*----------------------------------------------------------------------*/
+{
+  struct Runuran_dinv *dinv = DINV;
+  double p, h, total_est, tol;
+  int rb, i, j;
+
+  dinv->lb = DISTR.domain[0];
+  rb = DISTR.domain[1];
+
+  /* -- head -- */
+
+  dinv->n_head = (int) _unur_min((double) dinv->head, (double) rb - dinv->lb + 1.);
+  dinv->cdf_head = _unur_xmalloc(dinv->n_head * sizeof(double));
+  for (i=0, h=0.; i<dinv->n_head; i++) {
+    p = PMF(dinv->lb + i);
+    if (! (p >= 0. && p < UNUR_INFINITY)) {
+      _unur_error(gen->genid,UNUR_ERR_GEN_DATA,"PMF not valid");
+      return UNUR_ERR_GEN_DATA;
+    }
+    h += p;
+    dinv->cdf_head[i] = h;
+  }
+  dinv->kmax = dinv->lb + dinv->n_head - 1;
+
+  /* -- tail -- */
+
+  if (dinv->kmax < rb) {
+    /* first pass: estimate total probability */
+    if (_dinv_tail(gen, DINV_TOL_PASS1, 0., -1.) != UNUR_SUCCESS)
+      return UNUR_FAILURE;
+    for (j=0, total_est=h; j<dinv->n_blk; j++)
+      total_est += _dinv_blk_psum(dinv, j, (int) (dinv->ka[j+1]-1.));
+
+    /* second pass: blocks for requested u-resolution */
+    dinv->n_blk = 0;
+    tol = dinv->u_resolution * total_est;
+    if (_dinv_tail(gen, 0.5 * dinv->u_resolution, 1.e-3 * tol, DINV_TAILCUTOFF * tol)
+	!= UNUR_SUCCESS)
+      return UNUR_FAILURE;
+  }
+
+  /* cumulated probabilities of blocks */
+  if (dinv->n_blk > 0) {
+    dinv->cdf_blk = _unur_xmalloc(dinv->n_blk * sizeof(double));
+    for (j=0, p=h; j<dinv->n_blk; j++) {
+      p += _dinv_blk_psum(dinv, j, (int) (dinv->ka[j+1]-1.));
+      dinv->cdf_blk[j] = p;
+      if (dinv->cdf_blk[j] > ((j>0) ? dinv->cdf_blk[j-1] : h))
+	dinv->kmax = (int) (dinv->ka[j+1]-1.);
+    }
+    dinv->total = p;
+  }
+  else
+    dinv->total = h;
+
+  if (_unur_iszero(dinv->total)) {
+    _unur_error(gen->genid,UNUR_ERR_GEN_DATA,"PMF vanishes at all checked points (mode required)");
+    return UNUR_ERR_GEN_DATA;
+  }
+  if (! (dinv->total > 0. && dinv->total < UNUR_INFINITY)) {
+    _unur_error(gen->genid,UNUR_ERR_GEN_DATA,"sum over PMF not valid");
+    return UNUR_ERR_GEN_DATA;
+  }
+
+  /* guide table for head */
+  dinv->guide_head = _unur_xmalloc(dinv->n_head * sizeof(int));
+  for (i=0, j=0; i<dinv->n_head; i++) {
+    while (j < dinv->n_head-1 && dinv->cdf_head[j] < h * i / dinv->n_head) j++;
+    dinv->guide_head[i] = j;
+  }
+
+  /* guide table for blocks */
+  if (dinv->n_blk > 0) {
+    dinv->guide_blk = _unur_xmalloc(dinv->n_blk * sizeof(int));
+    for (i=0, j=0; i<dinv->n_blk; i++) {
+      while (j < dinv->n_blk-1 &&
+	     dinv->cdf_blk[j] < h + (dinv->total - h) * i / dinv->n_blk) j++;
+      dinv->guide_blk[i] = j;
+    }
+  }
+
+  return UNUR_SUCCESS;
+} /* end of _dinv_setup() */
+
+/*---------------------------------------------------------------------------*/
+
+int
+_dinv_tail (struct unur_gen *gen, double tol_rel, double tol_abs, double tol_tail)
+     /*----------------------------------------------------------------------*/
+     /* Split tail into blocks. The left boundary of the next block doubles  */
+     /* its distance from the left boundary of the domain.                   */
+     /*                                                                      */
+     /* Parameters:                                                          */
+     /*   gen      ... pointer to generator object                           */
+     /*   tol_rel  ... tolerated error relative to probability of block      */
+     /*   tol_abs  ... tolerated absolute error                              */
+     /*   tol_tail ... tail is cut off when probability is below this value  */
+     /*                (if negative: relative to the sum so far with         */
+     /*                 tolerance DINV_TOL_PASS1)                            */
+     /*                                                                      */
+     /* Return:                                                              */
+     /*   UNUR_SUCCESS ... on success                                        */
+     /*   error code   ... on error                                          */
+     /*----------------------------------------------------------------------*/
+{
+  struct Runuran_dinv *dinv = DINV;
+  UNUR_ERROR_HANDLER *old_handler;
+  double sum, tt, next;
+  int a, e, mode, rb, j;
+
+  rb = DISTR.domain[1];
+
+  /* mode is used as boundary of a block (if known) */
+  /* (the search for the mode may fail; so we suppress error messages) */
+  mode = INT_MIN;
+  if (! (gen->distr->set & UNUR_DISTR_SET_MODE) && DISTR.upd_mode != NULL) {
+    old_handler = unur_set_error_handler_off();
+    unur_distr_discr_upd_mode(gen->distr);
+    unur_set_error_handler(old_handler);
+  }
+  if (gen->distr->set & UNUR_DISTR_SET_MODE)
+    mode = DISTR.mode;
+
+  sum = dinv->cdf_head[dinv->n_head-1];
+  a = dinv->kmax + 1;
+
+  while (a <= rb) {
+    /* right boundary of block (inclusive) */
+    /* (computed in double precision as rb may be INT_MAX) */
+    next = _unur_min(2. * XS(a) + dinv->lb - 2., (double) rb);
+    e = (int) next;
+    if (mode > a && mode <= e) e = mode - 1;
+
+    /* compute model for PMF */
+    j = dinv->n_blk;
+    if (_dinv_block(gen, a, e, PMF(a), PMF(e), tol_rel, tol_abs) != UNUR_SUCCESS)
+      return UNUR_FAILURE;
+    for (; j<dinv->n_blk; j++)
+      sum += _dinv_blk_psum(dinv, j, (int) (dinv->ka[j+1]-1.));
+
+    /* cut off tail */
+    if (e >= rb) break;
+    if (e >= mode) {
+      tt = _dinv_blk_tail(dinv, dinv->n_blk-1);
+      if (tt <= ((tol_tail < 0.) ? DINV_TOL_PASS1 * sum : tol_tail))
+	break;
+    }
+    a = e + 1;
+  }
+
+  return UNUR_SUCCESS;
+} /* end of _dinv_tail() */
+
+/*---------------------------------------------------------------------------*/
+
+int
+_dinv_block (struct unur_gen *gen, int a, int e, double pa, double pe,
+	     double tol_rel, double tol_abs)
+     /*----------------------------------------------------------------------*/
+     /* Compute model for PMF in block [a,e]. The block is split when the    */
+     /* error of the model in the midpoint is too large.                     */
+     /*                                                                      */
+     /* Parameters:                                                          */
+     /*   gen     ... pointer to generator object                            */
+     /*   a, e    ... block [a,e]                                            */
+     /*   pa, pe  ... PMF at a and e                                         */
+     /*   tol_rel ... tolerated error relative to probability of block       */
+     /*   tol_abs ... tolerated absolute error                               */
+     /*                                                                      */
+     /* Return:                                                              */
+     /*   UNUR_SUCCESS ... on success                                        */
+     /*   error code   ... on error                                          */
+     /*----------------------------------------------------------------------*/
+{
+  struct Runuran_dinv *dinv = DINV;
+  double pm, c, beta, pred_e, pred_p, pred, S;
+  int m, type;
+
+  if (! (pa >= 0. && pa < UNUR_INFINITY && pe >= 0. && pe < UNUR_INFINITY)) {
+    _unur_error(gen->genid,UNUR_ERR_GEN_DATA,"PMF not valid");
+    return UNUR_ERR_GEN_DATA;
+  }
+
+  /* blocks with one or two points are stored exactly */
+  if (e == a)
+    return _dinv_append(dinv, a, e, DINV_EXACT, pa, 0.);
+  if (e == a+1) {
+    if (_dinv_append(dinv, a, a, DINV_EXACT, pa, 0.) != UNUR_SUCCESS)
+      return UNUR_FAILURE;
+    return _dinv_append(dinv, e, e, DINV_EXACT, pe, 0.);
+  }
+
+  /* midpoint */
+  m = a + (e - a) / 2;
+  pm = PMF(m);
+  if (! (pm >= 0. && pm < UNUR_INFINITY)) {
+    _unur_error(gen->genid,UNUR_ERR_GEN_DATA,"PMF not valid");
+    return UNUR_ERR_GEN_DATA;
+  }
+
+  if (_unur_iszero(pa) && _unur_iszero(pe) && _unur_iszero(pm)) {
+    /* PMF vanishes */
+    return _dinv_append(dinv, a, e, DINV_EXPON, 0., 0.);
+  }
+
+  if (pa > 0. && pe > 0. && pm > 0.) {
+    /* exponential function */
+    c = log(pe/pa) / (e - a);
+    pred_e = pa * exp(c * (m - a));
+    /* power function */
+    beta = log(pe/pa) / log(XS(e)/XS(a));
+    pred_p = pa * pow(XS(m)/XS(a), beta);
+    /* use better fit */
+    if (fabs(pred_e - pm) <= fabs(pred_p - pm)) {
+      type = DINV_EXPON;  pred = pred_e;
+    }
+    else {
+      type = DINV_POWER;  pred = pred_p;  c = beta;
+    }
+    if (_dinv_append(dinv, a, e, type, pa, c) != UNUR_SUCCESS)
+      return UNUR_FAILURE;
+
+    /* check error */
+    S = _dinv_blk_psum(dinv, dinv->n_blk-1, e);
+    if (fabs(pred - pm) / pm * S <= tol_rel * S + tol_abs)
+      return UNUR_SUCCESS;
+
+    /* remove block */
+    --(dinv->n_blk);
+  }
+
+  /* split block */
+  if (_dinv_block(gen, a, m-1, pa, PMF(m-1), tol_rel, tol_abs) != UNUR_SUCCESS)
+    return UNUR_FAILURE;
+  return _dinv_block(gen, m, e, pm, pe, tol_rel, tol_abs);
+
+} /* end of _dinv_block() */
+
+/*---------------------------------------------------------------------------*/
+
+int
+_dinv_append (struct Runuran_dinv *dinv, int a, int e, int type, double fa, double beta)
+     /*----------------------------------------------------------------------*/
+     /* Append block [a,e] to list of blocks.                                */
+     /*                                                                      */
+     /* Parameters:                                                          */
+     /*   dinv ... data for generator                                        */
+     /*   a, e ... block [a,e]                                               */
+     /*   type ... type of model for PMF                                     */
+     /*   fa   ... PMF at a                                                  */
+     /*   beta ... exponent (power function) or rate (exponential function)  */
+     /*                                                                      */
+     /* Return:                                                              */
+     /*   UNUR_SUCCESS ... on success                                        */
+     /*   error code   ... on error                                          */
+     /*----------------------------------------------------------------------*/
+{
+  int j = dinv->n_blk;
+
+  if (j >= DINV_MAX_BLOCKS) {
+    _unur_error("DINV",UNUR_ERR_GEN_CONDITION,"too many blocks; PMF not smooth or u-resolution too small");
+    return UNUR_ERR_GEN_CONDITION;
+  }
+
+  if (j+1 >= dinv->size_blk) {
+    dinv->size_blk = (dinv->size_blk) ? 2 * dinv->size_blk : 64;
+    dinv->ka   = _unur_xrealloc(dinv->ka,   (dinv->size_blk+1) * sizeof(double));
+    dinv->type = _unur_xrealloc(dinv->type, dinv->size_blk * sizeof(int));
+    dinv->fa   = _unur_xrealloc(dinv->fa,   dinv->size_blk * sizeof(double));
+    dinv->beta = _unur_xrealloc(dinv->beta, dinv->size_blk * sizeof(double));
+  }
+
+  dinv->ka[j] = a;
+  dinv->ka[j+1] = e + 1.;   /* may exceed INT_MAX */
+  dinv->type[j] = type;
+  dinv->fa[j] = fa;
+  dinv->beta[j] = beta;
+  ++(dinv->n_blk);
+
+  return UNUR_SUCCESS;
+} /* end of _dinv_append() */
+
+/*---------------------------------------------------------------------------*/
+
+double
+_dinv_blk_f (const struct Runuran_dinv *dinv, int j, double x)
+     /*----------------------------------------------------------------------*/
+     /* Evaluate model for PMF in block j at x.                              */
+     /*----------------------------------------------------------------------*/
+{
+  if (dinv->type[j] == DINV_POWER)
+    return dinv->fa[j] * pow(XS(x) / XS(dinv->ka[j]), dinv->beta[j]);
+  else
+    return dinv->fa[j] * exp(dinv->beta[j] * (x - dinv->ka[j]));
+} /* end of _dinv_blk_f() */
+
+/*---------------------------------------------------------------------------*/
+
+double
+_dinv_blk_int (const struct Runuran_dinv *dinv, int j, double x)
+     /*----------------------------------------------------------------------*/
+     /* Integral of model for PMF in block j over [a-1/2,x].                 */
+     /*----------------------------------------------------------------------*/
+{
+  double a = dinv->ka[j];
+  double beta = dinv->beta[j];
+  double A, r0, s, L;
+
+  if (dinv->type[j] == DINV_POWER) {
+    A = XS(a);
+    r0 = XS(a-0.5) / A;
+    s = beta + 1.;
+    L = log(XS(x) / XS(a-0.5));
+    if (_unur_iszero(s))
+      return dinv->fa[j] * A * L;
+    else
+      return dinv->fa[j] * A * pow(r0,s) * expm1(s*L) / s;
+  }
+  else {
+    if (_unur_iszero(beta))
+      return dinv->fa[j] * (x - a + 0.5);
+    else
+      return dinv->fa[j] * exp(-0.5*beta) * expm1(beta * (x - a + 0.5)) / beta;
+  }
+} /* end of _dinv_blk_int() */
+
+/*---------------------------------------------------------------------------*/
+
+double
+_dinv_blk_psum (const struct Runuran_dinv *dinv, int j, int k)
+     /*----------------------------------------------------------------------*/
+     /* Partial sum of model for PMF in block j over a,...,k                 */
+     /* (midpoint rule with Euler-Maclaurin correction).                     */
+     /*----------------------------------------------------------------------*/
+{
+  double a = dinv->ka[j];
+  double y0 = a - 0.5;
+  double y1 = k + 0.5;
+  double d0, d1;
+
+  if (dinv->type[j] == DINV_EXACT)
+    return dinv->fa[j];
+
+  /* derivatives of model */
+  if (dinv->type[j] == DINV_POWER) {
+    d0 = dinv->beta[j] * _dinv_blk_f(dinv,j,y0) / XS(y0);
+    d1 = dinv->beta[j] * _dinv_blk_f(dinv,j,y1) / XS(y1);
+  }
+  else {
+    d0 = dinv->beta[j] * _dinv_blk_f(dinv,j,y0);
+    d1 = dinv->beta[j] * _dinv_blk_f(dinv,j,y1);
+  }
+
+  return _dinv_blk_int(dinv,j,y1) - (d1 - d0) / 24.;
+} /* end of _dinv_blk_psum() */
+
+/*---------------------------------------------------------------------------*/
+
+double
+_dinv_blk_invint (const struct Runuran_dinv *dinv, int j, double t)
+     /*----------------------------------------------------------------------*/
+     /* Solve equation _dinv_blk_int(dinv,j,x) = t for x.                    */
+     /* Return UNUR_INFINITY if there is no solution.                        */
+     /*----------------------------------------------------------------------*/
+{
+  double a = dinv->ka[j];
+  double beta = dinv->beta[j];
+  double fa = dinv->fa[j];
+  double A, r0, s, z;
+
+  if (_unur_iszero(fa))
+    return UNUR_INFINITY;
+
+  if (dinv->type[j] == DINV_POWER) {
+    A = XS(a);
+    r0 = XS(a-0.5) / A;
+    s = beta + 1.;
+    if (_unur_iszero(s))
+      return (a - 0.5) + XS(a-0.5) * expm1(t / (fa * A));
+    z = t * s / (fa * A * pow(r0,s));
+    if (z <= -1.) return UNUR_INFINITY;
+    return (a - 0.5) + XS(a-0.5) * expm1(log1p(z) / s);
+  }
+  else {
+    if (_unur_iszero(beta))
+      return (a - 0.5) + t / fa;
+    z = t * beta / (fa * exp(-0.5*beta));
+    if (z <= -1.) return UNUR_INFINITY;
+    return (a - 0.5) + log1p(z) / beta;
+  }
+} /* end of _dinv_blk_invint() */
+
+/*---------------------------------------------------------------------------*/
+
+double
+_dinv_blk_tail (const struct Runuran_dinv *dinv, int j)
+     /*----------------------------------------------------------------------*/
+     /* Integral of model for PMF in block j from end of block to infinity.  */
+     /* Return UNUR_INFINITY if the model does not decrease fast enough.     */
+     /*----------------------------------------------------------------------*/
+{
+  double y = dinv->ka[j+1] - 0.5;
+  double beta = dinv->beta[j];
+
+  if (_unur_iszero(dinv->fa[j]))
+    return 0.;
+
+  switch (dinv->type[j]) {
+  case DINV_POWER:
+    return (beta < -1.) ? -_dinv_blk_f(dinv,j,y) * XS(y) / (beta + 1.) : UNUR_INFINITY;
+  case DINV_EXPON:
+    return (beta < 0.) ? -_dinv_blk_f(dinv,j,y) / beta : UNUR_INFINITY;
+  case DINV_EXACT:
+  default:
+    return UNUR_INFINITY;
+  }
+} /* end of _dinv_blk_tail() */
+
+/*---------------------------------------------------------------------------*/
+
+double
+_dinv_eval_pmf (struct unur_gen *gen, int k)
+     /*----------------------------------------------------------------------*/
+     /* Evaluate PMF.                                                        */
+     /*----------------------------------------------------------------------*/
+{
+  return (DISTR.pmf)(k, gen->distr);
+} /* end of _dinv_eval_pmf() */
+
+/*---------------------------------------------------------------------------*/
+
+void
+_dinv_free (struct unur_gen *gen)
+     /*----------------------------------------------------------------------*/
+     /* Destroy generator object (including tables).                         */
+     /*                                                                      */
+     /* Parameters:                                                          */
+     /*   gen ... pointer to generator object                                */
+     /*----------------------------------------------------------------------*/
+{
+  struct Runuran_dinv *dinv = DINV;
+
+  if (dinv) {
+    if (dinv->cdf_head)   free(dinv->cdf_head);
+    if (dinv->guide_head) free(dinv->guide_head);
+    if (dinv->ka)         free(dinv->ka);
+    if (dinv->type)       free(dinv->type);
+    if (dinv->fa)         free(dinv->fa);
+    if (dinv->beta)       free(dinv->beta);
+    if (dinv->cdf_blk)    free(dinv->cdf_blk);
+    if (dinv->guide_blk)  free(dinv->guide_blk);
+  }
+
+  _dext_free(gen);
+} /* end of _dinv_free() */
+
+/*---------------------------------------------------------------------------*/
+
+struct unur_gen *
+_dinv_clone (const struct unur_gen *gen)
+     /*----------------------------------------------------------------------*/
+     /* Copy generator object (including tables).                            */
+     /*                                                                      */
+     /* Parameters:                                                          */
+     /*   gen ... pointer to generator object                                */
+     /*                                                                      */
+     /* Return:                                                              */
+     /*   pointer to clone of generator object                               */
+     /*----------------------------------------------------------------------*/
+{
+#define CLONE  ((struct Runuran_dinv*)((struct unur_dext_gen*)clone->datap)->param)
+#define COPY(member,n,type) \
+  if (dinv->member) { \
+    CLONE->member = _unur_xmalloc((n) * sizeof(type)); \
+    memcpy(CLONE->member, dinv->member, (n) * sizeof(type)); }
+
+  struct Runuran_dinv *dinv = DINV;
+  struct unur_gen *clone;
+  int n = dinv->n_blk;
+
+  clone = _dext_clone(gen);
+
+  COPY(cdf_head, dinv->n_head, double);
+  COPY(guide_head, dinv->n_head, int);
+  COPY(ka, n+1, double);
+  COPY(type, n, int);
+  COPY(fa, n, double);
+  COPY(beta, n, double);
+  COPY(cdf_blk, n, double);
+  COPY(guide_blk, n, int);
+  CLONE->size_blk = n;
+
+  return clone;
+#undef COPY
+#undef CLONE
+} /* end of _dinv_clone() */
+
+/*---------------------------------------------------------------------------*/
@@ -49,11 +49,14 @@ struct Runuran_distr_cont {
   SEXP cdf;                 /* CDF of distribution                           */
   SEXP pdf;                 /* PDF of distribution                           */
   SEXP dpdf;                /* derivative of PDF of distribution             */
+  SEXP hr;                  /* hazard rate of distribution                   */
+  struct Runuran_lobatto *lobatto; /* table for Lobatto integration          */
 };
 
 struct Runuran_distr_cmv {
   SEXP env;                 /* R environment                                 */
   SEXP pdf;                 /* PDF of distribution                           */
+  SEXP pdf_array;           /* PDF for matrix of points (optional)           */
 };
 
 /*---------------------------------------------------------------------------*/
@@ -77,6 +80,13 @@ static double _Runuran_cont_eval_pdf( double x, const struct unur_distr *distr )
 static double _Runuran_cont_eval_dpdf( double x, const struct unur_distr *distr );
 /* Evaluate derivative of PDF function.                                      */
 
+static double _Runuran_cont_eval_hr( double x, const struct unur_distr *distr );
+/* Evaluate hazard rate.                                                     */
+
+static void _Runuran_cont_eval_R_array( SEXP fun, SEXP env, const double *x, int n,
+					double *y, int islog, const char *name );
+/* Evaluate R function for an array of points.                               */
+
 /*---------------------------------------------------------------------------*/
 /*  Continuous Multivariate Distributions (CMV)                              */
 
@@ -254,7 +264,7 @@ SEXP
 Runuran_cont_init (SEXP sexp_obj, SEXP sexp_env, 
 		   SEXP sexp_cdf, SEXP sexp_pdf, SEXP sexp_dpdf, SEXP sexp_islog,
 		   SEXP sexp_mode, SEXP sexp_center, SEXP sexp_domain,
-		   SEXP sexp_area, SEXP sexp_name)
+		   SEXP sexp_area, SEXP sexp_name, SEXP sexp_hr)
      /*----------------------------------------------------------------------*/
      /* Create and initialize UNU.RAN object for continuous distribution.    */
      /*                                                                      */
@@ -270,6 +280,7 @@ Runuran_cont_init (SEXP sexp_obj, SEXP sexp_env,
      /*   domain ... domain of distribution                                  */
      /*   area   ... area below PDF                                          */
      /*   name   ... name of distribution                                    */
+     /*   hr     ... hazard rate of distribution                             */
      /*----------------------------------------------------------------------*/
 {
   SEXP sexp_distr;
@@ -304,6 +315,7 @@ Runuran_cont_init (SEXP sexp_obj, SEXP sexp_env,
   Rdistr->cdf = sexp_cdf;
   Rdistr->pdf = sexp_pdf;
   Rdistr->dpdf = sexp_dpdf;
+  Rdistr->hr = sexp_hr;
 
   /* create distribution object */
   distr = unur_distr_cont_new();
@@ -330,6 +342,8 @@ Runuran_cont_init (SEXP sexp_obj, SEXP sexp_env,
     if (!Rf_isNull(sexp_dpdf))
       error |= unur_distr_cont_set_dpdf(distr, _Runuran_cont_eval_dpdf);
   }
+  if (!Rf_isNull(sexp_hr))
+    error |= unur_distr_cont_set_hr(distr, _Runuran_cont_eval_hr);
 
   /* set mode, center and PDFarea of distribution */
   mode = *REAL(Rf_coerceVector(sexp_mode, REALSXP));
@@ -432,6 +446,220 @@ _Runuran_cont_eval_dpdf( double x, const struct unur_distr *distr )
   return y;
 } /* end of _Runuran_cont_eval_dpdf() */
 
+/*---------------------------------------------------------------------------*/
+
+double
+_Runuran_cont_eval_hr( double x, const struct unur_distr *distr )
+     /*----------------------------------------------------------------------*/
+     /* Evaluate hazard rate.                                                */
+     /*----------------------------------------------------------------------*/
+{
+  const struct Runuran_distr_cont *Rdistr;
+  SEXP R_fcall, arg;
+  double y;
+
+  Rdistr = unur_distr_get_extobj(distr);
+  PROTECT(arg = Rf_allocVector(REALSXP, 1));
+  REAL(arg)[0] = x;
+  PROTECT(R_fcall = Rf_lang2(Rdistr->hr, arg));
+  y = REAL(Rf_eval(R_fcall, Rdistr->env))[0];
+  UNPROTECT(2);
+  return y;
+} /* end of _Runuran_cont_eval_hr() */
+
+/*---------------------------------------------------------------------------*/
+
+void
+_Runuran_cont_eval_hr_array( const double *x, int n, double *hx,
+			     const struct unur_distr *distr )
+     /*----------------------------------------------------------------------*/
+     /* Evaluate hazard rate for an array of points (array HR).              */
+     /*                                                                      */
+     /* Parameters:                                                          */
+     /*   x     ... array of n points                                        */
+     /*   n     ... number of points                                         */
+     /*   hx    ... array for storing values of hazard rate                  */
+     /*   distr ... pointer to distribution object                           */
+     /*                                                                      */
+     /* If the hazard rate is an R function, it is called once with the      */
+     /* vector of all points. Otherwise, it is evaluated point by point.     */
+     /*----------------------------------------------------------------------*/
+{
+  const struct Runuran_distr_cont *Rdistr;
+  SEXP R_fcall, arg, val;
+  int i;
+
+  if (unur_distr_cont_get_hr(distr) != _Runuran_cont_eval_hr) {
+    /* evaluate HR point by point */
+    for (i=0; i<n; i++)
+      hx[i] = unur_distr_cont_eval_hr(x[i], distr);
+    return;
+  }
+
+  Rdistr = unur_distr_get_extobj(distr);
+
+  /* copy points into R vector */
+  PROTECT(arg = Rf_allocVector(REALSXP, n));
+  memcpy(REAL(arg), x, n * sizeof(double));
+
+  /* evaluate HR */
+  PROTECT(R_fcall = Rf_lang2(Rdistr->hr, arg));
+  PROTECT(val = Rf_eval(R_fcall, Rdistr->env));
+  PROTECT(val = Rf_coerceVector(val, REALSXP));
+  if (Rf_length(val) != n) {
+    UNPROTECT(4);
+    Rf_errorcall(R_NilValue,"[UNU.RAN - error] 'hr' must return a numeric vector of the same length as its argument");
+  }
+  memcpy(hx, REAL(val), n * sizeof(double));
+  UNPROTECT(4);
+
+} /* end of _Runuran_cont_eval_hr_array() */
+
+/*---------------------------------------------------------------------------*/
+
+void
+_Runuran_cont_eval_cdf_array( const double *x, int n, double *Fx,
+			      const struct unur_distr *distr )
+     /*----------------------------------------------------------------------*/
+     /* Evaluate CDF for an array of points.                                 */
+     /*                                                                      */
+     /* Parameters:                                                          */
+     /*   x     ... array of n points                                        */
+     /*   n     ... number of points                                         */
+     /*   Fx    ... array for storing values of CDF                          */
+     /*   distr ... pointer to distribution object                           */
+     /*                                                                      */
+     /* If the CDF (or its logarithm) is an R function, it is called once    */
+     /* with the vector of all points. Otherwise, it is evaluated point by   */
+     /* point.                                                               */
+     /*----------------------------------------------------------------------*/
+{
+  const struct Runuran_distr_cont *Rdistr;
+  int i;
+
+  if (unur_distr_cont_get_cdf(distr) == _Runuran_cont_eval_cdf ||
+      unur_distr_cont_get_logcdf(distr) == _Runuran_cont_eval_cdf) {
+    Rdistr = unur_distr_get_extobj(distr);
+    _Runuran_cont_eval_R_array(Rdistr->cdf, Rdistr->env, x, n, Fx,
+			       (unur_distr_cont_get_logcdf(distr) == _Runuran_cont_eval_cdf),
+			       "cdf");
+  }
+  else {
+    /* evaluate CDF point by point */
+    for (i=0; i<n; i++)
+      Fx[i] = unur_distr_cont_eval_cdf(x[i], distr);
+  }
+
+} /* end of _Runuran_cont_eval_cdf_array() */
+
+/*---------------------------------------------------------------------------*/
+
+void
+_Runuran_cont_eval_pdf_array( const double *x, int n, double *fx,
+			      const struct unur_distr *distr )
+     /*----------------------------------------------------------------------*/
+     /* Evaluate PDF for an array of points.                                 */
+     /*                                                                      */
+     /* Parameters:                                                          */
+     /*   x     ... array of n points                                        */
+     /*   n     ... number of points                                         */
+     /*   fx    ... array for storing values of PDF                          */
+     /*   distr ... pointer to distribution object                           */
+     /*                                                                      */
+     /* If the PDF (or its logarithm) is an R function, it is called once    */
+     /* with the vector of all points. Otherwise, it is evaluated point by   */
+     /* point.                                                               */
+     /*----------------------------------------------------------------------*/
+{
+  const struct Runuran_distr_cont *Rdistr;
+  int i;
+
+  if (unur_distr_cont_get_pdf(distr) == _Runuran_cont_eval_pdf ||
+      unur_distr_cont_get_logpdf(distr) == _Runuran_cont_eval_pdf) {
+    Rdistr = unur_distr_get_extobj(distr);
+    _Runuran_cont_eval_R_array(Rdistr->pdf, Rdistr->env, x, n, fx,
+			       (unur_distr_cont_get_logpdf(distr) == _Runuran_cont_eval_pdf),
+			       "pdf");
+  }
+  else {
+    /* evaluate PDF point by point */
+    for (i=0; i<n; i++)
+      fx[i] = unur_distr_cont_eval_pdf(x[i], distr);
+  }
+
+} /* end of _Runuran_cont_eval_pdf_array() */
+
+/*---------------------------------------------------------------------------*/
+
+void
+_Runuran_cont_eval_R_array( SEXP fun, SEXP env, const double *x, int n,
+			    double *y, int islog, const char *name )
+     /*----------------------------------------------------------------------*/
+     /* Evaluate R function for an array of points by a single call.         */
+     /*                                                                      */
+     /* Parameters:                                                          */
+     /*   fun   ... R function                                               */
+     /*   env   ... R environment                                            */
+     /*   x     ... array of n points                                        */
+     /*   n     ... number of points                                         */
+     /*   y     ... array for storing function values                        */
+     /*   islog ... boolean: TRUE if 'fun' returns logarithms                */
+     /*   name  ... name of function (for error message)                     */
+     /*----------------------------------------------------------------------*/
+{
+  SEXP R_fcall, arg, val;
+  int i;
+
+  /* copy points into R vector */
+  PROTECT(arg = Rf_allocVector(REALSXP, n));
+  memcpy(REAL(arg), x, n * sizeof(double));
+
+  /* evaluate function */
+  PROTECT(R_fcall = Rf_lang2(fun, arg));
+  PROTECT(val = Rf_eval(R_fcall, env));
+  PROTECT(val = Rf_coerceVector(val, REALSXP));
+  if (Rf_length(val) != n) {
+    UNPROTECT(4);
+    Rf_errorcall(R_NilValue,"[UNU.RAN - error] '%s' must return a numeric vector of the same length as its argument", name);
+  }
+  memcpy(y, REAL(val), n * sizeof(double));
+  UNPROTECT(4);
+
+  if (islog)
+    for (i=0; i<n; i++)
+      y[i] = exp(y[i]);
+
+} /* end of _Runuran_cont_eval_R_array() */
+
+/*---------------------------------------------------------------------------*/
+
+struct Runuran_lobatto **
+_Runuran_cont_lobatto_slot (const struct unur_distr *distr)
+     /*----------------------------------------------------------------------*/
+     /* Get slot for table for Lobatto integration.                          */
+     /*                                                                      */
+     /* Parameters:                                                          */
+     /*   distr ... pointer to distribution object                           */
+     /*                                                                      */
+     /* Return:                                                              */
+     /*   pointer to slot                                                    */
+     /*   NULL if 'distr' is not created by means of R functions             */
+     /*----------------------------------------------------------------------*/
+{
+  struct Runuran_distr_cont *Rdistr;
+
+  if (unur_distr_get_type(distr) != UNUR_DISTR_CONT)
+    return NULL;
+  if (unur_distr_cont_get_pdf(distr) != _Runuran_cont_eval_pdf &&
+      unur_distr_cont_get_logpdf(distr) != _Runuran_cont_eval_pdf &&
+      unur_distr_cont_get_cdf(distr) != _Runuran_cont_eval_cdf &&
+      unur_distr_cont_get_logcdf(distr) != _Runuran_cont_eval_cdf)
+    return NULL;
+
+  Rdistr = (struct Runuran_distr_cont *) unur_distr_get_extobj(distr);
+  return (Rdistr) ? &(Rdistr->lobatto) : NULL;
+} /* end of _Runuran_cont_lobatto_slot() */
+
 
 /*****************************************************************************/
 /*                                                                           */
@@ -441,7 +669,7 @@ _Runuran_cont_eval_dpdf( double x, const struct unur_distr *distr )
 
 SEXP
 Runuran_cmv_init (SEXP sexp_obj, SEXP sexp_env, 
-		  SEXP sexp_dim, SEXP sexp_pdf,
+		  SEXP sexp_dim, SEXP sexp_pdf, SEXP sexp_pdf_array,
 		  SEXP sexp_mode, SEXP sexp_center,
 		  SEXP sexp_ll, SEXP sexp_ur, SEXP sexp_name)
      /*----------------------------------------------------------------------*/
@@ -453,6 +681,7 @@ Runuran_cmv_init (SEXP sexp_obj, SEXP sexp_env,
      /*   env    ... R environment                                           */
      /*   dim    ... dimensions of distribution                              */
      /*   pdf    ... PDF of distribution                                     */
+     /*   pdf_array ... PDF for matrix of points (optional)                  */
      /*   mode   ... mode of distribution                                    */
      /*   center ... center of distribution                                  */
      /*   ll, ur ... lower left and upper right vertex of rectangular domain */
@@ -484,6 +713,7 @@ Runuran_cmv_init (SEXP sexp_obj, SEXP sexp_env,
   Rdistr = R_Calloc(1,struct Runuran_distr_cmv);
   Rdistr->env = sexp_env;
   Rdistr->pdf = sexp_pdf;
+  Rdistr->pdf_array = sexp_pdf_array;
 
   /* create distribution object */
   distr = unur_distr_cvec_new(dim[0]);
@@ -573,6 +803,85 @@ _Runuran_cmv_eval_pdf( const double *x, struct unur_distr *distr )
   return y;
 } /* end of _Runuran_cmv_eval_pdf() */
 
+/*---------------------------------------------------------------------------*/
+
+void
+_Runuran_cvec_eval_pdf_array( const double *X, int n, double *fx,
+			      struct unur_distr *distr )
+     /*----------------------------------------------------------------------*/
+     /* Evaluate PDF of continuous multivariate distribution for an array    */
+     /* of points (array PDF).                                               */
+     /*                                                                      */
+     /* Parameters:                                                          */
+     /*   X     ... array of n points (stored consecutively)                 */
+     /*   n     ... number of points                                         */
+     /*   fx    ... array for storing PDF values                             */
+     /*   distr ... pointer to distribution object                           */
+     /*                                                                      */
+     /* Notice: points outside of the domain have PDF value 0.               */
+     /*                                                                      */
+     /* If the PDF is an R function and an R function for a matrix of        */
+     /* points has been provided, the latter is called once for all points   */
+     /* in the domain (as n x dim matrix). Otherwise, the PDF is evaluated   */
+     /* point by point.                                                      */
+     /*----------------------------------------------------------------------*/
+{
+  const struct Runuran_distr_cmv *Rdistr;
+  SEXP R_fcall, arg, val;
+  double *rarg;
+  int *idx;
+  int i, j, d, m, dim;
+
+  /* get dimension of distribution */
+  dim = unur_distr_get_dim(distr);
+
+  /* pointer to R object (if any) */
+  Rdistr = (unur_distr_cvec_get_pdf(distr) == _Runuran_cmv_eval_pdf)
+    ? unur_distr_get_extobj(distr) : NULL;
+
+  if (Rdistr == NULL || Rf_isNull(Rdistr->pdf_array)) {
+    /* evaluate PDF point by point */
+    for (i=0; i<n; i++)
+      fx[i] = unur_distr_cvec_eval_pdf(X + i*dim, distr);
+    return;
+  }
+
+  /* points in domain */
+  idx = (int *) R_alloc(n, sizeof(int));
+  for (i=0, m=0; i<n; i++) {
+    fx[i] = 0.;
+    if (unur_distr_cvec_is_indomain(X + i*dim, distr))
+      idx[m++] = i;
+  }
+  if (m == 0) return;
+
+  /* copy points into R object of type "matrix" */
+  PROTECT(arg = Rf_allocMatrix(REALSXP, m, dim));
+  rarg = REAL(arg);
+  for (j=0; j<m; j++)
+    for (d=0; d<dim; d++)
+      rarg[j + m*d] = X[idx[j]*dim + d];
+
+  /* evaluate PDF */
+  PROTECT(R_fcall = Rf_lang2(Rdistr->pdf_array, arg));
+  PROTECT(val = Rf_eval(R_fcall, Rdistr->env));
+  PROTECT(val = Rf_coerceVector(val, REALSXP));
+  if (Rf_length(val) != m) {
+    UNPROTECT(4);
+    Rf_errorcall(R_NilValue,"[UNU.RAN - error] 'pdf.array' must return a numeric vector of length nrow(x)");
+  }
+  for (j=0; j<m; j++) {
+    if (! (REAL(val)[j] >= 0.)) {
+      /* NA, NaN, or negative value */
+      UNPROTECT(4);
+      Rf_errorcall(R_NilValue,"[UNU.RAN - error] 'pdf.array' must return non-negative numbers");
+    }
+    fx[idx[j]] = REAL(val)[j];
+  }
+  UNPROTECT(4);
+
+} /* end of _Runuran_cvec_eval_pdf_array() */
+
 
 /*****************************************************************************/
 /*                                                                           */
@@ -732,6 +1041,8 @@ _Runuran_distr_free (SEXP sexp_distr)
 
   /* free structure that stores R object */
   Rdistr = unur_distr_get_extobj(distr);
+  if (Rdistr && unur_distr_get_type(distr) == UNUR_DISTR_CONT)
+    _Runuran_lobatto_free(((struct Runuran_distr_cont *) Rdistr)->lobatto);
   R_Free(Rdistr);
 
   /* free distribution object */
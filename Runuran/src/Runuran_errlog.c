@@ -0,0 +1,322 @@
+/*****************************************************************************
+ *                                                                           *
+ *          UNU.RAN -- Universal Non-Uniform Random number generator         *
+ *                                                                           *
+ *****************************************************************************
+ *                                                                           *
+ *   FILE: Runuran_errlog.c                                                  *
+ *                                                                           *
+ *   PURPOSE:                                                                *
+ *         Ring buffer for warnings and error messages of UNU.RAN            *
+ *                                                                           *
+ *****************************************************************************
+ *                                                                           *
+ *   Copyright (c) 2026 Wolfgang Hoermann and Josef Leydold                  *
+ *   Dept. for Statistics, University of Economics, Vienna, Austria          *
+ *                                                                           *
+ *   This program is free software; you can redistribute it and/or modify    *
+ *   it under the terms of the GNU General Public License as published by    *
+ *   the Free Software Foundation; either version 2 of the License, or       *
+ *   (at your option) any later version.                                     *
+ *                                                                           *
+ *   This program is distributed in the hope that it will be useful,         *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of          *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the           *
+ *   GNU General Public License for more details.                            *
+ *                                                                           *
+ *   You should have received a copy of the GNU General Public License       *
+ *   along with this program; if not, write to the                           *
+ *   Free Software Foundation, Inc.,                                         *
+ *   59 Temple Place, Suite 330, Boston, MA 02111-1307, USA                  *
+ *                                                                           *
+ *****************************************************************************
+ *                                                                           *
+ *   The UNU.RAN library reports every warning and error by calling the      *
+ *   error handler. With the default handler of the library each message     *
+ *   is written into a log file. Runuran prints the messages instead.        *
+ *   When a warning is raised for each generated random point (e.g., by      *
+ *   uq() for u-values outside of [0,1]) this results in a flood of lines    *
+ *   of output and is rather slow.                                           *
+ *                                                                           *
+ *   Thus we store all messages in a ring buffer of fixed size and           *
+ *   aggregate consecutive identical messages into a single entry with a     *
+ *   counter. Only the first RUNURAN_ERRLOG_MAXREPEAT repetitions of a       *
+ *   message are printed. The number of suppressed repetitions is printed    *
+ *   when a different message arrives or when a call to ur() or uq() is      *
+ *   finished.  The buffer can be read from R by means of unuran.errors().   *
+ *                                                                           *
+ *   Messages are recorded independently of the verbosity level of the       *
+ *   error handler, i.e., suppressed messages can be inspected later.        *
+ *                                                                           *
+ *   Remark: The error code unur_errno and the pointer to the error handler  *
+ *   are global variables in the UNU.RAN library which cannot be changed     *
+ *   here. As R is single threaded this is not a restriction for Runuran.    *
+ *   The only exception are the producer threads of stream objects (see      *
+ *   Runuran_stream.c). Their messages are not stored in the ring buffer.    *
+ *   However, they still set unur_errno (see the known limitation in         *
+ *   Runuran_stream.c).                                                      *
+ *                                                                           *
+ *****************************************************************************/
+
+/*---------------------------------------------------------------------------*/
+
+#include "Runuran.h"
+
+/*---------------------------------------------------------------------------*/
+
+#define RUNURAN_ERRLOG_SIZE      (64)
+/* number of entries in ring buffer                                          */
+
+#define RUNURAN_ERRLOG_MAXREPEAT (3)
+/* maximal number of repetitions of a message that are printed               */
+
+#define RUNURAN_ERRLOG_IDLEN     (32)
+#define RUNURAN_ERRLOG_REASONLEN (128)
+/* maximal length of stored strings (including terminating '\0')             */
+
+/*---------------------------------------------------------------------------*/
+
+struct Runuran_errlog_entry {
+  char objid[RUNURAN_ERRLOG_IDLEN];        /* id of generator object        */
+  char reason[RUNURAN_ERRLOG_REASONLEN];   /* short description of reason   */
+  int error;               /* TRUE for errors, FALSE for warnings            */
+  int errorcode;           /* UNU.RAN error code                             */
+  double count;            /* number of occurrences                          */
+  double printed;          /* number of printed messages                     */
+  int open;                /* TRUE while repetitions are aggregated          */
+};
+
+static struct {
+  struct Runuran_errlog_entry entry[RUNURAN_ERRLOG_SIZE];
+  int first;               /* index of oldest entry                          */
+  int n_entries;           /* number of entries in buffer                    */
+} errlog = { .first = 0, .n_entries = 0 };
+
+/*---------------------------------------------------------------------------*/
+
+static struct Runuran_errlog_entry *_errlog_last (void);
+/*---------------------------------------------------------------------------*/
+/* Get pointer to newest entry in ring buffer (NULL if buffer is empty).     */
+/*---------------------------------------------------------------------------*/
+
+static void _errlog_close (struct Runuran_errlog_entry *entry);
+/*---------------------------------------------------------------------------*/
+/* Close entry and print number of suppressed repetitions.                   */
+/*---------------------------------------------------------------------------*/
+
+static void _errlog_strcpy (char *dest, const char *src, size_t size);
+/*---------------------------------------------------------------------------*/
+/* Copy (and truncate) string.                                               */
+/*---------------------------------------------------------------------------*/
+
+/*---------------------------------------------------------------------------*/
+
+int
+_Runuran_errlog_add (const char *objid, const char *errortype,
+		     int errorcode, const char *reason, int print)
+     /*----------------------------------------------------------------------*/
+     /* Store warning or error message in ring buffer.                       */
+     /* Consecutive identical messages are aggregated.                       */
+     /*                                                                      */
+     /* Parameters:                                                          */
+     /*   objid     ... id/type of object                                    */
+     /*   errortype ... "warning" or "error"                                 */
+     /*   errorcode ... UNU.RAN error code                                   */
+     /*   reason    ... short description of reason                          */
+     /*   print     ... whether the error handler prints the message         */
+     /*                                                                      */
+     /* Return:                                                              */
+     /*   TRUE  ... if message should be printed                             */
+     /*   FALSE ... otherwise                                                */
+     /*----------------------------------------------------------------------*/
+{
+  struct Runuran_errlog_entry *entry;
+  char id[RUNURAN_ERRLOG_IDLEN];
+  char why[RUNURAN_ERRLOG_REASONLEN];
+  int error;
+
+  /* messages from the producer thread of a stream object are only counted */
+  if (_Runuran_stream_drop_message())
+    return FALSE;
+
+  error = (errortype && errortype[0] == 'e') ? TRUE : FALSE;
+  _errlog_strcpy(id, objid, RUNURAN_ERRLOG_IDLEN);
+  _errlog_strcpy(why, reason, RUNURAN_ERRLOG_REASONLEN);
+
+  /* repetition of last message? */
+  entry = _errlog_last();
+  if (entry && entry->open &&
+      entry->error == error && entry->errorcode == errorcode &&
+      !strcmp(entry->objid, id) && !strcmp(entry->reason, why) ) {
+    entry->count += 1.;
+    if (print && entry->printed < RUNURAN_ERRLOG_MAXREPEAT) {
+      entry->printed += 1.;
+      return TRUE;
+    }
+    return FALSE;
+  }
+
+  /* new message: close last entry */
+  if (entry) _errlog_close(entry);
+
+  /* append new entry (overwrite oldest entry if buffer is full) */
+  if (errlog.n_entries < RUNURAN_ERRLOG_SIZE)
+    ++errlog.n_entries;
+  else
+    errlog.first = (errlog.first + 1) % RUNURAN_ERRLOG_SIZE;
+  entry = _errlog_last();
+
+  memcpy(entry->objid, id, RUNURAN_ERRLOG_IDLEN);
+  memcpy(entry->reason, why, RUNURAN_ERRLOG_REASONLEN);
+  entry->error = error;
+  entry->errorcode = errorcode;
+  entry->count = 1.;
+  entry->printed = (print) ? 1. : 0.;
+  entry->open = TRUE;
+
+  return print;
+} /* end of _Runuran_errlog_add() */
+
+/*---------------------------------------------------------------------------*/
+
+void
+_Runuran_errlog_flush (void)
+     /*----------------------------------------------------------------------*/
+     /* Stop aggregating the last message and print the number of            */
+     /* suppressed repetitions.                                              */
+     /*----------------------------------------------------------------------*/
+{
+  struct Runuran_errlog_entry *entry;
+
+  entry = _errlog_last();
+  if (entry) _errlog_close(entry);
+} /* end of _Runuran_errlog_flush() */
+
+/*---------------------------------------------------------------------------*/
+
+SEXP
+Runuran_errlog (SEXP sexp_clear)
+     /*----------------------------------------------------------------------*/
+     /* Get list of stored warnings and error messages.                      */
+     /*                                                                      */
+     /* Parameters:                                                          */
+     /*   clear ... whether the buffer should be cleared (logical)           */
+     /*                                                                      */
+     /* Return:                                                              */
+     /*   list with components 'id', 'type', 'code', 'message', 'reason',    */
+     /*   and 'count' (oldest entry first)                                   */
+     /*----------------------------------------------------------------------*/
+{
+  const char *names[] = {"id", "type", "code", "message", "reason", "count"};
+  SEXP sexp_log, sexp_names;
+  SEXP sexp_id, sexp_type, sexp_code, sexp_msg, sexp_reason, sexp_count;
+  struct Runuran_errlog_entry *entry;
+  int clear;
+  int i, n;
+
+  clear = Rf_asLogical(sexp_clear);
+  if (clear == NA_LOGICAL)
+    Rf_error("[UNU.RAN - error] invalid argument 'clear'");
+
+  /* aggregated repetitions are complete */
+  _Runuran_errlog_flush();
+
+  n = errlog.n_entries;
+  PROTECT(sexp_id = Rf_allocVector(STRSXP, n));
+  PROTECT(sexp_type = Rf_allocVector(STRSXP, n));
+  PROTECT(sexp_code = Rf_allocVector(INTSXP, n));
+  PROTECT(sexp_msg = Rf_allocVector(STRSXP, n));
+  PROTECT(sexp_reason = Rf_allocVector(STRSXP, n));
+  PROTECT(sexp_count = Rf_allocVector(REALSXP, n));
+
+  for (i=0; i<n; i++) {
+    entry = errlog.entry + (errlog.first + i) % RUNURAN_ERRLOG_SIZE;
+    SET_STRING_ELT(sexp_id, i, Rf_mkChar(entry->objid));
+    SET_STRING_ELT(sexp_type, i, Rf_mkChar(entry->error ? "error" : "warning"));
+    INTEGER(sexp_code)[i] = entry->errorcode;
+    SET_STRING_ELT(sexp_msg, i, Rf_mkChar(unur_get_strerror(entry->errorcode)));
+    SET_STRING_ELT(sexp_reason, i, Rf_mkChar(entry->reason));
+    REAL(sexp_count)[i] = entry->count;
+  }
+
+  PROTECT(sexp_log = Rf_allocVector(VECSXP, 6));
+  SET_VECTOR_ELT(sexp_log, 0, sexp_id);
+  SET_VECTOR_ELT(sexp_log, 1, sexp_type);
+  SET_VECTOR_ELT(sexp_log, 2, sexp_code);
+  SET_VECTOR_ELT(sexp_log, 3, sexp_msg);
+  SET_VECTOR_ELT(sexp_log, 4, sexp_reason);
+  SET_VECTOR_ELT(sexp_log, 5, sexp_count);
+
+  PROTECT(sexp_names = Rf_allocVector(STRSXP, 6));
+  for (i=0; i<6; i++)
+    SET_STRING_ELT(sexp_names, i, Rf_mkChar(names[i]));
+  Rf_setAttrib(sexp_log, R_NamesSymbol, sexp_names);
+
+  if (clear) {
+    errlog.first = 0;
+    errlog.n_entries = 0;
+  }
+
+  UNPROTECT(8);
+  return sexp_log;
+} /* end of Runuran_errlog() */
+
+/*---------------------------------------------------------------------------*/
+
+struct Runuran_errlog_entry *
+_errlog_last (void)
+     /*----------------------------------------------------------------------*/
+     /* Get pointer to newest entry in ring buffer.                          */
+     /*                                                                      */
+     /* Return:                                                              */
+     /*   pointer to entry, or NULL if buffer is empty                       */
+     /*----------------------------------------------------------------------*/
+{
+  if (errlog.n_entries == 0)
+    return NULL;
+  return errlog.entry + (errlog.first + errlog.n_entries - 1) % RUNURAN_ERRLOG_SIZE;
+} /* end of _errlog_last() */
+
+/*---------------------------------------------------------------------------*/
+
+void
+_errlog_close (struct Runuran_errlog_entry *entry)
+     /*----------------------------------------------------------------------*/
+     /* Close entry and print number of suppressed repetitions.              */
+     /*                                                                      */
+     /* Parameters:                                                          */
+     /*   entry ... pointer to entry                                         */
+     /*----------------------------------------------------------------------*/
+{
+  if (!entry->open)
+    return;
+  entry->open = FALSE;
+
+  /* print number of suppressed repetitions (only if message was printed) */
+  if (entry->printed > 0. && entry->count > entry->printed)
+    Rprintf("[UNU.RAN - %s] last message repeated %.0f more times\n",
+	    entry->error ? "error" : "warning", entry->count - entry->printed);
+} /* end of _errlog_close() */
+
+/*---------------------------------------------------------------------------*/
+
+void
+_errlog_strcpy (char *dest, const char *src, size_t size)
+     /*----------------------------------------------------------------------*/
+     /* Copy (and truncate) string.                                          */
+     /*                                                                      */
+     /* Parameters:                                                          */
+     /*   dest ... pointer to destination (array of length 'size')           */
+     /*   src  ... string (may be NULL)                                      */
+     /*   size ... size of destination                                       */
+     /*----------------------------------------------------------------------*/
+{
+  if (src == NULL) {
+    dest[0] = '\0';
+    return;
+  }
+  strncpy(dest, src, size-1);
+  dest[size-1] = '\0';
+} /* end of _errlog_strcpy() */
+
+/*---------------------------------------------------------------------------*/
@@ -4,6 +4,9 @@
 #include "Runuran.h"
 #include "Runuran_ext.h"
 
+/* internal header files for UNU.RAN */
+#include <unur_source.h>
+
 /*****************************************************************************/
 /*                                                                           */
 /*  Continuous Univariate Distributions (CONT)                               */
@@ -96,3 +99,148 @@ SEXP Runuran_ext_cont_init
 } /* end of Runuran_ext_cont_init() */
 
 /*---------------------------------------------------------------------------*/
+
+
+/*****************************************************************************/
+/*                                                                           */
+/*  Batch routines for generator objects                                     */
+/*                                                                           */
+/*****************************************************************************/
+
+/*  These routines fill whole arrays in a single call. Thus packages that    */
+/*  link to Runuran need only one call through R_GetCCallable() for a        */
+/*  sample instead of one call per random variate. They use the same batch   */
+/*  sampling routines as ur() and uq().                                      */
+
+/*---------------------------------------------------------------------------*/
+
+void Runuran_ext_sample_array (UNUR_GEN *gen, double *X, int n)
+/*---------------------------------------------------------------------------*/
+/* Draw sample from generator object for univariate distribution.            */
+/* Random variates of discrete distributions are stored as doubles.          */
+/*                                                                           */
+/* As for unur_sample_cont() the caller is responsible for calling           */
+/* GetRNGstate() and PutRNGstate() when R's built-in URNG is used.           */
+/*                                                                           */
+/* Parameters:                                                               */
+/*   gen ... pointer to UNU.RAN generator object                             */
+/*   X   ... array for storing random sample                                 */
+/*   n   ... sample size                                                     */
+/*---------------------------------------------------------------------------*/
+{
+  if (gen == NULL)
+    Rf_error("[Runuran-Ext] invalid argument 'gen'");
+  if (n <= 0) return;
+
+  _Runuran_sample_array(gen, X, n);
+
+  /* print number of suppressed repetitions of warnings */
+  _Runuran_errlog_flush();
+
+} /* end of Runuran_ext_sample_array() */
+
+/*---------------------------------------------------------------------------*/
+
+void Runuran_ext_quantile_array (UNUR_GEN *gen, const double *U, double *X, int n)
+/*---------------------------------------------------------------------------*/
+/* Evaluate approximate quantile function for an array of u-values.          */
+/* The generator object must implement an inversion method.                  */
+/* 'U' and 'X' may point to the same array.                                  */
+/*                                                                           */
+/* Parameters:                                                               */
+/*   gen ... pointer to UNU.RAN generator object                             */
+/*   U   ... array of u-values                                               */
+/*   X   ... array for storing quantiles                                     */
+/*   n   ... length of arrays 'U' and 'X'                                    */
+/*---------------------------------------------------------------------------*/
+{
+  if (gen == NULL)
+    Rf_error("[Runuran-Ext] invalid argument 'gen'");
+  if (n <= 0) return;
+
+  _Runuran_quantile_array(gen, U, X, n);
+
+  /* print number of suppressed repetitions of warnings */
+  _Runuran_errlog_flush();
+
+} /* end of Runuran_ext_quantile_array() */
+
+/*---------------------------------------------------------------------------*/
+
+void Runuran_ext_pdf_array (const UNUR_GEN *gen, const double *x, double *y,
+			    int n, int islog)
+/*---------------------------------------------------------------------------*/
+/* Evaluate PDF (or PMF) of the distribution in generator object for an      */
+/* array of points.                                                          */
+/*                                                                           */
+/* Parameters:                                                               */
+/*   gen   ... pointer to UNU.RAN generator object                           */
+/*   x     ... array of n points                                             */
+/*   y     ... array for storing values of PDF                               */
+/*   n     ... number of points                                              */
+/*   islog ... boolean: if TRUE then the log-density is computed             */
+/*---------------------------------------------------------------------------*/
+{
+  const struct unur_distr *distr;
+
+  if (gen == NULL || (distr = unur_get_distr(gen)) == NULL)
+    Rf_error("[Runuran-Ext] invalid argument 'gen'");
+
+  switch (distr->type) {
+  case UNUR_DISTR_CONT:
+    if ( (islog && distr->data.cont.logpdf == NULL) ||
+	 (!islog && distr->data.cont.pdf == NULL) )
+      Rf_error("[Runuran-Ext] UNU.RAN object does not contain (log)PDF");
+    break;
+  case UNUR_DISTR_DISCR:
+    if (islog || distr->data.discr.pmf == NULL)
+      Rf_error("[Runuran-Ext] UNU.RAN object does not contain (log)PMF");
+    break;
+  default:
+    Rf_error("[Runuran-Ext] invalid distribution type");
+  }
+
+  if (n <= 0) return;
+  _Runuran_pdf_array(distr, x, y, n, islog);
+
+} /* end of Runuran_ext_pdf_array() */
+
+/*---------------------------------------------------------------------------*/
+
+void Runuran_ext_cdf_array (const UNUR_GEN *gen, const double *x, double *y, int n)
+/*---------------------------------------------------------------------------*/
+/* Evaluate CDF of the distribution in generator object for an array of      */
+/* points. If the continuous distribution has no CDF then the approximate    */
+/* CDF of method PINV is used.                                               */
+/*                                                                           */
+/* Parameters:                                                               */
+/*   gen   ... pointer to UNU.RAN generator object                           */
+/*   x     ... array of n points                                             */
+/*   y     ... array for storing values of CDF                               */
+/*   n     ... number of points                                              */
+/*---------------------------------------------------------------------------*/
+{
+  const struct unur_distr *distr;
+
+  if (gen == NULL || (distr = unur_get_distr(gen)) == NULL)
+    Rf_error("[Runuran-Ext] invalid argument 'gen'");
+
+  switch (distr->type) {
+  case UNUR_DISTR_CONT:
+    if (distr->data.cont.cdf == NULL && unur_get_method(gen) != UNUR_METH_PINV)
+      Rf_error("[Runuran-Ext] UNU.RAN object does not contain CDF");
+    break;
+  case UNUR_DISTR_DISCR:
+    if (distr->data.discr.cdf == NULL)
+      Rf_error("[Runuran-Ext] UNU.RAN object does not contain CDF");
+    break;
+  default:
+    Rf_error("[Runuran-Ext] invalid distribution type");
+  }
+
+  if (n <= 0) return;
+  _Runuran_cdf_array(gen, distr, x, y, n);
+
+} /* end of Runuran_ext_cdf_array() */
+
+/*---------------------------------------------------------------------------*/
@@ -0,0 +1,296 @@
+/*****************************************************************************
+ *                                                                           *
+ *          UNU.RAN -- Universal Non-Uniform Random number generator         *
+ *                                                                           *
+ *****************************************************************************
+ *                                                                           *
+ *   FILE: Runuran_gibbs.c                                                   *
+ *                                                                           *
+ *   PURPOSE:                                                                *
+ *         Warm starts for conditional generators in method GIBBS            *
+ *                                                                           *
+ *****************************************************************************
+ *                                                                           *
+ *   Copyright (c) 2026 Wolfgang Hoermann and Josef Leydold                  *
+ *   Dept. for Statistics, University of Economics, Vienna, Austria          *
+ *                                                                           *
+ *   This program is free software; you can redistribute it and/or modify    *
+ *   it under the terms of the GNU General Public License as published by    *
+ *   the Free Software Foundation; either version 2 of the License, or       *
+ *   (at your option) any later version.                                     *
+ *                                                                           *
+ *   This program is distributed in the hope that it will be useful,         *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of          *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the           *
+ *   GNU General Public License for more details.                            *
+ *                                                                           *
+ *   You should have received a copy of the GNU General Public License       *
+ *   along with this program; if not, write to the                           *
+ *   Free Software Foundation, Inc.,                                         *
+ *   59 Temple Place, Suite 330, Boston, MA 02111-1307, USA                  *
+ *                                                                           *
+ *****************************************************************************
+ *                                                                           *
+ *   Method GIBBS draws from the full conditional distributions by means     *
+ *   of methods ARS (T=log) or TDR (T=-1/sqrt). Before each coordinate step  *
+ *   the conditional generator is reinitialized. By default it uses the      *
+ *   percentiles of its previous hat as construction points. However, the    *
+ *   previous hat belongs to the previous conditional distribution which     *
+ *   may be located elsewhere. Then the hat is poor and many PDF evaluations *
+ *   are required for adaptive steps (or even a retry with many equidistant  *
+ *   construction points).                                                   *
+ *                                                                           *
+ *   We replace the reinit routine of these conditional generators by a      *
+ *   wrapper that shifts the construction points of the previous hat such    *
+ *   that its median coincides with the current state of the chain (i.e.,    *
+ *   the current value of the coordinate or the point t=0 on the random      *
+ *   line). As the current state is (approximately) a draw from the new      *
+ *   conditional distribution, the shifted points are usually well placed.   *
+ *   Thus only the PDF at these few points has to be evaluated to restore a  *
+ *   valid hat. If the shifted points cannot be computed, the original       *
+ *   reinit routine is used. (If the reinit with the shifted points fails,   *
+ *   the library has already retried with equidistant points.)               *
+ *                                                                           *
+ *   The sampling routines of method GIBBS and the results of the Markov     *
+ *   chain (in distribution) are not changed.                                *
+ *                                                                           *
+ *****************************************************************************/
+
+/*---------------------------------------------------------------------------*/
+
+#include "Runuran.h"
+
+/* internal header files for UNU.RAN */
+#include <unur_source.h>
+#include <distr/distr_source.h>
+#include <methods/ars_struct.h>
+#include <methods/tdr_struct.h>
+
+/*---------------------------------------------------------------------------*/
+
+/* flags for reinit with percentiles (copied from methods/ars.c and tdr.c)   */
+#define ARS_SET_N_PERCENTILES  0x008u
+#define TDR_SET_N_PERCENTILES  0x0008u
+
+/* parameters of conditional distributions (copied from distr/condi.c)       */
+#define iK           0
+#define iPOSITION    0
+#define iDIRECTION   1
+
+/*---------------------------------------------------------------------------*/
+
+static int (*_ars_reinit)(struct unur_gen *gen) = NULL;
+static int (*_tdr_reinit)(struct unur_gen *gen) = NULL;
+/* original reinit routines of methods ARS and TDR */
+
+/*---------------------------------------------------------------------------*/
+
+static int _gibbs_ars_reinit (struct unur_gen *gen);
+/*---------------------------------------------------------------------------*/
+/* Reinitialize ARS generator for conditional distribution (warm start).     */
+/*---------------------------------------------------------------------------*/
+
+static int _gibbs_tdr_reinit (struct unur_gen *gen);
+/*---------------------------------------------------------------------------*/
+/* Reinitialize TDR generator for conditional distribution (warm start).     */
+/*---------------------------------------------------------------------------*/
+
+static int _gibbs_shift_cpoints (double *cpoints, int *n_cpoints, double median,
+				 const struct unur_distr *condi);
+/*---------------------------------------------------------------------------*/
+/* Shift construction points to current state of Markov chain.               */
+/*---------------------------------------------------------------------------*/
+
+/*****************************************************************************/
+
+void
+_Runuran_gibbs_warm_start (struct unur_gen *gen)
+     /*----------------------------------------------------------------------*/
+     /* Replace reinit routines of conditional generators of GIBBS object.   */
+     /*                                                                      */
+     /* Parameters:                                                          */
+     /*   gen ... pointer to generator object                                */
+     /*                                                                      */
+     /* Remark: Nothing happens if 'gen' is not a GIBBS generator object.    */
+     /*----------------------------------------------------------------------*/
+{
+  struct unur_gen *condi;
+  int i;
+
+  if (gen == NULL || unur_get_method(gen) != UNUR_METH_GIBBS)
+    return;
+
+  for (i=0; i < gen->n_gen_aux_list; i++) {
+    if ((condi = gen->gen_aux_list[i]) == NULL)
+      continue;
+
+    switch (unur_get_method(condi)) {
+    case UNUR_METH_ARS:
+      if (_ars_reinit == NULL) _ars_reinit = condi->reinit;
+      if (condi->reinit == _ars_reinit) condi->reinit = _gibbs_ars_reinit;
+      break;
+    case UNUR_METH_TDR:
+      if (_tdr_reinit == NULL) _tdr_reinit = condi->reinit;
+      if (condi->reinit == _tdr_reinit) condi->reinit = _gibbs_tdr_reinit;
+      break;
+    default:
+      break;
+    }
+  }
+
+} /* end of _Runuran_gibbs_warm_start() */
+
+/*---------------------------------------------------------------------------*/
+
+#define GEN       ((struct unur_ars_gen*)gen->datap)
+
+int
+_gibbs_ars_reinit (struct unur_gen *gen)
+     /*----------------------------------------------------------------------*/
+     /* Reinitialize ARS generator for conditional distribution.             */
+     /* Use percentiles of old hat shifted to current state.                 */
+     /*                                                                      */
+     /* Parameters:                                                          */
+     /*   gen ... pointer to generator object                                */
+     /*                                                                      */
+     /* Return:                                                              */
+     /*   UNUR_SUCCESS ... on success                                        */
+     /*   error code   ... otherwise                                         */
+     /*----------------------------------------------------------------------*/
+{
+  int i, rcode;
+
+  if ((gen->set & ARS_SET_N_PERCENTILES) && GEN->iv != NULL && GEN->Atotal > 0.) {
+
+    /* percentiles of old hat */
+    GEN->starting_cpoints = _unur_xrealloc( GEN->starting_cpoints,
+					    GEN->n_percentiles * sizeof(double) );
+    GEN->n_starting_cpoints = GEN->n_percentiles;
+    for (i=0; i<GEN->n_percentiles; i++)
+      GEN->starting_cpoints[i] = unur_ars_eval_invcdfhat( gen, GEN->percentiles[i] );
+
+    /* shift to current state and run reinit with these points */
+    if (_gibbs_shift_cpoints(GEN->starting_cpoints, &(GEN->n_starting_cpoints),
+			     unur_ars_eval_invcdfhat(gen, 0.5), gen->distr) == UNUR_SUCCESS) {
+      gen->set &= ~ARS_SET_N_PERCENTILES;
+      rcode = _ars_reinit(gen);
+      gen->set |= ARS_SET_N_PERCENTILES;
+      /* The original routine has already retried with equidistant points */
+      /* and the old hat is destroyed. So we must not call it again.      */
+      return rcode;
+    }
+  }
+
+  /* use original routine */
+  return _ars_reinit(gen);
+
+} /* end of _gibbs_ars_reinit() */
+
+#undef GEN
+
+/*---------------------------------------------------------------------------*/
+
+#define GEN       ((struct unur_tdr_gen*)gen->datap)
+
+int
+_gibbs_tdr_reinit (struct unur_gen *gen)
+     /*----------------------------------------------------------------------*/
+     /* Reinitialize TDR generator for conditional distribution.             */
+     /* Use percentiles of old hat shifted to current state.                 */
+     /*                                                                      */
+     /* Parameters:                                                          */
+     /*   gen ... pointer to generator object                                */
+     /*                                                                      */
+     /* Return:                                                              */
+     /*   UNUR_SUCCESS ... on success                                        */
+     /*   error code   ... otherwise                                         */
+     /*----------------------------------------------------------------------*/
+{
+  int i, rcode;
+
+  if ((gen->set & TDR_SET_N_PERCENTILES) && GEN->iv != NULL && GEN->Atotal > 0.) {
+
+    /* percentiles of old hat */
+    GEN->starting_cpoints = _unur_xrealloc( GEN->starting_cpoints,
+					    GEN->n_percentiles * sizeof(double) );
+    GEN->n_starting_cpoints = GEN->n_percentiles;
+    for (i=0; i<GEN->n_percentiles; i++)
+      GEN->starting_cpoints[i] = 
+	unur_tdr_eval_invcdfhat( gen, GEN->percentiles[i], NULL, NULL, NULL );
+
+    /* shift to current state and run reinit with these points */
+    if (_gibbs_shift_cpoints(GEN->starting_cpoints, &(GEN->n_starting_cpoints),
+			     unur_tdr_eval_invcdfhat(gen, 0.5, NULL, NULL, NULL),
+			     gen->distr) == UNUR_SUCCESS) {
+      gen->set &= ~TDR_SET_N_PERCENTILES;
+      rcode = _tdr_reinit(gen);
+      gen->set |= TDR_SET_N_PERCENTILES;
+      /* The original routine has already retried with equidistant points */
+      /* and the old hat is destroyed. So we must not call it again.      */
+      return rcode;
+    }
+  }
+
+  /* use original routine */
+  return _tdr_reinit(gen);
+
+} /* end of _gibbs_tdr_reinit() */
+
+#undef GEN
+
+/*---------------------------------------------------------------------------*/
+
+int
+_gibbs_shift_cpoints (double *cpoints, int *n_cpoints, double median,
+		      const struct unur_distr *condi)
+     /*----------------------------------------------------------------------*/
+     /* Shift construction points to current state of Markov chain.          */
+     /* Points outside the domain are removed.                               */
+     /*                                                                      */
+     /* Parameters:                                                          */
+     /*   cpoints   ... array of construction points (sorted)                */
+     /*   n_cpoints ... pointer to number of construction points             */
+     /*   median    ... median of old hat                                    */
+     /*   condi     ... conditional distribution                             */
+     /*                                                                      */
+     /* Return:                                                              */
+     /*   UNUR_SUCCESS ... on success                                        */
+     /*   error code   ... otherwise                                         */
+     /*----------------------------------------------------------------------*/
+{
+  const double *domain = condi->data.cont.domain;
+  const double *pos, *dir;
+  double state, x;
+  int i, n;
+
+  if (condi->id != UNUR_DISTR_CONDI)
+    return UNUR_ERR_DISTR_INVALID;
+
+  /* current state of chain: */
+  /*   coordinate sampler:       current value of coordinate */
+  /*   random direction sampler: t=0 on the given line       */
+  pos = condi->data.cont.param_vecs[iPOSITION];
+  dir = condi->data.cont.param_vecs[iDIRECTION];
+  state = (dir) ? 0. : pos[(int) condi->data.cont.params[iK]];
+
+  if (!_unur_isfinite(state) || !_unur_isfinite(median))
+    return UNUR_FAILURE;
+
+  for (i=0, n=0; i < *n_cpoints; i++) {
+    x = cpoints[i] + (state - median);
+    if (! (x > domain[0] && x < domain[1]) )
+      continue;
+    if (n > 0 && x <= cpoints[n-1])
+      continue;
+    cpoints[n++] = x;
+  }
+
+  if (n == 0)
+    return UNUR_FAILURE;
+
+  *n_cpoints = n;
+  return UNUR_SUCCESS;
+
+} /* end of _gibbs_shift_cpoints() */
+
+/*---------------------------------------------------------------------------*/
@@ -0,0 +1,445 @@
+/*****************************************************************************
+ *                                                                           *
+ *          UNU.RAN -- Universal Non-Uniform Random number generator         *
+ *                                                                           *
+ *****************************************************************************
+ *                                                                           *
+ *   FILE: Runuran_hinv.c                                                    *
+ *                                                                           *
+ *   PURPOSE:                                                                *
+ *         R interface for UNU.RAN -- HINV                                   *
+ *                                                                           *
+ *****************************************************************************
+ *                                                                           *
+ *   Copyright (c) 2026 Wolfgang Hoermann and Josef Leydold                  *
+ *   Dept. for Statistics, University of Economics, Vienna, Austria          *
+ *                                                                           *
+ *   This program is free software; you can redistribute it and/or modify    *
+ *   it under the terms of the GNU General Public License as published by    *
+ *   the Free Software Foundation; either version 2 of the License, or       *
+ *   (at your option) any later version.                                     *
+ *                                                                           *
+ *   This program is distributed in the hope that it will be useful,         *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of          *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the           *
+ *   GNU General Public License for more details.                            *
+ *                                                                           *
+ *   You should have received a copy of the GNU General Public License       *
+ *   along with this program; if not, write to the                           *
+ *   Free Software Foundation, Inc.,                                         *
+ *   59 Temple Place, Suite 330, Boston, MA 02111-1307, USA                  *
+ *                                                                           *
+ *****************************************************************************/
+
+/*---------------------------------------------------------------------------*/
+
+#include "Runuran.h"
+
+/* internal header files for UNU.RAN */
+#include <unur_source.h>
+#include <methods/hinv_struct.h>
+
+/*---------------------------------------------------------------------------*/
+
+/* number of entries (slots) in data list */
+#define n_slots (6)
+#define n_slots_compact (7)   /* compact mode */
+
+/* names of slots */
+static const char *slot_name[n_slots_compact] = {"mid","order","Umin","Umax","guide","iv","cf"};
+
+/* positions in data list */
+enum {
+  pmid = 0,      /* method ID [ This MUST be 0 ! ] */
+  porder = 1,    /* order of polynomial */
+  pUmin = 2,     /* Umin */
+  pUmax = 3,     /* Umax */
+  pguide = 4,    /* guide table */
+  piv = 5,       /* coefficents of polynomials */
+  pcf = 6        /* coefficents in single precision (compact mode only) */
+};
+
+/*---------------------------------------------------------------------------*/
+
+static double _hinv_eval (double U, int order, int guide_size, int *guide,
+			  double *iv, int *cf);
+/*---------------------------------------------------------------------------*/
+/* Evaluate approximating polynomial.                                        */
+/*---------------------------------------------------------------------------*/
+
+static double _hinv_compact_uerror (struct unur_gen *gen);
+/*---------------------------------------------------------------------------*/
+/* Estimate additional u-error caused by single precision coefficients.      */
+/*---------------------------------------------------------------------------*/
+
+/*---------------------------------------------------------------------------*/
+
+#define GEN    ((struct unur_hinv_gen*)gen->datap)
+/* data for generator object */
+
+#define DISTR  (gen->distr->data.cont)
+/* data for distribution in generator object */
+
+/*****************************************************************************/
+
+void
+_Runuran_pack_hinv (struct unur_gen *gen, SEXP sexp_unur, int compact)
+     /*----------------------------------------------------------------------*/
+     /* Pack Runuran generator object for method HINV into R list            */
+     /*                                                                      */
+     /* Parameters:                                                          */
+     /*   gen     ... pointer to UNU.RAN generator object                    */
+     /*   unur    ... 'Runuran' object (S4 class)                            */
+     /*   compact ... whether coefficients are stored in single precision    */
+     /*                                                                      */
+     /* Return:                                                              */
+     /*   data for generation method (R list)                                */
+     /*----------------------------------------------------------------------*/
+{
+  int i,k;
+  int order, iv_size, n_data;
+  double *iv;
+
+  /* names of list entries */
+  SEXP sexp_data_names;
+
+  /* data list and its entries */
+  SEXP sexp_data, sexp_dom;
+  SEXP sexp_mid, sexp_order, sexp_Umin, sexp_Umax, sexp_guide, sexp_iv, sexp_cf;
+
+  /* in compact mode the polynomials are stored in single precision. */
+  /* we have to check whether this is accurate enough.               */
+  if (compact && _hinv_compact_uerror(gen) > GEN->u_resolution) {
+    Rf_warning("[UNU.RAN - warning] u-resolution too small for compact mode: object packed in double precision");
+    compact = FALSE;
+  }
+
+  /* order of polynomials */
+  order = GEN->order;
+
+  /* number of doubles stored for one interval */
+  iv_size = (compact) ? 2 : order + 2;
+
+  /* create entries for data list */
+
+  /* method ID (int) */
+  PROTECT(sexp_mid = Rf_allocVector(INTSXP, 1));
+  INTEGER(sexp_mid)[0] = UNUR_METH_HINV;
+
+  /* order (int) */
+  PROTECT(sexp_order = Rf_allocVector(INTSXP, 1));
+  INTEGER(sexp_order)[0] = order;
+
+  /* Umin, Umax (double) */
+  PROTECT(sexp_Umin = Rf_allocVector(REALSXP, 1));
+  REAL(sexp_Umin)[0] = GEN->Umin;
+  PROTECT(sexp_Umax = Rf_allocVector(REALSXP, 1));
+  REAL(sexp_Umax)[0] = GEN->Umax;
+
+  /* guide table (int[]) */
+  PROTECT(sexp_guide = Rf_allocVector(INTSXP, GEN->guide_size));
+  for (i=0; i<GEN->guide_size; i++) {
+    INTEGER(sexp_guide)[i] = iv_size * (GEN->guide[i] / (order+2));
+  }
+
+  /* table of coefficients for approximating polynomial */
+  PROTECT(sexp_iv = Rf_allocVector(REALSXP, GEN->N * iv_size));
+  iv = REAL(sexp_iv);
+
+  if (compact) {
+    /* sequence for each interval: u, spline[0]
+     * spline[1], ..., spline[order] are stored in single precision
+     * in entry 'cf'.
+     */
+    PROTECT(sexp_cf = Rf_allocVector(INTSXP, GEN->N * order));
+    for (i=0; i<GEN->N; i++) {
+      iv[2*i]   = GEN->intervals[i*(order+2)];
+      iv[2*i+1] = GEN->intervals[i*(order+2)+1];
+      for (k=1; k<=order; k++)
+	INTEGER(sexp_cf)[i*order+k-1] =
+	  _Runuran_float_to_int(GEN->intervals[i*(order+2)+1+k]);
+    }
+  }
+
+  else {
+    /* sequence for each interval: u, spline[0], ..., spline[order] */
+    PROTECT(sexp_cf = R_NilValue);
+    memcpy(iv, GEN->intervals, GEN->N * iv_size * sizeof(double));
+  }
+
+  /* size of data list */
+  n_data = (compact) ? n_slots_compact : n_slots;
+
+  /* list of "names" attribute of the objects in our list */
+  PROTECT(sexp_data_names = Rf_allocVector(STRSXP, n_data));
+  for (i=0; i<n_data; i++)
+    SET_STRING_ELT(sexp_data_names, i, Rf_mkChar(slot_name[i]));
+
+  /* create data list */
+  PROTECT(sexp_data = Rf_allocVector(VECSXP, n_data));
+  SET_VECTOR_ELT(sexp_data, pmid,   sexp_mid);      /* attach 'mid' element   */
+  SET_VECTOR_ELT(sexp_data, porder, sexp_order);    /* attach 'order' element */
+  SET_VECTOR_ELT(sexp_data, pUmin,  sexp_Umin);     /* attach 'Umin' element  */
+  SET_VECTOR_ELT(sexp_data, pUmax,  sexp_Umax);     /* attach 'Umax' element  */
+  SET_VECTOR_ELT(sexp_data, pguide, sexp_guide);    /* attach 'guide' element */
+  SET_VECTOR_ELT(sexp_data, piv,    sexp_iv);       /* attach 'iv' element    */
+  if (compact)
+    SET_VECTOR_ELT(sexp_data, pcf,  sexp_cf);       /* attach 'cf' element    */
+
+  /* attach vector names */
+  Rf_setAttrib(sexp_data, R_NamesSymbol, sexp_data_names);
+
+  /* store in slot 'data' of S4 object 'unur' */
+  R_do_slot_assign(sexp_unur, Rf_install("data"), sexp_data);
+
+  /* set (truncated) domain of distribution and store in slot 'dom' */
+  PROTECT(sexp_dom = Rf_allocVector(REALSXP, 2));
+  REAL(sexp_dom)[0] = DISTR.trunc[0];
+  REAL(sexp_dom)[1] = DISTR.trunc[1];
+  R_do_slot_assign(sexp_unur, Rf_install("dom"), sexp_dom);
+
+  /* o.k. */
+  UNPROTECT(10);
+  return;
+
+} /* end of _Runuran_pack_hinv() */
+
+/*---------------------------------------------------------------------------*/
+
+SEXP
+_Runuran_sample_hinv (SEXP sexp_data, int n, SEXP sexp_unur)
+     /*----------------------------------------------------------------------*/
+     /* Sample from generator object: use R data list (packed object)        */
+     /*                                                                      */
+     /* Parameters:                                                          */
+     /*   data ... data for generation method (R list)                       */
+     /*   n    ... sample size (positive integer)                            */
+     /*   unur ... 'Runuran' object (S4 class)                               */
+     /*                                                                      */
+     /* Return:                                                              */
+     /*   random sample of size 'n'                                          */
+     /*----------------------------------------------------------------------*/
+{
+  int i;
+  double U, X;
+  SEXP sexp_res = R_NilValue;
+
+  /* extract data */
+  int order = INTEGER(VECTOR_ELT(sexp_data, porder))[0];
+  double Umin = REAL(VECTOR_ELT(sexp_data, pUmin))[0];
+  double Umax = REAL(VECTOR_ELT(sexp_data, pUmax))[0];
+  int *guide = INTEGER(VECTOR_ELT(sexp_data, pguide));
+  int guide_size = Rf_length(VECTOR_ELT(sexp_data, pguide));
+  double *iv = REAL(VECTOR_ELT(sexp_data, piv));
+  int *cf = (Rf_length(sexp_data) == n_slots_compact)
+    ? INTEGER(VECTOR_ELT(sexp_data, pcf)) : NULL;
+  double *dom = REAL(R_do_slot(sexp_unur, Rf_install("dom")));
+
+  /* generate sample */
+  PROTECT(sexp_res = Rf_allocVector(REALSXP, n));
+  for (i=0; i<n; i++) {
+    U = Umin + unif_rand() * (Umax - Umin);   /* FIXME: R built-in URNG hard coded ! */
+    X = _hinv_eval (U, order, guide_size, guide, iv, cf);
+    if (X < dom[0]) X = dom[0];
+    if (X > dom[1]) X = dom[1];
+    REAL(sexp_res)[i] = X;
+  }
+
+  /* return result to R */
+  UNPROTECT(1);
+  return sexp_res;
+
+} /* end of _Runuran_sample_hinv() */
+
+/*---------------------------------------------------------------------------*/
+
+SEXP
+_Runuran_quantile_hinv (SEXP sexp_data, SEXP sexp_U, SEXP sexp_unur)
+     /*----------------------------------------------------------------------*/
+     /* Evaluate approximate quantile function:  use R data list (packed)    */
+     /*                                                                      */
+     /* Parameters:                                                          */
+     /*   data ... data for generation method (R list)                       */
+     /*   U    ... u-value (numeric array)                                   */
+     /*   unur ... 'Runuran' object (S4 class)                               */
+     /*                                                                      */
+     /* Return:                                                              */
+     /*   (approximate) quantiles for given 'U' values                       */
+     /*----------------------------------------------------------------------*/
+{
+  int i,n;
+  double *U, X;
+  SEXP sexp_res = R_NilValue;
+
+  /* domain of distribution */
+  SEXP sexp_dom  = R_NilValue;
+  double *dom;
+
+  /* extract data */
+  int order = INTEGER(VECTOR_ELT(sexp_data, porder))[0];
+  double Umin = REAL(VECTOR_ELT(sexp_data, pUmin))[0];
+  double Umax = REAL(VECTOR_ELT(sexp_data, pUmax))[0];
+  int *guide = INTEGER(VECTOR_ELT(sexp_data, pguide));
+  int guide_size = Rf_length(VECTOR_ELT(sexp_data, pguide));
+  double *iv = REAL(VECTOR_ELT(sexp_data, piv));
+  int *cf = (Rf_length(sexp_data) == n_slots_compact)
+    ? INTEGER(VECTOR_ELT(sexp_data, pcf)) : NULL;
+
+  /* Extract U */
+  U = REAL(sexp_U);
+  n = Rf_length(sexp_U);
+
+  /* domain of distribution */
+  PROTECT(sexp_dom = R_do_slot(sexp_unur, Rf_install("dom")));
+  dom = REAL(sexp_dom);
+
+  /* evaluate inverse CDF */
+  PROTECT(sexp_res = Rf_allocVector(REALSXP, n));
+  for (i=0; i<n; i++) {
+    if (ISNAN(U[i]))
+      /* if NA or NaN is given then we simply return the same value */
+      REAL(sexp_res)[i] = U[i];
+    else {
+
+      if (U[i] <= 0. ||  U[i] >= 1.) {
+	/* same bahavior as in UNU.RAN */
+
+	if (U[i] < 0. ||  U[i] > 1.)
+	  Rf_warning("[UNU.RAN - warning] argument out of domain: U not in [0,1]");
+	if (U[i] < 0.5 )
+	  REAL(sexp_res)[i] = dom[0];
+	if (U[i] > 0.5 )
+	  REAL(sexp_res)[i] = dom[1];
+      }
+
+      else {
+	X = _hinv_eval (Umin + U[i] * (Umax - Umin),
+			order, guide_size, guide, iv, cf);
+	if (X < dom[0]) X = dom[0];
+	if (X > dom[1]) X = dom[1];
+	REAL(sexp_res)[i] = X;
+      }
+    }
+  }
+
+  /* return result to R */
+  UNPROTECT(2);
+  return sexp_res;
+
+} /* end of _Runuran_quantile_hinv() */
+
+/*---------------------------------------------------------------------------*/
+
+double
+_hinv_eval (double U, int order, int guide_size, int *guide, double *iv, int *cf)
+     /*----------------------------------------------------------------------*/
+     /* Evaluate approximating polynomial.                                   */
+     /*                                                                      */
+     /* Parameters:                                                          */
+     /*   U          ... u-value ~ U(Umin,Umax)                              */
+     /*   order      ... order of polynomial                                 */
+     /*   guide_size ... size of guide table                                 */
+     /*   guide      ... guide table                                         */
+     /*   iv         ... array of coefficients for all intervals             */
+     /*   cf         ... array of coefficients in single precision           */
+     /*                  (compact mode only, NULL otherwise)                 */
+     /*                                                                      */
+     /* Return:                                                              */
+     /*   (approximate) quantiles for given 'U' values                       */
+     /*----------------------------------------------------------------------*/
+{
+  int I;
+  int k, width;
+  double t, X;
+  const int *c;
+
+  /* number of entries per interval */
+  width = (cf) ? 2 : order + 2;
+
+  /* find interval */
+  I = guide[(int) (U * guide_size)];
+  while (U > iv[I+width]) I+=width;
+
+  /* rescale U to [0,1] */
+  t = (U-iv[I]) / (iv[I+width] - iv[I]);
+
+  /* evaluate polynomial */
+  if (cf) {
+    c = cf + (I/2) * order;
+    X = _Runuran_int_to_float(c[order-1]);
+    for (k=order-2; k>=0; k--)
+      X = X*t + _Runuran_int_to_float(c[k]);
+    X = X*t + iv[I+1];
+  }
+  else {
+    X = iv[I+1+order];
+    for (k=order-1; k>=0; k--)
+      X = X*t + iv[I+1+k];
+  }
+
+  /* return result */
+  return X;
+
+} /* end of _hinv_eval() */
+
+/*---------------------------------------------------------------------------*/
+
+double
+_hinv_compact_uerror (struct unur_gen *gen)
+     /*----------------------------------------------------------------------*/
+     /* Estimate additional u-error caused by single precision coefficients. */
+     /*                                                                      */
+     /* We compare the polynomials in double and single precision at a few   */
+     /* points in each interval and convert the difference in x into an      */
+     /* error in u by means of the slope of the interval.                    */
+     /*                                                                      */
+     /* Parameters:                                                          */
+     /*   gen ... pointer to UNU.RAN generator object                        */
+     /*                                                                      */
+     /* Return:                                                              */
+     /*   estimated maximal u-error                                          */
+     /*----------------------------------------------------------------------*/
+{
+#define N_TEST (4)
+  double *c;
+  double h, dx, t, Xd, Xf, cfk;
+  double err, max_err = 0.;
+  int i, j, k, order;
+
+  order = GEN->order;
+
+  for (i=0; i<GEN->N-1; i++) {
+    c = GEN->intervals + i*(order+2);
+    h = c[order+2] - c[0];
+    dx = c[order+3] - c[1];
+    for (k=1; k<=order; k++) {
+      cfk = (float) c[1+k];
+      if (! _unur_isfinite(cfk)) return UNUR_INFINITY;
+    }
+
+    /* intervals shorter than the u-resolution are ignored */
+    /* (they only occur in the extreme tails).             */
+    if (! (h > GEN->u_resolution && _unur_isfinite(dx) && fabs(dx) > 0.)) continue;
+
+    for (j=1; j<=N_TEST; j++) {
+      t = ((double) j) / N_TEST;
+
+      Xd = c[1+order];
+      Xf = (float) c[1+order];
+      for (k=order-1; k>=1; k--) {
+	Xd = Xd*t + c[1+k];
+	Xf = Xf*t + (float) c[1+k];
+      }
+      Xd = Xd*t + c[1];
+      Xf = Xf*t + c[1];
+
+      err = fabs(Xf - Xd) * h / fabs(dx);
+      if (err > max_err) max_err = err;
+    }
+  }
+
+  return max_err;
+#undef N_TEST
+} /* end of _hinv_compact_uerror() */
+
+/*---------------------------------------------------------------------------*/
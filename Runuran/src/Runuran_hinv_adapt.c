@@ -0,0 +1,1081 @@
+/*****************************************************************************
+ *                                                                           *
+ *          UNU.RAN -- Universal Non-Uniform Random number generator         *
+ *                                                                           *
+ *****************************************************************************
+ *                                                                           *
+ *   FILE: Runuran_hinv_adapt.c                                              *
+ *                                                                           *
+ *   PURPOSE:                                                                *
+ *         Incremental setup for method HINV with error-driven refinement    *
+ *                                                                           *
+ *****************************************************************************
+ *                                                                           *
+ *   Copyright (c) 2026 Wolfgang Hoermann and Josef Leydold                  *
+ *   Dept. for Statistics, University of Economics, Vienna, Austria          *
+ *                                                                           *
+ *   This program is free software; you can redistribute it and/or modify    *
+ *   it under the terms of the GNU General Public License as published by    *
+ *   the Free Software Foundation; either version 2 of the License, or       *
+ *   (at your option) any later version.                                     *
+ *                                                                           *
+ *   This program is distributed in the hope that it will be useful,         *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of          *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the           *
+ *   GNU General Public License for more details.                            *
+ *                                                                           *
+ *   You should have received a copy of the GNU General Public License       *
+ *   along with this program; if not, write to the                           *
+ *   Free Software Foundation, Inc.,                                         *
+ *   59 Temple Place, Suite 330, Boston, MA 02111-1307, USA                  *
+ *                                                                           *
+ *****************************************************************************
+ *                                                                           *
+ *   Method HINV approximates the inverse CDF by Hermite interpolation.      *
+ *   Its setup splits the domain from left to right: each interval is        *
+ *   halved until the estimated u-error |CDF(H(m)) - U(m)| at the midpoint   *
+ *   m is below the requested u-resolution. This requires one call to the    *
+ *   CDF for every interval and every new construction point. When the CDF   *
+ *   is an R function or expensive to compute (e.g., by numerical            *
+ *   integration), the setup is dominated by these calls.                    *
+ *                                                                           *
+ *   Here we run the setup incrementally instead. We start with the coarse   *
+ *   table of a HINV generator object (order 1, u-resolution 1.e-2). All     *
+ *   intervals whose estimated u-error is too large are stored in a          *
+ *   priority queue (max-heap) keyed on this error. Intervals that must be   *
+ *   split anyway (too long or not monotone) have highest priority. In each  *
+ *   step a batch of the worst intervals is refined simultaneously: the new  *
+ *   construction points are computed for all of them, and then the CDF      *
+ *   and PDF are evaluated for the whole array of points (by a single call   *
+ *   to the R function if given as such, see _Runuran_cont_eval_cdf_array()  *
+ *   and _Runuran_cont_eval_pdf_array()). The same holds for the error       *
+ *   estimates of the new intervals. The splitting rule and the error        *
+ *   criterion are the same as for method HINV.                              *
+ *                                                                           *
+ *   As the worst intervals are refined first, the setup can be stopped at   *
+ *   any time with a valid table. This happens when the given time budget    *
+ *   is exceeded or when the table would require more memory than the given  *
+ *   budget. Then the u-resolution of the generator object is set to the     *
+ *   estimated u-error that has been achieved.                               *
+ *                                                                           *
+ *   The result is an ordinary HINV generator object. Thus it can be         *
+ *   cloned, packed, and used with unur_reinit() (which runs the standard    *
+ *   setup).                                                                 *
+ *                                                                           *
+ *****************************************************************************/
+
+/*---------------------------------------------------------------------------*/
+
+#include "Runuran.h"
+
+/* internal header files for UNU.RAN */
+#include <unur_source.h>
+#include <distr/distr_source.h>
+#include <methods/hinv_struct.h>
+#include <time.h>
+
+/*---------------------------------------------------------------------------*/
+
+#define HINV_ADAPT_BATCH       (64)
+/* maximal number of intervals that are refined simultaneously */
+
+#define HINV_ADAPT_SHELL_URES  (1.e-2)
+/* u-resolution for coarse table of initial generator object */
+
+/* constants (copied from methods/hinv.c) */
+#define HINV_MAX_ITER           (300)
+#define HINV_MAX_U_LENGTH       (0.05)
+#define HINV_TAILCUTOFF_FACTOR  (0.1)
+#define HINV_TAILCUTOFF_MIN     (1.e-10)
+#define HINV_UERROR_CORRECTION  (1.-HINV_TAILCUTOFF_FACTOR)
+#define HINV_XDEVIATION         (0.05)
+
+/*---------------------------------------------------------------------------*/
+
+/* construction point; the interval [node, next node] is stored with its     */
+/* left boundary                                                             */
+struct hinv_adapt_node {
+  double p;                 /* construction point                            */
+  double u;                 /* CDF(p)                                        */
+  double f;                 /* PDF(p)                                        */
+  double df;                /* derivative of PDF at p                        */
+  double spline[UNUR_HINV_MAX_ORDER+1]; /* coefficients of polynomial        */
+  double x;                 /* approximate inverse CDF at midpoint           */
+  double Fx;                /* CDF(x)                                        */
+  double err;               /* estimated u-error in interval                 */
+  int must;                 /* whether interval must be split                */
+  int next;                 /* index of next node (-1 for last node)         */
+};
+
+struct hinv_adapt_work {
+  struct hinv_adapt_node *node; /* array of nodes                            */
+  int n_node;               /* number of used entries in array of nodes      */
+  int n_alloc;              /* size of arrays                                */
+  int first;                /* index of first node                           */
+  int N;                    /* number of nodes in table                      */
+  int *heap;                /* priority queue of intervals (max-heap)        */
+  int n_heap;               /* number of intervals in queue                  */
+  int *todo;                /* intervals with unknown u-error                */
+  int n_todo;               /* number of such intervals                      */
+  int *idx;                 /* work arrays for batch evaluation              */
+  double *x;
+  double *y;
+  double max_err;           /* maximal u-error of accepted intervals         */
+  int short_iv;             /* whether there are very short intervals        */
+};
+
+/*---------------------------------------------------------------------------*/
+
+static int _hinv_adapt_table (struct unur_gen *gen, int order, double ures,
+			      double max_time, int max_ivs, double *uerror);
+/*---------------------------------------------------------------------------*/
+/* Compute table of generator object.                                        */
+/*---------------------------------------------------------------------------*/
+
+static int _hinv_adapt_init_nodes (struct unur_gen *gen, struct hinv_adapt_work *w,
+				   int order, double ures);
+/*---------------------------------------------------------------------------*/
+/* Get construction points from coarse table and extend tails.               */
+/*---------------------------------------------------------------------------*/
+
+static int _hinv_adapt_estimate (struct unur_gen *gen, struct hinv_adapt_work *w);
+/*---------------------------------------------------------------------------*/
+/* Estimate u-errors of new intervals and insert them into queue.            */
+/*---------------------------------------------------------------------------*/
+
+static int _hinv_adapt_split (struct unur_gen *gen, struct hinv_adapt_work *w, int m);
+/*---------------------------------------------------------------------------*/
+/* Split the m intervals with largest u-errors.                              */
+/*---------------------------------------------------------------------------*/
+
+static void _hinv_adapt_linear (struct unur_gen *gen, struct hinv_adapt_work *w);
+/*---------------------------------------------------------------------------*/
+/* Use linear interpolation in remaining intervals where this is better.    */
+/*---------------------------------------------------------------------------*/
+
+static int _hinv_adapt_eval_nodes (struct unur_gen *gen, struct hinv_adapt_work *w,
+				   const int *idx, int n, int n_cdf);
+/*---------------------------------------------------------------------------*/
+/* Evaluate CDF, PDF, and derivative of PDF at new construction points.      */
+/*---------------------------------------------------------------------------*/
+
+static void _hinv_adapt_CDF (struct unur_gen *gen, const double *x, double *u, int n);
+/*---------------------------------------------------------------------------*/
+/* Evaluate (normalized) CDF for an array of points.                         */
+/*---------------------------------------------------------------------------*/
+
+static int _hinv_adapt_new_node (struct hinv_adapt_work *w);
+/*---------------------------------------------------------------------------*/
+/* Get new node (reallocate arrays if necessary).                            */
+/*---------------------------------------------------------------------------*/
+
+static void _hinv_adapt_parameter (struct unur_gen *gen, struct hinv_adapt_work *w, int i);
+/*---------------------------------------------------------------------------*/
+/* Compute coefficients of interpolating polynomial.                         */
+/*---------------------------------------------------------------------------*/
+
+static int _hinv_adapt_is_monotone (struct unur_gen *gen, struct hinv_adapt_work *w, int i);
+/*---------------------------------------------------------------------------*/
+/* Check whether interpolating polynomial is monotone.                       */
+/*---------------------------------------------------------------------------*/
+
+static double _hinv_adapt_eval_polynomial (double x, const double *coeff, int order);
+/*---------------------------------------------------------------------------*/
+/* Evaluate interpolating polynomial.                                        */
+/*---------------------------------------------------------------------------*/
+
+static void _hinv_adapt_heap_push (struct hinv_adapt_work *w, int i);
+static int _hinv_adapt_heap_pop (struct hinv_adapt_work *w);
+/*---------------------------------------------------------------------------*/
+/* Insert interval into priority queue / remove interval with largest error. */
+/*---------------------------------------------------------------------------*/
+
+static void _hinv_adapt_make_guide_table (struct unur_gen *gen);
+/*---------------------------------------------------------------------------*/
+/* Make guide table for indexed search.                                      */
+/*---------------------------------------------------------------------------*/
+
+/*---------------------------------------------------------------------------*/
+
+#define PAR    ((struct unur_hinv_par*)par->datap)
+#define GEN    ((struct unur_hinv_gen*)gen->datap)
+#define DISTR  (gen->distr->data.cont)
+/* data for parameter object, generator object, and distribution */
+
+#define dPDF(x) (_unur_cont_dPDF((x),(gen->distr))/(GEN->CDFmax-GEN->CDFmin))
+/* derivative of normalized PDF (copied from methods/hinv.c) */
+
+/* priority of interval in queue */
+#define KEY(i)  (w->node[(i)].err + ((w->node[(i)].must) ? 2. : 0.))
+
+/*****************************************************************************/
+
+SEXP
+Runuran_hinv_adapt (SEXP sexp_obj, SEXP sexp_distr, SEXP sexp_order,
+		    SEXP sexp_ures, SEXP sexp_time, SEXP sexp_memory)
+     /*----------------------------------------------------------------------*/
+     /* Create UNU.RAN generator object for method HINV with incremental     */
+     /* setup.                                                               */
+     /*                                                                      */
+     /* Parameters:                                                          */
+     /*   obj    ... S4 class that contains 'Runuran' generator object       */
+     /*   distr  ... pointer to UNU.RAN distribution object                  */
+     /*   order  ... order of interpolating polynomials                      */
+     /*   ures   ... maximal tolerated u-error                               */
+     /*   time   ... time budget for setup (in seconds)                      */
+     /*   memory ... memory budget for table (in MB)                         */
+     /*                                                                      */
+     /* Return:                                                              */
+     /*   pointer to UNU.RAN generator object                                */
+     /*----------------------------------------------------------------------*/
+{
+  struct unur_distr *distr;
+  struct unur_par *par;
+  struct unur_gen *gen;
+  int order, max_ivs, rcode;
+  double ures, max_time, memory, uerror;
+  SEXP sexp_gen;
+  SEXP sexp_is_inversion;
+
+  /* check arguments */
+  CHECK_DISTR_PTR(sexp_distr);
+  distr = R_ExternalPtrAddr(sexp_distr);
+  if (distr == NULL || unur_distr_get_type(distr) != UNUR_DISTR_CONT)
+    Rf_errorcall(R_NilValue,"[UNU.RAN - error] invalid argument 'distr'");
+
+  max_time = Rf_asReal(sexp_time);
+  if (ISNAN(max_time) || max_time < 0.)
+    Rf_errorcall(R_NilValue,"[UNU.RAN - error] invalid argument 'time'");
+  memory = Rf_asReal(sexp_memory);
+  if (ISNAN(memory) || memory < 0.)
+    Rf_errorcall(R_NilValue,"[UNU.RAN - error] invalid argument 'memory'");
+
+  /* parameter object (parameters are checked by UNU.RAN) */
+  par = unur_hinv_new(distr);
+  if (par == NULL)
+    Rf_errorcall(R_NilValue,"[UNU.RAN - error] cannot create UNU.RAN object");
+  if (unur_hinv_set_order(par, Rf_asInteger(sexp_order)) != UNUR_SUCCESS) {
+    unur_par_free(par);
+    Rf_errorcall(R_NilValue,"[UNU.RAN - error] invalid argument 'order' (order 3 requires PDF, order 5 requires dPDF)");
+  }
+  if (unur_hinv_set_u_resolution(par, Rf_asReal(sexp_ures)) != UNUR_SUCCESS) {
+    unur_par_free(par);
+    Rf_errorcall(R_NilValue,"[UNU.RAN - error] invalid argument 'uresolution'");
+  }
+  order = PAR->order;
+  ures = PAR->u_resolution;
+
+  /* maximal number of construction points within memory budget */
+  max_ivs = PAR->max_ivs;
+  memory *= 1048576. / ((order+2) * sizeof(double) + PAR->guide_factor * sizeof(int));
+  if (memory < max_ivs)
+    max_ivs = (int) memory;
+
+  /* generator object with coarse table */
+  PAR->order = 1;
+  PAR->u_resolution = HINV_ADAPT_SHELL_URES;
+  gen = unur_init(par);
+  if (gen == NULL)
+    Rf_errorcall(R_NilValue,"[UNU.RAN - error] cannot create UNU.RAN object");
+
+  /* compute table */
+  rcode = _hinv_adapt_table(gen, order, ures, max_time, max_ivs, &uerror);
+  if (rcode != UNUR_SUCCESS && rcode != UNUR_ERR_GEN_CONDITION) {
+    unur_free(gen);
+    Rf_errorcall(R_NilValue,"[UNU.RAN - error] cannot create UNU.RAN object");
+  }
+
+  /* setup stopped by budget: store estimated u-error */
+  if (rcode == UNUR_ERR_GEN_CONDITION)
+    GEN->u_resolution = _unur_max(ures, uerror);
+
+  /* we have an inversion method */
+  PROTECT(sexp_is_inversion = Rf_allocVector(LGLSXP, 1));
+  LOGICAL(sexp_is_inversion)[0] = TRUE;
+  R_do_slot_assign(sexp_obj, Rf_install("inversion"), sexp_is_inversion);
+
+  /* make R external pointer and store pointer to structure */
+  PROTECT(sexp_gen = R_MakeExternalPtr(gen, _Runuran_tag(), sexp_obj));
+
+  /* register destructor as C finalizer */
+  R_RegisterCFinalizer(sexp_gen, _Runuran_free);
+
+  if (rcode == UNUR_ERR_GEN_CONDITION)
+    Rf_warningcall(R_NilValue,"[UNU.RAN - warning] setup stopped by time or memory budget: estimated u-error = %g", uerror);
+
+  /* return pointer to R */
+  UNPROTECT(2);
+  return (sexp_gen);
+
+} /* end of Runuran_hinv_adapt() */
+
+/*---------------------------------------------------------------------------*/
+
+int
+_hinv_adapt_table (struct unur_gen *gen, int order, double ures,
+		   double max_time, int max_ivs, double *uerror)
+     /*----------------------------------------------------------------------*/
+     /* Compute table of generator object.                                   */
+     /* The coarse table of 'gen' is replaced.                               */
+     /*                                                                      */
+     /* Parameters:                                                          */
+     /*   gen      ... pointer to generator object (with coarse table)       */
+     /*   order    ... order of interpolating polynomials                    */
+     /*   ures     ... maximal tolerated u-error                             */
+     /*   max_time ... time budget (in seconds)                              */
+     /*   max_ivs  ... maximal number of construction points                 */
+     /*   uerror   ... pointer for storing estimated u-error                 */
+     /*                                                                      */
+     /* Return:                                                              */
+     /*   UNUR_SUCCESS if u-resolution is reached                            */
+     /*   UNUR_ERR_GEN_CONDITION if setup is stopped by budget               */
+     /*   error code otherwise                                               */
+     /*----------------------------------------------------------------------*/
+{
+  struct hinv_adapt_work w;
+  clock_t start;
+  int i, k, m, stride;
+  int stopped = FALSE;
+  int rcode;
+
+  start = clock();
+
+  /* construction points */
+  memset(&w, 0, sizeof(struct hinv_adapt_work));
+  if ((rcode = _hinv_adapt_init_nodes(gen, &w, order, ures)) != UNUR_SUCCESS)
+    return rcode;
+
+  /* the u-errors of all intervals are unknown */
+  for (i=w.first; w.node[i].next >= 0; i=w.node[i].next)
+    w.todo[w.n_todo++] = i;
+
+  while (TRUE) {
+    /* estimate u-errors of new intervals */
+    if ((rcode = _hinv_adapt_estimate(gen, &w)) != UNUR_SUCCESS)
+      return rcode;
+
+    /* all intervals accepted ? */
+    if (w.n_heap == 0)
+      break;
+
+    /* check budgets */
+    m = _unur_min(HINV_ADAPT_BATCH, w.n_heap);
+    m = _unur_min(m, max_ivs - w.N);
+    if (m <= 0 || (double)(clock() - start) / CLOCKS_PER_SEC > max_time) {
+      stopped = TRUE;
+      break;
+    }
+
+    /* refine worst intervals */
+    if ((rcode = _hinv_adapt_split(gen, &w, m)) != UNUR_SUCCESS)
+      return rcode;
+  }
+
+  if (w.short_iv)
+    _unur_warning(gen->genid,UNUR_ERR_ROUNDOFF,
+		  "one or more intervals very short; possibly due to numerical problems with a pole or very flat tail");
+
+  /* setup stopped: the table must be monotone */
+  if (stopped && GEN->order > 1)
+    _hinv_adapt_linear(gen, &w);
+
+  /* estimated u-error */
+  *uerror = w.max_err;
+  for (k=0; k<w.n_heap; k++)
+    *uerror = _unur_max(*uerror, w.node[w.heap[k]].err);
+
+  /* store table in generator object */
+  stride = GEN->order+2;
+  GEN->intervals = _unur_xrealloc(GEN->intervals, w.N * stride * sizeof(double));
+  for (i=w.first, k=0; i>=0; i=w.node[i].next, k+=stride) {
+    if (w.node[i].next < 0) {
+      /* last construction point */
+      memset(w.node[i].spline, 0, (UNUR_HINV_MAX_ORDER+1)*sizeof(double));
+      w.node[i].spline[0] = w.node[i].p;
+      GEN->bright = w.node[i].p;
+    }
+    GEN->intervals[k] = w.node[i].u;
+    memcpy(GEN->intervals+(k+1), w.node[i].spline, (GEN->order+1)*sizeof(double));
+  }
+  GEN->N = w.N;
+  GEN->bleft = w.node[w.first].p;
+  GEN->Umin = _unur_max(0.,GEN->intervals[0]);
+  GEN->Umax = _unur_min(1.,GEN->intervals[(GEN->N-1)*stride]);
+  _hinv_adapt_make_guide_table(gen);
+
+  return (stopped) ? UNUR_ERR_GEN_CONDITION : UNUR_SUCCESS;
+
+} /* end of _hinv_adapt_table() */
+
+/*---------------------------------------------------------------------------*/
+
+int
+_hinv_adapt_init_nodes (struct unur_gen *gen, struct hinv_adapt_work *w,
+			int order, double ures)
+     /*----------------------------------------------------------------------*/
+     /* Get construction points from coarse table of generator object and    */
+     /* extend tails when the requested u-resolution requires this.          */
+     /*                                                                      */
+     /* Parameters:                                                          */
+     /*   gen   ... pointer to generator object (with coarse table)          */
+     /*   w     ... work space                                               */
+     /*   order ... order of interpolating polynomials                       */
+     /*   ures  ... maximal tolerated u-error                                */
+     /*                                                                      */
+     /* Return:                                                              */
+     /*   error code                                                         */
+     /*----------------------------------------------------------------------*/
+{
+  int i, k, n, stride;
+  double tailcutoff, x;
+  int *idx;
+
+  /* construction points of coarse table */
+  n = GEN->N;
+  stride = GEN->order+2;
+  for (i=0; i<n; i++) {
+    k = _hinv_adapt_new_node(w);
+    w->node[k].p = GEN->intervals[i*stride+1];
+    w->node[k].u = GEN->intervals[i*stride];
+    w->node[k].next = (i<n-1) ? k+1 : -1;
+  }
+  w->first = 0;
+  w->N = n;
+
+  /* requested order and u-resolution */
+  GEN->order = order;
+  GEN->u_resolution = ures;
+
+  /* cut-off points for tails (copied from methods/hinv.c) */
+  tailcutoff = _unur_min(HINV_TAILCUTOFF_MIN, HINV_TAILCUTOFF_FACTOR * GEN->u_resolution);
+  tailcutoff = _unur_max(tailcutoff, 2*DBL_EPSILON);
+  if (GEN->tailcutoff_left >= 0.)
+    GEN->tailcutoff_left = tailcutoff;
+  if (GEN->tailcutoff_right <= 1.)
+    GEN->tailcutoff_right = 1. - tailcutoff;
+
+  /* extend left tail (search as in methods/hinv.c) */
+  if (GEN->tailcutoff_left >= 0. && w->node[w->first].u > GEN->tailcutoff_left) {
+    x = w->node[w->first].p;
+    for (i=0; i<HINV_MAX_ITER; i++) {
+      if (DISTR.domain[0] <= -UNUR_INFINITY) {
+	x = (x > -1.) ? -1. : 10.*x;
+	if (! _unur_isfinite(x) ) { i = HINV_MAX_ITER; break; }
+      }
+      else {
+	x = _unur_arcmean(x, DISTR.domain[0]);
+	if (_unur_FP_equal(x,DISTR.domain[0])) { i = HINV_MAX_ITER; break; }
+      }
+      k = _hinv_adapt_new_node(w);
+      w->node[k].p = x;
+      _hinv_adapt_CDF(gen, &x, &(w->node[k].u), 1);
+      w->node[k].next = w->first;
+      w->first = k;
+      ++(w->N);
+      if (w->node[k].u <= GEN->tailcutoff_left)
+	break;
+    }
+    if (i >= HINV_MAX_ITER)
+      _unur_warning(gen->genid,UNUR_ERR_DISTR_PROP,"cannot find l.h.s. of domain");
+  }
+
+  /* extend right tail */
+  for (k=w->first; w->node[k].next >= 0; k=w->node[k].next) ;
+  if (GEN->tailcutoff_right <= 1. && w->node[k].u < GEN->tailcutoff_right) {
+    x = w->node[k].p;
+    for (i=0; i<HINV_MAX_ITER; i++) {
+      if (DISTR.domain[1] >= UNUR_INFINITY) {
+	x = (x < 1.) ? 1. : 10.*x;
+	if (! _unur_isfinite(x) ) { i = HINV_MAX_ITER; break; }
+      }
+      else {
+	x = _unur_arcmean(x, DISTR.domain[1]);
+	if (_unur_FP_equal(x,DISTR.domain[1])) { i = HINV_MAX_ITER; break; }
+      }
+      n = k;
+      k = _hinv_adapt_new_node(w);
+      w->node[k].p = x;
+      _hinv_adapt_CDF(gen, &x, &(w->node[k].u), 1);
+      w->node[k].next = -1;
+      w->node[n].next = k;
+      ++(w->N);
+      if (w->node[k].u >= GEN->tailcutoff_right)
+	break;
+    }
+    if (i >= HINV_MAX_ITER)
+      _unur_warning(gen->genid,UNUR_ERR_DISTR_PROP,"cannot find r.h.s. of domain");
+  }
+
+  /* PDF at construction points */
+  idx = (int *) R_alloc(w->n_node, sizeof(int));
+  for (i=0; i<w->n_node; i++)
+    idx[i] = i;
+  return _hinv_adapt_eval_nodes(gen, w, idx, w->n_node, 0);
+
+} /* end of _hinv_adapt_init_nodes() */
+
+/*---------------------------------------------------------------------------*/
+
+int
+_hinv_adapt_estimate (struct unur_gen *gen, struct hinv_adapt_work *w)
+     /*----------------------------------------------------------------------*/
+     /* Compute interpolating polynomials for intervals in 'todo' list and   */
+     /* estimate their u-errors. Intervals where the u-resolution is not     */
+     /* reached are inserted into priority queue.                            */
+     /*                                                                      */
+     /* Parameters:                                                          */
+     /*   gen ... pointer to generator object                                */
+     /*   w   ... work space                                                 */
+     /*                                                                      */
+     /* Return:                                                              */
+     /*   error code                                                         */
+     /*----------------------------------------------------------------------*/
+{
+  struct hinv_adapt_node *iv, *next;
+  double p_new;
+  int i, k, m;
+
+  for (k=0, m=0; k<w->n_todo; k++) {
+    i = w->todo[k];
+    iv = w->node+i;
+    next = w->node+iv->next;
+
+    _hinv_adapt_parameter(gen, w, i);
+
+    /* interval too short: accept it */
+    p_new = 0.5 * (next->p + iv->p);
+    if (_unur_FP_equal(p_new,iv->p) || _unur_FP_equal(p_new,next->p)) {
+      w->short_iv = TRUE;
+      continue;
+    }
+
+    /* intervals that must be split anyway */
+    iv->must = ( (next->u - iv->u > HINV_MAX_U_LENGTH) ||
+		 (! _hinv_adapt_is_monotone(gen, w, i)) );
+
+    /* approximate inverse CDF at midpoint */
+    iv->x = _hinv_adapt_eval_polynomial(0.5, iv->spline, GEN->order);
+    if (_unur_isnan(iv->x)) {
+      if (iv->must) {
+	iv->err = 1.;
+	_hinv_adapt_heap_push(w, i);
+	continue;
+      }
+      _unur_error(gen->genid,UNUR_ERR_ROUNDOFF,
+		  "NaN occured; possibly due to numerical problems with a pole or very flat tail");
+      return UNUR_ERR_ROUNDOFF;
+    }
+    w->idx[m] = i;
+    w->x[m] = iv->x;
+    ++m;
+  }
+  w->n_todo = 0;
+
+  /* u-errors */
+  _hinv_adapt_CDF(gen, w->x, w->y, m);
+  for (k=0; k<m; k++) {
+    iv = w->node + w->idx[k];
+    next = w->node + iv->next;
+    iv->Fx = w->y[k];
+    iv->err = fabs(iv->Fx - 0.5*(next->u + iv->u));
+    if (_unur_isnan(iv->err)) {
+      _unur_error(gen->genid,UNUR_ERR_ROUNDOFF,
+		  "NaN occured; possibly due to numerical problems with a pole or very flat tail");
+      return UNUR_ERR_ROUNDOFF;
+    }
+    if (iv->must || !(iv->err < GEN->u_resolution * HINV_UERROR_CORRECTION))
+      _hinv_adapt_heap_push(w, w->idx[k]);
+    else
+      w->max_err = _unur_max(w->max_err, iv->err);
+  }
+
+  return UNUR_SUCCESS;
+} /* end of _hinv_adapt_estimate() */
+
+/*---------------------------------------------------------------------------*/
+
+int
+_hinv_adapt_split (struct unur_gen *gen, struct hinv_adapt_work *w, int m)
+     /*----------------------------------------------------------------------*/
+     /* Split the m intervals with largest u-errors.                         */
+     /* New intervals are appended to 'todo' list.                           */
+     /*                                                                      */
+     /* Parameters:                                                          */
+     /*   gen ... pointer to generator object                                */
+     /*   w   ... work space                                                 */
+     /*   m   ... number of intervals (at most HINV_ADAPT_BATCH)             */
+     /*                                                                      */
+     /* Return:                                                              */
+     /*   error code                                                         */
+     /*----------------------------------------------------------------------*/
+{
+  int parent[HINV_ADAPT_BATCH];    /* intervals that are split */
+  int child[HINV_ADAPT_BATCH];     /* new construction points */
+  int known[HINV_ADAPT_BATCH];     /* whether CDF of new point is known */
+  struct hinv_adapt_node *iv, *next, *c;
+  double p_new;
+  int i, j, k, n_cdf, rcode;
+
+  /* new construction points */
+  for (k=0; k<m; k++) {
+    i = parent[k] = _hinv_adapt_heap_pop(w);
+    child[k] = _hinv_adapt_new_node(w);
+    iv = w->node+i;
+    next = w->node+iv->next;
+    c = w->node+child[k];
+
+    /* use x = H(0.5) if it is close to the midpoint (as in methods/hinv.c) */
+    p_new = 0.5 * (next->p + iv->p);
+    if (!iv->must && fabs(p_new - iv->x) < HINV_XDEVIATION * (next->p - iv->p)) {
+      c->p = iv->x;
+      c->u = iv->Fx;
+      known[k] = TRUE;
+    }
+    else {
+      c->p = p_new;
+      known[k] = FALSE;
+    }
+  }
+
+  /* evaluate CDF and PDF (points with unknown CDF first) */
+  for (k=0, n_cdf=0; k<m; k++)
+    if (!known[k]) w->idx[n_cdf++] = child[k];
+  for (k=0, j=n_cdf; k<m; k++)
+    if (known[k]) w->idx[j++] = child[k];
+  if ((rcode = _hinv_adapt_eval_nodes(gen, w, w->idx, m, n_cdf)) != UNUR_SUCCESS)
+    return rcode;
+
+  /* insert new points and cut off tails (as in methods/hinv.c) */
+  for (k=0; k<m; k++) {
+    i = parent[k];
+    j = w->node[i].next;
+    c = w->node+child[k];
+    if (w->node[j].next < 0 && c->u > GEN->tailcutoff_right) {
+      /* remove last construction point */
+      c->next = -1;
+      w->node[i].next = child[k];
+      w->todo[w->n_todo++] = i;
+    }
+    else if (i == w->first && c->u < GEN->tailcutoff_left) {
+      /* remove first construction point */
+      c->next = j;
+      w->first = child[k];
+      w->todo[w->n_todo++] = child[k];
+    }
+    else {
+      c->next = j;
+      w->node[i].next = child[k];
+      ++(w->N);
+      w->todo[w->n_todo++] = i;
+      w->todo[w->n_todo++] = child[k];
+    }
+  }
+
+  return UNUR_SUCCESS;
+} /* end of _hinv_adapt_split() */
+
+/*---------------------------------------------------------------------------*/
+
+void
+_hinv_adapt_linear (struct unur_gen *gen, struct hinv_adapt_work *w)
+     /*----------------------------------------------------------------------*/
+     /* Use linear interpolation in intervals of the queue where the         */
+     /* interpolating polynomial is not monotone or where the estimated      */
+     /* u-error of linear interpolation is smaller.                          */
+     /* (Only used when the setup has been stopped by a budget.)             */
+     /*                                                                      */
+     /* Parameters:                                                          */
+     /*   gen ... pointer to generator object                                */
+     /*   w   ... work space                                                 */
+     /*----------------------------------------------------------------------*/
+{
+  struct hinv_adapt_node *iv, *next;
+  double err;
+  int i, k;
+
+  /* u-errors of linear interpolation */
+  for (k=0; k<w->n_heap; k++) {
+    iv = w->node + w->heap[k];
+    next = w->node + iv->next;
+    w->x[k] = 0.5 * (next->p + iv->p);
+  }
+  _hinv_adapt_CDF(gen, w->x, w->y, w->n_heap);
+
+  for (k=0; k<w->n_heap; k++) {
+    i = w->heap[k];
+    iv = w->node + i;
+    next = w->node + iv->next;
+    err = fabs(w->y[k] - 0.5*(next->u + iv->u));
+    if (err < iv->err || !_hinv_adapt_is_monotone(gen, w, i)) {
+      memset(iv->spline, 0, (UNUR_HINV_MAX_ORDER+1)*sizeof(double));
+      iv->spline[0] = iv->p;
+      iv->spline[1] = next->p - iv->p;
+      iv->err = err;
+    }
+  }
+} /* end of _hinv_adapt_linear() */
+
+/*---------------------------------------------------------------------------*/
+
+int
+_hinv_adapt_eval_nodes (struct unur_gen *gen, struct hinv_adapt_work *w,
+			const int *idx, int n, int n_cdf)
+     /*----------------------------------------------------------------------*/
+     /* Evaluate CDF, PDF, and derivative of PDF at new construction points. */
+     /*                                                                      */
+     /* Parameters:                                                          */
+     /*   gen   ... pointer to generator object                              */
+     /*   w     ... work space                                               */
+     /*   idx   ... indices of n nodes                                       */
+     /*   n     ... number of nodes                                          */
+     /*   n_cdf ... CDF is evaluated for the first n_cdf nodes only          */
+     /*                                                                      */
+     /* Return:                                                              */
+     /*   error code                                                         */
+     /*----------------------------------------------------------------------*/
+{
+  struct hinv_adapt_node *c;
+  int k;
+
+  for (k=0; k<n; k++)
+    w->x[k] = w->node[idx[k]].p;
+
+  /* CDF */
+  _hinv_adapt_CDF(gen, w->x, w->y, n_cdf);
+  for (k=0; k<n; k++) {
+    c = w->node+idx[k];
+    if (k < n_cdf)
+      c->u = w->y[k];
+
+    /* check CDF (as in methods/hinv.c) */
+    if (_unur_isnan(c->u)) {
+      _unur_error(gen->genid,UNUR_ERR_GEN_DATA,"CDF(x) is NaN");
+      return UNUR_ERR_GEN_DATA;
+    }
+    if (c->u < 0.) {
+      if (c->u < -UNUR_SQRT_DBL_EPSILON) {
+	_unur_error(gen->genid,UNUR_ERR_GEN_DATA,"CDF(x) < 0.");
+	return UNUR_ERR_GEN_DATA;
+      }
+      c->u = 0.;
+    }
+    if (c->u > 1.) {
+      _unur_error(gen->genid,UNUR_ERR_GEN_DATA,"CDF(x) > 1.");
+      return UNUR_ERR_GEN_DATA;
+    }
+  }
+
+  /* PDF */
+  if (GEN->order >= 3) {
+    _Runuran_cont_eval_pdf_array(w->x, n, w->y, gen->distr);
+    for (k=0; k<n; k++)
+      w->node[idx[k]].f = w->y[k] / (GEN->CDFmax - GEN->CDFmin);
+  }
+
+  /* derivative of PDF */
+  if (GEN->order >= 5) {
+    for (k=0; k<n; k++)
+      w->node[idx[k]].df = dPDF(w->x[k]);
+  }
+
+  return UNUR_SUCCESS;
+} /* end of _hinv_adapt_eval_nodes() */
+
+/*---------------------------------------------------------------------------*/
+
+void
+_hinv_adapt_CDF (struct unur_gen *gen, const double *x, double *u, int n)
+     /*----------------------------------------------------------------------*/
+     /* Evaluate (normalized) CDF for an array of points.                    */
+     /* (copied from _unur_hinv_CDF() in methods/hinv.c)                     */
+     /*                                                                      */
+     /* Parameters:                                                          */
+     /*   gen ... pointer to generator object                                */
+     /*   x   ... array of n points                                          */
+     /*   u   ... array for storing values of CDF                            */
+     /*   n   ... number of points                                           */
+     /*----------------------------------------------------------------------*/
+{
+  int i;
+
+  if (n <= 0) return;
+
+  _Runuran_cont_eval_cdf_array(x, n, u, gen->distr);
+
+  for (i=0; i<n; i++) {
+    if (x[i] <= DISTR.domain[0])
+      u[i] = 0.;
+    else if (x[i] >= DISTR.domain[1])
+      u[i] = 1.;
+    else {
+      u[i] = (u[i] - GEN->CDFmin) / (GEN->CDFmax - GEN->CDFmin);
+      if (u[i]>1. && _unur_FP_equal(u[i],1.))
+	u[i] = 1.;
+    }
+  }
+} /* end of _hinv_adapt_CDF() */
+
+/*---------------------------------------------------------------------------*/
+
+int
+_hinv_adapt_new_node (struct hinv_adapt_work *w)
+     /*----------------------------------------------------------------------*/
+     /* Get new node. The work arrays are enlarged when necessary.           */
+     /* They are allocated by R_alloc() and thus freed on exit of .Call().   */
+     /*                                                                      */
+     /* Parameters:                                                          */
+     /*   w ... work space                                                   */
+     /*                                                                      */
+     /* Return:                                                              */
+     /*   index of new node                                                  */
+     /*----------------------------------------------------------------------*/
+{
+  int n_alloc;
+  struct hinv_adapt_node *node;
+  int *heap, *todo, *idx;
+
+  if (w->n_node >= w->n_alloc) {
+    n_alloc = (w->n_alloc > 0) ? 2 * w->n_alloc : 1024;
+
+    node = (struct hinv_adapt_node *) R_alloc(n_alloc, sizeof(struct hinv_adapt_node));
+    heap = (int *) R_alloc(n_alloc, sizeof(int));
+    todo = (int *) R_alloc(n_alloc, sizeof(int));
+    idx  = (int *) R_alloc(n_alloc, sizeof(int));
+    if (w->n_alloc > 0) {
+      memcpy(node, w->node, w->n_alloc * sizeof(struct hinv_adapt_node));
+      memcpy(heap, w->heap, w->n_alloc * sizeof(int));
+      memcpy(todo, w->todo, w->n_alloc * sizeof(int));
+    }
+    w->node = node;
+    w->heap = heap;
+    w->todo = todo;
+    w->idx  = idx;
+    w->x = (double *) R_alloc(n_alloc, sizeof(double));
+    w->y = (double *) R_alloc(n_alloc, sizeof(double));
+    w->n_alloc = n_alloc;
+  }
+
+  memset(w->node + w->n_node, 0, sizeof(struct hinv_adapt_node));
+  return (w->n_node)++;
+} /* end of _hinv_adapt_new_node() */
+
+/*---------------------------------------------------------------------------*/
+
+void
+_hinv_adapt_parameter (struct unur_gen *gen, struct hinv_adapt_work *w, int i)
+     /*----------------------------------------------------------------------*/
+     /* Compute coefficients of interpolating polynomial for interval i.     */
+     /* (copied from _unur_hinv_interval_parameter() in methods/hinv.c)      */
+     /*                                                                      */
+     /* Parameters:                                                          */
+     /*   gen ... pointer to generator object                                */
+     /*   w   ... work space                                                 */
+     /*   i   ... index of left boundary of interval                         */
+     /*----------------------------------------------------------------------*/
+{
+  struct hinv_adapt_node *iv = w->node+i;
+  struct hinv_adapt_node *next = w->node+iv->next;
+  double delta_u, delta_p;
+  double f1, fs0, fs1, fss0, fss1;
+
+  delta_u = next->u - iv->u;
+  delta_p = next->p - iv->p;
+
+  switch (GEN->order) {
+  case 5:
+    if (iv->f > 0. && next->f > 0. &&
+	iv->df < UNUR_INFINITY && iv->df > -UNUR_INFINITY &&
+	next->df < UNUR_INFINITY && next->df > -UNUR_INFINITY ) {
+      f1   = delta_p;
+      fs0  = delta_u / iv->f;
+      fs1  = delta_u / next->f;
+      fss0 = -delta_u * delta_u * iv->df / (iv->f * iv->f * iv->f);
+      fss1 = -delta_u * delta_u * next->df / (next->f * next->f * next->f);
+      iv->spline[0] = iv->p;
+      iv->spline[1] = fs0;
+      iv->spline[2] = 0.5*fss0;
+      iv->spline[3] = 10.*f1 - 6.*fs0 - 4.*fs1 - 1.5*fss0 + 0.5*fss1;
+      iv->spline[4] = -15.*f1 + 8.*fs0 + 7.*fs1 + 1.5*fss0 - fss1;
+      iv->spline[5] = 6.*f1 - 3.*fs0 - 3.*fs1 - 0.5*fss0 + 0.5*fss1;
+      return;
+    }
+    else {
+      iv->spline[4] = 0.;
+      iv->spline[5] = 0.;
+    }
+    /* FALLTHROUGH */
+  case 3:
+    if (iv->f > 0. && next->f > 0.) {
+      iv->spline[0] = iv->p;
+      iv->spline[1] = delta_u / iv->f;
+      iv->spline[2] = 3.* delta_p - delta_u * (2./iv->f + 1./next->f);
+      iv->spline[3] = -2.* delta_p + delta_u * (1./iv->f + 1./next->f);
+      return;
+    }
+    else {
+      iv->spline[2] = 0.;
+      iv->spline[3] = 0.;
+    }
+    /* FALLTHROUGH */
+  case 1:
+  default:
+    iv->spline[0] = iv->p;
+    iv->spline[1] = delta_p;
+  }
+} /* end of _hinv_adapt_parameter() */
+
+/*---------------------------------------------------------------------------*/
+
+int
+_hinv_adapt_is_monotone (struct unur_gen *gen, struct hinv_adapt_work *w, int i)
+     /*----------------------------------------------------------------------*/
+     /* Check whether interpolating polynomial for interval i is monotone.   */
+     /* (copied from _unur_hinv_interval_is_monotone() in methods/hinv.c)    */
+     /*                                                                      */
+     /* Parameters:                                                          */
+     /*   gen ... pointer to generator object                                */
+     /*   w   ... work space                                                 */
+     /*   i   ... index of left boundary of interval                         */
+     /*                                                                      */
+     /* Return:                                                              */
+     /*   TRUE if monotone, FALSE otherwise                                  */
+     /*----------------------------------------------------------------------*/
+{
+  struct hinv_adapt_node *iv = w->node+i;
+  struct hinv_adapt_node *next = w->node+iv->next;
+  double bound;
+
+  switch (GEN->order) {
+  case 5:
+  case 3:
+    if (_unur_iszero(iv->u) || _unur_FP_approx(iv->u,next->u))
+      return TRUE;
+    bound = 3.*(next->p - iv->p)/(next->u - iv->u);
+    return (1./next->f > bound || 1./iv->f > bound) ? FALSE : TRUE;
+  case 1:
+  default:
+    return TRUE;
+  }
+} /* end of _hinv_adapt_is_monotone() */
+
+/*---------------------------------------------------------------------------*/
+
+double
+_hinv_adapt_eval_polynomial (double x, const double *coeff, int order)
+     /*----------------------------------------------------------------------*/
+     /* Evaluate interpolating polynomial (Horner scheme).                   */
+     /* (copied from _unur_hinv_eval_polynomial() in methods/hinv.c)         */
+     /*                                                                      */
+     /* Parameters:                                                          */
+     /*   x     ... argument                                                 */
+     /*   coeff ... coefficients of polynomial                               */
+     /*   order ... order of polynomial                                      */
+     /*                                                                      */
+     /* Return:                                                              */
+     /*   value of polynomial                                                */
+     /*----------------------------------------------------------------------*/
+{
+  int i;
+  double poly;
+
+  poly = coeff[order];
+  for (i=order-1; i>=0; i--)
+    poly = x*poly + coeff[i];
+
+  return poly;
+} /* end of _hinv_adapt_eval_polynomial() */
+
+/*---------------------------------------------------------------------------*/
+
+void
+_hinv_adapt_heap_push (struct hinv_adapt_work *w, int i)
+     /*----------------------------------------------------------------------*/
+     /* Insert interval into priority queue.                                 */
+     /*                                                                      */
+     /* Parameters:                                                          */
+     /*   w ... work space                                                   */
+     /*   i ... index of left boundary of interval                           */
+     /*----------------------------------------------------------------------*/
+{
+  int k, parent;
+  double key = KEY(i);
+
+  /* sift up */
+  for (k = (w->n_heap)++; k > 0; k = parent) {
+    parent = (k-1)/2;
+    if (KEY(w->heap[parent]) >= key) break;
+    w->heap[k] = w->heap[parent];
+  }
+  w->heap[k] = i;
+} /* end of _hinv_adapt_heap_push() */
+
+/*---------------------------------------------------------------------------*/
+
+int
+_hinv_adapt_heap_pop (struct hinv_adapt_work *w)
+     /*----------------------------------------------------------------------*/
+     /* Remove interval with largest priority from queue.                    */
+     /*                                                                      */
+     /* Parameters:                                                          */
+     /*   w ... work space                                                   */
+     /*                                                                      */
+     /* Return:                                                              */
+     /*   index of left boundary of interval                                 */
+     /*----------------------------------------------------------------------*/
+{
+  int top, last, k, child;
+  double key;
+
+  top = w->heap[0];
+  last = w->heap[--(w->n_heap)];
+  key = KEY(last);
+
+  /* sift down */
+  for (k=0; (child = 2*k+1) < w->n_heap; k = child) {
+    if (child+1 < w->n_heap && KEY(w->heap[child+1]) > KEY(w->heap[child]))
+      ++child;
+    if (key >= KEY(w->heap[child])) break;
+    w->heap[k] = w->heap[child];
+  }
+  w->heap[k] = last;
+
+  return top;
+} /* end of _hinv_adapt_heap_pop() */
+
+/*---------------------------------------------------------------------------*/
+
+void
+_hinv_adapt_make_guide_table (struct unur_gen *gen)
+     /*----------------------------------------------------------------------*/
+     /* Make guide table for indexed search.                                 */
+     /* (copied from _unur_hinv_make_guide_table() in methods/hinv.c)        */
+     /*                                                                      */
+     /* Parameters:                                                          */
+     /*   gen ... pointer to generator object                                */
+     /*----------------------------------------------------------------------*/
+{
+  int i,j, imax;
+
+  GEN->guide_size = (int) (GEN->N * GEN->guide_factor);
+  if (GEN->guide_size <= 0) GEN->guide_size = 1;
+  GEN->guide = _unur_xrealloc( GEN->guide, GEN->guide_size * sizeof(int) );
+
+  imax = (GEN->N-2) * (GEN->order+2);
+
+# define u(i)  (GEN->intervals[(i)+GEN->order+2])
+  i = 0;
+  GEN->guide[0] = 0;
+  for( j=1; j<GEN->guide_size ;j++ ) {
+    while( u(i) < (j/(double)GEN->guide_size) && i <= imax)
+      i += GEN->order+2;
+    if (i > imax) break;
+    GEN->guide[j]=i;
+  }
+# undef u
+
+  i = _unur_min(i,imax);
+  for( ; j<GEN->guide_size ;j++ )
+    GEN->guide[j] = i;
+} /* end of _hinv_adapt_make_guide_table() */
+
+/*---------------------------------------------------------------------------*/
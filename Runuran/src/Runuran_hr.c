@@ -0,0 +1,361 @@
+/*****************************************************************************
+ *                                                                           *
+ *          UNU.RAN -- Universal Non-Uniform Random number generator         *
+ *                                                                           *
+ *****************************************************************************
+ *                                                                           *
+ *   FILE: Runuran_hr.c                                                      *
+ *                                                                           *
+ *   PURPOSE:                                                                *
+ *         Batch routines for hazard rate methods HRB, HRD, and HRI          *
+ *                                                                           *
+ *****************************************************************************
+ *                                                                           *
+ *   Copyright (c) 2026 Wolfgang Hoermann and Josef Leydold                  *
+ *   Dept. for Statistics, University of Economics, Vienna, Austria          *
+ *                                                                           *
+ *   This program is free software; you can redistribute it and/or modify    *
+ *   it under the terms of the GNU General Public License as published by    *
+ *   the Free Software Foundation; either version 2 of the License, or       *
+ *   (at your option) any later version.                                     *
+ *                                                                           *
+ *   This program is distributed in the hope that it will be useful,         *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of          *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the           *
+ *   GNU General Public License for more details.                            *
+ *                                                                           *
+ *   You should have received a copy of the GNU General Public License       *
+ *   along with this program; if not, write to the                           *
+ *   Free Software Foundation, Inc.,                                         *
+ *   59 Temple Place, Suite 330, Boston, MA 02111-1307, USA                  *
+ *                                                                           *
+ *****************************************************************************
+ *                                                                           *
+ *   The hazard rate methods HRB, HRD, and HRI generate a random variate by  *
+ *   thinning a Poisson process: each step requires an exponential jump      *
+ *   (a call to log()), a call to the hazard rate HR(x) and a second         *
+ *   uniform random number. When HR is an R function, the call of the R      *
+ *   interpreter for a single point by far dominates the generation time.    *
+ *                                                                           *
+ *   When a sample of size n > 1 is requested, we run the thinning           *
+ *   procedures for blocks of random variates simultaneously: in each        *
+ *   round the exponential jumps are computed for all points that have not   *
+ *   been accepted yet, the hazard rate is evaluated for the whole array of  *
+ *   points (by a single call to the R function if HR is given as such, see  *
+ *   _Runuran_cont_eval_hr_array()), and the accepted points are removed     *
+ *   from the array (compaction) before the next round starts.               *
+ *                                                                           *
+ *   The generated random variates follow the same distribution as those     *
+ *   of repeated calls to unur_sample_cont(). However, they do not coincide  *
+ *   as the uniform random numbers are consumed in a different order.        *
+ *   In verifying mode the UNU.RAN routines are used.                        *
+ *                                                                           *
+ *****************************************************************************/
+
+/*---------------------------------------------------------------------------*/
+
+#include "Runuran.h"
+
+/* internal header files for UNU.RAN */
+#include <unur_source.h>
+#include <methods/hrb_struct.h>
+#include <methods/hrd_struct.h>
+#include <methods/hri_struct.h>
+
+/*---------------------------------------------------------------------------*/
+
+#define HR_BLOCKSIZE  (4096)
+/* number of random variates that are generated simultaneously */
+
+/* variant flags and maximal number of iterations */
+/* (copied from methods/hrb.c, methods/hrd.c, and methods/hri.c) */
+#define HR_VARFLAG_VERIFY     0x01u
+#define HRB_EMERGENCY_BREAK   (100000)
+#define HRI_EMERGENCY_BREAK   (10000)
+
+/*---------------------------------------------------------------------------*/
+
+/* variants of thinning procedure */
+#define HR_BOUNDED    (1)   /* constant bound for HR (HRB)                 */
+#define HR_DECREASING (2)   /* bound is updated by HR(x) (HRD)             */
+#define HR_ABORT      (3)   /* constant bound, abort after max. iterations */
+
+struct Runuran_hr_work {
+  int *idx;                 /* position of point in block                    */
+  double *x;                /* current points of Poisson processes           */
+  double *lambda;           /* rates of Poisson processes                    */
+  double *v;                /* uniform random numbers for thinning           */
+  double *p1;               /* first stage of method HRI                     */
+  double *hx;               /* values of hazard rate                         */
+  double *xe;               /* points where hazard rate is evaluated         */
+  int *ie;                  /* corresponding indices                         */
+};
+
+/*---------------------------------------------------------------------------*/
+
+static void _hr_thinning (struct unur_gen *gen, struct Runuran_hr_work *w,
+			  int m, double left, double lambda, int variant,
+			  double *X, double *hX);
+/*---------------------------------------------------------------------------*/
+/* Thinning of m Poisson processes with (initial) rate lambda.               */
+/*---------------------------------------------------------------------------*/
+
+static void _hr_hri_block (struct unur_gen *gen, struct Runuran_hr_work *w,
+			   int m, double *X);
+/*---------------------------------------------------------------------------*/
+/* Generate block of m random variates with method HRI.                      */
+/*---------------------------------------------------------------------------*/
+
+/*---------------------------------------------------------------------------*/
+
+#define HRB_GEN  ((struct unur_hrb_gen*)gen->datap)
+#define HRD_GEN  ((struct unur_hrd_gen*)gen->datap)
+#define HRI_GEN  ((struct unur_hri_gen*)gen->datap)
+
+/*****************************************************************************/
+
+void
+_Runuran_hr_sample_array (struct unur_gen *gen, double *X, int n)
+     /*----------------------------------------------------------------------*/
+     /* Sample from generator object with method HRB, HRD, or HRI            */
+     /* (batch version).                                                     */
+     /*                                                                      */
+     /* Parameters:                                                          */
+     /*   gen ... pointer to generator object                                */
+     /*   X   ... array for storing random sample                            */
+     /*   n   ... sample size                                                */
+     /*----------------------------------------------------------------------*/
+{
+  struct Runuran_hr_work w;
+  int method;
+  int i, m, size;
+
+  method = unur_get_method(gen);
+
+  /* verifying mode: use UNU.RAN routine */
+  if (gen->variant & HR_VARFLAG_VERIFY) {
+    for (i=0; i<n; i++)
+      X[i] = unur_sample_cont(gen);
+    return;
+  }
+
+  /* allocate working arrays */
+  size = (n < HR_BLOCKSIZE) ? n : HR_BLOCKSIZE;
+  w.idx    = (int *)    R_alloc(size, sizeof(int));
+  w.ie     = (int *)    R_alloc(size, sizeof(int));
+  w.x      = (double *) R_alloc(size, sizeof(double));
+  w.lambda = (double *) R_alloc(size, sizeof(double));
+  w.v      = (double *) R_alloc(size, sizeof(double));
+  w.p1     = (double *) R_alloc(size, sizeof(double));
+  w.hx     = (double *) R_alloc(size, sizeof(double));
+  w.xe     = (double *) R_alloc(size, sizeof(double));
+
+  for (i=0; i<n; i+=m) {
+    m = (n-i < HR_BLOCKSIZE) ? n-i : HR_BLOCKSIZE;
+
+    switch (method) {
+    case UNUR_METH_HRB:
+      _hr_thinning(gen, &w, m, HRB_GEN->left_border, HRB_GEN->upper_bound,
+		   HR_BOUNDED, X+i, NULL);
+      break;
+    case UNUR_METH_HRD:
+      _hr_thinning(gen, &w, m, HRD_GEN->left_border, HRD_GEN->upper_bound,
+		   HR_DECREASING, X+i, NULL);
+      break;
+    case UNUR_METH_HRI:
+      _hr_hri_block(gen, &w, m, X+i);
+      break;
+    default:
+      /* this should not happen */
+      for (m=0; i+m<n; m++)
+	X[i+m] = unur_sample_cont(gen);
+    }
+  }
+
+} /* end of _Runuran_hr_sample_array() */
+
+/*---------------------------------------------------------------------------*/
+
+void
+_hr_thinning (struct unur_gen *gen, struct Runuran_hr_work *w,
+	      int m, double left, double lambda, int variant,
+	      double *X, double *hX)
+     /*----------------------------------------------------------------------*/
+     /* Thinning of m Poisson processes with (initial) rate lambda that      */
+     /* start at 'left'. For each process the first accepted point is        */
+     /* stored in X.                                                         */
+     /*                                                                      */
+     /* Parameters:                                                          */
+     /*   gen     ... pointer to generator object                            */
+     /*   w       ... working arrays                                         */
+     /*   m       ... number of random variates                              */
+     /*   left    ... left boundary of domain                                */
+     /*   lambda  ... (initial) rate                                         */
+     /*   variant ... HR_BOUNDED | HR_DECREASING | HR_ABORT                  */
+     /*   X       ... array for storing accepted points                      */
+     /*   hX      ... array for storing HR at accepted points (or NULL)      */
+     /*----------------------------------------------------------------------*/
+{
+  double U, V;
+  int i, j, k, round;
+
+  /* all processes start at left boundary */
+  for (j=0; j<m; j++) {
+    w->idx[j] = j;
+    w->x[j] = left;
+    w->lambda[j] = lambda;
+  }
+
+  for (k=m, round=1; k>0; round++) {
+
+    /* exponential jumps */
+    for (j=0; j<k; j++) {
+      while ( _unur_iszero(U = 1.-_unur_call_urng(gen->urng)) );
+      w->v[j] = U;
+    }
+    for (j=0; j<k; j++)
+      w->x[j] += -log(w->v[j]) / w->lambda[j];
+
+    /* hazard rate for all points */
+    _Runuran_cont_eval_hr_array(w->x, k, w->hx, gen->distr);
+
+    /* thinning: accepted points are removed from array */
+    for (j=0, i=0; j<k; j++) {
+      V = w->lambda[j] * _unur_call_urng(gen->urng);
+      if (V <= w->hx[j]) {
+	/* accept */
+	X[w->idx[j]] = w->x[j];
+	if (hX) hX[w->idx[j]] = w->hx[j];
+	continue;
+      }
+
+      switch (variant) {
+      case HR_DECREASING:
+	if (w->hx[j] > 0.)
+	  w->lambda[j] = w->hx[j];
+	else {
+	  _unur_error(gen->genid,UNUR_ERR_GEN_CONDITION,"HR not valid");
+	  X[w->idx[j]] = UNUR_INFINITY;
+	  continue;
+	}
+	break;
+      case HR_BOUNDED:
+	if (round > HRB_EMERGENCY_BREAK) {
+	  _unur_warning(gen->genid,UNUR_ERR_GEN_SAMPLING,"maximum number of iterations exceeded");
+	  X[w->idx[j]] = w->x[j];
+	  if (hX) hX[w->idx[j]] = w->hx[j];
+	  continue;
+	}
+	break;
+      case HR_ABORT:
+      default:
+	if (round > HRI_EMERGENCY_BREAK) {
+	  _unur_error(gen->genid,UNUR_ERR_GEN_CONDITION,"abort computation");
+	  X[w->idx[j]] = UNUR_INFINITY;
+	  if (hX) hX[w->idx[j]] = 0.;
+	  continue;
+	}
+	break;
+      }
+
+      /* keep point for next round */
+      w->idx[i] = w->idx[j];
+      w->x[i] = w->x[j];
+      w->lambda[i] = w->lambda[j];
+      ++i;
+    }
+    k = i;
+  }
+
+} /* end of _hr_thinning() */
+
+/*---------------------------------------------------------------------------*/
+
+void
+_hr_hri_block (struct unur_gen *gen, struct Runuran_hr_work *w, int m, double *X)
+     /*----------------------------------------------------------------------*/
+     /* Generate block of m random variates with method HRI.                 */
+     /* (adapted from _unur_hri_sample() in methods/hri.c)                   */
+     /*                                                                      */
+     /* Parameters:                                                          */
+     /*   gen ... pointer to generator object                                */
+     /*   w   ... working arrays                                             */
+     /*   m   ... number of random variates                                  */
+     /*   X   ... array for storing random variates                          */
+     /*----------------------------------------------------------------------*/
+{
+  double lambda0, hrp0, p0;
+  double *hX;
+  double U;
+  int i, j, k, l, round;
+
+  lambda0 = hrp0 = HRI_GEN->hrp0;
+  p0 = HRI_GEN->p0;
+
+  /* first stage: thinning with constant rate HR(p0) */
+  /* (HR at accepted points is stored in array 'xe') */
+  hX = w->xe;
+  _hr_thinning(gen, w, m, HRI_GEN->left_border, lambda0, HR_ABORT, X, hX);
+
+  /* second stage: thinning of process with rate HR(p1) - HR(p0) that */
+  /* starts at p0 for all points p1 = X > p0.                         */
+  for (j=0, k=0; j<m; j++) {
+    if (X[j] <= p0 || hX[j] - lambda0 <= 0.)
+      continue;
+    w->lambda[k] = hX[j] - lambda0;
+    w->idx[k] = j;
+    ++k;
+  }
+  for (i=0; i<k; i++) {
+    w->x[i] = p0;
+    w->p1[i] = X[w->idx[i]];
+  }
+
+  for (round=1; k>0; round++) {
+
+    /* exponential jumps */
+    for (j=0; j<k; j++) {
+      while ( _unur_iszero(U = 1.-_unur_call_urng(gen->urng)) );
+      w->v[j] = U;
+    }
+    for (j=0; j<k; j++)
+      w->x[j] += -log(w->v[j]) / w->lambda[j];
+
+    /* we need HR only for points with V > HR(p0) */
+    for (j=0, l=0; j<k; j++) {
+      w->v[j] = lambda0 + w->lambda[j] * _unur_call_urng(gen->urng);
+      if (w->v[j] > hrp0) {
+	w->xe[l] = w->x[j];
+	w->ie[l] = j;
+	++l;
+      }
+    }
+    _Runuran_cont_eval_hr_array(w->xe, l, w->hx, gen->distr);
+    for (j=0; j<l; j++)
+      /* mark accepted points */
+      if (w->v[w->ie[j]] <= w->hx[j])
+	w->v[w->ie[j]] = hrp0;
+
+    /* accepted points are removed from array */
+    for (j=0, i=0; j<k; j++) {
+      if (w->v[j] <= hrp0) {
+	X[w->idx[j]] = (w->x[j] <= w->p1[j]) ? w->x[j] : w->p1[j];
+	continue;
+      }
+      if (round > HRI_EMERGENCY_BREAK) {
+	_unur_error(gen->genid,UNUR_ERR_GEN_CONDITION,"abort computation");
+	X[w->idx[j]] = UNUR_INFINITY;
+	continue;
+      }
+      w->idx[i] = w->idx[j];
+      w->x[i] = w->x[j];
+      w->lambda[i] = w->lambda[j];
+      w->p1[i] = w->p1[j];
+      ++i;
+    }
+    k = i;
+  }
+
+} /* end of _hr_hri_block() */
+
+/*---------------------------------------------------------------------------*/
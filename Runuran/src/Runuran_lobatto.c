@@ -0,0 +1,614 @@
+/*****************************************************************************
+ *                                                                           *
+ *          UNU.RAN -- Universal Non-Uniform Random number generator         *
+ *                                                                           *
+ *****************************************************************************
+ *                                                                           *
+ *   FILE: Runuran_lobatto.c                                                 *
+ *                                                                           *
+ *   PURPOSE:                                                                *
+ *         Reusable tables for Gauss-Lobatto integration                     *
+ *                                                                           *
+ *****************************************************************************
+ *                                                                           *
+ *   Copyright (c) 2026 Wolfgang Hoermann and Josef Leydold                  *
+ *   Dept. for Statistics, University of Economics, Vienna, Austria          *
+ *                                                                           *
+ *   This program is free software; you can redistribute it and/or modify    *
+ *   it under the terms of the GNU General Public License as published by    *
+ *   the Free Software Foundation; either version 2 of the License, or       *
+ *   (at your option) any later version.                                     *
+ *                                                                           *
+ *   This program is distributed in the hope that it will be useful,         *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of          *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the           *
+ *   GNU General Public License for more details.                            *
+ *                                                                           *
+ *   You should have received a copy of the GNU General Public License       *
+ *   along with this program; if not, write to the                           *
+ *   Free Software Foundation, Inc.,                                         *
+ *   59 Temple Place, Suite 330, Boston, MA 02111-1307, USA                  *
+ *                                                                           *
+ *****************************************************************************
+ *                                                                           *
+ *   Method PINV computes the CDF by means of adaptive Gauss-Lobatto         *
+ *   integration. The subintervals of this integration are stored in a       *
+ *   table which is discarded when the setup is completed. When a            *
+ *   generator object for the same distribution is created again (e.g.,      *
+ *   with a smaller u-resolution or another truncated domain) the            *
+ *   integration is repeated completely.                                     *
+ *                                                                           *
+ *   Thus we keep such a table together with the used tolerance in the       *
+ *   distribution object. For each subinterval it contains the boundaries,   *
+ *   the integral, the error estimate of the recursion step that accepted    *
+ *   this subinterval, and the values of the integrand at the boundaries     *
+ *   and at the center. For a new integration over some interval             *
+ *   [left,right] the stored subintervals are reused:                        *
+ *    - A subinterval that is contained in [left,right] is copied when its   *
+ *      error estimate is below the requested tolerance.                     *
+ *    - Otherwise the recursion is continued on this subinterval. Since      *
+ *      the stored values of the integrand are exactly those required by     *
+ *      the next recursion step, we only compute the integrand at the new    *
+ *      nodes inside the subinterval.                                        *
+ *    - Parts of [left,right] that are not covered by complete               *
+ *      subintervals are integrated from scratch.                            *
+ *   Thus only new subintervals at the boundaries of [left,right] have to    *
+ *   be computed when the domain is truncated or enlarged, and only the      *
+ *   subintervals that do not meet a smaller tolerance are split.            *
+ *   The recursion is the same as in UNU.RAN (utils/lobatto.c).              *
+ *                                                                           *
+ *   The table can be extracted as R list and stored into another            *
+ *   distribution object with the same PDF (e.g., in a new R session).       *
+ *                                                                           *
+ *****************************************************************************/
+
+/*---------------------------------------------------------------------------*/
+
+#include "Runuran.h"
+
+/* internal header files for UNU.RAN */
+#include <unur_source.h>
+
+/*---------------------------------------------------------------------------*/
+
+/* constants (copied from utils/lobatto.c) */
+#define W1 (0.17267316464601146)   /* = 0.5-sqrt(3/28) */
+#define W2 (1.-W1)
+#define LOBATTO_MAX_CALLS (1000000)
+
+/* names of list elements */
+static const char *lobatto_names[] = { "tol", "x", "u", "err", "fx", "fc" };
+#define LOBATTO_N_NAMES (6)
+
+/*---------------------------------------------------------------------------*/
+
+static struct Runuran_lobatto *_lobatto_alloc (int size);
+/*---------------------------------------------------------------------------*/
+/* Allocate empty table for 'size' subintervals.                             */
+/*---------------------------------------------------------------------------*/
+
+static void _lobatto_append (struct Runuran_lobatto *tab, double x, double u, double err,
+			     double fl, double fc, double fr);
+/*---------------------------------------------------------------------------*/
+/* Append subinterval with right boundary 'x' and integral 'u'.              */
+/*---------------------------------------------------------------------------*/
+
+static void _lobatto_integrate (struct Runuran_lobatto *tab, const struct Runuran_lobatto *old,
+				double (*funct)(double, struct unur_gen *), struct unur_gen *gen,
+				double a, double b, int *W_accuracy, int *n_calls);
+/*---------------------------------------------------------------------------*/
+/* Integrate over [a,b] and append subintervals to table. Subintervals of    */
+/* table 'old' are copied or refined.                                        */
+/*---------------------------------------------------------------------------*/
+
+static void _lobatto_adaptive (struct Runuran_lobatto *tab,
+			       double (*funct)(double, struct unur_gen *), struct unur_gen *gen,
+			       double x, double h, int *W_accuracy, int *n_calls);
+/*---------------------------------------------------------------------------*/
+/* Adaptive integration over [x,x+h].                                        */
+/*---------------------------------------------------------------------------*/
+
+static void _lobatto_recursion (struct Runuran_lobatto *tab,
+				double (*funct)(double, struct unur_gen *), struct unur_gen *gen,
+				double x, double h, double int1, double fl, double fc, double fr,
+				int *W_accuracy, int *n_calls);
+/*---------------------------------------------------------------------------*/
+/* Recursive step in adaptive integration (copied from utils/lobatto.c).     */
+/*---------------------------------------------------------------------------*/
+
+/*---------------------------------------------------------------------------*/
+
+#define FKT(x)  (funct((x),gen))
+
+/*****************************************************************************/
+
+struct Runuran_lobatto *
+_Runuran_lobatto_new (const struct Runuran_lobatto *old,
+		      double (*funct)(double, struct unur_gen *), struct unur_gen *gen,
+		      double left, double center, double right, double tol)
+     /*----------------------------------------------------------------------*/
+     /* Compute table for Gauss-Lobatto integration of 'funct' over          */
+     /* [left,right]. Subintervals of table 'old' are copied if their        */
+     /* error estimates are below 'tol' and refined otherwise.               */
+     /*                                                                      */
+     /* Parameters:                                                          */
+     /*   old    ... stored table (or NULL)                                  */
+     /*   funct  ... integrand                                               */
+     /*   gen    ... pointer to generator object (passed to 'funct')         */
+     /*   left   ... left boundary of integration domain                     */
+     /*   center ... point in integration domain (splitting point)           */
+     /*   right  ... right boundary of integration domain                    */
+     /*   tol    ... (absolute) tolerated error for each subinterval         */
+     /*                                                                      */
+     /* Return:                                                              */
+     /*   pointer to new table                                               */
+     /*                                                                      */
+     /* Error:                                                               */
+     /*   return NULL                                                        */
+     /*----------------------------------------------------------------------*/
+{
+  struct Runuran_lobatto *tab;
+  int W_accuracy = 0;
+  int n_calls = 0;
+
+  if (!(_unur_isfinite(left) && _unur_isfinite(right))) {
+    _unur_error(gen->genid,UNUR_ERR_INF,"boundaries of integration domain not finite");
+    return NULL;
+  }
+
+  tab = _lobatto_alloc((old) ? old->n + 100 : 1000);
+  tab->tol = tol;
+  tab->x[0] = left;
+
+  center = _unur_max(center, left);
+  center = _unur_min(center, right);
+  _lobatto_integrate(tab, old, funct, gen, left, center, &W_accuracy, &n_calls);
+  _lobatto_integrate(tab, old, funct, gen, center, right, &W_accuracy, &n_calls);
+
+  if (W_accuracy == 1)
+    _unur_warning(gen->genid,UNUR_ERR_ROUNDOFF,
+		  "numeric integration did not reach full accuracy");
+  if (W_accuracy == 2) {
+    _unur_error(gen->genid,UNUR_ERR_ROUNDOFF,
+		"adaptive numeric integration aborted (too many function calls)");
+    _Runuran_lobatto_free(tab);
+    return NULL;
+  }
+
+  return tab;
+} /* end of _Runuran_lobatto_new() */
+
+/*---------------------------------------------------------------------------*/
+
+double
+_Runuran_lobatto_integral (const struct Runuran_lobatto *tab)
+     /*----------------------------------------------------------------------*/
+     /* Get integral over whole domain of table.                             */
+     /*                                                                      */
+     /* Parameters:                                                          */
+     /*   tab ... pointer to table                                           */
+     /*                                                                      */
+     /* Return:                                                              */
+     /*   integral                                                           */
+     /*----------------------------------------------------------------------*/
+{
+  double sum = 0.;
+  int i;
+
+  for (i=0; i<tab->n; i++)
+    sum += tab->u[i];
+
+  return sum;
+} /* end of _Runuran_lobatto_integral() */
+
+/*---------------------------------------------------------------------------*/
+
+void
+_Runuran_lobatto_free (struct Runuran_lobatto *tab)
+     /*----------------------------------------------------------------------*/
+     /* Free table.                                                          */
+     /*                                                                      */
+     /* Parameters:                                                          */
+     /*   tab ... pointer to table (or NULL)                                 */
+     /*----------------------------------------------------------------------*/
+{
+  if (tab) {
+    free(tab->x);
+    free(tab->u);
+    free(tab->err);
+    free(tab->fx);
+    free(tab->fc);
+    free(tab);
+  }
+} /* end of _Runuran_lobatto_free() */
+
+/*---------------------------------------------------------------------------*/
+
+void
+_Runuran_lobatto_store (const struct unur_distr *distr, struct Runuran_lobatto *tab)
+     /*----------------------------------------------------------------------*/
+     /* Store table in distribution object.                                  */
+     /* The stored table is only replaced when the new one covers the same   */
+     /* domain and has a smaller tolerance. Otherwise, or when 'distr' is    */
+     /* not created from R functions, 'tab' is freed.                        */
+     /*                                                                      */
+     /* Parameters:                                                          */
+     /*   distr ... pointer to distribution object                           */
+     /*   tab   ... pointer to table                                         */
+     /*----------------------------------------------------------------------*/
+{
+  struct Runuran_lobatto **slot;
+  struct Runuran_lobatto *old;
+
+  if (tab == NULL) return;
+
+  slot = _Runuran_cont_lobatto_slot(distr);
+  if (slot == NULL) {
+    _Runuran_lobatto_free(tab);
+    return;
+  }
+
+  old = *slot;
+  if (old == NULL ||
+      (tab->tol <= old->tol && tab->x[0] <= old->x[0] && tab->x[tab->n] >= old->x[old->n])) {
+    _Runuran_lobatto_free(old);
+    *slot = tab;
+  }
+  else {
+    _Runuran_lobatto_free(tab);
+  }
+} /* end of _Runuran_lobatto_store() */
+
+/*---------------------------------------------------------------------------*/
+
+struct Runuran_lobatto *
+_lobatto_alloc (int size)
+     /*----------------------------------------------------------------------*/
+     /* Allocate empty table for 'size' subintervals.                        */
+     /*                                                                      */
+     /* Parameters:                                                          */
+     /*   size ... number of subintervals                                    */
+     /*                                                                      */
+     /* Return:                                                              */
+     /*   pointer to table                                                   */
+     /*----------------------------------------------------------------------*/
+{
+  struct Runuran_lobatto *tab;
+
+  tab = _unur_xmalloc(sizeof(struct Runuran_lobatto));
+  tab->tol = 0.;
+  tab->n = 0;
+  tab->size = size;
+  tab->x = _unur_xmalloc((size+1) * sizeof(double));
+  tab->u = _unur_xmalloc(size * sizeof(double));
+  tab->err = _unur_xmalloc(size * sizeof(double));
+  tab->fx = _unur_xmalloc((size+1) * sizeof(double));
+  tab->fc = _unur_xmalloc(size * sizeof(double));
+
+  return tab;
+} /* end of _lobatto_alloc() */
+
+/*---------------------------------------------------------------------------*/
+
+void
+_lobatto_append (struct Runuran_lobatto *tab, double x, double u, double err,
+		 double fl, double fc, double fr)
+     /*----------------------------------------------------------------------*/
+     /* Append subinterval with right boundary 'x' and integral 'u'.         */
+     /*                                                                      */
+     /* Parameters:                                                          */
+     /*   tab ... pointer to table                                           */
+     /*   x   ... right boundary of subinterval                              */
+     /*   u   ... integral over subinterval                                  */
+     /*   err ... error estimate for subinterval                             */
+     /*   fl  ... integrand at left boundary of subinterval                  */
+     /*   fc  ... integrand at center of subinterval                         */
+     /*   fr  ... integrand at right boundary of subinterval                 */
+     /*----------------------------------------------------------------------*/
+{
+  if (tab->n >= tab->size) {
+    tab->size *= 2;
+    tab->x = _unur_xrealloc(tab->x, (tab->size+1) * sizeof(double));
+    tab->u = _unur_xrealloc(tab->u, tab->size * sizeof(double));
+    tab->err = _unur_xrealloc(tab->err, tab->size * sizeof(double));
+    tab->fx = _unur_xrealloc(tab->fx, (tab->size+1) * sizeof(double));
+    tab->fc = _unur_xrealloc(tab->fc, tab->size * sizeof(double));
+  }
+  tab->u[tab->n] = u;
+  tab->err[tab->n] = err;
+  tab->fx[tab->n] = fl;
+  tab->fc[tab->n] = fc;
+  ++(tab->n);
+  tab->x[tab->n] = x;
+  tab->fx[tab->n] = fr;
+} /* end of _lobatto_append() */
+
+/*---------------------------------------------------------------------------*/
+
+void
+_lobatto_integrate (struct Runuran_lobatto *tab, const struct Runuran_lobatto *old,
+		    double (*funct)(double, struct unur_gen *), struct unur_gen *gen,
+		    double a, double b, int *W_accuracy, int *n_calls)
+     /*----------------------------------------------------------------------*/
+     /* Integrate over [a,b] and append subintervals to table.               */
+     /* Complete subintervals of table 'old' are copied when their error     */
+     /* estimates are below the tolerance of 'tab'. Otherwise the recursion  */
+     /* is continued with the stored values of the integrand.                */
+     /*                                                                      */
+     /* Parameters:                                                          */
+     /*   tab        ... pointer to new table                                */
+     /*   old        ... pointer to stored table (or NULL)                   */
+     /*   funct      ... integrand                                           */
+     /*   gen        ... pointer to generator object                         */
+     /*   a, b       ... boundaries of integration domain                    */
+     /*   W_accuracy ... warning code                                        */
+     /*   n_calls    ... number of recursive calls                           */
+     /*----------------------------------------------------------------------*/
+{
+  double x, xr;
+  int i;
+
+  if (!(a < b)) return;
+
+  /* no stored table or no overlap */
+  if (old == NULL || old->n == 0 || b <= old->x[0] || a >= old->x[old->n]) {
+    _lobatto_adaptive(tab, funct, gen, a, b-a, W_accuracy, n_calls);
+    return;
+  }
+
+  /* part left of stored table */
+  x = a;
+  if (x < old->x[0]) {
+    _lobatto_adaptive(tab, funct, gen, x, old->x[0]-x, W_accuracy, n_calls);
+    x = old->x[0];
+  }
+
+  /* first subinterval of stored table that contains x: x[i] <= x < x[i+1] */
+  for (i=0; i < old->n && old->x[i+1] <= x; i++) ;
+
+  /* subintervals of stored table */
+  for (; i < old->n && x < b; i++) {
+    xr = _unur_min(old->x[i+1], b);
+    if (_unur_FP_same(x, old->x[i]) && _unur_FP_same(xr, old->x[i+1])) {
+      /* complete subinterval */
+      if (old->err[i] < tab->tol)
+	_lobatto_append(tab, xr, old->u[i], old->err[i], old->fx[i], old->fc[i], old->fx[i+1]);
+      else
+	_lobatto_recursion(tab, funct, gen, x, xr-x, old->u[i],
+			   old->fx[i], old->fc[i], old->fx[i+1], W_accuracy, n_calls);
+    }
+    else
+      /* part of subinterval */
+      _lobatto_adaptive(tab, funct, gen, x, xr-x, W_accuracy, n_calls);
+    x = xr;
+  }
+
+  /* part right of stored table */
+  if (x < b)
+    _lobatto_adaptive(tab, funct, gen, x, b-x, W_accuracy, n_calls);
+
+} /* end of _lobatto_integrate() */
+
+/*---------------------------------------------------------------------------*/
+
+void
+_lobatto_adaptive (struct Runuran_lobatto *tab,
+		   double (*funct)(double, struct unur_gen *), struct unur_gen *gen,
+		   double x, double h, int *W_accuracy, int *n_calls)
+     /*----------------------------------------------------------------------*/
+     /* Adaptive integration over [x,x+h].                                   */
+     /*                                                                      */
+     /* Parameters:                                                          */
+     /*   tab        ... pointer to table                                    */
+     /*   funct      ... integrand                                           */
+     /*   gen        ... pointer to generator object                         */
+     /*   x          ... left boundary of interval                           */
+     /*   h          ... length of interval                                  */
+     /*   W_accuracy ... warning code                                        */
+     /*   n_calls    ... number of recursive calls                           */
+     /*----------------------------------------------------------------------*/
+{
+  double fl, fc, fr;
+  double int1;
+
+  if (_unur_iszero(h))
+    return;
+
+  fl = FKT(x);
+  fc = FKT(x+h/2.);
+  fr = FKT(x+h);
+  int1 = (9*(fl+fr)+49.*(FKT(x+h*W1)+FKT(x+h*W2))+64*fc)*h/180.;
+
+  _lobatto_recursion(tab, funct, gen, x, h, int1, fl, fc, fr, W_accuracy, n_calls);
+
+} /* end of _lobatto_adaptive() */
+
+/*---------------------------------------------------------------------------*/
+
+void
+_lobatto_recursion (struct Runuran_lobatto *tab,
+		    double (*funct)(double, struct unur_gen *), struct unur_gen *gen,
+		    double x, double h, double int1, double fl, double fc, double fr,
+		    int *W_accuracy, int *n_calls)
+     /*----------------------------------------------------------------------*/
+     /* Recursive step in adaptive integration.                              */
+     /* (copied from _unur_lobatto5_recursion() in utils/lobatto.c)          */
+     /*----------------------------------------------------------------------*/
+{
+  double flc, frc;    /* values at left and right center point */
+  double int2;        /* estimate as sum of the two halves */
+  double intl, intr;  /* estimates for left and right half */
+  double err;         /* error estimate */
+
+  if (++(*n_calls) > LOBATTO_MAX_CALLS) {
+    *W_accuracy = 2;
+    return;
+  }
+
+  flc = FKT(x+h/4);
+  frc = FKT(x+3*h/4);
+  intl = (9*(fl+fc)+49.*(FKT(x+h*W1*0.5)+FKT(x+h*W2*0.5))+64*flc)*h/360.;
+  intr = (9*(fc+fr)+49.*(FKT(x+h*(0.5+W1*0.5))+FKT(x+h*(0.5+W2*0.5)))+64*frc)*h/360.;
+  int2 = intl + intr;
+
+  err = fabs(int1-int2);
+  if (err >= tab->tol) {
+    if (_unur_FP_equal(x+h/2.,x)) {
+      *W_accuracy = 1;
+    }
+    else {
+      _lobatto_recursion(tab, funct, gen, x, h/2, intl, fl, flc, fc, W_accuracy, n_calls);
+      _lobatto_recursion(tab, funct, gen, x+h/2, h/2, intr, fc, frc, fr, W_accuracy, n_calls);
+      return;
+    }
+  }
+
+  _lobatto_append(tab, x+h/2., intl, err, fl, flc, fc);
+  _lobatto_append(tab, x+h, intr, err, fc, frc, fr);
+
+} /* end of _lobatto_recursion() */
+
+/*****************************************************************************/
+/*                                                                           */
+/*   R interface                                                             */
+/*                                                                           */
+/*****************************************************************************/
+
+SEXP
+Runuran_get_lobatto (SEXP sexp_distr)
+     /*----------------------------------------------------------------------*/
+     /* Get table for Gauss-Lobatto integration stored in distribution       */
+     /* object.                                                              */
+     /*                                                                      */
+     /* Parameters:                                                          */
+     /*   distr ... pointer to UNU.RAN distribution object                   */
+     /*                                                                      */
+     /* Return:                                                              */
+     /*   list with tolerance 'tol', boundaries 'x', integrals 'u', error    */
+     /*   estimates 'err', values of integrand at boundaries 'fx' and at     */
+     /*   centers 'fc' of subintervals                                       */
+     /*   NULL if there is no such table                                     */
+     /*----------------------------------------------------------------------*/
+{
+  struct unur_distr *distr;
+  struct Runuran_lobatto **slot;
+  struct Runuran_lobatto *tab;
+  SEXP sexp_tab, sexp_names;
+  int i;
+
+  CHECK_DISTR_PTR(sexp_distr);
+  distr = R_ExternalPtrAddr(sexp_distr);
+  if (distr == NULL)
+    Rf_errorcall(R_NilValue,"[UNU.RAN - error] invalid distribution object");
+
+  slot = _Runuran_cont_lobatto_slot(distr);
+  if (slot == NULL || *slot == NULL)
+    return R_NilValue;
+  tab = *slot;
+
+  PROTECT(sexp_tab = Rf_allocVector(VECSXP, LOBATTO_N_NAMES));
+  SET_VECTOR_ELT(sexp_tab, 0, Rf_ScalarReal(tab->tol));
+  SET_VECTOR_ELT(sexp_tab, 1, Rf_allocVector(REALSXP, tab->n+1));
+  SET_VECTOR_ELT(sexp_tab, 2, Rf_allocVector(REALSXP, tab->n));
+  SET_VECTOR_ELT(sexp_tab, 3, Rf_allocVector(REALSXP, tab->n));
+  SET_VECTOR_ELT(sexp_tab, 4, Rf_allocVector(REALSXP, tab->n+1));
+  SET_VECTOR_ELT(sexp_tab, 5, Rf_allocVector(REALSXP, tab->n));
+  memcpy(REAL(VECTOR_ELT(sexp_tab,1)), tab->x, (tab->n+1) * sizeof(double));
+  memcpy(REAL(VECTOR_ELT(sexp_tab,2)), tab->u, tab->n * sizeof(double));
+  memcpy(REAL(VECTOR_ELT(sexp_tab,3)), tab->err, tab->n * sizeof(double));
+  memcpy(REAL(VECTOR_ELT(sexp_tab,4)), tab->fx, (tab->n+1) * sizeof(double));
+  memcpy(REAL(VECTOR_ELT(sexp_tab,5)), tab->fc, tab->n * sizeof(double));
+
+  PROTECT(sexp_names = Rf_allocVector(STRSXP, LOBATTO_N_NAMES));
+  for (i=0; i<LOBATTO_N_NAMES; i++)
+    SET_STRING_ELT(sexp_names, i, Rf_mkChar(lobatto_names[i]));
+  Rf_setAttrib(sexp_tab, R_NamesSymbol, sexp_names);
+
+  UNPROTECT(2);
+  return sexp_tab;
+} /* end of Runuran_get_lobatto() */
+
+/*---------------------------------------------------------------------------*/
+
+SEXP
+Runuran_set_lobatto (SEXP sexp_distr, SEXP sexp_tab)
+     /*----------------------------------------------------------------------*/
+     /* Store table for Gauss-Lobatto integration in distribution object.    */
+     /*                                                                      */
+     /* Parameters:                                                          */
+     /*   distr ... pointer to UNU.RAN distribution object                   */
+     /*   tab   ... list as returned by Runuran_get_lobatto()                */
+     /*             (or NULL to remove stored table)                         */
+     /*                                                                      */
+     /* Return:                                                              */
+     /*   R_NilValue                                                         */
+     /*----------------------------------------------------------------------*/
+{
+  struct unur_distr *distr;
+  struct Runuran_lobatto **slot;
+  struct Runuran_lobatto *tab;
+  SEXP sexp_tol, sexp_x, sexp_u, sexp_err, sexp_fx, sexp_fc;
+  int i, n;
+
+  CHECK_DISTR_PTR(sexp_distr);
+  distr = R_ExternalPtrAddr(sexp_distr);
+  if (distr == NULL)
+    Rf_errorcall(R_NilValue,"[UNU.RAN - error] invalid distribution object");
+
+  slot = _Runuran_cont_lobatto_slot(distr);
+  if (slot == NULL)
+    Rf_errorcall(R_NilValue,"[UNU.RAN - error] distribution object must have an R function as PDF");
+
+  /* remove stored table */
+  if (Rf_isNull(sexp_tab)) {
+    _Runuran_lobatto_free(*slot);
+    *slot = NULL;
+    return R_NilValue;
+  }
+
+  /* check table */
+  if (TYPEOF(sexp_tab) != VECSXP || Rf_length(sexp_tab) != LOBATTO_N_NAMES)
+    Rf_errorcall(R_NilValue,"[UNU.RAN - error] invalid Lobatto table");
+  sexp_tol = VECTOR_ELT(sexp_tab, 0);
+  sexp_x = VECTOR_ELT(sexp_tab, 1);
+  sexp_u = VECTOR_ELT(sexp_tab, 2);
+  sexp_err = VECTOR_ELT(sexp_tab, 3);
+  sexp_fx = VECTOR_ELT(sexp_tab, 4);
+  sexp_fc = VECTOR_ELT(sexp_tab, 5);
+  if (TYPEOF(sexp_tol) != REALSXP || TYPEOF(sexp_x) != REALSXP || TYPEOF(sexp_u) != REALSXP ||
+      TYPEOF(sexp_err) != REALSXP || TYPEOF(sexp_fx) != REALSXP || TYPEOF(sexp_fc) != REALSXP ||
+      Rf_length(sexp_tol) != 1 || !(REAL(sexp_tol)[0] > 0.) ||
+      Rf_length(sexp_u) < 1 || Rf_length(sexp_x) != Rf_length(sexp_u) + 1 ||
+      Rf_length(sexp_err) != Rf_length(sexp_u) || Rf_length(sexp_fc) != Rf_length(sexp_u) ||
+      Rf_length(sexp_fx) != Rf_length(sexp_x))
+    Rf_errorcall(R_NilValue,"[UNU.RAN - error] invalid Lobatto table");
+  n = Rf_length(sexp_u);
+  for (i=0; i<n; i++) {
+    if (!(REAL(sexp_x)[i] < REAL(sexp_x)[i+1]) || !_unur_isfinite(REAL(sexp_u)[i]) || REAL(sexp_u)[i] < 0. ||
+	!(REAL(sexp_err)[i] >= 0.) || !_unur_isfinite(REAL(sexp_fx)[i]) || !_unur_isfinite(REAL(sexp_fc)[i]))
+      Rf_errorcall(R_NilValue,"[UNU.RAN - error] invalid Lobatto table");
+  }
+  if (!_unur_isfinite(REAL(sexp_fx)[n]))
+    Rf_errorcall(R_NilValue,"[UNU.RAN - error] invalid Lobatto table");
+
+  /* store copy of table */
+  tab = _lobatto_alloc(n);
+  tab->tol = REAL(sexp_tol)[0];
+  tab->n = n;
+  memcpy(tab->x, REAL(sexp_x), (n+1) * sizeof(double));
+  memcpy(tab->u, REAL(sexp_u), n * sizeof(double));
+  memcpy(tab->err, REAL(sexp_err), n * sizeof(double));
+  memcpy(tab->fx, REAL(sexp_fx), (n+1) * sizeof(double));
+  memcpy(tab->fc, REAL(sexp_fc), n * sizeof(double));
+
+  _Runuran_lobatto_free(*slot);
+  *slot = tab;
+
+  return R_NilValue;
+} /* end of Runuran_set_lobatto() */
+
+/*---------------------------------------------------------------------------*/
+
+#undef FKT
+
+/*---------------------------------------------------------------------------*/
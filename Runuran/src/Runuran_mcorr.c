@@ -0,0 +1,233 @@
+/*****************************************************************************
+ *                                                                           *
+ *          UNU.RAN -- Universal Non-Uniform Random number generator         *
+ *                                                                           *
+ *****************************************************************************
+ *                                                                           *
+ *   FILE: Runuran_mcorr.c                                                   *
+ *                                                                           *
+ *   PURPOSE:                                                                *
+ *         Random correlation matrices (method MCORR)                        *
+ *                                                                           *
+ *****************************************************************************
+ *                                                                           *
+ *   Copyright (c) 2026 Wolfgang Hoermann and Josef Leydold                  *
+ *   Dept. for Statistics, University of Economics, Vienna, Austria          *
+ *                                                                           *
+ *   This program is free software; you can redistribute it and/or modify    *
+ *   it under the terms of the GNU General Public License as published by    *
+ *   the Free Software Foundation; either version 2 of the License, or       *
+ *   (at your option) any later version.                                     *
+ *                                                                           *
+ *   This program is distributed in the hope that it will be useful,         *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of          *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the           *
+ *   GNU General Public License for more details.                            *
+ *                                                                           *
+ *   You should have received a copy of the GNU General Public License       *
+ *   along with this program; if not, write to the                           *
+ *   Free Software Foundation, Inc.,                                         *
+ *   59 Temple Place, Suite 330, Boston, MA 02111-1307, USA                  *
+ *                                                                           *
+ *****************************************************************************
+ *                                                                           *
+ *   Method MCORR generates random correlation matrices. In the default      *
+ *   variant the matrix H H^t is computed where the rows of H are            *
+ *   independent random unit vectors.                                        *
+ *                                                                           *
+ *   When a sample of size n is requested, the matrices are written          *
+ *   directly into the dim x dim x n array for R. The products of the rows   *
+ *   of H are computed in blocks of rows so that these remain in the cache,  *
+ *   and four products are computed simultaneously. Each sum is still        *
+ *   accumulated in the same order as in UNU.RAN. Thus the                   *
+ *   generated matrices coincide with those of unur_sample_matr().           *
+ *                                                                           *
+ *****************************************************************************/
+
+/*---------------------------------------------------------------------------*/
+
+#include "Runuran.h"
+
+/* internal header files for UNU.RAN */
+#include <unur_source.h>
+#include <distr/distr_source.h>
+#include <methods/mcorr_struct.h>
+
+/*---------------------------------------------------------------------------*/
+
+#define BLOCK_SIZE  (16)
+/* number of rows of H in one block */
+
+/* flag for variant (copied from methods/mcorr.c) */
+#define MCORR_SET_EIGENVALUES  0x001u
+
+/*---------------------------------------------------------------------------*/
+
+#define GEN       ((struct unur_mcorr_gen*)gen->datap)
+#define NORMAL    gen->gen_aux
+
+/*****************************************************************************/
+
+SEXP
+Runuran_mcorr (SEXP sexp_obj, SEXP sexp_dim, SEXP sexp_eigenvalues)
+     /*----------------------------------------------------------------------*/
+     /* Create UNU.RAN generator object for random correlation matrices.     */
+     /*                                                                      */
+     /* Parameters:                                                          */
+     /*   obj         ... S4 class that contains 'Runuran' generator object  */
+     /*   dim         ... dimension of correlation matrices                  */
+     /*   eigenvalues ... eigenvalues of correlation matrices (or NULL)      */
+     /*                                                                      */
+     /* Return:                                                              */
+     /*   pointer to UNU.RAN generator object                                */
+     /*----------------------------------------------------------------------*/
+{
+  struct unur_distr *distr;
+  struct unur_par *par;
+  struct unur_gen *gen = NULL;
+  SEXP sexp_gen;
+  int dim;
+
+  /* extract dimension */
+  dim = *INTEGER(sexp_dim);
+
+  /* create distribution object */
+  distr = unur_distr_correlation(dim);
+  if (distr == NULL) {
+    Rf_errorcall(R_NilValue,"[UNU.RAN - error] invalid argument 'dim'");
+  }
+
+  /* create UNU.RAN generator object */
+  par = unur_mcorr_new(distr);
+  if (par != NULL && !Rf_isNull(sexp_eigenvalues)) {
+    if (Rf_length(sexp_eigenvalues) != dim ||
+	unur_mcorr_set_eigenvalues(par, REAL(sexp_eigenvalues)) != UNUR_SUCCESS) {
+      unur_par_free(par);
+      unur_distr_free(distr);
+      Rf_errorcall(R_NilValue,"[UNU.RAN - error] invalid argument 'eigenvalues'");
+    }
+  }
+  if (par != NULL)
+    gen = unur_init(par);
+
+  /* generator object has its own copy of distribution object */
+  unur_distr_free(distr);
+
+  /* 'gen' must not be a NULL pointer */
+  if (gen == NULL) {
+    Rf_errorcall(R_NilValue,"[UNU.RAN - error] cannot create UNU.RAN object");
+  }
+
+  /* make R external pointer and store pointer to structure */
+  PROTECT(sexp_gen = R_MakeExternalPtr(gen, _Runuran_tag(), sexp_obj));
+  
+  /* register destructor as C finalizer */
+  R_RegisterCFinalizer(sexp_gen, _Runuran_free);
+
+  /* return pointer to R */
+  UNPROTECT(1);
+  return (sexp_gen);
+
+} /* end of Runuran_mcorr() */
+
+/*---------------------------------------------------------------------------*/
+
+void
+_Runuran_mcorr_sample_array (struct unur_gen *gen, double *res, int n)
+     /*----------------------------------------------------------------------*/
+     /* Sample random correlation matrices (batch version).                  */
+     /*                                                                      */
+     /* Parameters:                                                          */
+     /*   gen ... pointer to generator object                                */
+     /*   res ... array for storing random sample (dim x dim x n array)      */
+     /*   n   ... sample size                                                */
+     /*----------------------------------------------------------------------*/
+{
+#define idx(a,b) ((a)*dim+(b))
+  double *H, *mat;
+  double sum, norm, x;
+  double s0, s1, s2, s3;
+  int dim, i, j, k, l;
+  int i0, j0, i1, j1;
+
+  dim = GEN->dim;
+
+  /* variant with given eigenvalues: use UNU.RAN routine */
+  if (gen->set & MCORR_SET_EIGENVALUES) {
+    H = (double *) R_alloc((size_t) dim * dim, sizeof(double));
+    for (l=0; l<n; l++) {
+      mat = res + (size_t) l * dim * dim;
+      if (unur_sample_matr(gen, H) != UNUR_SUCCESS)
+	for (i=0; i<dim*dim; i++) mat[i] = NA_REAL;
+      else
+	/* UNU.RAN stores matrices row-wise */
+	for (i=0; i<dim; i++)
+	  for (j=0; j<dim; j++)
+	    mat[i + dim*j] = H[idx(i,j)];
+    }
+    return;
+  }
+
+  /* working array for random unit vectors */
+  H = (double *) R_alloc((size_t) dim * dim, sizeof(double));
+
+  for (l=0; l<n; l++) {
+    mat = res + (size_t) l * dim * dim;
+
+    /* rows of H: random unit vectors */
+    /* (same order of normal random variates as in UNU.RAN) */
+    for (i=0; i<dim; i++) {
+      sum=0.;
+      for (j=0; j<dim; j++) {
+	x = unur_sample_cont(NORMAL);
+	H[idx(i,j)] = x;
+	sum += x * x;
+      }
+      norm = sqrt(sum);
+      for (j=0; j<dim; j++) H[idx(i,j)] /= norm;
+    }
+
+    /* mat = H H^t (upper triangle, block-wise) */
+    for (i0=0; i0<dim; i0+=BLOCK_SIZE) {
+      i1 = _unur_min(i0+BLOCK_SIZE, dim);
+      for (j0=i0; j0<dim; j0+=BLOCK_SIZE) {
+	j1 = _unur_min(j0+BLOCK_SIZE, dim);
+	for (i=i0; i<i1; i++) {
+	  j = _unur_max(j0,i+1);
+	  /* four entries at once (independent sums) */
+	  for (; j+3<j1; j+=4) {
+	    s0 = s1 = s2 = s3 = 0.;
+	    for (k=0; k<dim; k++) {
+	      x = H[idx(i,k)];
+	      s0 += x*H[idx(j,k)];
+	      s1 += x*H[idx(j+1,k)];
+	      s2 += x*H[idx(j+2,k)];
+	      s3 += x*H[idx(j+3,k)];
+	    }
+	    mat[idx(i,j)] = s0;
+	    mat[idx(i,j+1)] = s1;
+	    mat[idx(i,j+2)] = s2;
+	    mat[idx(i,j+3)] = s3;
+	  }
+	  for (; j<j1; j++) {
+	    sum=0.;
+	    for (k=0; k<dim; k++)
+	      sum += H[idx(i,k)]*H[idx(j,k)];
+	    mat[idx(i,j)] = sum;
+	  }
+	}
+      }
+    }
+
+    /* diagonal and lower triangle */
+    for (i=0; i<dim; i++) {
+      mat[idx(i,i)] = 1.;
+      for (j=0; j<i; j++)
+	mat[idx(i,j)] = mat[idx(j,i)];
+    }
+  }
+
+#undef idx
+} /* end of _Runuran_mcorr_sample_array() */
+
+/*---------------------------------------------------------------------------*/
@@ -0,0 +1,560 @@
+/*****************************************************************************
+ *                                                                           *
+ *          UNU.RAN -- Universal Non-Uniform Random number generator         *
+ *                                                                           *
+ *****************************************************************************
+ *                                                                           *
+ *   FILE: Runuran_mvrou.c                                                   *
+ *                                                                           *
+ *   PURPOSE:                                                                *
+ *         Batch sampling for methods VNROU and HITRO                        *
+ *                                                                           *
+ *****************************************************************************
+ *                                                                           *
+ *   Copyright (c) 2026 Wolfgang Hoermann and Josef Leydold                  *
+ *   Dept. for Statistics, University of Economics, Vienna, Austria          *
+ *                                                                           *
+ *   This program is free software; you can redistribute it and/or modify    *
+ *   it under the terms of the GNU General Public License as published by    *
+ *   the Free Software Foundation; either version 2 of the License, or       *
+ *   (at your option) any later version.                                     *
+ *                                                                           *
+ *   This program is distributed in the hope that it will be useful,         *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of          *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the           *
+ *   GNU General Public License for more details.                            *
+ *                                                                           *
+ *   You should have received a copy of the GNU General Public License       *
+ *   along with this program; if not, write to the                           *
+ *   Free Software Foundation, Inc.,                                         *
+ *   59 Temple Place, Suite 330, Boston, MA 02111-1307, USA                  *
+ *                                                                           *
+ *****************************************************************************
+ *                                                                           *
+ *   Methods VNROU and HITRO test one candidate point at a time: the point   *
+ *   (v,u) is converted into x and the PDF is evaluated at x. For            *
+ *   distributions in higher dimensions (and for PDFs implemented in R)      *
+ *   the overhead of these single calls dominates the generation time.       *
+ *                                                                           *
+ *   When a sample of size n > 1 is requested, we propose a block of K       *
+ *   candidates at once, evaluate the PDF for all of them by means of the    *
+ *   array PDF _Runuran_cvec_eval_pdf_array() and then run the acceptance    *
+ *   tests in the given order. K is estimated from the number of trials      *
+ *   that have been required so far.                                         *
+ *                                                                           *
+ *   VNROU: The candidates are generated from the same uniform random        *
+ *   numbers as in repeated calls to unur_sample_vec(). Thus the generated   *
+ *   random vectors coincide with those of the UNU.RAN routine (only the     *
+ *   URNG is advanced further at the end of the sample).                    *
+ *                                                                           *
+ *   HITRO: All K candidates are drawn uniformly from the current line       *
+ *   segment and the first accepted one is used. When the line segment is    *
+ *   shrunken after a rejection (adaptive line segment), candidates outside  *
+ *   the new segment are skipped. The remaining candidates are still         *
+ *   uniformly distributed on the new segment. Thus the Markov chain has     *
+ *   the same transition kernel as the chain of the UNU.RAN routine. The     *
+ *   state of the generator object is updated, i.e., the chain continues    *
+ *   when unur_sample_vec() is called.                                       *
+ *                                                                           *
+ *****************************************************************************/
+
+/*---------------------------------------------------------------------------*/
+
+#include "Runuran.h"
+
+/* internal header files for UNU.RAN */
+#include <unur_source.h>
+#include <distr/distr_source.h>
+#include <methods/vnrou_struct.h>
+#include <methods/hitro_struct.h>
+
+/*---------------------------------------------------------------------------*/
+
+#define MAX_BATCH  (64)
+/* maximal number of candidates in one block */
+
+/* variant flags (copied from methods/vnrou.c and methods/hitro.c) */
+#define VNROU_VARFLAG_VERIFY      0x002u
+
+#define HITRO_VARMASK_VARIANT     0x000fu
+#define HITRO_VARIANT_COORD       0x0001u
+#define HITRO_VARIANT_RANDOMDIR   0x0002u
+#define HITRO_VARFLAG_ADAPTLINE   0x0010u
+#define HITRO_VARFLAG_ADAPTRECT   0x0020u
+#define HITRO_VARFLAG_BOUNDRECT   0x0040u
+#define HITRO_VARFLAG_BOUNDDOMAIN 0x0080u
+
+/*---------------------------------------------------------------------------*/
+
+struct Runuran_mvrou_batch {
+  int dim;                      /* dimension of distribution */
+  double *X;                    /* candidate points x (K x dim) */
+  double *fx;                   /* PDF values at candidate points */
+  double *t;                    /* v-coordinates / parameters of candidates */
+  long n_trials;                /* number of tested candidates */
+  long n_steps;                 /* number of accepted candidates */
+};
+/*---------------------------------------------------------------------------*/
+/* Work space for blocks of candidates.                                      */
+/*---------------------------------------------------------------------------*/
+
+static void _mvrou_batch_init (struct Runuran_mvrou_batch *batch, int dim);
+/*---------------------------------------------------------------------------*/
+/* Allocate work space for blocks of candidates.                             */
+/*---------------------------------------------------------------------------*/
+
+static int _mvrou_batch_size (const struct Runuran_mvrou_batch *batch, int n);
+/*---------------------------------------------------------------------------*/
+/* Estimate number of candidates required for n accepted points.             */
+/*---------------------------------------------------------------------------*/
+
+static void _hitro_coord_step (struct unur_gen *gen, struct Runuran_mvrou_batch *batch);
+/*---------------------------------------------------------------------------*/
+/* One step of coordinate sampler (batch version).                           */
+/*---------------------------------------------------------------------------*/
+
+static void _hitro_randomdir_step (struct unur_gen *gen, struct Runuran_mvrou_batch *batch);
+/*---------------------------------------------------------------------------*/
+/* One step of random direction sampler (batch version).                     */
+/*---------------------------------------------------------------------------*/
+
+static double _hitro_xv_to_u (const struct unur_gen *gen, double x, double v, int k);
+static void _hitro_vu_to_x (const struct unur_gen *gen, const double *vu, double *x);
+static int _hitro_is_inside (const struct unur_gen *gen, double v, double fx);
+static int _hitro_vu_is_inside_region (struct unur_gen *gen, const double *vu);
+/*---------------------------------------------------------------------------*/
+/* Auxiliary routines (copied from methods/hitro.c).                         */
+/*---------------------------------------------------------------------------*/
+
+/*****************************************************************************/
+
+#define GEN       ((struct unur_vnrou_gen*)gen->datap)
+
+int
+_Runuran_vnrou_sample_array (struct unur_gen *gen, double *res, int n)
+     /*----------------------------------------------------------------------*/
+     /* Sample from generator object with method VNROU (batch version).      */
+     /*                                                                      */
+     /* Parameters:                                                          */
+     /*   gen ... pointer to generator object                                */
+     /*   res ... array for storing random sample (n x dim matrix)           */
+     /*   n   ... sample size                                                */
+     /*                                                                      */
+     /* Return:                                                              */
+     /*   number of random vectors where a violation of the hat has been     */
+     /*   detected (verifying mode only)                                     */
+     /*----------------------------------------------------------------------*/
+{
+  struct Runuran_mvrou_batch batch;
+  double *x, V, U;
+  double fx, sfx, xfx;
+  int verify, hat_error;
+  int failed = 0;
+  int dim, i, j, d, K;
+
+  dim = GEN->dim;
+  verify = (gen->variant & VNROU_VARFLAG_VERIFY) ? TRUE : FALSE;
+  hat_error = FALSE;
+
+  _mvrou_batch_init(&batch, dim);
+
+  for (i=0; i<n; ) {
+
+    /* generate block of candidates */
+    /* (use uniform random numbers in the same order as _unur_vnrou_sample_cvec()) */
+    K = _mvrou_batch_size(&batch, n-i);
+    for (j=0; j<K; j++) {
+      x = batch.X + j*dim;
+      while ( _unur_iszero(V = _unur_call_urng(gen->urng)) );
+      V *= GEN->vmax;
+      for (d=0; d<dim; d++) {
+	U = GEN->umin[d] + _unur_call_urng(gen->urng) * (GEN->umax[d] - GEN->umin[d]);
+	x[d] = U/pow(V,GEN->r) + GEN->center[d];
+      }
+      batch.t[j] = V;
+    }
+
+    /* evaluate PDF */
+    _Runuran_cvec_eval_pdf_array(batch.X, K, batch.fx, gen->distr);
+
+    /* acceptance tests */
+    for (j=0; j<K && i<n; j++) {
+      ++batch.n_trials;
+      x = batch.X + j*dim;
+      fx = batch.fx[j];
+
+      if (verify) {
+	/* check whether hat is correct */
+	/* (see _unur_vnrou_sample_check() in methods/vnrou.c) */
+	sfx = pow( fx, 1./(GEN->r * dim+1.) );
+	if ( sfx > (1.+DBL_EPSILON) * GEN->vmax )
+	  hat_error = TRUE;
+	sfx = pow( fx, GEN->r/(GEN->r * dim + 1.) );
+	for (d=0; d<dim; d++) {
+	  xfx = (x[d]-GEN->center[d]) * sfx;
+	  if ( (xfx < (1.+UNUR_EPSILON) * GEN->umin[d])
+	       || (xfx > (1.+UNUR_EPSILON) * GEN->umax[d]))
+	    hat_error = TRUE;
+	}
+	if (hat_error)
+	  _unur_error(gen->genid,UNUR_ERR_GEN_CONDITION,"PDF(x) > hat(x)");
+      }
+
+      if (batch.t[j] <= pow(fx,1./(GEN->r * dim + 1.))) {
+	++batch.n_steps;
+	for (d=0; d<dim; d++) res[i + n*d] = x[d];
+	++i;
+	if (hat_error) ++failed;
+	hat_error = FALSE;
+      }
+    }
+  }
+
+  return failed;
+
+} /* end of _Runuran_vnrou_sample_array() */
+
+#undef GEN
+
+/*****************************************************************************/
+
+#define GEN       ((struct unur_hitro_gen*)gen->datap)
+#define DISTR     gen->distr->data.cvec
+#define GEN_NORMAL    gen->gen_aux
+
+void
+_Runuran_hitro_sample_array (struct unur_gen *gen, double *res, int n)
+     /*----------------------------------------------------------------------*/
+     /* Sample from generator object with method HITRO (batch version).      */
+     /*                                                                      */
+     /* Parameters:                                                          */
+     /*   gen ... pointer to generator object                                */
+     /*   res ... array for storing random sample (n x dim matrix)           */
+     /*   n   ... sample size                                                */
+     /*----------------------------------------------------------------------*/
+{
+  struct Runuran_mvrou_batch batch;
+  double *x;
+  int dim, i, d, thinning;
+  int variant;
+
+  dim = GEN->dim;
+  variant = gen->variant & HITRO_VARMASK_VARIANT;
+
+  _mvrou_batch_init(&batch, dim);
+  x = (double *) R_alloc(dim, sizeof(double));
+
+  for (i=0; i<n; i++) {
+    for (thinning = GEN->thinning; thinning > 0; --thinning) {
+      if (variant == HITRO_VARIANT_RANDOMDIR)
+	_hitro_randomdir_step(gen, &batch);
+      else
+	_hitro_coord_step(gen, &batch);
+    }
+    _hitro_vu_to_x(gen, GEN->state, x);
+    for (d=0; d<dim; d++) res[i + n*d] = x[d];
+  }
+
+} /* end of _Runuran_hitro_sample_array() */
+
+/*---------------------------------------------------------------------------*/
+
+void
+_hitro_coord_step (struct unur_gen *gen, struct Runuran_mvrou_batch *batch)
+     /*----------------------------------------------------------------------*/
+     /* One step of coordinate sampler (batch version).                      */
+     /* (see _unur_hitro_coord_sample_cvec() in methods/hitro.c)             */
+     /*                                                                      */
+     /* Parameters:                                                          */
+     /*   gen   ... pointer to generator object                              */
+     /*   batch ... work space                                               */
+     /*----------------------------------------------------------------------*/
+{
+  double lmin, lmax, lmid;   /* l.h.s., r.h.s. and midpoint of line segment */
+  double *vuaux = GEN->vu;   /* candidate point */
+  double U, t;
+  int dim = GEN->dim;
+  int coord, j, K;
+
+  /* update coordinate direction */
+  coord = GEN->coord = (GEN->coord + 1) % (dim + 1);
+
+  /* l.h.s. and r.h.s. of line segment */
+  if (! (gen->variant & HITRO_VARFLAG_BOUNDDOMAIN) || coord == 0) {
+    lmin = GEN->vumin[coord];
+    lmax = GEN->vumax[coord];
+  }
+  else {
+    int k = coord-1;
+    double *domain = DISTR.domainrect;
+    lmin = _hitro_xv_to_u(gen, domain[2*k], vuaux[0], k );
+    lmax = _hitro_xv_to_u(gen, domain[2*k+1], vuaux[0], k );
+    if (gen->variant & HITRO_VARFLAG_BOUNDRECT) {
+      lmin = _unur_max(lmin,GEN->vumin[coord]);
+      lmax = _unur_min(lmax,GEN->vumax[coord]);
+    }
+  }
+
+  /* adaptive bounding rectangle */
+  if ( gen->variant & HITRO_VARFLAG_ADAPTRECT ) {
+    lmid = 0.5 * (lmin + lmax);
+    vuaux[coord] = lmax;
+    while ( _hitro_vu_is_inside_region(gen,vuaux) ) {
+      lmax = lmid + (lmax-lmid) * GEN->adaptive_mult;
+      GEN->vumax[coord] = vuaux[coord] = lmax;
+    }
+    vuaux[coord] = lmin;
+    while ( coord!=0 && _hitro_vu_is_inside_region(gen,vuaux) ) {
+      lmin = lmid + (lmin-lmid) * GEN->adaptive_mult;
+      GEN->vumin[coord] = vuaux[coord] = lmin;
+    }
+  }
+
+  while (1) {
+    /* block of candidates on line segment */
+    K = _mvrou_batch_size(batch, 1);
+    for (j=0; j<K; j++) {
+      U = _unur_call_urng(gen->urng);
+      batch->t[j] = vuaux[coord] = U * lmin + (1.-U) * lmax;
+      _hitro_vu_to_x(gen, vuaux, batch->X + j*dim);
+    }
+    _Runuran_cvec_eval_pdf_array(batch->X, K, batch->fx, gen->distr);
+
+    /* first accepted candidate */
+    for (j=0; j<K; j++) {
+      t = batch->t[j];
+      if (t < lmin || t > lmax)
+	/* not in shrunken line segment */
+	continue;
+      ++batch->n_trials;
+      if (_hitro_is_inside(gen, (coord==0) ? t : vuaux[0], batch->fx[j])) {
+	++batch->n_steps;
+	GEN->state[coord] = vuaux[coord] = t;
+	return;
+      }
+      /* adaptive line segment */
+      if ( gen->variant & HITRO_VARFLAG_ADAPTLINE ) {
+	if (GEN->state[coord] < t)
+	  lmax = t;
+	else
+	  lmin = t;
+      }
+    }
+  }
+
+} /* end of _hitro_coord_step() */
+
+/*---------------------------------------------------------------------------*/
+
+void
+_hitro_randomdir_step (struct unur_gen *gen, struct Runuran_mvrou_batch *batch)
+     /*----------------------------------------------------------------------*/
+     /* One step of random direction sampler (batch version).                */
+     /* (see _unur_hitro_randomdir_sample_cvec() in methods/hitro.c)         */
+     /*                                                                      */
+     /* Parameters:                                                          */
+     /*   gen   ... pointer to generator object                              */
+     /*   batch ... work space                                               */
+     /*----------------------------------------------------------------------*/
+{
+#define new_point(ll)  { for (i=0;i<dim+1;i++) vuaux[i] = GEN->state[i]+(ll)*GEN->direction[i]; }
+
+  double lambda, lb[2];      /* line segment is [lb[0],lb[1]] */
+  double *vuaux = GEN->vu;   /* candidate point */
+  double U;
+  int dim = GEN->dim;
+  int d, i, j, k, K;
+  int update;
+
+  /* entries of bounding rectangle that are used */
+  d = (gen->variant & HITRO_VARFLAG_BOUNDRECT) ? dim+1 : 1;
+
+  /* random direction */
+  do {
+    for (i=0; i<dim+1; i++)
+      GEN->direction[i] = unur_sample_cont(GEN_NORMAL);
+    _unur_vector_normalize(dim+1, GEN->direction);
+  } while (!_unur_isfinite(GEN->direction[0]));
+
+  /* intersection of line with bounding rectangle */
+  lb[1] = UNUR_INFINITY;
+  lb[0] = -UNUR_INFINITY;
+  for (i=0; i<d; i++) {
+    lambda = (GEN->vumin[i] - GEN->state[i]) / GEN->direction[i];
+    if (lambda>0 && lambda<lb[1]) lb[1] = lambda;
+    if (lambda<0 && lambda>lb[0]) lb[0] = lambda;
+    lambda = (GEN->vumax[i] - GEN->state[i]) / GEN->direction[i];
+    if (lambda>0 && lambda<lb[1]) lb[1] = lambda;
+    if (lambda<0 && lambda>lb[0]) lb[0] = lambda;
+  }
+  if (! (_unur_isfinite(lb[0]) && _unur_isfinite(lb[1])) ) {
+    _unur_warning(gen->genid,UNUR_ERR_GEN_CONDITION,"line segment not bounded, try again");
+    return;
+  }
+
+  /* adaptive bounding rectangle */
+  if ( gen->variant & HITRO_VARFLAG_ADAPTRECT ) {
+    for (k=0; k<2; k++) {
+      update = FALSE;
+      while (1) {
+	new_point(lb[k]);
+	if (! _hitro_vu_is_inside_region(gen,vuaux) )
+	  break;
+	update = TRUE;
+	lb[k] *= GEN->adaptive_mult;
+      }
+      if (update) {
+	new_point(lb[k]);
+	for (i=0; i<d; i++) {
+	  if (vuaux[i] < GEN->vumin[i] && i!=0) GEN->vumin[i] =  vuaux[i];
+	  if (vuaux[i] > GEN->vumax[i])         GEN->vumax[i] =  vuaux[i];
+	}
+      }
+    }
+  }
+
+  while (1) {
+    /* block of candidates on line segment */
+    K = _mvrou_batch_size(batch, 1);
+    for (j=0; j<K; j++) {
+      U = _unur_call_urng(gen->urng);
+      batch->t[j] = lambda = U * lb[0] + (1.-U) * lb[1];
+      new_point(lambda);
+      _hitro_vu_to_x(gen, vuaux, batch->X + j*dim);
+    }
+    _Runuran_cvec_eval_pdf_array(batch->X, K, batch->fx, gen->distr);
+
+    /* first accepted candidate */
+    for (j=0; j<K; j++) {
+      lambda = batch->t[j];
+      if (lambda < lb[0] || lambda > lb[1])
+	/* not in shrunken line segment */
+	continue;
+      ++batch->n_trials;
+      if (_hitro_is_inside(gen, GEN->state[0] + lambda * GEN->direction[0], batch->fx[j])) {
+	++batch->n_steps;
+	new_point(lambda);
+	memcpy( GEN->state, vuaux, (dim+1)*sizeof(double) );
+	return;
+      }
+      /* adaptive line segment */
+      if ( gen->variant & HITRO_VARFLAG_ADAPTLINE ) {
+	if (lambda < 0) lb[0] = lambda;
+	else            lb[1] = lambda;
+      }
+    }
+  }
+
+#undef new_point
+} /* end of _hitro_randomdir_step() */
+
+/*---------------------------------------------------------------------------*/
+
+double
+_hitro_xv_to_u (const struct unur_gen *gen, double x, double v, int k)
+     /* transform point where we are given the x-coordinate */
+{
+  if (_unur_isone(GEN->r))
+    return (x - GEN->center[k]) * v;
+  else
+    return (x - GEN->center[k]) * pow(v,GEN->r) ;
+} /* end of _hitro_xv_to_u() */
+
+/*---------------------------------------------------------------------------*/
+
+void
+_hitro_vu_to_x (const struct unur_gen *gen, const double *vu, double *x)
+     /* transform point (v,u) into x */
+{
+  int d;
+  double v = vu[0];
+  const double *u = vu+1;
+
+  if (v<=0.) {
+    for (d=0; d<GEN->dim; d++)  x[d] = 0.;
+    return;
+  }
+  if (_unur_isone(GEN->r))
+    for (d=0; d<GEN->dim; d++)  x[d] = u[d]/v + GEN->center[d];
+  else
+    for (d=0; d<GEN->dim; d++)  x[d] = u[d]/pow(v,GEN->r) + GEN->center[d];
+} /* end of _hitro_vu_to_x() */
+
+/*---------------------------------------------------------------------------*/
+
+int
+_hitro_is_inside (const struct unur_gen *gen, double v, double fx)
+     /* check whether point with v-coordinate v and PDF value fx at  */
+     /* corresponding x is inside region                             */
+{
+  if (fx <= 0. || v <= 0.) return FALSE;
+  return ( (v < pow(fx,1./(GEN->r * GEN->dim + 1.))) ? TRUE : FALSE );
+} /* end of _hitro_is_inside() */
+
+/*---------------------------------------------------------------------------*/
+
+int
+_hitro_vu_is_inside_region (struct unur_gen *gen, const double *vu)
+     /* check whether point (v,u) is inside region */
+{
+  double fx;
+
+  _hitro_vu_to_x(gen, vu, GEN->x);
+  _Runuran_cvec_eval_pdf_array(GEN->x, 1, &fx, gen->distr);
+  return _hitro_is_inside(gen, vu[0], fx);
+} /* end of _hitro_vu_is_inside_region() */
+
+#undef GEN
+#undef DISTR
+#undef GEN_NORMAL
+
+/*****************************************************************************/
+
+void
+_mvrou_batch_init (struct Runuran_mvrou_batch *batch, int dim)
+     /*----------------------------------------------------------------------*/
+     /* Allocate work space for blocks of candidates.                        */
+     /* (Memory is released by R at the end of the .Call.)                   */
+     /*                                                                      */
+     /* Parameters:                                                          */
+     /*   batch ... work space                                               */
+     /*   dim   ... dimension of distribution                                */
+     /*----------------------------------------------------------------------*/
+{
+  batch->dim = dim;
+  batch->X  = (double *) R_alloc(MAX_BATCH * dim, sizeof(double));
+  batch->fx = (double *) R_alloc(MAX_BATCH, sizeof(double));
+  batch->t  = (double *) R_alloc(MAX_BATCH, sizeof(double));
+  batch->n_trials = 0;
+  batch->n_steps = 0;
+} /* end of _mvrou_batch_init() */
+
+/*---------------------------------------------------------------------------*/
+
+int
+_mvrou_batch_size (const struct Runuran_mvrou_batch *batch, int n)
+     /*----------------------------------------------------------------------*/
+     /* Estimate number of candidates required for n accepted points.        */
+     /*                                                                      */
+     /* Parameters:                                                          */
+     /*   batch ... work space                                               */
+     /*   n     ... number of required points                                */
+     /*                                                                      */
+     /* Return:                                                              */
+     /*   size of block (between 1 and MAX_BATCH)                            */
+     /*----------------------------------------------------------------------*/
+{
+  double K;
+
+  if (batch->n_steps == 0)
+    /* no information yet */
+    K = (n > 1) ? n : 2.;
+  else
+    /* (rounding down keeps the number of superfluous evaluations small) */
+    K = floor(n * (double) batch->n_trials / (double) batch->n_steps);
+
+  if (K < 1.) K = 1.;
+  return (K > MAX_BATCH) ? MAX_BATCH : (int) K;
+} /* end of _mvrou_batch_size() */
+
+/*---------------------------------------------------------------------------*/
@@ -0,0 +1,280 @@
+/*****************************************************************************
+ *                                                                           *
+ *          UNU.RAN -- Universal Non-Uniform Random number generator         *
+ *                                                                           *
+ *****************************************************************************
+ *                                                                           *
+ *   FILE: Runuran_ninv.c                                                    *
+ *                                                                           *
+ *   PURPOSE:                                                                *
+ *         R interface for UNU.RAN -- NINV                                   *
+ *         (batch inversion with warm starts)                                *
+ *                                                                           *
+ *****************************************************************************
+ *                                                                           *
+ *   Copyright (c) 2026 Wolfgang Hoermann and Josef Leydold                  *
+ *   Dept. for Statistics, University of Economics, Vienna, Austria          *
+ *                                                                           *
+ *   This program is free software; you can redistribute it and/or modify    *
+ *   it under the terms of the GNU General Public License as published by    *
+ *   the Free Software Foundation; either version 2 of the License, or       *
+ *   (at your option) any later version.                                     *
+ *                                                                           *
+ *   This program is distributed in the hope that it will be useful,         *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of          *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the           *
+ *   GNU General Public License for more details.                            *
+ *                                                                           *
+ *   You should have received a copy of the GNU General Public License       *
+ *   along with this program; if not, write to the                           *
+ *   Free Software Foundation, Inc.,                                         *
+ *   59 Temple Place, Suite 330, Boston, MA 02111-1307, USA                  *
+ *                                                                           *
+ *****************************************************************************
+ *                                                                           *
+ *   Method NINV computes every quantile from scratch: the root finding      *
+ *   starts at a point from the (optional) table of starting points or at    *
+ *   the starting point 's[0]'. When many quantiles are requested at once    *
+ *   we sort the u-values and use the root found for the previous u-value    *
+ *   as starting point (and left boundary of the bracket) for the next one,  *
+ *   whenever it is closer than the point taken from the table.              *
+ *   Thus the effective table of starting points becomes finer where the     *
+ *   u-values are dense. The number of CDF evaluations is then usually       *
+ *   reduced to 2-3 per quantile.                                            *
+ *                                                                           *
+ *   The root finding routines of UNU.RAN are used unchanged. We only run    *
+ *   them on a shallow copy of the generator object where the starting       *
+ *   points are replaced. Thus the original generator object is never       *
+ *   modified (not even temporarily).                                        *
+ *                                                                           *
+ *****************************************************************************/
+
+/*---------------------------------------------------------------------------*/
+
+#include "Runuran.h"
+
+/* internal header files for UNU.RAN */
+#include <unur_source.h>
+#include <methods/ninv_struct.h>
+
+/*---------------------------------------------------------------------------*/
+
+static void _Runuran_ninv_eval_sorted (const struct unur_gen *gen,
+				       const double *U, double *X, int n);
+/*---------------------------------------------------------------------------*/
+/* Evaluate approximate inverse CDF for sorted array of u-values.            */
+/*---------------------------------------------------------------------------*/
+
+/*---------------------------------------------------------------------------*/
+
+#define GEN    ((struct unur_ninv_gen*)gen->datap)
+/* data for generator object */
+
+#define DISTR  (gen->distr->data.cont)
+/* data for distribution in generator object */
+
+#define CDF(x) (unur_distr_cont_eval_cdf((x),gen->distr))
+/* evaluate CDF of distribution */
+
+#define NINV_VARFLAG_NEWTON   0x1u
+/* use Newton's method (copied from unuran-src/methods/ninv.c) */
+
+/*****************************************************************************/
+
+void
+_Runuran_ninv_eval_array (const struct unur_gen *gen,
+			  const double *U, double *X, int n)
+     /*----------------------------------------------------------------------*/
+     /* Evaluate approximate inverse CDF for an array of u-values.           */
+     /* (Batch version of unur_ninv_eval_approxinvcdf())                     */
+     /*                                                                      */
+     /* Parameters:                                                          */
+     /*   gen ... pointer to UNU.RAN generator object (method NINV)          */
+     /*   U   ... array of u-values                                          */
+     /*   X   ... array for storing quantiles                                */
+     /*   n   ... length of arrays 'U' and 'X'                               */
+     /*                                                                      */
+     /* Remark:                                                              */
+     /*   NaN and u-values outside of (0,1) are handled by                   */
+     /*   unur_ninv_eval_approxinvcdf() directly.                            */
+     /*----------------------------------------------------------------------*/
+{
+  double *Us;       /* sorted u-values in (0,1) */
+  double *Xs;       /* corresponding quantiles */
+  int *idx;         /* position of sorted u-values in array 'U' */
+  int i, m;
+
+  /* working space */
+  Us  = (double *) R_alloc(n, sizeof(double));
+  Xs  = (double *) R_alloc(n, sizeof(double));
+  idx = (int *)    R_alloc(n, sizeof(int));
+
+  /* collect u-values in (0,1); all others are treated immediately */
+  for (i=0, m=0; i<n; i++) {
+    if (ISNAN(U[i]))
+      /* if NA or NaN is given then we simply return the same value */
+      X[i] = U[i];
+    else if (U[i] <= 0. || U[i] >= 1.)
+      X[i] = unur_ninv_eval_approxinvcdf(gen, U[i]);
+    else {
+      Us[m] = U[i];
+      idx[m] = i;
+      ++m;
+    }
+  }
+
+  /* sort u-values */
+  rsort_with_index(Us, idx, m);
+
+  /* compute quantiles */
+  _Runuran_ninv_eval_sorted(gen, Us, Xs, m);
+
+  /* store result in original order */
+  for (i=0; i<m; i++)
+    X[idx[i]] = Xs[i];
+
+} /* end of _Runuran_ninv_eval_array() */
+
+/*---------------------------------------------------------------------------*/
+
+void
+_Runuran_ninv_sample_array (struct unur_gen *gen, double *X, int n)
+     /*----------------------------------------------------------------------*/
+     /* Sample from generator object with method NINV (batch version).       */
+     /*                                                                      */
+     /* Parameters:                                                          */
+     /*   gen ... pointer to UNU.RAN generator object (method NINV)          */
+     /*   X   ... array for storing random sample                            */
+     /*   n   ... sample size                                                */
+     /*                                                                      */
+     /* Remark:                                                              */
+     /*   We consume the uniform random numbers in the same order as         */
+     /*   unur_sample_cont() does. Hence the sample coincides with that      */
+     /*   generated by repeated calls of unur_sample_cont() (up to the       */
+     /*   requested accuracy of the root finding algorithm).                 */
+     /*----------------------------------------------------------------------*/
+{
+  UNUR_URNG *urng = unur_get_urng(gen);
+  double Umin = GEN->Umin;
+  double Umax = GEN->Umax;
+  double *U;
+  int i;
+
+  /* draw uniform random numbers and map them into (Umin,Umax) */
+  U = (double *) R_alloc(n, sizeof(double));
+  for (i=0; i<n; i++)
+    U[i] = Umin + unur_urng_sample(urng) * (Umax - Umin);
+
+  /* compute quantiles */
+  _Runuran_ninv_eval_array(gen, U, X, n);
+
+} /* end of _Runuran_ninv_sample_array() */
+
+/*---------------------------------------------------------------------------*/
+
+void
+_Runuran_ninv_eval_sorted (const struct unur_gen *gen,
+			   const double *U, double *X, int n)
+     /*----------------------------------------------------------------------*/
+     /* Evaluate approximate inverse CDF for sorted array of u-values.       */
+     /*                                                                      */
+     /* Parameters:                                                          */
+     /*   gen ... pointer to UNU.RAN generator object (method NINV)          */
+     /*   U   ... sorted array of u-values in (0,1)                          */
+     /*   X   ... array for storing quantiles                                */
+     /*   n   ... length of arrays 'U' and 'X'                               */
+     /*----------------------------------------------------------------------*/
+{
+  /* shallow copy of generator object with modified starting points */
+  struct unur_gen gen_ws;
+  struct unur_ninv_gen data_ws;
+
+  double xp, fp, up;   /* previous root, its CDF value and u-value */
+  double xpp, upp;     /* root and u-value before previous one */
+  double ft;           /* CDF value at starting point from table */
+  double xu, fu;       /* right boundary of bracket */
+  int n_roots;         /* number of available previous roots (at most 2) */
+  int i, j;
+
+  /* make shallow copy. it shares all tables with 'gen'. */
+  memcpy(&gen_ws, gen, sizeof(struct unur_gen));
+  memcpy(&data_ws, GEN, sizeof(struct unur_ninv_gen));
+  gen_ws.datap = &data_ws;
+
+  /* we select the starting points ourselves */
+  data_ws.table_on = FALSE;
+
+  n_roots = 0;
+  xp = fp = up = xpp = upp = 0.;
+
+  for (i=0; i<n; i++) {
+
+    /* starting point used by UNU.RAN */
+    if (GEN->table_on) {
+      if (_unur_FP_same(GEN->CDFmin, GEN->CDFmax))
+	j = GEN->table_size/2;
+      else {
+	j = (int) ( GEN->table_size * (U[i] - GEN->CDFmin) / (GEN->CDFmax - GEN->CDFmin) );
+	if (j<0) j = 0;
+	else if (j > GEN->table_size - 2) j = GEN->table_size - 2;
+      }
+      ft = GEN->f_table[j];
+      xu = GEN->table[j+1]; fu = GEN->f_table[j+1];
+    }
+    else {
+      ft = 0.;
+      xu = UNUR_INFINITY; fu = 1.;
+    }
+
+    /* we use the previous root if it is closer than the table point */
+    if (n_roots == 0 || fp < ft) {
+      X[i] = unur_ninv_eval_approxinvcdf(gen, U[i]);
+    }
+
+    else if (! (U[i] > up)) {
+      /* same u-value */
+      X[i] = xp;
+      continue;
+    }
+
+    else {
+      /* left boundary of bracket and starting point for Newton */
+      data_ws.s[0] = xp; data_ws.CDFs[0] = fp;
+
+      /* right boundary of bracket: extrapolate the inverse CDF linearly */
+      /* from the last two roots. (the bracket is enlarged if necessary) */
+      if (n_roots > 1 && gen->variant != NINV_VARFLAG_NEWTON) {
+	xu = xp + 1.1 * (xp - xpp) / (up - upp) * (U[i] - up);
+	if (xu > xp && _unur_isfinite(xu)) {
+	  if (xu > DISTR.trunc[1]) xu = DISTR.trunc[1];
+	  fu = CDF(xu);
+	}
+      }
+      if (! (xu > xp && _unur_isfinite(xu))) {
+	xu = xp + (GEN->s[1] - GEN->s[0]);
+	fu = (gen->variant != NINV_VARFLAG_NEWTON) ? CDF(xu) : 0.;
+      }
+      data_ws.s[1] = xu; data_ws.CDFs[1] = fu;
+
+      /* compute root */
+      X[i] = unur_ninv_eval_approxinvcdf(&gen_ws, U[i]);
+    }
+
+    /* store root */
+    if (_unur_isfinite(X[i]) && (n_roots == 0 || X[i] > xp)) {
+      xpp = xp; upp = up;
+      xp = X[i]; up = U[i];
+      /* We use U[i] as CDF value and save one evaluation of the CDF.   */
+      /* The error is bounded by the requested u-resolution. Otherwise, */
+      /* the root for the next u-value is within x-resolution of 'xp'.  */
+      fp = U[i];
+      if (n_roots < 2) ++n_roots;
+    }
+    else {
+      n_roots = 0;
+    }
+  }
+
+} /* end of _Runuran_ninv_eval_sorted() */
+
+/*---------------------------------------------------------------------------*/
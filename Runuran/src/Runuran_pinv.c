@@ -37,15 +37,17 @@
 
 /* internal header files for UNU.RAN */
 #include <unur_source.h>
+#include <distr/distr_source.h>
 #include <methods/pinv_struct.h>
 
 /*---------------------------------------------------------------------------*/
 
 /* number of entries (slots) in data list */
 #define n_slots (5)
+#define n_slots_compact (6)   /* compact mode */
 
 /* names of slots */
-static const char *slot_name[n_slots] = {"mid","order","Umax","guide","iv"};
+static const char *slot_name[n_slots_compact] = {"mid","order","Umax","guide","iv","cf"};
 
 /* positions in data list */
 enum {
@@ -53,7 +55,8 @@ enum {
   porder = 1,    /* order of polynomial */
   pUmax = 2,     /* Umax */
   pguide = 3,    /* guide table */
-  piv = 4        /* coefficents of polynomials */
+  piv = 4,       /* coefficents of polynomials */
+  pcf = 5        /* coefficents in single precision (compact mode only) */
 };
 
 /*---------------------------------------------------------------------------*/
@@ -64,6 +67,48 @@ static double _pinv_eval (double U, double Umax, int order,
 /* Evaluate approximating polynomial.                                        */
 /*---------------------------------------------------------------------------*/
 
+static double _pinv_eval_compact (double U, double Umax, int order,
+				  int guide_size, int *guide, double *iv, int *cf);
+/*---------------------------------------------------------------------------*/
+/* Evaluate approximating polynomial (compact mode).                         */
+/*---------------------------------------------------------------------------*/
+
+static void _pinv_compact_coeff (struct unur_gen *gen, int i, double *cf);
+/*---------------------------------------------------------------------------*/
+/* Compute scaled coefficients of polynomial in interval 'i' rounded to      */
+/* single precision.                                                         */
+/*---------------------------------------------------------------------------*/
+
+static double _pinv_compact_uerror (struct unur_gen *gen);
+/*---------------------------------------------------------------------------*/
+/* Estimate additional u-error caused by single precision coefficients.      */
+/*---------------------------------------------------------------------------*/
+
+static double _pinv_trunc_sample (struct unur_gen *gen);
+/*---------------------------------------------------------------------------*/
+/* Sample from generator object with truncated domain.                       */
+/*---------------------------------------------------------------------------*/
+
+static double _pinv_eval_approxinvcdf (const struct unur_gen *gen, double u);
+/*---------------------------------------------------------------------------*/
+/* Evaluate approximate inverse CDF (interpolating polynomial).              */
+/*---------------------------------------------------------------------------*/
+
+static double _pinv_eval_approxcdf (const struct unur_gen *gen, double x);
+/*---------------------------------------------------------------------------*/
+/* Evaluate approximate CDF, i.e., the inverse of the interpolating          */
+/* polynomial.                                                               */
+/*---------------------------------------------------------------------------*/
+
+static double _pinv_newton_eval (double q, const double *ui, const double *zi,
+				 int order, double *dx);
+/*---------------------------------------------------------------------------*/
+/* Evaluate Newton polynomial and its derivative.                            */
+/*---------------------------------------------------------------------------*/
+
+/* maximal number of iterations for inverting interpolating polynomial */
+#define PINV_TRUNC_MAX_ITER (100)
+
 /*---------------------------------------------------------------------------*/
 
 #define GEN    ((struct unur_pinv_gen*)gen->datap)
@@ -75,13 +120,14 @@ static double _pinv_eval (double U, double Umax, int order,
 /*****************************************************************************/
 
 void
-_Runuran_pack_pinv (struct unur_gen *gen, SEXP sexp_unur)
+_Runuran_pack_pinv (struct unur_gen *gen, SEXP sexp_unur, int compact)
      /*----------------------------------------------------------------------*/
      /* Pack Runuran generator object for method PINV into R list            */
      /*                                                                      */
      /* Parameters:                                                          */
-     /*   gen  ... pointer to UNU.RAN generator object                       */
-     /*   unur ... 'Runuran' object (S4 class)                               */ 
+     /*   gen     ... pointer to UNU.RAN generator object                    */
+     /*   unur    ... 'Runuran' object (S4 class)                            */ 
+     /*   compact ... whether coefficients are stored in single precision    */
      /*                                                                      */
      /* Return:                                                              */
      /*   data for generation method (R list)                                */
@@ -89,17 +135,34 @@ _Runuran_pack_pinv (struct unur_gen *gen, SEXP sexp_unur)
 {
   int i,n,k;
   int iv_size, n_coeff;
+  int cf_size;
   double *iv;
+  double *cf;
+  int n_data;
 
   /* names of list entries */
   SEXP sexp_data_names;
 
   /* data list and its entries */
   SEXP sexp_data, sexp_dom;
-  SEXP sexp_mid, sexp_order, sexp_Umax, sexp_guide, sexp_iv;
+  SEXP sexp_mid, sexp_order, sexp_Umax, sexp_guide, sexp_iv, sexp_cf;
+
+  /* the packed object contains the tables for the whole domain */
+  if (_Runuran_pinv_is_truncated(gen))
+    Rf_errorcall(R_NilValue,"[UNU.RAN - error] cannot pack PINV object with truncated domain");
+
+  /* in compact mode the polynomials are stored in single precision. */
+  /* we have to check whether this is accurate enough.               */
+  if (compact && _pinv_compact_uerror(gen) > GEN->u_resolution) {
+    Rf_warning("[UNU.RAN - warning] u-resolution too small for compact mode: object packed in double precision");
+    compact = FALSE;
+  }
 
   /* number of doubles stored for one interval */
-  iv_size = 1 + 2*GEN->order;
+  iv_size = (compact) ? 2 : 1 + 2*GEN->order;
+
+  /* number of floats stored for one interval (compact mode) */
+  cf_size = 2*GEN->order - 1;
 
   /* create entries for data list */
 
@@ -125,34 +188,59 @@ _Runuran_pack_pinv (struct unur_gen *gen, SEXP sexp_unur)
   n_coeff = (GEN->n_ivs+1) * iv_size;
 
   /* table of coefficients for approximating polynomial */
-  /* sequence for each interval: 
-   *   cdfi, z[order-1], u[order-2], z[order-2], ..., u[0], z[0], xi  
-   */
   PROTECT(sexp_iv = Rf_allocVector(REALSXP, n_coeff));
   iv = REAL(sexp_iv);
-  for (i=0,n=-1; i<=GEN->n_ivs; i++) {
-    iv[++n] = GEN->iv[i].cdfi;
-    k = GEN->order - 1;
-    iv[++n] = GEN->iv[i].zi[k];
-    for (k--; k>=0; k--) {
-      iv[++n] = GEN->iv[i].ui[k];
+
+  if (compact) {
+    /* sequence for each interval: cdfi, xi 
+     * the remaining coefficients are stored in single precision 
+     * in entry 'cf' (see _pinv_compact_coeff()).
+     */
+    PROTECT(sexp_cf = Rf_allocVector(INTSXP, (GEN->n_ivs+1) * cf_size));
+    cf = (double *) R_alloc(cf_size, sizeof(double));
+    for (i=0; i<=GEN->n_ivs; i++) {
+      iv[2*i]   = GEN->iv[i].cdfi;
+      iv[2*i+1] = GEN->iv[i].xi;
+      _pinv_compact_coeff(gen, i, cf);
+      for (k=0; k<cf_size; k++)
+	INTEGER(sexp_cf)[i*cf_size+k] = _Runuran_float_to_int(cf[k]);
+    }
+  }
+
+  else {
+    /* sequence for each interval: 
+     *   cdfi, z[order-1], u[order-2], z[order-2], ..., u[0], z[0], xi  
+     */
+    PROTECT(sexp_cf = R_NilValue);
+    for (i=0,n=-1; i<=GEN->n_ivs; i++) {
+      iv[++n] = GEN->iv[i].cdfi;
+      k = GEN->order - 1;
       iv[++n] = GEN->iv[i].zi[k];
+      for (k--; k>=0; k--) {
+	iv[++n] = GEN->iv[i].ui[k];
+	iv[++n] = GEN->iv[i].zi[k];
+      }
+      iv[++n] = GEN->iv[i].xi;
     }
-    iv[++n] = GEN->iv[i].xi;
   }
 
+  /* size of data list */
+  n_data = (compact) ? n_slots_compact : n_slots;
+
   /* list of "names" attribute of the objects in our list */
-  PROTECT(sexp_data_names = Rf_allocVector(STRSXP, n_slots));
-  for (i=0; i<n_slots; i++)
+  PROTECT(sexp_data_names = Rf_allocVector(STRSXP, n_data));
+  for (i=0; i<n_data; i++)
     SET_STRING_ELT(sexp_data_names, i, Rf_mkChar(slot_name[i]));
 
   /* create data list */
-  PROTECT(sexp_data = Rf_allocVector(VECSXP, n_slots));
+  PROTECT(sexp_data = Rf_allocVector(VECSXP, n_data));
   SET_VECTOR_ELT(sexp_data, pmid,   sexp_mid);      /* attach 'mid' element   */
   SET_VECTOR_ELT(sexp_data, porder, sexp_order);    /* attach 'order' element */
   SET_VECTOR_ELT(sexp_data, pUmax,  sexp_Umax);     /* attach 'Umax' element  */
   SET_VECTOR_ELT(sexp_data, pguide, sexp_guide);    /* attach 'guide' element */
   SET_VECTOR_ELT(sexp_data, piv,    sexp_iv);       /* attach 'iv' element    */
+  if (compact)
+    SET_VECTOR_ELT(sexp_data, pcf,  sexp_cf);       /* attach 'cf' element    */
 
   /* attach vector names */
   Rf_setAttrib(sexp_data, R_NamesSymbol, sexp_data_names);
@@ -167,7 +255,7 @@ _Runuran_pack_pinv (struct unur_gen *gen, SEXP sexp_unur)
   R_do_slot_assign(sexp_unur, Rf_install("dom"), sexp_dom);
 
   /* o.k. */
-  UNPROTECT(8);
+  UNPROTECT(9);
   return;
 
 } /* end of _Runuran_pack_pinv() */
@@ -197,13 +285,16 @@ _Runuran_sample_pinv (SEXP sexp_data, int n)
   int *guide = INTEGER(VECTOR_ELT(sexp_data, pguide));
   int guide_size = Rf_length(VECTOR_ELT(sexp_data, pguide));
   double *iv = REAL(VECTOR_ELT(sexp_data, piv));
+  int *cf = (Rf_length(sexp_data) == n_slots_compact) 
+    ? INTEGER(VECTOR_ELT(sexp_data, pcf)) : NULL;
   
   /* generate sample */
   PROTECT(sexp_res = Rf_allocVector(REALSXP, n));
   for (i=0; i<n; i++) {
     U = unif_rand();   /* FIXME: R built-in URNG hard coded ! */
-    REAL(sexp_res)[i] = 
-      _pinv_eval (U, Umax, order, guide_size, guide, iv);
+    REAL(sexp_res)[i] = (cf)
+      ? _pinv_eval_compact (U, Umax, order, guide_size, guide, iv, cf)
+      : _pinv_eval (U, Umax, order, guide_size, guide, iv);
   }
 
   /* return result to R */
@@ -241,6 +332,8 @@ _Runuran_quantile_pinv (SEXP sexp_data, SEXP sexp_U, SEXP sexp_unur)
   int *guide = INTEGER(VECTOR_ELT(sexp_data, pguide));
   int guide_size = Rf_length(VECTOR_ELT(sexp_data, pguide));
   double *iv = REAL(VECTOR_ELT(sexp_data, piv));
+  int *cf = (Rf_length(sexp_data) == n_slots_compact) 
+    ? INTEGER(VECTOR_ELT(sexp_data, pcf)) : NULL;
 
   /* Extract U */
   U = REAL(sexp_U);
@@ -269,8 +362,9 @@ _Runuran_quantile_pinv (SEXP sexp_data, SEXP sexp_U, SEXP sexp_unur)
       }
 
       else {
-	REAL(sexp_res)[i] = 
-	  _pinv_eval (U[i], Umax, order, guide_size, guide, iv);
+	REAL(sexp_res)[i] = (cf)
+	  ? _pinv_eval_compact (U[i], Umax, order, guide_size, guide, iv, cf)
+	  : _pinv_eval (U[i], Umax, order, guide_size, guide, iv);
       }
     }
   }
@@ -283,6 +377,317 @@ _Runuran_quantile_pinv (SEXP sexp_data, SEXP sexp_U, SEXP sexp_unur)
 
 /*---------------------------------------------------------------------------*/
 
+int
+_Runuran_pinv_chg_truncated (struct unur_gen *gen, double left, double right)
+     /*----------------------------------------------------------------------*/
+     /* Change truncated domain of generator object (method PINV).           */
+     /* The u-values of the boundaries are computed from the table of        */
+     /* interpolating polynomials (approximate CDF). No new setup and no     */
+     /* evaluation of the CDF or PDF of the distribution is required.        */
+     /*                                                                      */
+     /* Parameters:                                                          */
+     /*   gen   ... pointer to PINV generator object                         */
+     /*   left  ... left boundary of truncated domain                        */
+     /*   right ... right boundary of truncated domain                       */
+     /*                                                                      */
+     /* Return:                                                              */
+     /*   UNUR_SUCCESS ... on success                                        */
+     /*   error code   ... otherwise                                         */
+     /*----------------------------------------------------------------------*/
+{
+  double Umin, Umax;
+  double *urange;
+
+  if (gen->method != UNUR_METH_PINV) {
+    _unur_error(gen->genid,UNUR_ERR_GEN_INVALID,"");
+    return UNUR_ERR_GEN_INVALID;
+  }
+
+  /* Umin and Umax are stored in the memory block of the tables */
+  urange = _Runuran_arena_pinv_urange( _Runuran_arena_compact(gen) );
+  if (urange == NULL) {
+    _unur_error(gen->genid,UNUR_ERR_GEN_DATA,"tables not in single memory block");
+    return UNUR_ERR_GEN_DATA;
+  }
+
+  /* check new parameter for generator */
+  if (left < DISTR.domain[0]) {
+    _unur_warning(gen->genid,UNUR_ERR_DISTR_SET,"domain, increase left boundary");
+    left = DISTR.domain[0];
+  }
+  if (right > DISTR.domain[1]) {
+    _unur_warning(gen->genid,UNUR_ERR_DISTR_SET,"domain, decrease right boundary");
+    right = DISTR.domain[1];
+  }
+  if (!_unur_FP_less(left,right)) {
+    _unur_error(gen->genid,UNUR_ERR_DISTR_SET,"domain, left >= right");
+    return UNUR_ERR_DISTR_SET;
+  }
+
+  /* compute approximate CDF at boundary points */
+  Umin = _pinv_eval_approxcdf(gen,left);
+  Umax = _pinv_eval_approxcdf(gen,right);
+
+  /* check result (same checks as in unur_hinv_chg_truncated()) */
+  if (Umin > Umax) {
+    /* this is a serious error that should not happen */
+    _unur_error(gen->genid,UNUR_ERR_SHOULD_NOT_HAPPEN,"");
+    return UNUR_ERR_SHOULD_NOT_HAPPEN;
+  }
+
+  if (_unur_FP_equal(Umin,Umax)) {
+    /* CDF values very close */
+    _unur_warning(gen->genid,UNUR_ERR_DISTR_SET,"CDF values very close");
+    if (_unur_iszero(Umin) || _unur_FP_same(Umax,1.)) {
+      /* this is very bad */
+      _unur_error(gen->genid,UNUR_ERR_DISTR_SET,"CDF values at boundary points too close");
+      return UNUR_ERR_DISTR_SET;
+    }
+  }
+
+  /* copy new boundaries into generator object */
+  DISTR.trunc[0] = left;
+  DISTR.trunc[1] = right;
+  urange[0] = Umin;
+  urange[1] = Umax;
+
+  /* changelog */
+  gen->distr->set |= UNUR_DISTR_SET_TRUNCATED;
+
+  /* sampling routine maps U into [Umin,Umax] */
+  gen->sample.cont = _pinv_trunc_sample;
+
+  return UNUR_SUCCESS;
+} /* end of _Runuran_pinv_chg_truncated() */
+
+/*---------------------------------------------------------------------------*/
+
+int
+_Runuran_pinv_is_truncated (const struct unur_gen *gen)
+     /*----------------------------------------------------------------------*/
+     /* Check whether generator object implements method PINV with a         */
+     /* truncated domain set by _Runuran_pinv_chg_truncated().               */
+     /*                                                                      */
+     /* Parameters:                                                          */
+     /*   gen ... pointer to UNU.RAN generator object                        */
+     /*                                                                      */
+     /* Return:                                                              */
+     /*   TRUE if truncated, FALSE otherwise                                 */
+     /*----------------------------------------------------------------------*/
+{
+  return (gen->method == UNUR_METH_PINV && gen->sample.cont == _pinv_trunc_sample);
+} /* end of _Runuran_pinv_is_truncated() */
+
+/*---------------------------------------------------------------------------*/
+
+double
+_Runuran_pinv_trunc_eval_approxinvcdf (const struct unur_gen *gen, double u)
+     /*----------------------------------------------------------------------*/
+     /* Evaluate approximate inverse CDF of truncated distribution.          */
+     /* (adapted from unur_hinv_eval_approxinvcdf() in methods/hinv.c)       */
+     /*                                                                      */
+     /* Parameters:                                                          */
+     /*   gen ... pointer to PINV generator object with truncated domain     */
+     /*   u   ... argument for inverse CDF (0<=u<=1)                         */
+     /*                                                                      */
+     /* Return:                                                              */
+     /*   double (approximate inverse CDF)                                   */
+     /*----------------------------------------------------------------------*/
+{
+  const double *urange = _Runuran_arena_pinv_urange(gen);
+  double x;
+
+  if ( ! (u>0. && u<1.)) {
+    if ( ! (u>=0. && u<=1.)) {
+      _unur_warning(gen->genid,UNUR_ERR_DOMAIN,"U not in [0,1]");
+    }
+    if (u<=0.) return DISTR.trunc[0];
+    if (u>=1.) return DISTR.trunc[1];
+    return u;  /* = NaN */
+  }
+
+  /* rescale given u */
+  u = urange[0] + u * (urange[1] - urange[0]);
+
+  /* compute inverse CDF */
+  x = _pinv_eval_approxinvcdf(gen,u);
+
+  /* validate range */
+  if (x<DISTR.trunc[0]) x = DISTR.trunc[0];
+  if (x>DISTR.trunc[1]) x = DISTR.trunc[1];
+
+  return x;
+} /* end of _Runuran_pinv_trunc_eval_approxinvcdf() */
+
+/*---------------------------------------------------------------------------*/
+
+double
+_pinv_trunc_sample (struct unur_gen *gen)
+     /*----------------------------------------------------------------------*/
+     /* Sample from generator object with truncated domain.                  */
+     /* (adapted from _unur_hinv_sample() in methods/hinv.c)                 */
+     /*                                                                      */
+     /* Parameters:                                                          */
+     /*   gen ... pointer to PINV generator object                           */
+     /*                                                                      */
+     /* Return:                                                              */
+     /*   double (sample from random variate)                                */
+     /*----------------------------------------------------------------------*/
+{
+  const double *urange = _Runuran_arena_pinv_urange(gen);
+  double U,X;
+
+  /* sample from U(Umin,Umax) */
+  U = urange[0] + _unur_call_urng(gen->urng) * (urange[1] - urange[0]);
+
+  /* compute inverse CDF */
+  X = _pinv_eval_approxinvcdf(gen,U);
+
+  if (X<DISTR.trunc[0]) return DISTR.trunc[0];
+  if (X>DISTR.trunc[1]) return DISTR.trunc[1];
+
+  return X;
+} /* end of _pinv_trunc_sample() */
+
+/*---------------------------------------------------------------------------*/
+
+double
+_pinv_eval_approxinvcdf (const struct unur_gen *gen, double u)
+     /*----------------------------------------------------------------------*/
+     /* Evaluate approximate inverse CDF (interpolating polynomial).         */
+     /* (adapted from _unur_pinv_eval_approxinvcdf() in                      */
+     /* methods/pinv_sample.ch)                                              */
+     /*                                                                      */
+     /* Parameters:                                                          */
+     /*   gen ... pointer to PINV generator object                           */
+     /*   u   ... argument for inverse CDF (0<=u<=1)                         */
+     /*                                                                      */
+     /* Return:                                                              */
+     /*   double (approximate inverse CDF)                                   */
+     /*----------------------------------------------------------------------*/
+{
+  int i,j;
+  double x,un;
+
+  /* rescale for range (0, Umax) */
+  un = u * GEN->Umax;
+
+  /* look up in guide table and search for interval */
+  /* (u == Umax == 1 may occur after rounding in U(Umin,Umax)) */
+  j = (int)(u * GEN->guide_size);
+  i = GEN->guide[(j < GEN->guide_size) ? j : GEN->guide_size-1];
+  while (GEN->iv[i+1].cdfi < un)
+    i++;
+
+  /* rescale for range (0, CDF(right)-CDF(left) for interval) */
+  un -= GEN->iv[i].cdfi;
+
+  /* evaluate polynomial */
+  x = _pinv_newton_eval(un, GEN->iv[i].ui, GEN->iv[i].zi, GEN->order, NULL);
+
+  return (GEN->iv)[i].xi + x;
+} /* end of _pinv_eval_approxinvcdf() */
+
+/*---------------------------------------------------------------------------*/
+
+double
+_pinv_eval_approxcdf (const struct unur_gen *gen, double x)
+     /*----------------------------------------------------------------------*/
+     /* Evaluate approximate CDF, i.e., the inverse of the interpolating     */
+     /* polynomial. The interval that contains 'x' is found by bisection in  */
+     /* the table of construction points. Then the polynomial is inverted by */
+     /* Newton's method which falls back to bisection when the Newton step   */
+     /* leaves the bracket.                                                  */
+     /*                                                                      */
+     /* Parameters:                                                          */
+     /*   gen ... pointer to PINV generator object                           */
+     /*   x   ... argument for CDF                                           */
+     /*                                                                      */
+     /* Return:                                                              */
+     /*   double (approximate CDF)                                           */
+     /*----------------------------------------------------------------------*/
+{
+  const struct unur_pinv_interval *iv = GEN->iv;
+  int i, lo, hi;
+  int iter;
+  double d, t, tnew, a, b;
+  double f, df;
+
+  /* outside of computational domain */
+  if (! (x > iv[0].xi)) return 0.;
+  if (! (x < iv[GEN->n_ivs].xi)) return 1.;
+
+  /* find interval:  iv[i].xi <= x < iv[i+1].xi  */
+  lo = 0;  hi = GEN->n_ivs;
+  while (hi - lo > 1) {
+    i = (lo + hi) / 2;
+    if (iv[i].xi <= x) lo = i; else hi = i;
+  }
+  i = lo;
+
+  /* we have to solve  p(t) = x - xi  for  0 <= t <= cdf[i+1] - cdf[i]. */
+  d = x - iv[i].xi;
+  a = 0.;
+  b = iv[i+1].cdfi - iv[i].cdfi;
+
+  /* starting point: linear interpolation */
+  t = b * d / (iv[i+1].xi - iv[i].xi);
+
+  for (iter=0; iter < PINV_TRUNC_MAX_ITER; iter++) {
+    f = _pinv_newton_eval(t, iv[i].ui, iv[i].zi, GEN->order, &df) - d;
+    if (fabs(f) <= DBL_EPSILON * fabs(x))
+      break;
+
+    /* update bracket */
+    if (f < 0.) a = t; else b = t;
+
+    /* Newton step; use bisection if it leaves the bracket */
+    tnew = (df > 0.) ? t - f/df : a;
+    if (! (tnew > a && tnew < b))
+      tnew = 0.5 * (a + b);
+    if (_unur_FP_same(tnew,t))
+      break;
+    t = tnew;
+  }
+
+  return (iv[i].cdfi + t) / GEN->Umax;
+} /* end of _pinv_eval_approxcdf() */
+
+/*---------------------------------------------------------------------------*/
+
+double
+_pinv_newton_eval (double q, const double *ui, const double *zi, int order, double *dx)
+     /*----------------------------------------------------------------------*/
+     /* Evaluate Newton polynomial and (optionally) its derivative.          */
+     /* (adapted from _unur_pinv_newton_eval() in methods/pinv_newton.ch)    */
+     /*                                                                      */
+     /* Parameters:                                                          */
+     /*   q     ... argument                                                 */
+     /*   ui    ... nodes of polynomial                                      */
+     /*   zi    ... coefficients of polynomial                               */
+     /*   order ... order of polynomial                                      */
+     /*   dx    ... pointer for storing derivative at 'q' (or NULL)          */
+     /*                                                                      */
+     /* Return:                                                              */
+     /*   value of polynomial at 'q'                                         */
+     /*----------------------------------------------------------------------*/
+{
+  int k;
+  double chi, dchi;
+
+  chi = zi[order-1];
+  dchi = 0.;
+  for (k=order-2; k>=0; k--) {
+    dchi = dchi*(q-ui[k]) + chi;
+    chi = chi*(q-ui[k]) + zi[k];
+  }
+
+  if (dx) *dx = chi + dchi*q;
+  return (chi*q);
+} /* end of _pinv_newton_eval() */
+
+/*---------------------------------------------------------------------------*/
+
 double
 _pinv_eval (double U, double Umax, int order, int guide_size, int *guide, double *iv)
      /*----------------------------------------------------------------------*/
@@ -330,3 +735,185 @@ _pinv_eval (double U, double Umax, int order, int guide_size, int *guide, double
 } /* end of _pinv_eval() */
 
 /*---------------------------------------------------------------------------*/
+
+double
+_pinv_eval_compact (double U, double Umax, int order,
+		    int guide_size, int *guide, double *iv, int *cf)
+     /*----------------------------------------------------------------------*/
+     /* Evaluate approximating polynomial (compact mode).                    */
+     /*                                                                      */
+     /* Parameters:                                                          */
+     /*   U          ... u-value ~ U(0,1)                                    */
+     /*   Umax       ... upper bound of computational  domain for U          */
+     /*   order      ... order of Newton polynomial                          */
+     /*   guide_size ... size of guide table                                 */
+     /*   guide      ... guide table                                         */
+     /*   iv         ... array of cdfi and xi for all intervals              */
+     /*   cf         ... array of scaled coefficients (single precision)     */
+     /*                                                                      */
+     /* Return:                                                              */
+     /*   (approximate) quantiles for given 'U' values                       */
+     /*----------------------------------------------------------------------*/
+{
+  int I;
+  double V,X;
+  const int *c;
+  int k;
+
+  /* transform U ~ U(0,1) to V ~ U(0,Umax) */
+  V = Umax * U;
+
+  /* find interval */
+  I = guide[(int) (U * guide_size)];
+  while (V > iv[I+2]) I+=2;
+
+  /* rescale V to [0,1] */
+  V = (iv[I+2] > iv[I]) ? (V - iv[I]) / (iv[I+2] - iv[I]) : 0.;
+
+  /* compute interpolating polynomial for corresponding interval */
+  c = cf + (I/2) * (2*order-1);
+
+  X = _Runuran_int_to_float(c[0]);
+  for (k=1; k<order; k++)
+    X = X*(V-_Runuran_int_to_float(c[2*k-1])) + _Runuran_int_to_float(c[2*k]);
+  X = V*X + iv[I+1];
+
+  /* return result */
+  return X;
+
+} /* end of _pinv_eval_compact() */
+
+/*---------------------------------------------------------------------------*/
+
+void
+_pinv_compact_coeff (struct unur_gen *gen, int i, double *cf)
+     /*----------------------------------------------------------------------*/
+     /* Compute scaled coefficients of polynomial in interval 'i' rounded to */
+     /* single precision.                                                    */
+     /*                                                                      */
+     /* The Newton polynomial in interval [cdfi, cdfi+h] is evaluated at     */
+     /* V/h in [0,1]. Thus z[k] is multiplied by h^(k+1) and u[k] is         */
+     /* divided by h. Then all coefficients are of the same magnitude as     */
+     /* the length of the interval in x-scale and can be stored as offsets   */
+     /* to xi in single precision.                                           */
+     /*                                                                      */
+     /* Parameters:                                                          */
+     /*   gen ... pointer to UNU.RAN generator object                        */
+     /*   i   ... index of interval                                          */
+     /*   cf  ... array for storing 2*order-1 coefficients                   */
+     /*           z[order-1], u[order-2], z[order-2], ..., u[0], z[0]        */
+     /*----------------------------------------------------------------------*/
+{
+  double h, hk;
+  int k, n;
+
+  /* length of interval (the last "interval" is a sentinel) */
+  h = (i < GEN->n_ivs) ? GEN->iv[i+1].cdfi - GEN->iv[i].cdfi : 1.;
+  if (! (h > 0.)) h = 1.;
+
+  n = 0;
+  k = GEN->order - 1;
+  hk = pow(h, (double) GEN->order);
+  cf[n++] = (float) (GEN->iv[i].zi[k] * hk);
+  for (k--; k>=0; k--) {
+    hk /= h;
+    cf[n++] = (float) (GEN->iv[i].ui[k] / h);
+    cf[n++] = (float) (GEN->iv[i].zi[k] * hk);
+  }
+
+} /* end of _pinv_compact_coeff() */
+
+/*---------------------------------------------------------------------------*/
+
+double
+_pinv_compact_uerror (struct unur_gen *gen)
+     /*----------------------------------------------------------------------*/
+     /* Estimate additional u-error caused by single precision coefficients. */
+     /*                                                                      */
+     /* We compare the polynomials in double and single precision at a few   */
+     /* points in each interval and convert the difference in x into an      */
+     /* error in u by means of the slope of the interval.                    */
+     /*                                                                      */
+     /* Parameters:                                                          */
+     /*   gen ... pointer to UNU.RAN generator object                        */
+     /*                                                                      */
+     /* Return:                                                              */
+     /*   estimated maximal u-error                                          */
+     /*----------------------------------------------------------------------*/
+{
+#define N_TEST (4)
+  double *cf;
+  double h, dx, t, V, Xd, Xf;
+  double err, max_err = 0.;
+  int i, j, k, order;
+
+  order = GEN->order;
+  cf = (double *) R_alloc(2*order-1, sizeof(double));
+
+  for (i=0; i<GEN->n_ivs; i++) {
+    h = GEN->iv[i+1].cdfi - GEN->iv[i].cdfi;
+    dx = GEN->iv[i+1].xi - GEN->iv[i].xi;
+    _pinv_compact_coeff(gen, i, cf);
+    for (k=0; k<2*order-1; k++)
+      if (! _unur_isfinite(cf[k])) return UNUR_INFINITY;
+
+    /* intervals shorter than the u-resolution are ignored */
+    /* (they only occur in the extreme tails).             */
+    if (! (h > GEN->u_resolution && _unur_isfinite(dx) && fabs(dx) > 0.)) continue;
+
+    for (j=1; j<=N_TEST; j++) {
+      t = ((double) j) / N_TEST;
+
+      /* double precision */
+      V = t * h;
+      k = order - 1;
+      Xd = GEN->iv[i].zi[k];
+      for (k--; k>=0; k--)
+	Xd = Xd*(V-GEN->iv[i].ui[k]) + GEN->iv[i].zi[k];
+      Xd = V*Xd + GEN->iv[i].xi;
+
+      /* single precision */
+      Xf = cf[0];
+      for (k=1; k<order; k++)
+	Xf = Xf*(t-cf[2*k-1]) + cf[2*k];
+      Xf = t*Xf + GEN->iv[i].xi;
+
+      err = fabs(Xf - Xd) * h / fabs(dx);
+      if (err > max_err) max_err = err;
+    }
+  }
+
+  return max_err;
+#undef N_TEST
+} /* end of _pinv_compact_uerror() */
+
+/*---------------------------------------------------------------------------*/
+
+int
+_Runuran_float_to_int (double x)
+     /*----------------------------------------------------------------------*/
+     /* Round x to single precision and store bit pattern as integer.        */
+     /* (R has no single precision vectors. Integer vectors are portable    */
+     /* between platforms with different byte orders.)                       */
+     /*----------------------------------------------------------------------*/
+{
+  float f = (float) x;
+  int i;
+  memcpy(&i, &f, sizeof(int));
+  return i;
+} /* end of _Runuran_float_to_int() */
+
+/*---------------------------------------------------------------------------*/
+
+double
+_Runuran_int_to_float (int i)
+     /*----------------------------------------------------------------------*/
+     /* Convert bit pattern created by _Runuran_float_to_int() into number.  */
+     /*----------------------------------------------------------------------*/
+{
+  float f;
+  memcpy(&f, &i, sizeof(float));
+  return (double) f;
+} /* end of _Runuran_int_to_float() */
+
+/*---------------------------------------------------------------------------*/
@@ -0,0 +1,1020 @@
+/*****************************************************************************
+ *                                                                           *
+ *          UNU.RAN -- Universal Non-Uniform Random number generator         *
+ *                                                                           *
+ *****************************************************************************
+ *                                                                           *
+ *   FILE: Runuran_pinv_lazy.c                                               *
+ *                                                                           *
+ *   PURPOSE:                                                                *
+ *         Lazy setup for method PINV                                        *
+ *                                                                           *
+ *****************************************************************************
+ *                                                                           *
+ *   Copyright (c) 2026 Wolfgang Hoermann and Josef Leydold                  *
+ *   Dept. for Statistics, University of Economics, Vienna, Austria          *
+ *                                                                           *
+ *   This program is free software; you can redistribute it and/or modify    *
+ *   it under the terms of the GNU General Public License as published by    *
+ *   the Free Software Foundation; either version 2 of the License, or       *
+ *   (at your option) any later version.                                     *
+ *                                                                           *
+ *   This program is distributed in the hope that it will be useful,         *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of          *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the           *
+ *   GNU General Public License for more details.                            *
+ *                                                                           *
+ *   You should have received a copy of the GNU General Public License       *
+ *   along with this program; if not, write to the                           *
+ *   Free Software Foundation, Inc.,                                         *
+ *   59 Temple Place, Suite 330, Boston, MA 02111-1307, USA                  *
+ *                                                                           *
+ *****************************************************************************
+ *                                                                           *
+ *   The setup of method PINV consists of two parts: (1) the area below      *
+ *   the PDF is computed by means of an adaptive Gauss-Lobatto integration   *
+ *   and (2) the interpolating polynomials are computed in Newton            *
+ *   interpolation intervals. For small u-resolutions the second part is     *
+ *   by far the most expensive one. When only a part of the quantile         *
+ *   function is required (e.g., for quantiles in [0.01,0.99]) most of       *
+ *   this work is wasted.                                                    *
+ *                                                                           *
+ *   Thus we split the setup: At creation of the generator object only the   *
+ *   computational domain and the table of the Lobatto integration are       *
+ *   computed (the "skeleton"). The nodes of this table close to a fixed     *
+ *   grid of u-values (with the points 10^(-k) and 1-10^(-k) in the tails)   *
+ *   are used as boundaries of segments of the domain. The corresponding     *
+ *   values of the CDF are read from the table as well.                      *
+ *   The PINV generator object for a segment is created when the first       *
+ *   u-value falls into this segment. Its u-resolution is scaled by the      *
+ *   probability of the segment such that the u-error for the whole          *
+ *   distribution remains below the requested u-resolution.                  *
+ *                                                                           *
+ *   The generator object is a wrapper for an external generator (method     *
+ *   CEXT). The routines for destroying and cloning the wrapper are          *
+ *   replaced such that the segments are freed and copied as well.           *
+ *   Every clone has its own copy of the segments.                           *
+ *                                                                           *
+ *   The segments are built while sampling, possibly in several threads      *
+ *   (e.g., by packages that call quantile_array() via the C API). A new     *
+ *   segment is built without holding a lock and published by an atomic      *
+ *   compare-and-swap; the loser of a race frees its copy. We do not use a   *
+ *   mutex as the PDF may be an R function that leaves by longjmp() and      *
+ *   would never release it. When the setup of a segment fails, only this    *
+ *   segment is marked as failed and returns UNUR_INFINITY; all other        *
+ *   segments can still be used.                                             *
+ *                                                                           *
+ *   The computational domain must be computed exactly as in the setup of    *
+ *   method PINV (otherwise the u-errors of the segments would not add up    *
+ *   to the requested u-resolution). The corresponding routines of the       *
+ *   library (_unur_pinv_relevant_support(), _unur_pinv_searchborder(),      *
+ *   _unur_pinv_approx_pdfarea(), _unur_pinv_computational_domain(),         *
+ *   _unur_pinv_cut(), and _unur_pinv_cut_bisect() in methods/pinv_prep.ch)  *
+ *   are static and operate on the PINV generator object, and there is no    *
+ *   public entry point that runs only the preprocessing step of PINV (the   *
+ *   expensive Newton interpolation always follows). As we do not modify     *
+ *   the bundled library, these routines are copied below with the fields    *
+ *   of 'struct unur_pinv_gen' replaced by those of 'struct                  *
+ *   Runuran_pinv_lazy'. They must be kept in sync with the library.         *
+ *                                                                           *
+ *****************************************************************************/
+
+/*---------------------------------------------------------------------------*/
+
+#include "Runuran.h"
+
+/* internal header files for UNU.RAN */
+#include <unur_source.h>
+#include <distr/distr_source.h>
+#include <methods/cext_struct.h>
+#include <utils/lobatto_source.h>
+
+/* we need C11 atomics if segments may be created concurrently */
+#if defined(HAVE_STDATOMIC_H) && !defined(__STDC_NO_ATOMICS__)
+#  define RUNURAN_LAZY_ATOMIC 1
+#  include <stdatomic.h>
+#endif
+
+/*---------------------------------------------------------------------------*/
+
+/* constants (copied from methods/pinv.c) */
+#define PINV_UERROR_CORRECTION  (0.9)
+#define PINV_MAX_LOBATTO_IVS    (20001)
+#define PINV_PDFLLIM            (1.e-13)
+#define PINV_UERROR_AREA_APPROX (1.e-5)
+#define PINV_TAILCUTOFF_FACTOR  (0.05)
+#define PINV_TAILCUTOFF_MAX     (1.e-10)
+#define PINV_UTOL_CORRECTION    (0.05)
+
+/* maximal u-resolution for method PINV */
+#define PINV_MAX_URESOLUTION    (1.e-5)
+
+/* u-values for boundaries of segments (central part) */
+static const double lazy_ugrid[] = { 0.1, 0.5, 0.9 };
+#define LAZY_N_UGRID  (3)
+
+/*---------------------------------------------------------------------------*/
+
+/* pointer to segment and failure flag (read and written by several threads) */
+#ifdef RUNURAN_LAZY_ATOMIC
+typedef _Atomic(struct unur_gen *) lazy_seg_t;
+typedef atomic_char lazy_flag_t;
+#else
+typedef struct unur_gen *lazy_seg_t;
+typedef char lazy_flag_t;
+#endif
+
+/*---------------------------------------------------------------------------*/
+
+struct Runuran_pinv_lazy {
+  double u_resolution;    /* maximal u-error                                 */
+  int    smooth;          /* smoothness parameter                            */
+  double bleft, bright;   /* boundary of computational domain                */
+  double dleft, dright;   /* boundary of domain of distribution              */
+  int    sleft, sright;   /* whether to search for boundary                  */
+  double area;            /* area below PDF                                  */
+  int    n_seg;           /* number of segments                              */
+  double *xb;             /* boundaries of segments [n_seg+1]                */
+  double *ub;             /* CDF at boundaries of segments [n_seg+1]         */
+  lazy_seg_t *seg;        /* PINV generators for segments (or NULL) [n_seg]  */
+  lazy_flag_t *failed;    /* TRUE if setup of segment has failed [n_seg]     */
+};
+
+/*---------------------------------------------------------------------------*/
+
+static double _lazy_sample (struct unur_gen *gen);
+/*---------------------------------------------------------------------------*/
+/* Sample from lazy PINV generator (sampling routine for method CEXT).       */
+/*---------------------------------------------------------------------------*/
+
+static int _lazy_skeleton (struct unur_gen *gen);
+/*---------------------------------------------------------------------------*/
+/* Compute computational domain and boundaries of segments.                  */
+/*---------------------------------------------------------------------------*/
+
+static struct unur_gen *_lazy_make_segment (struct unur_gen *gen, int k);
+/*---------------------------------------------------------------------------*/
+/* Create PINV generator object for segment 'k'.                             */
+/*---------------------------------------------------------------------------*/
+
+static struct unur_gen *_lazy_get_segment (struct unur_gen *gen, int k);
+/*---------------------------------------------------------------------------*/
+/* Get PINV generator object for segment 'k' (create it on first use).       */
+/*---------------------------------------------------------------------------*/
+
+static void _lazy_free (struct unur_gen *gen);
+/*---------------------------------------------------------------------------*/
+/* Destroy generator object (including segments).                           */
+/*---------------------------------------------------------------------------*/
+
+static struct unur_gen *_lazy_clone (const struct unur_gen *gen);
+/*---------------------------------------------------------------------------*/
+/* Copy generator object (including segments).                               */
+/*---------------------------------------------------------------------------*/
+
+static double _lazy_eval_PDF (double x, struct unur_gen *gen);
+static int _lazy_relevant_support (struct unur_gen *gen);
+static double _lazy_searchborder (struct unur_gen *gen, double x0, double bound,
+				  double *dom, int *search);
+static int _lazy_approx_pdfarea (struct unur_gen *gen);
+static int _lazy_computational_domain (struct unur_gen *gen);
+static double _lazy_cut (struct unur_gen *gen, double w, double dw, double crit);
+static double _lazy_cut_bisect (struct unur_gen *gen, double x0, double x1);
+/*---------------------------------------------------------------------------*/
+/* Auxiliary routines for computing the computational domain.                */
+/* (copied from methods/pinv_prep.ch and methods/pinv_init.ch as they are    */
+/* static in the library; see the remark at the top of this file.)           */
+/*---------------------------------------------------------------------------*/
+
+/* original routines of method CEXT */
+static void (*_cext_free)(struct unur_gen *gen) = NULL;
+static struct unur_gen *(*_cext_clone)(const struct unur_gen *gen) = NULL;
+
+/*---------------------------------------------------------------------------*/
+
+#define GEN       ((struct unur_cext_gen*)gen->datap)
+#define LAZY      ((struct Runuran_pinv_lazy*)GEN->param)
+#define DISTR     gen->distr->data.cont
+#define PDF(x)    (_lazy_eval_PDF((x),(gen)))
+
+/*****************************************************************************/
+
+SEXP
+Runuran_pinv_lazy (SEXP sexp_obj, SEXP sexp_distr, SEXP sexp_ures, SEXP sexp_smooth)
+     /*----------------------------------------------------------------------*/
+     /* Create UNU.RAN generator object for method PINV with lazy setup.     */
+     /*                                                                      */
+     /* Parameters:                                                          */
+     /*   obj    ... S4 class that contains 'Runuran' generator object       */
+     /*   distr  ... pointer to UNU.RAN distribution object                  */
+     /*   ures   ... maximal tolerated u-error                               */
+     /*   smooth ... smoothness parameter                                    */
+     /*                                                                      */
+     /* Return:                                                              */
+     /*   pointer to UNU.RAN generator object                                */
+     /*----------------------------------------------------------------------*/
+{
+  struct unur_distr *distr;
+  struct unur_par *par;
+  struct unur_gen *gen;
+  struct Runuran_pinv_lazy *lazy;
+  double ures;
+  SEXP sexp_gen;
+  SEXP sexp_is_inversion;
+
+  /* check arguments */
+  CHECK_DISTR_PTR(sexp_distr);
+  distr = R_ExternalPtrAddr(sexp_distr);
+  if (distr == NULL || unur_distr_get_type(distr) != UNUR_DISTR_CONT)
+    Rf_errorcall(R_NilValue,"[UNU.RAN - error] invalid argument 'distr'");
+  if (unur_distr_cont_get_pdf(distr) == NULL)
+    Rf_errorcall(R_NilValue,"[UNU.RAN - error] lazy setup requires PDF");
+
+  ures = Rf_asReal(sexp_ures);
+  if (! (ures <= PINV_MAX_URESOLUTION * 1.001)) {
+    Rf_warningcall(R_NilValue,"[UNU.RAN - warning] u-resolution too large --> use 1.e-5 instead");
+    ures = PINV_MAX_URESOLUTION;
+  }
+  if (ures < 0.999e-15) {
+    Rf_warningcall(R_NilValue,"[UNU.RAN - warning] u-resolution too small --> use 1.e-15 instead");
+    ures = 1.e-15;
+  }
+
+  /* create wrapper (method CEXT) */
+  par = unur_cext_new(distr);
+  unur_cext_set_sample(par, _lazy_sample);
+  gen = unur_init(par);
+  if (gen == NULL)
+    Rf_errorcall(R_NilValue,"[UNU.RAN - error] cannot create UNU.RAN object");
+
+  /* replace routines for destroying and cloning the generator object */
+  _cext_free = gen->destroy;
+  _cext_clone = gen->clone;
+  gen->destroy = _lazy_free;
+  gen->clone = _lazy_clone;
+
+  /* parameters */
+  lazy = unur_cext_get_params(gen, sizeof(struct Runuran_pinv_lazy));
+  memset(lazy, 0, sizeof(struct Runuran_pinv_lazy));
+  lazy->u_resolution = ures;
+  lazy->smooth = Rf_asInteger(sexp_smooth);
+
+  /* compute skeleton */
+  if (_lazy_skeleton(gen) != UNUR_SUCCESS) {
+    unur_free(gen);
+    Rf_errorcall(R_NilValue,"[UNU.RAN - error] cannot create UNU.RAN object");
+  }
+
+  /* we have an inversion method */
+  PROTECT(sexp_is_inversion = Rf_allocVector(LGLSXP, 1));
+  LOGICAL(sexp_is_inversion)[0] = TRUE;
+  R_do_slot_assign(sexp_obj, Rf_install("inversion"), sexp_is_inversion);
+
+  /* make R external pointer and store pointer to structure */
+  PROTECT(sexp_gen = R_MakeExternalPtr(gen, _Runuran_tag(), sexp_obj));
+  
+  /* register destructor as C finalizer */
+  R_RegisterCFinalizer(sexp_gen, _Runuran_free);
+
+  /* return pointer to R */
+  UNPROTECT(2);
+  return (sexp_gen);
+
+} /* end of Runuran_pinv_lazy() */
+
+/*---------------------------------------------------------------------------*/
+
+int
+_Runuran_pinv_is_lazy (const struct unur_gen *gen)
+     /*----------------------------------------------------------------------*/
+     /* Check whether generator object uses lazy setup for method PINV.      */
+     /*                                                                      */
+     /* Parameters:                                                          */
+     /*   gen ... pointer to UNU.RAN generator object                        */
+     /*                                                                      */
+     /* Return:                                                              */
+     /*   TRUE if 'gen' is a lazy PINV generator, FALSE otherwise            */
+     /*----------------------------------------------------------------------*/
+{
+  return (gen->method == UNUR_METH_CEXT && gen->sample.cont == _lazy_sample);
+} /* end of _Runuran_pinv_is_lazy() */
+
+/*---------------------------------------------------------------------------*/
+
+double
+_Runuran_pinv_lazy_eval_approxinvcdf (struct unur_gen *gen, double u)
+     /*----------------------------------------------------------------------*/
+     /* Evaluate approximate inverse CDF. The segment that contains 'u' is   */
+     /* created when required.                                               */
+     /*                                                                      */
+     /* Parameters:                                                          */
+     /*   gen ... pointer to lazy PINV generator object                      */
+     /*   u   ... argument for inverse CDF (0<=u<=1)                         */
+     /*                                                                      */
+     /* Return:                                                              */
+     /*   double (approximate inverse CDF)                                   */
+     /*                                                                      */
+     /* Error:                                                               */
+     /*   return UNUR_INFINITY                                               */
+     /*----------------------------------------------------------------------*/
+{
+  struct Runuran_pinv_lazy *lazy = LAZY;
+  struct unur_gen *seg;
+  int lo, hi, k;
+
+  /* boundary of domain (as in unur_pinv_eval_approxinvcdf()) */
+  if ( ! (u>0. && u<1.)) {
+    if ( ! (u>=0. && u<=1.)) {
+      _unur_warning(gen->genid,UNUR_ERR_DOMAIN,"U not in [0,1]");
+    }
+    if (u<=0.) return DISTR.domain[0];
+    if (u>=1.) return DISTR.domain[1];
+    return u;  /* = NaN */
+  }
+
+  /* find segment: ub[k] <= u < ub[k+1] */
+  lo = 0; hi = lazy->n_seg;
+  while (hi - lo > 1) {
+    k = (lo + hi) / 2;
+    if (lazy->ub[k] <= u) lo = k; else hi = k;
+  }
+  k = lo;
+
+  /* get segment (create it on first use) */
+  seg = _lazy_get_segment(gen,k);
+  if (seg == NULL)
+    return UNUR_INFINITY;
+
+  /* evaluate inverse CDF of segment */
+  return unur_pinv_eval_approxinvcdf(seg, (u - lazy->ub[k]) / (lazy->ub[k+1] - lazy->ub[k]));
+} /* end of _Runuran_pinv_lazy_eval_approxinvcdf() */
+
+/*---------------------------------------------------------------------------*/
+
+double
+_lazy_sample (struct unur_gen *gen)
+     /*----------------------------------------------------------------------*/
+     /* Sample from lazy PINV generator.                                     */
+     /*                                                                      */
+     /* Parameters:                                                          */
+     /*   gen ... pointer to generator object                                */
+     /*                                                                      */
+     /* Return:                                                              */
+     /*   double (sample from random variate)                                */
+     /*----------------------------------------------------------------------*/
+{
+  return _Runuran_pinv_lazy_eval_approxinvcdf(gen, _unur_call_urng(gen->urng));
+} /* end of _lazy_sample() */
+
+/*---------------------------------------------------------------------------*/
+
+int
+_lazy_skeleton (struct unur_gen *gen)
+     /*----------------------------------------------------------------------*/
+     /* Compute computational domain, the table of the Lobatto integration   */
+     /* and the boundaries of the segments.                                  */
+     /*                                                                      */
+     /* Parameters:                                                          */
+     /*   gen ... pointer to generator object                                */
+     /*                                                                      */
+     /* Return:                                                              */
+     /*   UNUR_SUCCESS ... on success                                        */
+     /*   error code   ... on error                                          */
+     /*----------------------------------------------------------------------*/
+{
+  struct Runuran_pinv_lazy *lazy = LAZY;
+  struct Runuran_lobatto **stored;  /* table stored in distribution object */
+  struct Runuran_lobatto *tab;
+  double area_approx, tol;
+  double *ut;         /* u-values for boundaries of segments */
+  int n_ut, K;
+  double cum;         /* cumulated area at node */
+  int i, j, k;
+
+  /* domain of distribution (copied from methods/pinv_init.ch) */
+  lazy->dleft = lazy->bleft = DISTR.domain[0];
+  lazy->dright = lazy->bright = DISTR.domain[1];
+  lazy->sleft = lazy->sright = TRUE;
+  DISTR.center = unur_distr_cont_get_center(gen->distr);
+  DISTR.center = _unur_max(DISTR.center,lazy->dleft);
+  DISTR.center = _unur_min(DISTR.center,lazy->dright);
+  if (_unur_distr_cont_find_center(gen->distr) != UNUR_SUCCESS) {
+    _unur_error(gen->genid,UNUR_ERR_GEN_CONDITION,"PDF(center) <= 0.");
+    return UNUR_ERR_GEN_CONDITION;
+  }
+
+  /* table for Lobatto integration from a previous setup (if any) */
+  stored = _Runuran_cont_lobatto_slot(gen->distr);
+
+  /* computational domain (copied from methods/pinv_prep.ch) */
+  lazy->area = DISTR.area;
+  if (_lazy_relevant_support(gen) != UNUR_SUCCESS)
+    return UNUR_FAILURE;
+  if (stored && *stored) {
+    /* we already have a good approximation for the area */
+    lazy->area = _Runuran_lobatto_integral(*stored);
+  }
+  else {
+    if (_lazy_approx_pdfarea(gen) != UNUR_SUCCESS)
+      return UNUR_FAILURE;
+  }
+  area_approx = lazy->area;
+  if (_lazy_computational_domain(gen) != UNUR_SUCCESS)
+    return UNUR_FAILURE;
+
+  /* table for Lobatto integration (reuse subintervals of stored table) */
+  tol = lazy->u_resolution * lazy->area * PINV_UERROR_CORRECTION * PINV_UTOL_CORRECTION;
+  DISTR.center = _unur_max(DISTR.center, lazy->bleft);
+  DISTR.center = _unur_min(DISTR.center, lazy->bright);
+  tab = _Runuran_lobatto_new((stored) ? *stored : NULL, _lazy_eval_PDF, gen,
+			     lazy->bleft, DISTR.center, lazy->bright, tol);
+  if (tab == NULL)
+    return UNUR_FAILURE;
+  lazy->area = _Runuran_lobatto_integral(tab);
+  if ( !_unur_isfinite(lazy->area) || _unur_iszero(lazy->area) ) {
+    _unur_error(gen->genid,UNUR_ERR_GEN_CONDITION,"cannot compute area below PDF");
+    _Runuran_lobatto_free(tab);
+    return UNUR_FAILURE;
+  }
+  if (lazy->area < 0.99 * area_approx) {
+    _unur_error(gen->genid,UNUR_ERR_GEN_CONDITION,"integration of pdf: numerical problems with cut-off points of computational domain");
+    _Runuran_lobatto_free(tab);
+    return UNUR_FAILURE;
+  }
+
+  /* u-values for boundaries of segments:                         */
+  /*   10^(-K),...,10^(-2), central grid, 1-10^(-2),...,1-10^(-K) */
+  K = (int) (-log10(lazy->u_resolution)) - 1;
+  K = _unur_max(K,2);
+  ut = _unur_xmalloc((2*K + LAZY_N_UGRID) * sizeof(double));
+  n_ut = 0;
+  for (k=K; k>=2; k--)  ut[n_ut++] = pow(10.,-k);
+  for (k=0; k<LAZY_N_UGRID; k++)  ut[n_ut++] = lazy_ugrid[k];
+  for (k=2; k<=K; k++)  ut[n_ut++] = 1. - pow(10.,-k);
+
+  /* boundaries of segments: first node in table where CDF exceeds u-value */
+  lazy->xb = _unur_xmalloc((n_ut+2) * sizeof(double));
+  lazy->ub = _unur_xmalloc((n_ut+2) * sizeof(double));
+  lazy->xb[0] = lazy->bleft;
+  lazy->ub[0] = 0.;
+  k = 0;  cum = 0.;
+  for (i=0, j=0; i < tab->n && j < n_ut; i++) {
+    cum += tab->u[i];
+    if (cum / lazy->area < ut[j]) continue;
+    if (tab->x[i+1] > lazy->xb[k] && tab->x[i+1] < lazy->bright &&
+	cum / lazy->area < 1.) {
+      ++k;
+      lazy->xb[k] = tab->x[i+1];
+      lazy->ub[k] = cum / lazy->area;
+    }
+    /* skip all u-values that are exceeded by this node */
+    while (j < n_ut && cum / lazy->area >= ut[j]) ++j;
+  }
+  ++k;
+  lazy->xb[k] = lazy->bright;
+  lazy->ub[k] = 1.;
+  lazy->n_seg = k;
+
+  /* segments are created on demand */
+  lazy->seg = _unur_xmalloc(lazy->n_seg * sizeof(lazy_seg_t));
+  lazy->failed = _unur_xmalloc(lazy->n_seg * sizeof(lazy_flag_t));
+  for (k=0; k<lazy->n_seg; k++) {
+    lazy->seg[k] = NULL;
+    lazy->failed[k] = FALSE;
+  }
+
+  /* keep table for subsequent setups */
+  _Runuran_lobatto_store(gen->distr, tab);
+  free(ut);
+
+  return UNUR_SUCCESS;
+} /* end of _lazy_skeleton() */
+
+/*---------------------------------------------------------------------------*/
+
+struct unur_gen *
+_lazy_get_segment (struct unur_gen *gen, int k)
+     /*----------------------------------------------------------------------*/
+     /* Get PINV generator object for segment 'k'. It is created on first    */
+     /* use. If two threads create the same segment concurrently, the first  */
+     /* one that stores its generator object wins and the other one is       */
+     /* destroyed.                                                           */
+     /*                                                                      */
+     /* Parameters:                                                          */
+     /*   gen ... pointer to generator object                                */
+     /*   k   ... index of segment                                           */
+     /*                                                                      */
+     /* Return:                                                              */
+     /*   pointer to PINV generator object of segment                        */
+     /*                                                                      */
+     /* Error:                                                               */
+     /*   return NULL                                                        */
+     /*----------------------------------------------------------------------*/
+{
+  struct Runuran_pinv_lazy *lazy = LAZY;
+  struct unur_gen *seg;
+
+#ifdef RUNURAN_LAZY_ATOMIC
+  struct unur_gen *expected = NULL;
+
+  seg = atomic_load_explicit(&lazy->seg[k], memory_order_acquire);
+  if (seg != NULL || lazy->failed[k])
+    return seg;
+
+  if ((seg = _lazy_make_segment(gen,k)) == NULL) {
+    lazy->failed[k] = TRUE;
+    return NULL;
+  }
+
+  if (! atomic_compare_exchange_strong_explicit(&lazy->seg[k], &expected, seg,
+						memory_order_acq_rel, memory_order_acquire)) {
+    /* another thread has been faster */
+    unur_free(seg);
+    seg = expected;
+  }
+
+#else
+  seg = lazy->seg[k];
+  if (seg != NULL || lazy->failed[k])
+    return seg;
+
+  if ((seg = _lazy_make_segment(gen,k)) == NULL)
+    lazy->failed[k] = TRUE;
+  lazy->seg[k] = seg;
+#endif
+
+  return seg;
+} /* end of _lazy_get_segment() */
+
+/*---------------------------------------------------------------------------*/
+
+struct unur_gen *
+_lazy_make_segment (struct unur_gen *gen, int k)
+     /*----------------------------------------------------------------------*/
+     /* Create PINV generator object for segment 'k'.                        */
+     /*                                                                      */
+     /* Parameters:                                                          */
+     /*   gen ... pointer to generator object                                */
+     /*   k   ... index of segment                                           */
+     /*                                                                      */
+     /* Return:                                                              */
+     /*   pointer to PINV generator object of segment                        */
+     /*                                                                      */
+     /* Error:                                                               */
+     /*   return NULL                                                        */
+     /*----------------------------------------------------------------------*/
+{
+  struct Runuran_pinv_lazy *lazy = LAZY;
+  struct unur_distr *distr;
+  struct unur_par *par;
+  struct unur_gen *seg;
+  double xl = lazy->xb[k];
+  double xr = lazy->xb[k+1];
+  double ures;
+
+  /* distribution restricted to segment */
+  distr = unur_distr_clone(gen->distr);
+  unur_distr_cont_set_domain(distr, xl, xr);
+  /* the center must be in the segment: we use the boundary that is */
+  /* closer to the center of the distribution.                       */
+  if (DISTR.center < xl)       unur_distr_cont_set_center(distr, xl);
+  else if (DISTR.center > xr)  unur_distr_cont_set_center(distr, xr);
+  else                         unur_distr_cont_set_center(distr, DISTR.center);
+
+  /* u-error of segment is multiplied by its probability */
+  ures = lazy->u_resolution / (lazy->ub[k+1] - lazy->ub[k]);
+  ures = _unur_min(ures, PINV_MAX_URESOLUTION);
+
+  par = unur_pinv_new(distr);
+  unur_pinv_set_u_resolution(par, ures);
+  unur_pinv_set_smoothness(par, lazy->smooth);
+  seg = _Runuran_arena_compact( unur_init(par) );
+  unur_distr_free(distr);
+
+  if (seg == NULL)
+    _unur_error(gen->genid,UNUR_ERR_GEN_CONDITION,"cannot create segment");
+
+  return seg;
+} /* end of _lazy_make_segment() */
+
+/*---------------------------------------------------------------------------*/
+
+void
+_lazy_free (struct unur_gen *gen)
+     /*----------------------------------------------------------------------*/
+     /* Destroy generator object (including segments).                       */
+     /*                                                                      */
+     /* Parameters:                                                          */
+     /*   gen ... pointer to generator object                                */
+     /*----------------------------------------------------------------------*/
+{
+  struct Runuran_pinv_lazy *lazy = LAZY;
+  int k;
+
+  if (lazy) {
+    if (lazy->seg) {
+      for (k=0; k<lazy->n_seg; k++)
+	if (lazy->seg[k]) unur_free(lazy->seg[k]);
+      free(lazy->seg);
+    }
+    if (lazy->failed) free(lazy->failed);
+    if (lazy->xb) free(lazy->xb);
+    if (lazy->ub) free(lazy->ub);
+  }
+
+  _cext_free(gen);
+} /* end of _lazy_free() */
+
+/*---------------------------------------------------------------------------*/
+
+struct unur_gen *
+_lazy_clone (const struct unur_gen *gen)
+     /*----------------------------------------------------------------------*/
+     /* Copy generator object (including segments).                          */
+     /*                                                                      */
+     /* Parameters:                                                          */
+     /*   gen ... pointer to generator object                                */
+     /*                                                                      */
+     /* Return:                                                              */
+     /*   pointer to clone of generator object                               */
+     /*----------------------------------------------------------------------*/
+{
+#define CLONE  ((struct Runuran_pinv_lazy*)((struct unur_cext_gen*)clone->datap)->param)
+  struct Runuran_pinv_lazy *lazy = LAZY;
+  struct unur_gen *clone;
+  int k;
+
+  clone = _cext_clone(gen);
+
+  CLONE->xb = _unur_xmalloc((lazy->n_seg+1) * sizeof(double));
+  memcpy(CLONE->xb, lazy->xb, (lazy->n_seg+1) * sizeof(double));
+  CLONE->ub = _unur_xmalloc((lazy->n_seg+1) * sizeof(double));
+  memcpy(CLONE->ub, lazy->ub, (lazy->n_seg+1) * sizeof(double));
+  CLONE->seg = _unur_xmalloc(lazy->n_seg * sizeof(lazy_seg_t));
+  for (k=0; k<lazy->n_seg; k++)
+    CLONE->seg[k] = (lazy->seg[k]) ? unur_gen_clone(lazy->seg[k]) : NULL;
+  CLONE->failed = _unur_xmalloc(lazy->n_seg * sizeof(lazy_flag_t));
+  for (k=0; k<lazy->n_seg; k++)
+    CLONE->failed[k] = lazy->failed[k];
+
+  return clone;
+#undef CLONE
+} /* end of _lazy_clone() */
+
+/*****************************************************************************/
+/*                                                                           */
+/*   Computational domain (copied from methods/pinv_prep.ch)                 */
+/*                                                                           */
+/*****************************************************************************/
+
+double
+_lazy_eval_PDF (double x, struct unur_gen *gen)
+     /*----------------------------------------------------------------------*/
+     /* Evaluate PDF. If PDF(x) is not finite we move x slightly towards     */
+     /* the center of the computational domain.                              */
+     /* (copied from methods/pinv_init.ch)                                   */
+     /*----------------------------------------------------------------------*/
+{
+  struct unur_distr *distr = gen->distr;
+  double fx, dx;
+  int i;
+
+  for (i=1; i<=2; i++) {
+    if (DISTR.logpdf != NULL)
+      fx = exp((DISTR.logpdf)(x,distr));
+    else
+      fx = (DISTR.pdf)(x,distr);
+
+    if (fx >= UNUR_INFINITY) {
+      dx = 2.*fabs(x)*DBL_EPSILON;
+      dx = _unur_max(dx,2.*DBL_MIN);
+      x += ((x - LAZY->bleft) < (LAZY->bright - x)) ? dx : -dx;
+    }
+    else
+      break;
+  }
+
+  return fx;
+} /* end of _lazy_eval_PDF() */
+
+/*---------------------------------------------------------------------------*/
+
+int
+_lazy_relevant_support (struct unur_gen *gen)
+     /*----------------------------------------------------------------------*/
+     /* Get relevant part of support of PDF.                                 */
+     /*----------------------------------------------------------------------*/
+{
+  struct Runuran_pinv_lazy *lazy = LAZY;
+  double fb;
+
+  if(lazy->sleft) {
+    fb = PDF(lazy->dleft);
+    if (fb > 1.e-20 && fb < 1.e300) {
+      lazy->bleft = lazy->dleft;
+      lazy->sleft = FALSE;
+    }
+  }
+  if(lazy->sright) {
+    fb = PDF(lazy->dright);
+    if (fb > 1.e-20 && fb < 1.e300) {
+      lazy->bright = lazy->dright;
+      lazy->sright = FALSE;
+    }
+  }
+
+  if(lazy->sleft) {
+    lazy->bleft = _lazy_searchborder(gen, DISTR.center, lazy->bleft,
+				     &(lazy->dleft), &(lazy->sleft) );
+    if (!_unur_isfinite(lazy->bleft)) {
+      _unur_error(gen->genid,UNUR_ERR_GEN_CONDITION,"Cannot get left boundary of relevant domain.");
+      return UNUR_ERR_GEN_CONDITION;
+    }
+  }
+  if(lazy->sright) {
+    lazy->bright = _lazy_searchborder(gen, DISTR.center, lazy->bright,
+				      &(lazy->dright), &(lazy->sright) );
+    if (!_unur_isfinite(lazy->bright)) {
+      _unur_error(gen->genid,UNUR_ERR_GEN_CONDITION,"Cannot get right boundary of relevant domain.");
+      return UNUR_ERR_GEN_CONDITION;
+    }
+  }
+
+  return UNUR_SUCCESS;
+} /* end of _lazy_relevant_support() */
+
+/*---------------------------------------------------------------------------*/
+
+double
+_lazy_searchborder (struct unur_gen *gen, double x0, double bound,
+		    double *dom, int *search)
+     /*----------------------------------------------------------------------*/
+     /* Find left or right boundary of relevant domain.                      */
+     /*----------------------------------------------------------------------*/
+{
+  double x;         /* current point */
+  double xs, xl;    /* point in and outside of relevant domain */
+  double fx;        /* PDF at current point */
+  double fs, fl;    /* PDF at xs and xl */
+  double fllim;     /* lower limit for PDF */
+  double fulim;     /* upper limit for PDF */
+
+  fllim = PDF(x0) * PINV_PDFLLIM;
+  fulim = 1.e4 * fllim;
+
+  if (fllim <= 0.) {
+    _unur_error(gen->genid,UNUR_ERR_GEN_CONDITION,"PDF(center) too small");
+    return UNUR_INFINITY;
+  }
+
+  /* search for point outside of relevant domain */
+  xl = x0;
+  fl = UNUR_INFINITY;
+  x = _unur_arcmean(x0,bound);
+  while ( (fx=PDF(x)) > fllim ) {
+    if (_unur_FP_same(x,bound))
+      return bound;
+    xl = x; fl = fx;
+    x = _unur_arcmean(x,bound);
+  }
+  xs = x; fs = fx;
+
+  if (fx < 0.) {
+    _unur_error(gen->genid,UNUR_ERR_GEN_DATA,"PDF(x) < 0");
+    return UNUR_INFINITY;
+  }
+
+  /* bisection */
+  while (!_unur_FP_same(xs,xl)) {
+    if (_unur_iszero(fs)) {
+      *dom = xs;
+    }
+    x = xs/2. + xl/2.;
+    fx = PDF(x);
+    if (fx < 0.) {
+      _unur_error(gen->genid,UNUR_ERR_GEN_DATA,"PDF(x) < 0");
+      return UNUR_INFINITY;
+    }
+    if (fx < fllim) {
+      xs = x; fs = fx;
+    }
+    else {
+      if (fl > fulim) {
+	xl = x; fl = fx;
+      }
+      else {
+	return x;
+      }
+    }
+  }
+
+  *search = FALSE;
+  return xl;
+} /* end of _lazy_searchborder() */
+
+/*---------------------------------------------------------------------------*/
+
+int
+_lazy_approx_pdfarea (struct unur_gen *gen)
+     /*----------------------------------------------------------------------*/
+     /* Compute approximate area below PDF.                                  */
+     /*----------------------------------------------------------------------*/
+{
+  struct Runuran_pinv_lazy *lazy = LAZY;
+  double tol;
+  int i;
+  int res = UNUR_SUCCESS;
+
+  for (i=1; i<=2; i++) {
+    tol = PINV_UERROR_AREA_APPROX * lazy->area;
+    DISTR.center = _unur_max(DISTR.center, lazy->bleft);
+    DISTR.center = _unur_min(DISTR.center, lazy->bright);
+    lazy->area =
+      _unur_lobatto_adaptive(_lazy_eval_PDF, gen,
+			     lazy->bleft, DISTR.center - lazy->bleft, tol, NULL);
+    if (_unur_isfinite(lazy->area))
+      lazy->area +=
+	_unur_lobatto_adaptive(_lazy_eval_PDF, gen,
+			       DISTR.center, lazy->bright - DISTR.center, tol, NULL);
+    if ( !_unur_isfinite(lazy->area) || _unur_iszero(lazy->area) ) {
+      _unur_error(gen->genid,UNUR_ERR_GEN_CONDITION,"cannot approximate area below PDF");
+      res = UNUR_FAILURE;
+      break;
+    }
+    if (lazy->area > 1.e-2) {
+      break;
+    }
+  }
+
+  return res;
+} /* end of _lazy_approx_pdfarea() */
+
+/*---------------------------------------------------------------------------*/
+
+int
+_lazy_computational_domain (struct unur_gen *gen)
+     /*----------------------------------------------------------------------*/
+     /* Compute computational domain: cut off tails with negligible mass.    */
+     /*----------------------------------------------------------------------*/
+{
+  struct Runuran_pinv_lazy *lazy = LAZY;
+  double tailcut_error;
+  double range;
+
+  tailcut_error = lazy->u_resolution * PINV_TAILCUTOFF_FACTOR;
+  tailcut_error = _unur_min( tailcut_error, PINV_TAILCUTOFF_MAX );
+  tailcut_error = _unur_max( tailcut_error, 2*DBL_EPSILON );
+  tailcut_error *= lazy->area * PINV_UERROR_CORRECTION;
+
+  range = lazy->bright - lazy->bleft;
+
+  if(lazy->sleft) {
+    lazy->bleft = _lazy_cut( gen, lazy->bleft, -range, tailcut_error);
+    if ( !_unur_isfinite(lazy->bleft) ) {
+      _unur_error(gen->genid,UNUR_ERR_GEN_CONDITION,"cannot find left boundary for computational domain");
+      return UNUR_FAILURE;
+    }
+  }
+  if(lazy->sright) {
+    lazy->bright = _lazy_cut( gen, lazy->bright, range, tailcut_error);
+    if ( !_unur_isfinite(lazy->bright) ) {
+      _unur_error(gen->genid,UNUR_ERR_GEN_CONDITION,"cannot find right boundary for computational domain");
+      return UNUR_FAILURE;
+    }
+  }
+
+  return UNUR_SUCCESS;
+} /* end of _lazy_computational_domain() */
+
+/*---------------------------------------------------------------------------*/
+
+double
+_lazy_cut (struct unur_gen *gen, double w, double dw, double crit)
+     /*----------------------------------------------------------------------*/
+     /* Find cut-off point where the tail has (approximately) area 'crit'.   */
+     /*----------------------------------------------------------------------*/
+{
+  struct Runuran_pinv_lazy *lazy = LAZY;
+  double fl,fx,fr;  /* PDF at x-dx, x, and x+dx */
+  double x = w;     /* current point */
+  double dx;        /* step size for numerical derivative */
+  double xnew;      /* new point */
+  double df;        /* derivative of PDF */
+  double lc;        /* local concavity */
+  double area;      /* tail area */
+  int i,j;
+
+  if (_unur_iszero(fabs(dw))) return w;
+
+  x = w;
+  fx = PDF(x);
+
+  for (i=1; i<100; i++) {
+
+    dx = (fabs(dw) + fabs(x-w)) * 1.e-3;
+    if (x-dx < lazy->dleft)  dx = x - lazy->dleft;
+    if (x+dx > lazy->dright) dx = lazy->dright - x;
+
+    for (j=1;;j++) {
+      dx = dx/2.;
+      if (dx < 128.*DBL_EPSILON*fabs(dw))
+	return x;
+      fl = PDF(x-dx);
+      fr = PDF(x+dx);
+      if (! (_unur_iszero(fl) || _unur_iszero(fx) ||_unur_iszero(fr)) )
+	break;
+    }
+
+    df = (fr-fl)/(2.*dx);
+    lc = fl/(fl-fx)+fr/(fr-fx) - 1;
+    area = fabs(fx*fx / ((lc+1.) * df));
+
+    if (! _unur_isfinite(df)) {
+      _unur_error(gen->genid,UNUR_ERR_GEN_CONDITION,
+		  "numerical problems with cut-off point, PDF too steep");
+      return UNUR_INFINITY;
+    }
+
+    if (  ((dw>0)?1.:-1.) * df > 0.) {
+      _unur_warning(gen->genid,UNUR_ERR_GEN_CONDITION,"PDF increasing towards boundary");
+      xnew = (dw>0) ? lazy->dright : lazy->dleft;
+      return _lazy_cut_bisect(gen, x, xnew);
+    }
+
+    if (_unur_isnan(area)) {
+      _unur_warning(gen->genid,UNUR_ERR_NAN,"tail probability gives NaN --> assume 0.");
+      return x;
+    }
+
+    if (fabs(area/crit-1.) < 1.e-4)
+      return x;
+
+    if (_unur_iszero(lc))
+      xnew = x + fx/df * log(crit*fabs(df)/(fx*fx));
+    else
+      xnew = x + fx/(lc*df) * ( pow(crit*fabs(df)*(lc+1.)/(fx*fx),lc/(lc+1.)) - 1.);
+
+    if (! _unur_isfinite(xnew))
+      xnew = (dw > 0) ? _unur_arcmean(x,lazy->dright) : _unur_arcmean(x,lazy->dleft);
+
+    if (xnew < lazy->dleft || xnew > lazy->dright) {
+      if ( (dw > 0 && xnew < lazy->dleft) ||
+	   (dw < 0 && xnew > lazy->dright) ) {
+	_unur_error(gen->genid,UNUR_ERR_GEN_CONDITION,
+		    "numerical problems with cut-off point, out of domain");
+	return UNUR_INFINITY;
+      }
+      else {
+	xnew = (xnew < lazy->dleft) ? lazy->dleft : lazy->dright;
+	return _lazy_cut_bisect(gen, x, xnew);
+      }
+    }
+
+    fx = PDF(xnew);
+    if (_unur_iszero(fx))
+      return _lazy_cut_bisect(gen, x, xnew);
+
+    x = xnew;
+  }
+
+  return x;
+} /* end of _lazy_cut() */
+
+/*---------------------------------------------------------------------------*/
+
+double
+_lazy_cut_bisect (struct unur_gen *gen, double x0, double x1)
+     /*----------------------------------------------------------------------*/
+     /* Find boundary of support of PDF between x0 (PDF>0) and x1 by         */
+     /* bisection.                                                           */
+     /*----------------------------------------------------------------------*/
+{
+  double x,fx;
+
+  if (! (_unur_isfinite(x0) && _unur_isfinite(x1)) )
+    return UNUR_INFINITY;
+
+  x = x1;
+  fx = PDF(x);
+  if (fx > 0.) return x;
+
+  while ( !_unur_FP_equal(x0,x1) ) {
+    x = _unur_arcmean(x0,x1);
+    fx = PDF(x);
+    if (fx > 0.)
+      x0 = x;
+    else
+      x1 = x;
+  }
+
+  return x;
+} /* end of _lazy_cut_bisect() */
+
+/*---------------------------------------------------------------------------*/
+
+#undef GEN
+#undef LAZY
+#undef DISTR
+#undef PDF
+
+/*---------------------------------------------------------------------------*/
@@ -0,0 +1,754 @@
+/*****************************************************************************
+ *                                                                           *
+ *          UNU.RAN -- Universal Non-Uniform Random number generator         *
+ *                                                                           *
+ *****************************************************************************
+ *                                                                           *
+ *   FILE: Runuran_qrng.c                                                    *
+ *                                                                           *
+ *   PURPOSE:                                                                *
+ *         Quasi-random number generators (Sobol, Halton)                    *
+ *                                                                           *
+ *****************************************************************************
+ *                                                                           *
+ *   Copyright (c) 2026 Wolfgang Hoermann and Josef Leydold                  *
+ *   Dept. for Statistics, University of Economics, Vienna, Austria          *
+ *                                                                           *
+ *   This program is free software; you can redistribute it and/or modify    *
+ *   it under the terms of the GNU General Public License as published by    *
+ *   the Free Software Foundation; either version 2 of the License, or       *
+ *   (at your option) any later version.                                     *
+ *                                                                           *
+ *   This program is distributed in the hope that it will be useful,         *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of          *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the           *
+ *   GNU General Public License for more details.                            *
+ *                                                                           *
+ *   You should have received a copy of the GNU General Public License       *
+ *   along with this program; if not, write to the                           *
+ *   Free Software Foundation, Inc.,                                         *
+ *   59 Temple Place, Suite 330, Boston, MA 02111-1307, USA                  *
+ *                                                                           *
+ *****************************************************************************
+ *                                                                           *
+ *   Quasi-Monte Carlo (QMC) integration replaces the uniform random         *
+ *   numbers by the points of a low-discrepancy sequence. We implement       *
+ *   the Sobol sequence (with the direction numbers of Joe and Kuo) and      *
+ *   the Halton sequence as UNU.RAN URNG objects: _qrng_sample() returns     *
+ *   the coordinates of the current point one after the other and            *
+ *   samplearray() returns a complete point (as for the QRNGs from GSL).     *
+ *                                                                           *
+ *   Points are randomized when a URNG for the shift is given:               *
+ *    - Sobol: digital shift, i.e., each coordinate (as 32 bit integer) is   *
+ *      XORed with a random integer. This preserves the net structure.       *
+ *    - Halton: random shift modulo 1 (Cranley-Patterson rotation).          *
+ *   Method nextsub() draws a new shift and restarts the sequence.           *
+ *                                                                           *
+ *   The first point of the unrandomized sequences is the origin. As it is   *
+ *   mapped onto the boundary of the domain by inversion, it is omitted.     *
+ *   The randomized Sobol sequence starts with index 0 such that the first   *
+ *   2^m points form a net.                                                  *
+ *                                                                           *
+ *   Runuran_qmc() maps an n x d point set through a list of d generator     *
+ *   objects that implement inversion methods. The point set is computed     *
+ *   directly into the (column-major) R matrix and each column is then       *
+ *   transformed in place by the corresponding approximate inverse CDF.      *
+ *                                                                           *
+ *****************************************************************************/
+
+/*---------------------------------------------------------------------------*/
+
+#include "Runuran.h"
+
+/* internal header files for UNU.RAN */
+#include <unur_source.h>
+
+/* direction numbers for Sobol sequence */
+#include "Runuran_qrng_sobol.h"
+
+/*---------------------------------------------------------------------------*/
+
+#define SOBOL_BITS      (32)
+/* number of bits of points in Sobol sequence */
+
+#define HALTON_MAX_DIM  (10000)
+/* maximal dimension of Halton sequence */
+
+#define QRNG_MAX_INDEX  (4294967295.)
+/* maximal index of point (2^32-1) */
+
+/*---------------------------------------------------------------------------*/
+/* Data for quasi-random number generator                                    */
+
+struct Runuran_qrng {
+  int type;                /* type of sequence (RUNURAN_QRNG_SOBOL, ...)     */
+  int dim;                 /* dimension of points                            */
+  unsigned long start;     /* index of first point                           */
+  unsigned long index;     /* index of next point                            */
+  int coord;               /* next coordinate returned by _qrng_sample()     */
+  double *point;           /* current point                                  */
+  unsigned int *v;         /* Sobol: direction numbers (dim x SOBOL_BITS)    */
+  unsigned int *x;         /* Sobol: next point (as integers)                */
+  unsigned int *dshift;    /* Sobol: digital shift                           */
+  int *base;               /* Halton: bases (primes)                         */
+  double *shift;           /* Halton: shift modulo 1                         */
+  UNUR_URNG *srng;         /* URNG for random shift (NULL if not randomized) */
+};
+
+/*---------------------------------------------------------------------------*/
+
+static double _qrng_sample (void *state);
+static unsigned int _qrng_sample_array (void *state, double *X, int dim);
+/*---------------------------------------------------------------------------*/
+/* Sample next coordinate / next point.                                      */
+/*---------------------------------------------------------------------------*/
+
+static void _qrng_reset (void *state);
+/*---------------------------------------------------------------------------*/
+/* Restart sequence with first point.                                        */
+/*---------------------------------------------------------------------------*/
+
+static void _qrng_nextsub (void *state);
+/*---------------------------------------------------------------------------*/
+/* Draw new random shift and restart sequence.                               */
+/*---------------------------------------------------------------------------*/
+
+static void _qrng_free (void *state);
+/*---------------------------------------------------------------------------*/
+/* Free QRNG data.                                                           */
+/*---------------------------------------------------------------------------*/
+
+static void _qrng_next_point (struct Runuran_qrng *qrng);
+/*---------------------------------------------------------------------------*/
+/* Compute next point and store it in qrng->point.                           */
+/*---------------------------------------------------------------------------*/
+
+static void _qrng_set_index (struct Runuran_qrng *qrng, unsigned long index);
+/*---------------------------------------------------------------------------*/
+/* Set index of next point.                                                  */
+/*---------------------------------------------------------------------------*/
+
+static void _qrng_draw_shift (struct Runuran_qrng *qrng);
+/*---------------------------------------------------------------------------*/
+/* Draw random shift.                                                        */
+/*---------------------------------------------------------------------------*/
+
+static void _sobol_init (struct Runuran_qrng *qrng);
+/*---------------------------------------------------------------------------*/
+/* Compute direction numbers for Sobol sequence.                             */
+/*---------------------------------------------------------------------------*/
+
+static void _halton_init (struct Runuran_qrng *qrng);
+/*---------------------------------------------------------------------------*/
+/* Compute bases for Halton sequence.                                        */
+/*---------------------------------------------------------------------------*/
+
+static SEXP _qrng_make_points (SEXP sexp_n, int dim, SEXP sexp_type,
+			       SEXP sexp_randomize, SEXP sexp_skip);
+/*---------------------------------------------------------------------------*/
+/* Create R matrix with QMC point set (checks arguments).                    */
+/*---------------------------------------------------------------------------*/
+
+/*---------------------------------------------------------------------------*/
+
+#define QRNG  ((struct Runuran_qrng *) urng->state)
+
+/*---------------------------------------------------------------------------*/
+
+/*****************************************************************************/
+/*                                                                           */
+/*   Create and use QRNG                                                     */
+/*                                                                           */
+/*****************************************************************************/
+
+UNUR_URNG *
+_Runuran_qrng_new (int type, int dim, UNUR_URNG *srng)
+     /*----------------------------------------------------------------------*/
+     /* Create URNG object for quasi-random sequence.                        */
+     /*                                                                      */
+     /* Parameters:                                                          */
+     /*   type ... type of sequence (RUNURAN_QRNG_SOBOL or _HALTON)          */
+     /*   dim  ... dimension of points                                       */
+     /*   srng ... URNG for random shift (NULL for no randomization)         */
+     /*                                                                      */
+     /* Return:                                                              */
+     /*   pointer to URNG object                                             */
+     /*   NULL in case of error                                              */
+     /*----------------------------------------------------------------------*/
+{
+  struct Runuran_qrng *qrng;
+  UNUR_URNG *urng;
+
+  /* check arguments */
+  if (dim < 1) return NULL;
+  switch (type) {
+  case RUNURAN_QRNG_SOBOL:
+    if (dim > SOBOL_MAX_DIM) return NULL;
+    break;
+  case RUNURAN_QRNG_HALTON:
+    if (dim > HALTON_MAX_DIM) return NULL;
+    break;
+  default:
+    return NULL;
+  }
+
+  /* data for generator */
+  qrng = _unur_xmalloc(sizeof(struct Runuran_qrng));
+  qrng->type = type;
+  qrng->dim = dim;
+  qrng->srng = srng;
+  qrng->point = _unur_xmalloc(dim * sizeof(double));
+  qrng->v = qrng->x = qrng->dshift = NULL;
+  qrng->base = NULL;
+  qrng->shift = NULL;
+
+  if (type == RUNURAN_QRNG_SOBOL) {
+    qrng->v = _unur_xmalloc((size_t) dim * SOBOL_BITS * sizeof(unsigned int));
+    qrng->x = _unur_xmalloc(dim * sizeof(unsigned int));
+    qrng->dshift = _unur_xmalloc(dim * sizeof(unsigned int));
+    _sobol_init(qrng);
+    /* the first point (origin) is omitted unless randomized */
+    qrng->start = (srng) ? 0 : 1;
+  }
+  else {
+    qrng->base = _unur_xmalloc(dim * sizeof(int));
+    qrng->shift = _unur_xmalloc(dim * sizeof(double));
+    _halton_init(qrng);
+    qrng->start = 1;
+  }
+
+  /* random shift */
+  _qrng_draw_shift(qrng);
+
+  /* first point */
+  _qrng_set_index(qrng, qrng->start);
+
+  /* create URNG object */
+  urng = unur_urng_new(_qrng_sample, qrng);
+  unur_urng_set_sample_array(urng, _qrng_sample_array);
+  unur_urng_set_reset(urng, _qrng_reset);
+  unur_urng_set_nextsub(urng, _qrng_nextsub);
+  unur_urng_set_delete(urng, _qrng_free);
+
+  return urng;
+} /* end of _Runuran_qrng_new() */
+
+/*---------------------------------------------------------------------------*/
+
+int
+_Runuran_qrng_skip (UNUR_URNG *urng, double n)
+     /*----------------------------------------------------------------------*/
+     /* Skip the first 'n' points of the sequence (starting from the first   */
+     /* point).                                                              */
+     /*                                                                      */
+     /* Parameters:                                                          */
+     /*   urng ... pointer to URNG object (created by _Runuran_qrng_new())   */
+     /*   n    ... number of points to be skipped                            */
+     /*                                                                      */
+     /* Return:                                                              */
+     /*   UNUR_SUCCESS ... on success                                        */
+     /*   error code   ... otherwise                                         */
+     /*----------------------------------------------------------------------*/
+{
+  if (!(n >= 0. && n + QRNG->start <= QRNG_MAX_INDEX))
+    return UNUR_ERR_PAR_INVALID;
+
+  _qrng_set_index(QRNG, QRNG->start + (unsigned long) n);
+  return UNUR_SUCCESS;
+} /* end of _Runuran_qrng_skip() */
+
+/*---------------------------------------------------------------------------*/
+
+void
+_Runuran_qrng_fill (UNUR_URNG *urng, double *X, int n)
+     /*----------------------------------------------------------------------*/
+     /* Store the next 'n' points of the sequence in 'X' (batch version).    */
+     /* 'X' is an n x dim matrix in column-major order (as in R).            */
+     /*                                                                      */
+     /* Parameters:                                                          */
+     /*   urng ... pointer to URNG object (created by _Runuran_qrng_new())   */
+     /*   X    ... array for storing points                                  */
+     /*   n    ... number of points                                          */
+     /*----------------------------------------------------------------------*/
+{
+  struct Runuran_qrng *qrng = QRNG;
+  int i, j;
+
+  for (i=0; i<n; i++) {
+    _qrng_next_point(qrng);
+    for (j=0; j<qrng->dim; j++)
+      X[i + (size_t) j * n] = qrng->point[j];
+  }
+
+  /* next call to _qrng_sample() starts with new point */
+  qrng->coord = qrng->dim;
+
+} /* end of _Runuran_qrng_fill() */
+
+/*---------------------------------------------------------------------------*/
+
+double
+_qrng_sample (void *state)
+     /*----------------------------------------------------------------------*/
+     /* Sample next coordinate of current point. A new point is started      */
+     /* when all coordinates of the current one have been used.              */
+     /*                                                                      */
+     /* Parameters:                                                          */
+     /*   state ... data for QRNG                                            */
+     /*                                                                      */
+     /* Return:                                                              */
+     /*   quasi-random number                                                */
+     /*----------------------------------------------------------------------*/
+{
+  struct Runuran_qrng *qrng = state;
+
+  if (qrng->coord >= qrng->dim) {
+    _qrng_next_point(qrng);
+    qrng->coord = 0;
+  }
+
+  return qrng->point[qrng->coord++];
+} /* end of _qrng_sample() */
+
+/*---------------------------------------------------------------------------*/
+
+unsigned int
+_qrng_sample_array (void *state, double *X, int dim)
+     /*----------------------------------------------------------------------*/
+     /* Sample next point.                                                   */
+     /*                                                                      */
+     /* Parameters:                                                          */
+     /*   state ... data for QRNG                                            */
+     /*   X     ... array for storing point                                  */
+     /*   dim   ... length of array 'X'                                      */
+     /*                                                                      */
+     /* Return:                                                              */
+     /*   number of coordinates stored in 'X'                                */
+     /*   (the minimum of 'dim' and the dimension of the QRNG)               */
+     /*----------------------------------------------------------------------*/
+{
+  struct Runuran_qrng *qrng = state;
+  int n = _unur_min(dim, qrng->dim);
+
+  _qrng_next_point(qrng);
+  memcpy(X, qrng->point, n * sizeof(double));
+  qrng->coord = qrng->dim;
+
+  return (unsigned int) n;
+} /* end of _qrng_sample_array() */
+
+/*---------------------------------------------------------------------------*/
+
+void
+_qrng_reset (void *state)
+     /*----------------------------------------------------------------------*/
+     /* Restart sequence with first point.                                   */
+     /*                                                                      */
+     /* Parameters:                                                          */
+     /*   state ... data for QRNG                                            */
+     /*----------------------------------------------------------------------*/
+{
+  struct Runuran_qrng *qrng = state;
+  _qrng_set_index(qrng, qrng->start);
+} /* end of _qrng_reset() */
+
+/*---------------------------------------------------------------------------*/
+
+void
+_qrng_nextsub (void *state)
+     /*----------------------------------------------------------------------*/
+     /* Draw new random shift and restart sequence.                          */
+     /*                                                                      */
+     /* Parameters:                                                          */
+     /*   state ... data for QRNG                                            */
+     /*----------------------------------------------------------------------*/
+{
+  struct Runuran_qrng *qrng = state;
+  _qrng_draw_shift(qrng);
+  _qrng_set_index(qrng, qrng->start);
+} /* end of _qrng_nextsub() */
+
+/*---------------------------------------------------------------------------*/
+
+void
+_qrng_free (void *state)
+     /*----------------------------------------------------------------------*/
+     /* Free QRNG data.                                                      */
+     /*                                                                      */
+     /* Parameters:                                                          */
+     /*   state ... data for QRNG                                            */
+     /*----------------------------------------------------------------------*/
+{
+  struct Runuran_qrng *qrng = state;
+
+  if (qrng == NULL) return;
+  free(qrng->point);
+  if (qrng->v) free(qrng->v);
+  if (qrng->x) free(qrng->x);
+  if (qrng->dshift) free(qrng->dshift);
+  if (qrng->base) free(qrng->base);
+  if (qrng->shift) free(qrng->shift);
+  free(qrng);
+} /* end of _qrng_free() */
+
+/*---------------------------------------------------------------------------*/
+
+void
+_qrng_next_point (struct Runuran_qrng *qrng)
+     /*----------------------------------------------------------------------*/
+     /* Compute next point and store it in qrng->point.                      */
+     /* The sequence is restarted when all points have been used.            */
+     /*                                                                      */
+     /* Parameters:                                                          */
+     /*   qrng ... data for QRNG                                             */
+     /*----------------------------------------------------------------------*/
+{
+  unsigned long k;
+  unsigned int *v;
+  double f, r;
+  int b, c, j;
+
+  switch (qrng->type) {
+
+  case RUNURAN_QRNG_SOBOL:
+    /* qrng->x contains the point with index qrng->index */
+    for (j=0; j<qrng->dim; j++)
+      /* multiply by 2^-32 */
+      qrng->point[j] = (qrng->x[j] ^ qrng->dshift[j]) * 2.3283064365386963e-10;
+
+    /* Gray code: the next point differs in the direction number */
+    /* of the lowest zero bit of the index.                      */
+    for (k=qrng->index, c=0; (k & 1UL) && c < SOBOL_BITS; k >>= 1, c++) ;
+    if (c >= SOBOL_BITS) {
+      /* all points have been used */
+      _qrng_set_index(qrng, qrng->start);
+      return;
+    }
+    for (j=0, v=qrng->v; j<qrng->dim; j++, v+=SOBOL_BITS)
+      qrng->x[j] ^= v[c];
+    ++(qrng->index);
+    break;
+
+  case RUNURAN_QRNG_HALTON:
+  default:
+    /* radical inverse of index */
+    for (j=0; j<qrng->dim; j++) {
+      b = qrng->base[j];
+      for (k=qrng->index, f=1./b, r=0.; k>0; k/=b, f/=b)
+	r += f * (k % b);
+      r += qrng->shift[j];
+      qrng->point[j] = (r >= 1.) ? r - 1. : r;
+    }
+    if (qrng->index >= (unsigned long) QRNG_MAX_INDEX)
+      qrng->index = qrng->start;
+    else
+      ++(qrng->index);
+    break;
+  }
+
+} /* end of _qrng_next_point() */
+
+/*---------------------------------------------------------------------------*/
+
+void
+_qrng_set_index (struct Runuran_qrng *qrng, unsigned long index)
+     /*----------------------------------------------------------------------*/
+     /* Set index of next point.                                             */
+     /*                                                                      */
+     /* Parameters:                                                          */
+     /*   qrng  ... data for QRNG                                            */
+     /*   index ... index of next point                                      */
+     /*----------------------------------------------------------------------*/
+{
+  unsigned long gray;
+  unsigned int *v;
+  int c, j;
+
+  qrng->index = index;
+  qrng->coord = qrng->dim;
+
+  if (qrng->type == RUNURAN_QRNG_SOBOL) {
+    /* point with given index is the sum (XOR) of the direction numbers */
+    /* for the bits of the Gray code of the index.                      */
+    gray = index ^ (index >> 1);
+    for (j=0, v=qrng->v; j<qrng->dim; j++, v+=SOBOL_BITS) {
+      qrng->x[j] = 0u;
+      for (c=0; c<SOBOL_BITS; c++)
+	if ((gray >> c) & 1UL) qrng->x[j] ^= v[c];
+    }
+  }
+
+} /* end of _qrng_set_index() */
+
+/*---------------------------------------------------------------------------*/
+
+void
+_qrng_draw_shift (struct Runuran_qrng *qrng)
+     /*----------------------------------------------------------------------*/
+     /* Draw random shift.                                                   */
+     /*                                                                      */
+     /* Parameters:                                                          */
+     /*   qrng ... data for QRNG                                             */
+     /*----------------------------------------------------------------------*/
+{
+  int j;
+
+  for (j=0; j<qrng->dim; j++) {
+    if (qrng->type == RUNURAN_QRNG_SOBOL)
+      qrng->dshift[j] = (qrng->srng)
+	? (unsigned int) (unur_urng_sample(qrng->srng) * 4294967296.) : 0u;
+    else
+      qrng->shift[j] = (qrng->srng) ? unur_urng_sample(qrng->srng) : 0.;
+  }
+
+} /* end of _qrng_draw_shift() */
+
+/*---------------------------------------------------------------------------*/
+
+void
+_sobol_init (struct Runuran_qrng *qrng)
+     /*----------------------------------------------------------------------*/
+     /* Compute direction numbers for Sobol sequence.                        */
+     /* (Recursion from Bratley and Fox, ACM TOMS 14 (1988), 88-100.)        */
+     /*                                                                      */
+     /* Parameters:                                                          */
+     /*   qrng ... data for QRNG                                             */
+     /*----------------------------------------------------------------------*/
+{
+  const unsigned short *m = sobol_minit;  /* initial direction numbers */
+  unsigned int *v;
+  unsigned int poly;
+  int s, i, j, k;
+
+  for (j=0, v=qrng->v; j<qrng->dim; j++, v+=SOBOL_BITS) {
+
+    if (j==0) {
+      /* first coordinate: van der Corput sequence */
+      for (k=0; k<SOBOL_BITS; k++)
+	v[k] = 1u << (SOBOL_BITS-1-k);
+      continue;
+    }
+
+    /* primitive polynomial and its degree */
+    poly = sobol_poly[j-1];
+    for (s=0; (poly >> (s+1)) > 0; s++) ;
+
+    /* initial direction numbers */
+    for (k=0; k<s; k++)
+      v[k] = ((unsigned int) m[k]) << (SOBOL_BITS-1-k);
+    m += s;
+
+    /* recursion */
+    for (k=s; k<SOBOL_BITS; k++) {
+      v[k] = v[k-s] ^ (v[k-s] >> s);
+      for (i=1; i<s; i++)
+	if ((poly >> (s-i)) & 1u)
+	  v[k] ^= v[k-i];
+    }
+  }
+
+} /* end of _sobol_init() */
+
+/*---------------------------------------------------------------------------*/
+
+void
+_halton_init (struct Runuran_qrng *qrng)
+     /*----------------------------------------------------------------------*/
+     /* Compute bases for Halton sequence (the first 'dim' primes).          */
+     /*                                                                      */
+     /* Parameters:                                                          */
+     /*   qrng ... data for QRNG                                             */
+     /*----------------------------------------------------------------------*/
+{
+  int j, p, i;
+
+  for (j=0, p=2; j<qrng->dim; p++) {
+    for (i=0; i<j && qrng->base[i]*qrng->base[i] <= p; i++)
+      if (p % qrng->base[i] == 0) break;
+    if (i<j && qrng->base[i]*qrng->base[i] <= p)
+      /* p is not prime */
+      continue;
+    qrng->base[j++] = p;
+  }
+
+} /* end of _halton_init() */
+
+/*---------------------------------------------------------------------------*/
+
+/*****************************************************************************/
+/*                                                                           */
+/*   R interface                                                             */
+/*                                                                           */
+/*****************************************************************************/
+
+SEXP
+Runuran_qrng (SEXP sexp_n, SEXP sexp_dim, SEXP sexp_type,
+	      SEXP sexp_randomize, SEXP sexp_skip)
+     /*----------------------------------------------------------------------*/
+     /* Create QMC point set.                                                */
+     /*                                                                      */
+     /* Parameters:                                                          */
+     /*   n         ... number of points                                     */
+     /*   dim       ... dimension of points                                  */
+     /*   type      ... type of sequence ("sobol" or "halton")               */
+     /*   randomize ... whether points are randomized (logical)              */
+     /*   skip      ... number of points that are skipped                    */
+     /*                                                                      */
+     /* Return:                                                              */
+     /*   n x dim matrix                                                     */
+     /*----------------------------------------------------------------------*/
+{
+  SEXP sexp_X;
+  int dim;
+
+  dim = *(INTEGER (Rf_coerceVector(sexp_dim, INTSXP)));
+  if (dim == NA_INTEGER || dim < 1)
+    Rf_error("[UNU.RAN - error] invalid argument 'dim'");
+
+  PROTECT(sexp_X = _qrng_make_points(sexp_n, dim, sexp_type, sexp_randomize, sexp_skip));
+  UNPROTECT(1);
+
+  return sexp_X;
+} /* end of Runuran_qrng() */
+
+/*---------------------------------------------------------------------------*/
+
+SEXP
+Runuran_qmc (SEXP sexp_unrs, SEXP sexp_n, SEXP sexp_type,
+	     SEXP sexp_randomize, SEXP sexp_skip)
+     /*----------------------------------------------------------------------*/
+     /* Map QMC point set through inversion methods: column j of the point   */
+     /* set is transformed by the j-th generator object.                     */
+     /*                                                                      */
+     /* Parameters:                                                          */
+     /*   unrs      ... list of 'Runuran' objects (S4 class)                 */
+     /*   n         ... number of points                                     */
+     /*   type      ... type of sequence ("sobol" or "halton")               */
+     /*   randomize ... whether points are randomized (logical)              */
+     /*   skip      ... number of points that are skipped                    */
+     /*                                                                      */
+     /* Return:                                                              */
+     /*   n x d matrix where d is the length of list 'unrs'                  */
+     /*----------------------------------------------------------------------*/
+{
+  SEXP sexp_X, sexp_unur, sexp_gen, sexp_U, sexp_res;
+  struct unur_gen *gen;
+  double *col;
+  int n, dim, j;
+
+  /* check list of generator objects */
+  if (TYPEOF(sexp_unrs) != VECSXP || Rf_length(sexp_unrs) < 1)
+    Rf_error("[UNU.RAN - error] argument invalid: 'unr' must be list of UNU.RAN objects");
+  dim = Rf_length(sexp_unrs);
+  for (j=0; j<dim; j++) {
+    sexp_unur = VECTOR_ELT(sexp_unrs, j);
+    if (!Rf_isS4(sexp_unur) ||
+	strcmp(Rf_translateChar(STRING_ELT(Rf_getAttrib(sexp_unur, R_ClassSymbol), 0)), "unuran"))
+      Rf_error("[UNU.RAN - error] argument invalid: 'unr' must be list of UNU.RAN objects");
+    if (! LOGICAL(R_do_slot(sexp_unur, Rf_install("inversion")))[0])
+      Rf_error("[UNU.RAN - error] invalid UNU.RAN object: inversion method required!\n\
+\tUse methods 'HINV', 'NINV', 'PINV'; or 'DGT'");
+  }
+
+  /* create point set */
+  PROTECT(sexp_X = _qrng_make_points(sexp_n, dim, sexp_type, sexp_randomize, sexp_skip));
+  n = Rf_nrows(sexp_X);
+
+  /* transform each column */
+  for (j=0; j<dim; j++) {
+    sexp_unur = VECTOR_ELT(sexp_unrs, j);
+    col = REAL(sexp_X) + (size_t) j * n;
+
+    sexp_gen = R_do_slot(sexp_unur, Rf_install("unur"));
+    gen = (Rf_isNull(sexp_gen)) ? NULL : R_ExternalPtrAddr(sexp_gen);
+
+    if (gen != NULL) {
+      /* compute quantiles in place */
+      _Runuran_quantile_array(gen, col, col, n);
+    }
+    else {
+      /* packed generator object */
+      PROTECT(sexp_U = Rf_allocVector(REALSXP, n));
+      memcpy(REAL(sexp_U), col, n * sizeof(double));
+      PROTECT(sexp_res = Runuran_quantile(sexp_unur, sexp_U));
+      memcpy(col, REAL(sexp_res), n * sizeof(double));
+      UNPROTECT(2);
+    }
+  }
+
+  UNPROTECT(1);
+  return sexp_X;
+} /* end of Runuran_qmc() */
+
+/*---------------------------------------------------------------------------*/
+
+SEXP
+_qrng_make_points (SEXP sexp_n, int dim, SEXP sexp_type,
+		   SEXP sexp_randomize, SEXP sexp_skip)
+     /*----------------------------------------------------------------------*/
+     /* Create R matrix with QMC point set.                                  */
+     /*                                                                      */
+     /* Parameters:                                                          */
+     /*   n         ... number of points                                     */
+     /*   dim       ... dimension of points                                  */
+     /*   type      ... type of sequence ("sobol" or "halton")               */
+     /*   randomize ... whether points are randomized (logical)              */
+     /*   skip      ... number of points that are skipped                    */
+     /*                                                                      */
+     /* Return:                                                              */
+     /*   n x dim matrix                                                     */
+     /*----------------------------------------------------------------------*/
+{
+  SEXP sexp_X;
+  UNUR_URNG *qrng;
+  const char *type_str;
+  int type, n, randomize;
+  double skip;
+
+  /* check arguments */
+  n = *(INTEGER (Rf_coerceVector(sexp_n, INTSXP)));
+  if (n == NA_INTEGER || n <= 0)
+    Rf_error("[UNU.RAN - error] number of points 'n' must be positive integer");
+
+  if (TYPEOF(sexp_type) != STRSXP || Rf_length(sexp_type) < 1)
+    Rf_error("[UNU.RAN - error] invalid argument 'type'");
+  type_str = CHAR(STRING_ELT(sexp_type,0));
+  if (!strcmp(type_str, "sobol")) {
+    type = RUNURAN_QRNG_SOBOL;
+    if (dim > SOBOL_MAX_DIM)
+      Rf_error("[UNU.RAN - error] dimension of Sobol sequence must not exceed %d", SOBOL_MAX_DIM);
+  }
+  else if (!strcmp(type_str, "halton")) {
+    type = RUNURAN_QRNG_HALTON;
+    if (dim > HALTON_MAX_DIM)
+      Rf_error("[UNU.RAN - error] dimension of Halton sequence must not exceed %d", HALTON_MAX_DIM);
+  }
+  else
+    Rf_error("[UNU.RAN - error] invalid argument 'type'");
+
+  randomize = *(LOGICAL (Rf_coerceVector(sexp_randomize, LGLSXP)));
+  if (randomize == NA_LOGICAL)
+    Rf_error("[UNU.RAN - error] invalid argument 'randomize'");
+
+  skip = *(REAL (Rf_coerceVector(sexp_skip, REALSXP)));
+  if (!(skip >= 0. && skip + n <= QRNG_MAX_INDEX))
+    Rf_error("[UNU.RAN - error] invalid argument 'skip' (or too many points)");
+  skip = floor(skip);
+
+  /* allocate memory for points */
+  PROTECT(sexp_X = Rf_allocMatrix(REALSXP, n, dim));
+
+  /* create point set. */
+  /* (no R error may occur until qrng is freed) */
+  GetRNGstate();
+  qrng = _Runuran_qrng_new(type, dim, (randomize) ? unur_get_default_urng() : NULL);
+  PutRNGstate();
+  _Runuran_qrng_skip(qrng, skip);
+  _Runuran_qrng_fill(qrng, REAL(sexp_X), n);
+  unur_urng_free(qrng);
+
+  UNPROTECT(1);
+  return sexp_X;
+} /* end of _qrng_make_points() */
+
+/*---------------------------------------------------------------------------*/
@@ -0,0 +1,669 @@
+/*****************************************************************************
+ *                                                                           *
+ *          UNU.RAN -- Universal Non-Uniform Random number generator         *
+ *                                                                           *
+ *****************************************************************************
+ *                                                                           *
+ *   FILE: Runuran_registry.c                                                *
+ *                                                                           *
+ *   PURPOSE:                                                                *
+ *         Registry of generator objects for reusing setups                  *
+ *                                                                           *
+ *****************************************************************************
+ *                                                                           *
+ *   Copyright (c) 2026 Wolfgang Hoermann and Josef Leydold                  *
+ *   Dept. for Statistics, University of Economics, Vienna, Austria          *
+ *                                                                           *
+ *   This program is free software; you can redistribute it and/or modify    *
+ *   it under the terms of the GNU General Public License as published by    *
+ *   the Free Software Foundation; either version 2 of the License, or       *
+ *   (at your option) any later version.                                     *
+ *                                                                           *
+ *   This program is distributed in the hope that it will be useful,         *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of          *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the           *
+ *   GNU General Public License for more details.                            *
+ *                                                                           *
+ *   You should have received a copy of the GNU General Public License       *
+ *   along with this program; if not, write to the                           *
+ *   Free Software Foundation, Inc.,                                         *
+ *   59 Temple Place, Suite 330, Boston, MA 02111-1307, USA                  *
+ *                                                                           *
+ *****************************************************************************
+ *                                                                           *
+ *   The setup of a generator object is expensive compared to sampling      *
+ *   for many methods (e.g., PINV, HINV, TDR). Thus we keep a copy of each   *
+ *   generator object that has been created by Runuran_init() in a           *
+ *   process-wide registry. When the same distribution and method are        *
+ *   requested again, we simply return a clone of the stored object.         *
+ *                                                                           *
+ *   The key of an entry is a byte string that consists of                   *
+ *    - the method string, and                                               *
+ *    - for a standard distribution: type, id, parameters, domain, and the   *
+ *      other data that can be set for such an object; or                    *
+ *    - the distribution string, otherwise.                                  *
+ *   Thus "gamma(2,1)" and "gamma(2.0, 1)" as well as udgamma(2,1) result    *
+ *   in the same key. Distribution objects with R functions cannot be        *
+ *   compared and are never stored in the registry.                          *
+ *                                                                           *
+ *   The stored objects are never used for sampling. So every clone starts   *
+ *   in exactly the same state as a freshly created generator object.        *
+ *   Generators whose setup produced a warning are not stored, so that the   *
+ *   warning is shown again. Only univariate distributions are stored, as    *
+ *   the setup of methods for multivariate distributions may consume         *
+ *   random numbers (e.g., burn-in of MCMC samplers).                        *
+ *                                                                           *
+ *   When the (estimated) total memory of the stored objects exceeds the     *
+ *   given budget, the least recently used entries are removed.              *
+ *                                                                           *
+ *****************************************************************************/
+
+/*---------------------------------------------------------------------------*/
+
+#include "Runuran.h"
+
+/* internal header files for UNU.RAN */
+#include <unur_source.h>
+#include <distr/distr_source.h>
+#include <methods/arou_struct.h>
+#include <methods/ars_struct.h>
+#include <methods/dau_struct.h>
+#include <methods/dgt_struct.h>
+#include <methods/hinv_struct.h>
+#include <methods/ninv_struct.h>
+#include <methods/pinv_struct.h>
+#include <methods/tdr_struct.h>
+#include <utils/lobatto_source.h>
+#include <utils/lobatto_struct.h>
+
+/*---------------------------------------------------------------------------*/
+
+#define REGISTRY_N_BUCKETS  (257)
+/* number of buckets in hash table */
+
+#define REGISTRY_DEFAULT_MEMORY  (32. * 1048576.)
+/* default memory budget in bytes (must match default in R/options.R) */
+
+/*---------------------------------------------------------------------------*/
+
+struct Runuran_registry_entry {
+  struct Runuran_key key;       /* key of entry */
+  unsigned long hash;                    /* hash value of key */
+  struct unur_gen *gen;                  /* stored generator object */
+  double memory;                         /* (estimated) size of entry */
+  struct Runuran_registry_entry *next;   /* next entry in bucket */
+  struct Runuran_registry_entry *newer;  /* LRU list: more recently used */
+  struct Runuran_registry_entry *older;  /* LRU list: less recently used */
+};
+
+static struct {
+  struct Runuran_registry_entry *bucket[REGISTRY_N_BUCKETS];
+  struct Runuran_registry_entry *newest;  /* most recently used entry */
+  struct Runuran_registry_entry *oldest;  /* least recently used entry */
+  int n_entries;                /* number of entries */
+  double memory;                /* total memory of entries */
+  double budget;                /* maximal memory of entries */
+  double hits;                  /* number of successful lookups */
+  double misses;                /* number of failed lookups */
+} registry = { {NULL}, NULL, NULL, 0, 0., REGISTRY_DEFAULT_MEMORY, 0., 0. };
+
+/*---------------------------------------------------------------------------*/
+
+static int _registry_make_key (struct Runuran_key *key,
+			       const struct unur_distr *distr, const char *distrstr,
+			       const char *method);
+/*---------------------------------------------------------------------------*/
+/* Compute key for distribution and method.                                  */
+/*---------------------------------------------------------------------------*/
+
+static struct unur_gen *_registry_lookup (const struct Runuran_key *key,
+					  unsigned long hash);
+/*---------------------------------------------------------------------------*/
+/* Search entry for key and return a clone of the stored generator.          */
+/*---------------------------------------------------------------------------*/
+
+static void _registry_insert (struct Runuran_key *key,
+			      unsigned long hash, const struct unur_gen *gen);
+/*---------------------------------------------------------------------------*/
+/* Store clone of generator object in registry.                              */
+/*---------------------------------------------------------------------------*/
+
+static void _registry_remove (struct Runuran_registry_entry *entry);
+/*---------------------------------------------------------------------------*/
+/* Remove entry from registry.                                               */
+/*---------------------------------------------------------------------------*/
+
+static void _registry_evict (void);
+/*---------------------------------------------------------------------------*/
+/* Remove least recently used entries until memory budget is met.            */
+/*---------------------------------------------------------------------------*/
+
+/*****************************************************************************/
+
+struct unur_gen *
+_Runuran_registry_makegen (SEXP sexp_distr, const char *method)
+     /*----------------------------------------------------------------------*/
+     /* Create generator object for given distribution and method.           */
+     /* Reuse generator object from registry if possible.                    */
+     /*                                                                      */
+     /* Parameters:                                                          */
+     /*   distr  ... distribution (string or R external pointer)             */
+     /*   method ... method (string)                                         */
+     /*                                                                      */
+     /* Return:                                                              */
+     /*   pointer to UNU.RAN generator object                                */
+     /*                                                                      */
+     /* Error:                                                               */
+     /*   return NULL                                                        */
+     /*----------------------------------------------------------------------*/
+{
+  struct unur_gen *gen = NULL;
+  struct unur_distr *distr = NULL;
+  const char *distrstr = NULL;
+  struct Runuran_key key = {NULL, 0, 0};
+  unsigned long hash = 0;
+  int has_key = FALSE;
+
+  /* get distribution */
+  switch (TYPEOF(sexp_distr)) {
+  case STRSXP:
+    distrstr = CHAR(STRING_ELT(sexp_distr,0));
+    if (registry.budget <= 0.)
+      return _Runuran_arena_compact( unur_makegen_ssu( distrstr, method, NULL ) );
+    /* we need the distribution object for computing the key */
+    distr = unur_str2distr(distrstr);
+    if (distr == NULL) return NULL;
+    break;
+
+  case EXTPTRSXP:
+    distr = R_ExternalPtrAddr(sexp_distr);
+    if (registry.budget <= 0.)
+      return _Runuran_arena_compact( unur_makegen_dsu( distr, method, NULL ) );
+    break;
+
+  default:
+    return NULL;
+  }
+
+  /* search registry */
+  has_key = _registry_make_key(&key, distr, distrstr, method);
+  if (has_key) {
+    hash = _Runuran_key_hash(&key);
+    gen = _registry_lookup(&key, hash);
+  }
+
+  if (gen == NULL) {
+    /* create generator object */
+    unur_reset_errno();
+    gen = _Runuran_arena_compact( unur_makegen_dsu( distr, method, NULL ) );
+
+    /* store a copy in registry */
+    if (has_key && gen != NULL && unur_get_errno() == UNUR_SUCCESS)
+      _registry_insert(&key, hash, gen);
+  }
+
+  /* clear memory */
+  if (key.buf) free(key.buf);
+  if (distrstr) unur_distr_free(distr);
+
+  return gen;
+
+} /* end of _Runuran_registry_makegen() */
+
+/*---------------------------------------------------------------------------*/
+
+void
+_Runuran_registry_clear (void)
+     /*----------------------------------------------------------------------*/
+     /* Remove all entries from registry.                                    */
+     /*----------------------------------------------------------------------*/
+{
+  while (registry.oldest)
+    _registry_remove(registry.oldest);
+} /* end of _Runuran_registry_clear() */
+
+/*---------------------------------------------------------------------------*/
+
+SEXP
+Runuran_set_registry_memory (SEXP sexp_memory)
+     /*----------------------------------------------------------------------*/
+     /* Set memory budget for registry of generator objects.                 */
+     /*                                                                      */
+     /* Parameters:                                                          */
+     /*   memory ... memory budget in MB (0 disables the registry)           */
+     /*                                                                      */
+     /* Return:                                                              */
+     /*   R_NilValue                                                         */
+     /*----------------------------------------------------------------------*/
+{
+  double memory;
+
+  memory = *(REAL (Rf_coerceVector(sexp_memory, REALSXP)));
+  if (ISNAN(memory) || memory < 0.)
+    Rf_error("[UNU.RAN - error] invalid memory budget for registry");
+
+  registry.budget = memory * 1048576.;
+  _registry_evict();
+
+  return R_NilValue;
+} /* end of Runuran_set_registry_memory() */
+
+/*---------------------------------------------------------------------------*/
+
+SEXP
+Runuran_registry_info (void)
+     /*----------------------------------------------------------------------*/
+     /* Get some informations about registry of generator objects.           */
+     /*                                                                      */
+     /* Return:                                                              */
+     /*   named numeric vector                                               */
+     /*----------------------------------------------------------------------*/
+{
+  const char *names[] = {"entries", "memory", "budget", "hits", "misses"};
+  SEXP sexp_info, sexp_names;
+  int i;
+
+  PROTECT(sexp_info = Rf_allocVector(REALSXP, 5));
+  REAL(sexp_info)[0] = registry.n_entries;
+  REAL(sexp_info)[1] = registry.memory;
+  REAL(sexp_info)[2] = registry.budget;
+  REAL(sexp_info)[3] = registry.hits;
+  REAL(sexp_info)[4] = registry.misses;
+
+  PROTECT(sexp_names = Rf_allocVector(STRSXP, 5));
+  for (i=0; i<5; i++)
+    SET_STRING_ELT(sexp_names, i, Rf_mkChar(names[i]));
+  Rf_setAttrib(sexp_info, R_NamesSymbol, sexp_names);
+
+  UNPROTECT(2);
+  return sexp_info;
+} /* end of Runuran_registry_info() */
+
+/*---------------------------------------------------------------------------*/
+
+void
+_Runuran_key_add (struct Runuran_key *key, const void *data, size_t len)
+     /*----------------------------------------------------------------------*/
+     /* Append data to key.                                                  */
+     /*                                                                      */
+     /* Parameters:                                                          */
+     /*   key  ... pointer to key                                            */
+     /*   data ... pointer to data                                           */
+     /*   len  ... length of data in bytes                                   */
+     /*----------------------------------------------------------------------*/
+{
+  if (key->len + len > key->size) {
+    key->size = 2 * (key->len + len) + 64;
+    key->buf = _unur_xrealloc(key->buf, key->size);
+  }
+  memcpy(key->buf + key->len, data, len);
+  key->len += len;
+} /* end of _Runuran_key_add() */
+
+/*---------------------------------------------------------------------------*/
+
+unsigned long
+_Runuran_key_hash (const struct Runuran_key *key)
+     /*----------------------------------------------------------------------*/
+     /* Compute hash value for key (FNV-1a).                                 */
+     /*                                                                      */
+     /* Parameters:                                                          */
+     /*   key ... pointer to key                                             */
+     /*                                                                      */
+     /* Return:                                                              */
+     /*   hash value                                                         */
+     /*----------------------------------------------------------------------*/
+{
+  unsigned long hash = 2166136261UL;
+  size_t i;
+
+  for (i=0; i<key->len; i++) {
+    hash ^= key->buf[i];
+    hash *= 16777619UL;
+    hash &= 0xffffffffUL;
+  }
+
+  return hash;
+} /* end of _Runuran_key_hash() */
+
+/*****************************************************************************/
+
+int
+_registry_make_key (struct Runuran_key *key,
+		    const struct unur_distr *distr, const char *distrstr,
+		    const char *method)
+     /*----------------------------------------------------------------------*/
+     /* Compute key for distribution and method.                             */
+     /*                                                                      */
+     /* Parameters:                                                          */
+     /*   key      ... pointer to (empty) key                                */
+     /*   distr    ... pointer to distribution object                        */
+     /*   distrstr ... distribution string (or NULL)                         */
+     /*   method   ... method string                                         */
+     /*                                                                      */
+     /* Return:                                                              */
+     /*   TRUE  ... if key could be computed                                 */
+     /*   FALSE ... otherwise (distribution cannot be stored)                */
+     /*----------------------------------------------------------------------*/
+{
+  char tag;
+  int is_std;
+
+  /* standard distributions that are not modified */
+  is_std = ( distr->id != UNUR_DISTR_GENERIC && distr->extobj == NULL &&
+	     distr->base == NULL );
+  switch (distr->type) {
+  case UNUR_DISTR_CONT:
+    is_std = is_std && ( distr->data.cont.pdftree == NULL &&
+			 distr->data.cont.cdftree == NULL );
+    break;
+  case UNUR_DISTR_DISCR:
+    is_std = is_std && ( distr->data.discr.pv == NULL &&
+			 distr->data.discr.pmftree == NULL &&
+			 distr->data.discr.cdftree == NULL );
+    break;
+  default:
+    is_std = FALSE;
+  }
+
+  /* other distributions can only be compared by means of their string */
+  if (!is_std && distrstr == NULL)
+    return FALSE;
+
+  /* method */
+  _Runuran_key_add(key, method, strlen(method)+1);
+
+  if (!is_std) {
+    /* distribution string */
+    tag = 's';
+    _Runuran_key_add(key, &tag, 1);
+    _Runuran_key_add(key, distrstr, strlen(distrstr)+1);
+    return TRUE;
+  }
+
+  /* standard distribution */
+  tag = 'd';
+  _Runuran_key_add(key, &tag, 1);
+  _Runuran_key_add(key, &(distr->type), sizeof(unsigned));
+  _Runuran_key_add(key, &(distr->id), sizeof(unsigned));
+  _Runuran_key_add(key, &(distr->set), sizeof(unsigned));
+
+  if (distr->type == UNUR_DISTR_CONT) {
+#define DISTR distr->data.cont
+    _Runuran_key_add(key, &(DISTR.n_params), sizeof(int));
+    _Runuran_key_add(key, DISTR.params, DISTR.n_params * sizeof(double));
+    _Runuran_key_add(key, DISTR.domain, 2 * sizeof(double));
+    _Runuran_key_add(key, DISTR.trunc, 2 * sizeof(double));
+    _Runuran_key_add(key, &(DISTR.mode), sizeof(double));
+    _Runuran_key_add(key, &(DISTR.center), sizeof(double));
+    _Runuran_key_add(key, &(DISTR.area), sizeof(double));
+#undef DISTR
+  }
+  else {
+#define DISTR distr->data.discr
+    _Runuran_key_add(key, &(DISTR.n_params), sizeof(int));
+    _Runuran_key_add(key, DISTR.params, DISTR.n_params * sizeof(double));
+    _Runuran_key_add(key, DISTR.domain, 2 * sizeof(int));
+    _Runuran_key_add(key, DISTR.trunc, 2 * sizeof(int));
+    _Runuran_key_add(key, &(DISTR.mode), sizeof(int));
+    _Runuran_key_add(key, &(DISTR.sum), sizeof(double));
+#undef DISTR
+  }
+
+  return TRUE;
+} /* end of _registry_make_key() */
+
+
+/*---------------------------------------------------------------------------*/
+
+struct unur_gen *
+_registry_lookup (const struct Runuran_key *key, unsigned long hash)
+     /*----------------------------------------------------------------------*/
+     /* Search entry for key and return a clone of the stored generator.     */
+     /*                                                                      */
+     /* Parameters:                                                          */
+     /*   key  ... pointer to key                                            */
+     /*   hash ... hash value of key                                         */
+     /*                                                                      */
+     /* Return:                                                              */
+     /*   pointer to clone of generator object                               */
+     /*   NULL if the registry does not contain the key (or if the stored    */
+     /*   generator cannot be cloned; then the entry is removed)             */
+     /*----------------------------------------------------------------------*/
+{
+  struct Runuran_registry_entry *entry;
+  struct unur_gen *clone;
+
+  for (entry = registry.bucket[hash % REGISTRY_N_BUCKETS]; entry; entry = entry->next) {
+    if (entry->hash == hash && entry->key.len == key->len &&
+	memcmp(entry->key.buf, key->buf, key->len) == 0)
+      break;
+  }
+
+  if (entry == NULL) {
+    ++registry.misses;
+    return NULL;
+  }
+
+  if ((clone = unur_gen_clone(entry->gen)) == NULL) {
+    /* broken entry: remove it, such that the caller can store a new one */
+    _registry_remove(entry);
+    ++registry.misses;
+    return NULL;
+  }
+
+  /* move entry to front of LRU list */
+  if (entry != registry.newest) {
+    /* unlink */
+    entry->newer->older = entry->older;
+    if (entry->older) entry->older->newer = entry->newer;
+    else registry.oldest = entry->newer;
+    /* insert at front */
+    entry->older = registry.newest;
+    entry->newer = NULL;
+    registry.newest->newer = entry;
+    registry.newest = entry;
+  }
+
+  ++registry.hits;
+  return clone;
+} /* end of _registry_lookup() */
+
+/*---------------------------------------------------------------------------*/
+
+void
+_registry_insert (struct Runuran_key *key, unsigned long hash,
+		  const struct unur_gen *gen)
+     /*----------------------------------------------------------------------*/
+     /* Store clone of generator object in registry.                         */
+     /*                                                                      */
+     /* Parameters:                                                          */
+     /*   key  ... pointer to key (the buffer is moved into the registry)    */
+     /*   hash ... hash value of key                                         */
+     /*   gen  ... pointer to generator object                               */
+     /*----------------------------------------------------------------------*/
+{
+  struct Runuran_registry_entry *entry;
+  struct unur_gen *clone;
+  double memory;
+  int b;
+
+  /* only univariate distributions */
+  switch (gen->distr->type) {
+  case UNUR_DISTR_CONT:
+  case UNUR_DISTR_CEMP:
+  case UNUR_DISTR_DISCR:
+    break;
+  default:
+    return;
+  }
+
+  /* check size of generator object */
+  memory = sizeof(struct Runuran_registry_entry) + key->len + _Runuran_gen_memory(gen);
+  if (memory > registry.budget)
+    return;
+
+  /* make a copy */
+  if ((clone = unur_gen_clone(gen)) == NULL)
+    return;
+
+  /* create entry */
+  entry = _unur_xmalloc(sizeof(struct Runuran_registry_entry));
+  entry->key = *key;
+  key->buf = NULL; key->len = key->size = 0;
+  entry->hash = hash;
+  entry->gen = clone;
+  entry->memory = memory;
+
+  /* insert into hash table */
+  b = hash % REGISTRY_N_BUCKETS;
+  entry->next = registry.bucket[b];
+  registry.bucket[b] = entry;
+
+  /* insert at front of LRU list */
+  entry->newer = NULL;
+  entry->older = registry.newest;
+  if (registry.newest) registry.newest->newer = entry;
+  else registry.oldest = entry;
+  registry.newest = entry;
+
+  ++registry.n_entries;
+  registry.memory += memory;
+
+  /* check memory budget */
+  _registry_evict();
+
+} /* end of _registry_insert() */
+
+/*---------------------------------------------------------------------------*/
+
+void
+_registry_remove (struct Runuran_registry_entry *entry)
+     /*----------------------------------------------------------------------*/
+     /* Remove entry from registry.                                          */
+     /*                                                                      */
+     /* Parameters:                                                          */
+     /*   entry ... pointer to entry                                         */
+     /*----------------------------------------------------------------------*/
+{
+  struct Runuran_registry_entry **p;
+
+  /* remove from hash table */
+  for (p = &(registry.bucket[entry->hash % REGISTRY_N_BUCKETS]); *p != entry; p = &((*p)->next))
+    ;
+  *p = entry->next;
+
+  /* remove from LRU list */
+  if (entry->newer) entry->newer->older = entry->older;
+  else registry.newest = entry->older;
+  if (entry->older) entry->older->newer = entry->newer;
+  else registry.oldest = entry->newer;
+
+  --registry.n_entries;
+  registry.memory -= entry->memory;
+
+  /* free memory */
+  unur_free(entry->gen);
+  free(entry->key.buf);
+  free(entry);
+
+} /* end of _registry_remove() */
+
+/*---------------------------------------------------------------------------*/
+
+void
+_registry_evict (void)
+     /*----------------------------------------------------------------------*/
+     /* Remove least recently used entries until memory budget is met.       */
+     /*----------------------------------------------------------------------*/
+{
+  while (registry.oldest && registry.memory > registry.budget)
+    _registry_remove(registry.oldest);
+
+  /* avoid accumulation of round-off errors */
+  if (registry.n_entries == 0)
+    registry.memory = 0.;
+} /* end of _registry_evict() */
+
+/*---------------------------------------------------------------------------*/
+
+double
+_Runuran_gen_memory (const struct unur_gen *gen)
+     /*----------------------------------------------------------------------*/
+     /* Estimate memory used by generator object.                            */
+     /* Only the large tables of the most important methods are taken into   */
+     /* account.                                                             */
+     /*                                                                      */
+     /* Parameters:                                                          */
+     /*   gen ... pointer to generator object                                */
+     /*                                                                      */
+     /* Return:                                                              */
+     /*   memory in bytes                                                    */
+     /*----------------------------------------------------------------------*/
+{
+  double memory;
+  int i;
+
+  memory = sizeof(struct unur_gen) + gen->s_datap + sizeof(struct unur_distr);
+
+  switch (unur_get_method(gen)) {
+  case UNUR_METH_AROU:
+#define GEN ((struct unur_arou_gen*)gen->datap)
+    memory += GEN->n_segs * sizeof(struct unur_arou_segment)
+      + GEN->guide_size * sizeof(struct unur_arou_segment*);
+#undef GEN
+    break;
+  case UNUR_METH_ARS:
+#define GEN ((struct unur_ars_gen*)gen->datap)
+    memory += GEN->n_ivs * sizeof(struct unur_ars_interval);
+#undef GEN
+    break;
+  case UNUR_METH_DAU:
+#define GEN ((struct unur_dau_gen*)gen->datap)
+    memory += GEN->urn_size * (sizeof(double) + sizeof(int));
+#undef GEN
+    break;
+  case UNUR_METH_DGT:
+#define GEN ((struct unur_dgt_gen*)gen->datap)
+    memory += gen->distr->data.discr.n_pv * sizeof(double) + GEN->guide_size * sizeof(int);
+#undef GEN
+    break;
+  case UNUR_METH_HINV:
+#define GEN ((struct unur_hinv_gen*)gen->datap)
+    memory += GEN->N * (GEN->order+2) * sizeof(double) + GEN->guide_size * sizeof(int);
+#undef GEN
+    break;
+  case UNUR_METH_NINV:
+#define GEN ((struct unur_ninv_gen*)gen->datap)
+    memory += (GEN->table) ? 2 * GEN->table_size * sizeof(double) : 0;
+#undef GEN
+    break;
+  case UNUR_METH_PINV:
+#define GEN ((struct unur_pinv_gen*)gen->datap)
+    memory += ((GEN->n_ivs+1) * (sizeof(struct unur_pinv_interval) + 2*GEN->order*sizeof(double))
+	       + GEN->guide_size * sizeof(int)
+	       + ((GEN->aCDF) ? sizeof(struct unur_lobatto_table)
+		  + GEN->aCDF->size * sizeof(struct unur_lobatto_nodes) : 0));
+#undef GEN
+    break;
+  case UNUR_METH_TDR:
+#define GEN ((struct unur_tdr_gen*)gen->datap)
+    memory += GEN->n_ivs * sizeof(struct unur_tdr_interval)
+      + GEN->guide_size * sizeof(struct unur_tdr_interval*);
+#undef GEN
+    break;
+  default:
+    break;
+  }
+
+  /* auxiliary generators */
+  if (gen->gen_aux)
+    memory += _Runuran_gen_memory(gen->gen_aux);
+  for (i=0; i<gen->n_gen_aux_list; i++)
+    if (gen->gen_aux_list[i])
+      memory += _Runuran_gen_memory(gen->gen_aux_list[i]);
+
+  return memory;
+} /* end of _Runuran_gen_memory() */
+
+/*---------------------------------------------------------------------------*/
@@ -0,0 +1,386 @@
+/*****************************************************************************
+ *                                                                           *
+ *          UNU.RAN -- Universal Non-Uniform Random number generator         *
+ *                                                                           *
+ *****************************************************************************
+ *                                                                           *
+ *   FILE: Runuran_std.c                                                     *
+ *                                                                           *
+ *   PURPOSE:                                                                *
+ *         Change parameters of generator objects for methods CSTD and DSTD  *
+ *         Change truncated domain of generator objects                      *
+ *                                                                           *
+ *****************************************************************************
+ *                                                                           *
+ *   Copyright (c) 2026 Wolfgang Hoermann and Josef Leydold                  *
+ *   Dept. for Statistics, University of Economics, Vienna, Austria          *
+ *                                                                           *
+ *   This program is free software; you can redistribute it and/or modify    *
+ *   it under the terms of the GNU General Public License as published by    *
+ *   the Free Software Foundation; either version 2 of the License, or       *
+ *   (at your option) any later version.                                     *
+ *                                                                           *
+ *   This program is distributed in the hope that it will be useful,         *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of          *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the           *
+ *   GNU General Public License for more details.                            *
+ *                                                                           *
+ *   You should have received a copy of the GNU General Public License       *
+ *   along with this program; if not, write to the                           *
+ *   Free Software Foundation, Inc.,                                         *
+ *   59 Temple Place, Suite 330, Boston, MA 02111-1307, USA                  *
+ *                                                                           *
+ *****************************************************************************
+ *                                                                           *
+ *   Methods CSTD and DSTD use the special generators for standard           *
+ *   distributions. Their setup consists of computing a few constants        *
+ *   that depend on the parameters of the distribution (e.g.,                *
+ *   gamma_gd_init() in c_gamma_gen.c). When the parameters are changed      *
+ *   frequently (e.g., in Gibbs samplers where a gamma or Poisson variate    *
+ *   with new parameters is drawn in every step) the costs for creating a    *
+ *   new generator object dominate.                                          *
+ *                                                                           *
+ *   Thus we change the parameters of the distribution object inside the     *
+ *   generator object and rerun the reinit routine of the method. This       *
+ *   recomputes the constants in place; the array for the constants is       *
+ *   only reallocated when the special generator switches to a variant       *
+ *   that requires a different number of constants.                          *
+ *   For inversion methods the boundaries of the truncated domain are        *
+ *   kept and the corresponding CDF values are recomputed.                   *
+ *   If the new parameters are invalid the old parameters are restored and   *
+ *   the generator object remains unchanged.                                 *
+ *                                                                           *
+ *   The truncated domain is changed by the corresponding functions of the   *
+ *   UNU.RAN library. For method PINV (which has no such function) see       *
+ *   _Runuran_pinv_chg_truncated() in Runuran_pinv.c.                        *
+ *                                                                           *
+ *****************************************************************************/
+
+/*---------------------------------------------------------------------------*/
+
+#include "Runuran.h"
+
+/* internal header files for UNU.RAN */
+#include <unur_source.h>
+#include <distr/distr_source.h>
+#include <methods/cstd_struct.h>
+#include <methods/dstd_struct.h>
+
+/*---------------------------------------------------------------------------*/
+
+static int _cstd_update (struct unur_gen *gen, const double *domain, const double *trunc);
+/*---------------------------------------------------------------------------*/
+/* Recompute constants after parameters have been changed (method CSTD).     */
+/*---------------------------------------------------------------------------*/
+
+static int _dstd_update (struct unur_gen *gen, const int *domain, const int *trunc);
+/*---------------------------------------------------------------------------*/
+/* Recompute constants after parameters have been changed (method DSTD).     */
+/*---------------------------------------------------------------------------*/
+
+/*****************************************************************************/
+
+SEXP
+Runuran_chg_params (SEXP sexp_unur, SEXP sexp_params)
+     /*----------------------------------------------------------------------*/
+     /* Change parameters of distribution in generator object.               */
+     /* (methods CSTD and DSTD only)                                         */
+     /*                                                                      */
+     /* Parameters:                                                          */
+     /*   unur   ... 'Runuran' object (S4 class)                             */ 
+     /*   params ... vector of new parameter values                          */
+     /*                                                                      */
+     /* Return:                                                              */
+     /*   R_NilValue                                                         */
+     /*----------------------------------------------------------------------*/
+{
+  SEXP sexp_gen;
+  struct unur_gen *gen = NULL;
+  int rcode;
+
+  /* first argument must be S4 class */
+  if (!Rf_isS4(sexp_unur))
+    Rf_error("[UNU.RAN - error] argument invalid: 'unr' must be UNU.RAN object");
+
+  /* Extract pointer to UNU.RAN generator */
+  sexp_gen = R_do_slot(sexp_unur, Rf_install("unur"));
+  if (! Rf_isNull(sexp_gen)) {
+    CHECK_UNUR_PTR(sexp_gen);
+    gen = R_ExternalPtrAddr(sexp_gen);
+  }
+  if (gen == NULL)
+    Rf_error("[UNU.RAN - error] invalid UNU.RAN object (packed?)");
+
+  /* parameters */
+  PROTECT(sexp_params = Rf_coerceVector(sexp_params, REALSXP));
+
+  switch (unur_get_method(gen)) {
+  case UNUR_METH_CSTD:
+    rcode = _Runuran_cstd_chg_params(gen, REAL(sexp_params), Rf_length(sexp_params));
+    break;
+  case UNUR_METH_DSTD:
+    rcode = _Runuran_dstd_chg_params(gen, REAL(sexp_params), Rf_length(sexp_params));
+    break;
+  default:
+    UNPROTECT(1);
+    Rf_error("[UNU.RAN - error] parameters can only be changed for methods CSTD and DSTD");
+  }
+
+  UNPROTECT(1);
+
+  if (rcode != UNUR_SUCCESS)
+    Rf_error("[UNU.RAN - error] cannot change parameters");
+
+  return R_NilValue;
+} /* end of Runuran_chg_params() */
+
+/*---------------------------------------------------------------------------*/
+
+SEXP
+Runuran_chg_truncated (SEXP sexp_unur, SEXP sexp_lb, SEXP sexp_ub)
+     /*----------------------------------------------------------------------*/
+     /* Change truncated domain of distribution in generator object.         */
+     /* (methods PINV, HINV, NINV, CSTD, and DSTD)                           */
+     /*                                                                      */
+     /* Parameters:                                                          */
+     /*   unur ... 'Runuran' object (S4 class)                               */ 
+     /*   lb   ... left boundary of truncated domain                         */
+     /*   ub   ... right boundary of truncated domain                        */
+     /*                                                                      */
+     /* Return:                                                              */
+     /*   R_NilValue                                                         */
+     /*----------------------------------------------------------------------*/
+{
+  SEXP sexp_gen;
+  struct unur_gen *gen = NULL;
+  double lb, ub;
+  int rcode;
+
+  /* first argument must be S4 class */
+  if (!Rf_isS4(sexp_unur))
+    Rf_error("[UNU.RAN - error] argument invalid: 'unr' must be UNU.RAN object");
+
+  /* Extract pointer to UNU.RAN generator */
+  sexp_gen = R_do_slot(sexp_unur, Rf_install("unur"));
+  if (! Rf_isNull(sexp_gen)) {
+    CHECK_UNUR_PTR(sexp_gen);
+    gen = R_ExternalPtrAddr(sexp_gen);
+  }
+  if (gen == NULL)
+    Rf_error("[UNU.RAN - error] invalid UNU.RAN object (packed?)");
+
+  /* boundaries of domain */
+  lb = Rf_asReal(sexp_lb);
+  ub = Rf_asReal(sexp_ub);
+  if (ISNAN(lb) || ISNAN(ub))
+    Rf_error("[UNU.RAN - error] invalid domain");
+
+  switch (unur_get_method(gen)) {
+  case UNUR_METH_PINV:
+    rcode = _Runuran_pinv_chg_truncated(gen, lb, ub);
+    break;
+  case UNUR_METH_HINV:
+    rcode = unur_hinv_chg_truncated(gen, lb, ub);
+    break;
+  case UNUR_METH_NINV:
+    rcode = unur_ninv_chg_truncated(gen, lb, ub);
+    break;
+  case UNUR_METH_CSTD:
+    rcode = unur_cstd_chg_truncated(gen, lb, ub);
+    break;
+  case UNUR_METH_DSTD:
+    rcode = unur_dstd_chg_truncated(gen,
+				    (lb < (double) INT_MIN) ? INT_MIN : (int) lb,
+				    (ub > (double) INT_MAX) ? INT_MAX : (int) ub);
+    break;
+  default:
+    Rf_error("[UNU.RAN - error] truncated domain can only be changed for methods PINV, HINV, NINV, CSTD, and DSTD");
+  }
+
+  if (rcode != UNUR_SUCCESS)
+    Rf_error("[UNU.RAN - error] cannot change truncated domain");
+
+  return R_NilValue;
+} /* end of Runuran_chg_truncated() */
+
+/*---------------------------------------------------------------------------*/
+
+#define DISTR     gen->distr->data.cont
+#define GEN       ((struct unur_cstd_gen*)gen->datap)
+
+int
+_Runuran_cstd_chg_params (struct unur_gen *gen, const double *params, int n_params)
+     /*----------------------------------------------------------------------*/
+     /* Change parameters of distribution in generator object (method CSTD). */
+     /*                                                                      */
+     /* Parameters:                                                          */
+     /*   gen      ... pointer to generator object                           */
+     /*   params   ... array of new parameter values                         */
+     /*   n_params ... number of parameters                                  */
+     /*                                                                      */
+     /* Return:                                                              */
+     /*   UNUR_SUCCESS ... on success                                        */
+     /*   error code   ... otherwise (generator object is unchanged)         */
+     /*----------------------------------------------------------------------*/
+{
+  double old_params[UNUR_DISTR_MAXPARAMS];
+  int n_old_params;
+  double domain[2], trunc[2];
+  int rcode;
+
+  if (gen == NULL || unur_get_method(gen) != UNUR_METH_CSTD)
+    return UNUR_ERR_GEN_INVALID;
+
+  /* store old parameters and domain */
+  n_old_params = DISTR.n_params;
+  memcpy(old_params, DISTR.params, n_old_params * sizeof(double));
+  domain[0] = DISTR.domain[0];  domain[1] = DISTR.domain[1];
+  trunc[0] = DISTR.trunc[0];    trunc[1] = DISTR.trunc[1];
+
+  /* set new parameters and recompute constants */
+  rcode = unur_distr_cont_set_pdfparams(gen->distr, params, n_params);
+  if (rcode == UNUR_SUCCESS)
+    rcode = _cstd_update(gen, domain, trunc);
+
+  if (rcode != UNUR_SUCCESS) {
+    /* restore old parameters */
+    unur_distr_cont_set_pdfparams(gen->distr, old_params, n_old_params);
+    _cstd_update(gen, domain, trunc);
+  }
+
+  return rcode;
+} /* end of _Runuran_cstd_chg_params() */
+
+/*---------------------------------------------------------------------------*/
+
+int
+_cstd_update (struct unur_gen *gen, const double *domain, const double *trunc)
+     /*----------------------------------------------------------------------*/
+     /* Recompute constants after parameters have been changed (CSTD).       */
+     /*                                                                      */
+     /* Parameters:                                                          */
+     /*   gen    ... pointer to generator object                             */
+     /*   domain ... domain of distribution for old parameters               */
+     /*   trunc  ... truncated domain for old parameters                     */
+     /*                                                                      */
+     /* Return:                                                              */
+     /*   UNUR_SUCCESS ... on success                                        */
+     /*   error code   ... otherwise                                         */
+     /*----------------------------------------------------------------------*/
+{
+  double left, right;
+  int rcode;
+
+  /* normalization constant (used by ud()) */
+  if (DISTR.upd_area)
+    unur_distr_cont_upd_pdfarea(gen->distr);
+
+  /* constants for special generator */
+  if ((rcode = unur_reinit(gen)) != UNUR_SUCCESS)
+    return rcode;
+
+  /* CDF values at boundaries of truncated domain */
+  if (GEN->is_inversion) {
+    /* a boundary that coincides with the boundary of the domain follows */
+    /* the domain of the distribution with the new parameters.           */
+    left  = (trunc[0] > domain[0]) ? trunc[0] : DISTR.domain[0];
+    right = (trunc[1] < domain[1]) ? trunc[1] : DISTR.domain[1];
+    rcode = unur_cstd_chg_truncated(gen, left, right);
+  }
+
+  return rcode;
+} /* end of _cstd_update() */
+
+#undef DISTR
+#undef GEN
+
+/*---------------------------------------------------------------------------*/
+
+#define DISTR     gen->distr->data.discr
+#define GEN       ((struct unur_dstd_gen*)gen->datap)
+
+int
+_Runuran_dstd_chg_params (struct unur_gen *gen, const double *params, int n_params)
+     /*----------------------------------------------------------------------*/
+     /* Change parameters of distribution in generator object (method DSTD). */
+     /*                                                                      */
+     /* Parameters:                                                          */
+     /*   gen      ... pointer to generator object                           */
+     /*   params   ... array of new parameter values                         */
+     /*   n_params ... number of parameters                                  */
+     /*                                                                      */
+     /* Return:                                                              */
+     /*   UNUR_SUCCESS ... on success                                        */
+     /*   error code   ... otherwise (generator object is unchanged)         */
+     /*----------------------------------------------------------------------*/
+{
+  double old_params[UNUR_DISTR_MAXPARAMS];
+  int n_old_params;
+  int domain[2], trunc[2];
+  int rcode;
+
+  if (gen == NULL || unur_get_method(gen) != UNUR_METH_DSTD)
+    return UNUR_ERR_GEN_INVALID;
+
+  /* store old parameters and domain */
+  n_old_params = DISTR.n_params;
+  memcpy(old_params, DISTR.params, n_old_params * sizeof(double));
+  domain[0] = DISTR.domain[0];  domain[1] = DISTR.domain[1];
+  trunc[0] = DISTR.trunc[0];    trunc[1] = DISTR.trunc[1];
+
+  /* set new parameters and recompute constants */
+  rcode = unur_distr_discr_set_pmfparams(gen->distr, params, n_params);
+  if (rcode == UNUR_SUCCESS)
+    rcode = _dstd_update(gen, domain, trunc);
+
+  if (rcode != UNUR_SUCCESS) {
+    /* restore old parameters */
+    unur_distr_discr_set_pmfparams(gen->distr, old_params, n_old_params);
+    _dstd_update(gen, domain, trunc);
+  }
+
+  return rcode;
+} /* end of _Runuran_dstd_chg_params() */
+
+/*---------------------------------------------------------------------------*/
+
+int
+_dstd_update (struct unur_gen *gen, const int *domain, const int *trunc)
+     /*----------------------------------------------------------------------*/
+     /* Recompute constants after parameters have been changed (DSTD).       */
+     /*                                                                      */
+     /* Parameters:                                                          */
+     /*   gen    ... pointer to generator object                             */
+     /*   domain ... domain of distribution for old parameters               */
+     /*   trunc  ... truncated domain for old parameters                     */
+     /*                                                                      */
+     /* Return:                                                              */
+     /*   UNUR_SUCCESS ... on success                                        */
+     /*   error code   ... otherwise                                         */
+     /*----------------------------------------------------------------------*/
+{
+  int left, right;
+  int rcode;
+
+  /* normalization constant (used by ud()) */
+  if (DISTR.upd_sum)
+    unur_distr_discr_upd_pmfsum(gen->distr);
+
+  /* constants for special generator */
+  if ((rcode = unur_reinit(gen)) != UNUR_SUCCESS)
+    return rcode;
+
+  /* CDF values at boundaries of truncated domain */
+  if (GEN->is_inversion) {
+    left  = (trunc[0] > domain[0]) ? trunc[0] : DISTR.domain[0];
+    right = (trunc[1] < domain[1]) ? trunc[1] : DISTR.domain[1];
+    rcode = unur_dstd_chg_truncated(gen, left, right);
+  }
+
+  return rcode;
+} /* end of _dstd_update() */
+
+#undef DISTR
+#undef GEN
+
+/*---------------------------------------------------------------------------*/
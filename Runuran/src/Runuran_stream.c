@@ -0,0 +1,853 @@
+/*****************************************************************************
+ *                                                                           *
+ *          UNU.RAN -- Universal Non-Uniform Random number generator         *
+ *                                                                           *
+ *****************************************************************************
+ *                                                                           *
+ *   FILE: Runuran_stream.c                                                  *
+ *                                                                           *
+ *   PURPOSE:                                                                *
+ *         Streaming sampler: random variates from a background thread       *
+ *                                                                           *
+ *****************************************************************************
+ *                                                                           *
+ *   Copyright (c) 2026 Wolfgang Hoermann and Josef Leydold                  *
+ *   Dept. for Statistics, University of Economics, Vienna, Austria          *
+ *                                                                           *
+ *   This program is free software; you can redistribute it and/or modify    *
+ *   it under the terms of the GNU General Public License as published by    *
+ *   the Free Software Foundation; either version 2 of the License, or       *
+ *   (at your option) any later version.                                     *
+ *                                                                           *
+ *   This program is distributed in the hope that it will be useful,         *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of          *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the           *
+ *   GNU General Public License for more details.                            *
+ *                                                                           *
+ *   You should have received a copy of the GNU General Public License       *
+ *   along with this program; if not, write to the                           *
+ *   Free Software Foundation, Inc.,                                         *
+ *   59 Temple Place, Suite 330, Boston, MA 02111-1307, USA                  *
+ *                                                                           *
+ *****************************************************************************
+ *                                                                           *
+ *   Runuran_sample() allocates the whole result vector and returns only     *
+ *   when all random variates are generated. For huge samples the user has   *
+ *   to split the job into chunks. A streaming sampler instead returns the   *
+ *   next block of an (infinite) sequence of random variates each time it    *
+ *   is called.                                                              *
+ *                                                                           *
+ *   The stream object owns a clone of the given generator object together   *
+ *   with a private uniform random number generator (combined multiple       *
+ *   recursive generator MRG31k3p). Thus the state of the R built-in URNG    *
+ *   is not changed and the same seed results in the same sequence of        *
+ *   random variates independent of the block sizes.                         *
+ *                                                                           *
+ *   When POSIX threads are available and the sampling routine of the        *
+ *   generator object only uses precomputed tables or special generators     *
+ *   (methods PINV, HINV, DGT, DAU, DINV, and CSTD/DSTD without inversion),  *
+ *   a background thread (producer) fills a ring buffer with random          *
+ *   variates while R (consumer) is busy with other computations.            *
+ *   The ring buffer is a lock-free single-producer / single-consumer        *
+ *   queue: the producer only writes 'head', the consumer only writes        *
+ *   'tail' (both are running counters). A mutex and a condition variable    *
+ *   are only used to put a thread to sleep when the buffer is full or       *
+ *   empty. For all other generator objects (e.g., those that evaluate R     *
+ *   functions) the random variates are generated in the main thread when    *
+ *   they are requested. They are generated one at a time (as in the         *
+ *   producer) since the array samplers of some methods (e.g., thinning of   *
+ *   blocks for HRB/HRD/HRI or warm starts for NINV) consume a different     *
+ *   number of uniform random numbers depending on the size of the array.    *
+ *                                                                           *
+ *   External generators (methods CEXT and DEXT created by cext.new() and    *
+ *   dext.new()) use the R built-in URNG and thus ignore the private URNG.   *
+ *   Such generators (also as components of a mixture) are rejected.         *
+ *                                                                           *
+ *   The producer thread must not use the R API. Thus warnings and errors    *
+ *   of UNU.RAN in the producer thread are neither printed nor stored in     *
+ *   the error log. They are counted and reported by the consumer instead.   *
+ *                                                                           *
+ *   Known limitation: the error code 'unur_errno' and the pointer to the    *
+ *   error handler are global variables of the UNU.RAN library (and we do    *
+ *   not modify the library). Our error handlers check whether they run in   *
+ *   a producer thread (thread specific data '_stream_key') and thus behave  *
+ *   as if they were thread local. However, an error in a producer thread    *
+ *   also sets 'unur_errno' of the main thread. Routines that read this      *
+ *   error code (verify.c, Runuran_registry.c) may then see a spurious       *
+ *   error. As the generator objects that are run in a producer thread only  *
+ *   use precomputed tables such errors should not occur in practice. In     *
+ *   any case their number is reported by a warning.                         *
+ *                                                                           *
+ *****************************************************************************/
+
+/*---------------------------------------------------------------------------*/
+
+#include "Runuran.h"
+
+/* internal header files for UNU.RAN */
+#include <unur_source.h>
+#include <methods/cstd_struct.h>
+#include <methods/dstd_struct.h>
+
+#include <time.h>
+
+/* we need POSIX threads and C11 atomics for the background thread */
+#if defined(HAVE_PTHREAD) && defined(HAVE_PTHREAD_H) && \
+    defined(HAVE_STDATOMIC_H) && !defined(__STDC_NO_ATOMICS__)
+#  define RUNURAN_STREAM_THREADS 1
+#  include <pthread.h>
+#  include <signal.h>
+#  include <stdatomic.h>
+#endif
+
+/*---------------------------------------------------------------------------*/
+
+/* minimal and maximal size of ring buffer */
+#define STREAM_MIN_BUFFER  (1024)
+#define STREAM_MAX_BUFFER  (16777216)
+
+/* number of random variates generated by producer between two updates */
+#define STREAM_CHUNK       (1024)
+
+/* maximal waiting time for consumer before checking for user interrupt [ns] */
+#define STREAM_WAIT_NSEC   (100000000L)
+
+/* moduli of private URNG (MRG31k3p) */
+#define STREAM_M1          (2147483647UL)
+#define STREAM_M2          (2147462579UL)
+
+/*---------------------------------------------------------------------------*/
+
+struct Runuran_stream {
+  struct unur_gen *gen;   /* clone of generator object                       */
+  UNUR_URNG *urng;        /* private URNG                                    */
+  unsigned long state[6]; /* state of private URNG                           */
+  int is_discr;           /* whether distribution is discrete                */
+  int threaded;           /* whether random variates are produced in thread  */
+  size_t size;            /* size of ring buffer (power of 2)                */
+  double *ring;           /* ring buffer for random variates [size]          */
+#ifdef RUNURAN_STREAM_THREADS
+  atomic_size_t head;     /* number of random variates produced so far       */
+  atomic_size_t tail;     /* number of random variates consumed so far       */
+  atomic_int stop;        /* request to terminate producer thread            */
+  atomic_int consumer_waiting; /* consumer is waiting for random variates    */
+  atomic_int producer_waiting; /* producer is waiting for free space         */
+  atomic_int n_messages;  /* number of suppressed UNU.RAN messages           */
+  pthread_t thread;       /* producer thread                                 */
+  pthread_mutex_t lock;   /* mutex for condition variable                    */
+  pthread_cond_t cond;    /* wake up sleeping producer or consumer           */
+#endif
+};
+
+#ifdef RUNURAN_STREAM_THREADS
+/* key for thread specific data: stream object of producer thread */
+static pthread_key_t _stream_key;
+static int _stream_key_created = FALSE;
+#endif
+
+/*---------------------------------------------------------------------------*/
+
+static SEXP _Runuran_stream_tag (void);
+/*---------------------------------------------------------------------------*/
+/* Make tag for R UNU.RAN stream object.                                     */
+/*---------------------------------------------------------------------------*/
+
+static void _Runuran_stream_free (SEXP sexp_stream);
+/*---------------------------------------------------------------------------*/
+/* Stop producer thread and free stream object.                              */
+/*---------------------------------------------------------------------------*/
+
+static double _stream_urng_sample (void *state);
+/*---------------------------------------------------------------------------*/
+/* Private URNG of stream object (MRG31k3p).                                 */
+/*---------------------------------------------------------------------------*/
+
+static void _stream_urng_seed (unsigned long *state, unsigned long seed);
+/*---------------------------------------------------------------------------*/
+/* Seed private URNG of stream object.                                       */
+/*---------------------------------------------------------------------------*/
+
+static int _stream_uses_R_urng (const struct unur_gen *gen);
+/*---------------------------------------------------------------------------*/
+/* Check whether generator object uses the R built-in URNG.                  */
+/*---------------------------------------------------------------------------*/
+
+#ifdef RUNURAN_STREAM_THREADS
+
+static int _stream_is_threadsafe (const struct unur_gen *gen);
+/*---------------------------------------------------------------------------*/
+/* Check whether sampling routine can run in background thread.              */
+/*---------------------------------------------------------------------------*/
+
+static int _stream_start (struct Runuran_stream *stream);
+/*---------------------------------------------------------------------------*/
+/* Start producer thread.                                                    */
+/*---------------------------------------------------------------------------*/
+
+static void _stream_stop (struct Runuran_stream *stream);
+/*---------------------------------------------------------------------------*/
+/* Stop producer thread.                                                     */
+/*---------------------------------------------------------------------------*/
+
+static void *_stream_producer (void *arg);
+/*---------------------------------------------------------------------------*/
+/* Producer thread: fill ring buffer with random variates.                   */
+/*---------------------------------------------------------------------------*/
+
+static void _stream_read (struct Runuran_stream *stream, double *X, size_t n);
+/*---------------------------------------------------------------------------*/
+/* Consumer: copy next n random variates from ring buffer.                   */
+/*---------------------------------------------------------------------------*/
+
+#endif
+
+/*---------------------------------------------------------------------------*/
+
+SEXP
+Runuran_stream (SEXP sexp_unur, SEXP sexp_buffer, SEXP sexp_seed)
+     /*----------------------------------------------------------------------*/
+     /* Create streaming sampler for UNU.RAN generator object.               */
+     /*                                                                      */
+     /* Parameters:                                                          */
+     /*   unur   ... 'Runuran' object (S4 class)                             */
+     /*   buffer ... size of ring buffer                                     */
+     /*   seed   ... seed for private URNG (positive integer or NULL)        */
+     /*                                                                      */
+     /* Return:                                                              */
+     /*   pointer to stream object                                           */
+     /*----------------------------------------------------------------------*/
+{
+  static unsigned long n_streams = 0;
+  SEXP sexp_gen, sexp_stream, sexp_attr;
+  struct unur_gen *gen = NULL;
+  struct Runuran_stream *stream;
+  unsigned long seed;
+  double buffer;
+  size_t size;
+
+  /* first argument must be S4 class */
+  if (!Rf_isS4(sexp_unur))
+    Rf_error("[UNU.RAN - error] argument invalid: 'unr' must be UNU.RAN object");
+
+  /* Extract pointer to UNU.RAN generator */
+  sexp_gen = R_do_slot(sexp_unur, Rf_install("unur"));
+  if (! Rf_isNull(sexp_gen)) {
+    CHECK_UNUR_PTR(sexp_gen);
+    gen = R_ExternalPtrAddr(sexp_gen);
+  }
+  if (gen == NULL)
+    Rf_error("[UNU.RAN - error] invalid UNU.RAN object (packed?)");
+
+  /* we only support univariate distributions */
+  switch (unur_distr_get_type(unur_get_distr(gen))) {
+  case UNUR_DISTR_CONT:
+  case UNUR_DISTR_CEMP:
+  case UNUR_DISTR_DISCR:
+    break;
+  default:
+    Rf_error("[UNU.RAN - error] streaming sampler requires univariate distribution");
+  }
+
+  /* external generators ignore the private URNG */
+  if (_stream_uses_R_urng(gen))
+    Rf_error("[UNU.RAN - error] streaming sampler cannot be used with external generators (cext.new, dext.new)");
+
+  /* size of ring buffer: power of 2 */
+  buffer = Rf_asReal(sexp_buffer);
+  if (ISNAN(buffer) || buffer < 1.)
+    Rf_error("[UNU.RAN - error] invalid size of buffer");
+  for (size = STREAM_MIN_BUFFER; size < buffer && size < STREAM_MAX_BUFFER; size *= 2) ;
+
+  /* seed for private URNG */
+  if (Rf_isNull(sexp_seed)) {
+    /* use time and counter; the R built-in URNG must not be touched */
+    seed = (unsigned long) time(NULL) + 69069UL * (++n_streams);
+  }
+  else {
+    double s = Rf_asReal(sexp_seed);
+    if (ISNAN(s) || s < 1. || s > (double) STREAM_M1)
+      Rf_error("[UNU.RAN - error] invalid seed");
+    seed = (unsigned long) s;
+  }
+
+  /* create stream object */
+  stream = _unur_xmalloc(sizeof(struct Runuran_stream));
+  stream->gen = unur_gen_clone(gen);
+  if (stream->gen == NULL) {
+    free(stream);
+    Rf_error("[UNU.RAN - error] cannot clone generator object");
+  }
+  stream->is_discr = unur_distr_is_discr(unur_get_distr(gen));
+  stream->threaded = FALSE;
+  stream->size = size;
+  stream->ring = _unur_xmalloc(size * sizeof(double));
+
+  /* private URNG */
+  _stream_urng_seed(stream->state, seed);
+  stream->urng = unur_urng_new(_stream_urng_sample, stream->state);
+  unur_chg_urng(stream->gen, stream->urng);
+
+#ifdef RUNURAN_STREAM_THREADS
+  atomic_init(&stream->head, 0);
+  atomic_init(&stream->tail, 0);
+  atomic_init(&stream->stop, FALSE);
+  atomic_init(&stream->consumer_waiting, FALSE);
+  atomic_init(&stream->producer_waiting, FALSE);
+  atomic_init(&stream->n_messages, 0);
+
+  /* start producer thread (if possible) */
+  if (_stream_is_threadsafe(stream->gen))
+    stream->threaded = _stream_start(stream);
+#endif
+
+  /* make R object */
+  PROTECT(sexp_stream = R_MakeExternalPtr(stream, _Runuran_stream_tag(), R_NilValue));
+  R_RegisterCFinalizerEx(sexp_stream, _Runuran_stream_free, TRUE);
+  PROTECT(sexp_attr = Rf_mkString("unuran.stream"));
+  Rf_setAttrib(sexp_stream, R_ClassSymbol, sexp_attr);
+  PROTECT(sexp_attr = Rf_ScalarLogical(stream->threaded));
+  Rf_setAttrib(sexp_stream, Rf_install("threaded"), sexp_attr);
+
+  UNPROTECT(3);
+  return sexp_stream;
+
+} /* end of Runuran_stream() */
+
+/*---------------------------------------------------------------------------*/
+
+SEXP
+_Runuran_stream_sample (SEXP sexp_stream, int n)
+     /*----------------------------------------------------------------------*/
+     /* Get next n random variates from stream object.                       */
+     /*                                                                      */
+     /* Parameters:                                                          */
+     /*   stream ... pointer to stream object                                */
+     /*   n      ... sample size (positive integer)                          */
+     /*                                                                      */
+     /* Return:                                                              */
+     /*   random sample of size 'n'                                          */
+     /*----------------------------------------------------------------------*/
+{
+  struct Runuran_stream *stream;
+  SEXP sexp_res;
+  int i;
+
+  stream = R_ExternalPtrAddr(sexp_stream);
+  if (stream == NULL)
+    Rf_error("[UNU.RAN - error] invalid UNU.RAN stream object (saved and restored?)");
+
+  PROTECT(sexp_res = Rf_allocVector(REALSXP, n));
+
+#ifdef RUNURAN_STREAM_THREADS
+  if (stream->threaded) {
+    int n_messages;
+
+    _stream_read(stream, REAL(sexp_res), (size_t) n);
+
+    n_messages = atomic_exchange(&stream->n_messages, 0);
+    if (n_messages > 0)
+      Rf_warningcall(R_NilValue,"[UNU.RAN - warning] %d message(s) of UNU.RAN suppressed in background thread",
+		     n_messages);
+
+    UNPROTECT(1);
+    return sexp_res;
+  }
+#endif
+
+  /* generate random variates in main thread */
+  /* (one at a time such that the sequence does not depend on block sizes) */
+  if (stream->is_discr) {
+    for (i=0; i<n; i++)
+      REAL(sexp_res)[i] = (double) unur_sample_discr(stream->gen);
+  }
+  else {
+    for (i=0; i<n; i++)
+      REAL(sexp_res)[i] = unur_sample_cont(stream->gen);
+  }
+  _Runuran_errlog_flush();
+
+  UNPROTECT(1);
+  return sexp_res;
+
+} /* end of _Runuran_stream_sample() */
+
+/*---------------------------------------------------------------------------*/
+
+int
+_Runuran_is_stream (SEXP sexp_obj)
+     /*----------------------------------------------------------------------*/
+     /* Check whether R object is a UNU.RAN stream object.                   */
+     /*                                                                      */
+     /* Parameters:                                                          */
+     /*   obj ... R object                                                   */
+     /*                                                                      */
+     /* Return:                                                              */
+     /*   TRUE if 'obj' is a stream object, FALSE otherwise                  */
+     /*----------------------------------------------------------------------*/
+{
+  return (TYPEOF(sexp_obj) == EXTPTRSXP && R_ExternalPtrTag(sexp_obj) == _Runuran_stream_tag());
+} /* end of _Runuran_is_stream() */
+
+/*---------------------------------------------------------------------------*/
+
+int
+_Runuran_stream_drop_message (void)
+     /*----------------------------------------------------------------------*/
+     /* Check whether we are in a producer thread. Then the message of the   */
+     /* UNU.RAN error handler must be dropped (as the R API must not be      */
+     /* used) and is only counted.                                           */
+     /*                                                                      */
+     /* Parameters: none                                                     */
+     /*                                                                      */
+     /* Return:                                                              */
+     /*   TRUE  ... if message must be dropped                               */
+     /*   FALSE ... otherwise                                                */
+     /*----------------------------------------------------------------------*/
+{
+#ifdef RUNURAN_STREAM_THREADS
+  struct Runuran_stream *stream;
+
+  if (!_stream_key_created)
+    return FALSE;
+
+  stream = pthread_getspecific(_stream_key);
+  if (stream == NULL)
+    return FALSE;
+
+  atomic_fetch_add(&stream->n_messages, 1);
+  return TRUE;
+#else
+  return FALSE;
+#endif
+} /* end of _Runuran_stream_drop_message() */
+
+/*---------------------------------------------------------------------------*/
+
+SEXP
+_Runuran_stream_tag (void)
+     /*----------------------------------------------------------------------*/
+     /* Make tag for R UNU.RAN stream object                                 */
+     /*                                                                      */
+     /* Parameters: none                                                     */
+     /*                                                                      */
+     /* Return:                                                              */
+     /*   tag (R object)                                                     */
+     /*----------------------------------------------------------------------*/
+{
+  static SEXP tag = NULL;
+
+  /* make tag for R object */
+  if (!tag) tag = Rf_install("R_UNURAN_STREAM_TAG");
+
+  return tag;
+} /* end of _Runuran_stream_tag() */
+
+/*---------------------------------------------------------------------------*/
+
+void
+_Runuran_stream_free (SEXP sexp_stream)
+     /*----------------------------------------------------------------------*/
+     /* Stop producer thread and free stream object.                         */
+     /*                                                                      */
+     /* Parameters:                                                          */
+     /*   stream ... pointer to stream object                                */
+     /*                                                                      */
+     /* Return:                                                              */
+     /*   (void)                                                             */
+     /*----------------------------------------------------------------------*/
+{
+  struct Runuran_stream *stream;
+
+  stream = R_ExternalPtrAddr(sexp_stream);
+  if (stream == NULL) return;
+
+#ifdef RUNURAN_STREAM_THREADS
+  if (stream->threaded)
+    _stream_stop(stream);
+#endif
+
+  unur_free(stream->gen);
+  unur_urng_free(stream->urng);
+  free(stream->ring);
+  free(stream);
+
+  R_ClearExternalPtr(sexp_stream);
+} /* end of _Runuran_stream_free() */
+
+/*---------------------------------------------------------------------------*/
+
+double
+_stream_urng_sample (void *state)
+     /*----------------------------------------------------------------------*/
+     /* Private URNG of stream object:                                       */
+     /* Combined multiple recursive generator by Pierre L'Ecuyer and         */
+     /* Renee Touzin (MRG31k3p).                                             */
+     /* (adapted from unur_urng_MRG31k3p() in uniform/mrg31k3p.c)            */
+     /*                                                                      */
+     /* Parameters:                                                          */
+     /*   state ... state of generator [6]                                   */
+     /*                                                                      */
+     /* Return:                                                              */
+     /*   uniform random number in (0,1)                                     */
+     /*----------------------------------------------------------------------*/
+{
+# define mask11  511
+# define mask12  16777215
+# define mask20  65535
+# define norm    4.656612873077393e-10
+
+  unsigned long *x = state;
+  unsigned long yy1, yy2;
+
+  /* first component */
+  yy1 = ( (((x[1] & mask11) << 22) + (x[1] >> 9))
+	  + (((x[2] & mask12) << 7)  + (x[2] >> 24)) );
+  if (yy1 > STREAM_M1) yy1 -= STREAM_M1;
+  yy1 += x[2];
+  if (yy1 > STREAM_M1) yy1 -= STREAM_M1;
+  x[2] = x[1];  x[1] = x[0];  x[0] = yy1;
+
+  /* second component */
+  yy1 = ((x[3] & mask20) << 15) + 21069 * (x[3] >> 16);
+  if (yy1 > STREAM_M2) yy1 -= STREAM_M2;
+  yy2 = ((x[5] & mask20) << 15) + 21069 * (x[5] >> 16);
+  if (yy2 > STREAM_M2) yy2 -= STREAM_M2;
+  yy2 += x[5];
+  if (yy2 > STREAM_M2) yy2 -= STREAM_M2;
+  yy2 += yy1;
+  if (yy2 > STREAM_M2) yy2 -= STREAM_M2;
+  x[5] = x[4];  x[4] = x[3];  x[3] = yy2;
+
+  /* combination */
+  if (x[0] <= x[3])
+    return ((x[0] - x[3] + STREAM_M1) * norm);
+  else
+    return ((x[0] - x[3]) * norm);
+
+# undef mask11
+# undef mask12
+# undef mask20
+# undef norm
+} /* end of _stream_urng_sample() */
+
+/*---------------------------------------------------------------------------*/
+
+void
+_stream_urng_seed (unsigned long *state, unsigned long seed)
+     /*----------------------------------------------------------------------*/
+     /* Seed private URNG of stream object.                                  */
+     /* As in unur_urng_MRG31k3p_seed() all components are set to 'seed'     */
+     /* (reduced modulo m1 and m2, resp.).                                   */
+     /*                                                                      */
+     /* Parameters:                                                          */
+     /*   state ... state of generator [6]                                   */
+     /*   seed  ... seed (positive integer)                                  */
+     /*                                                                      */
+     /* Return:                                                              */
+     /*   (void)                                                             */
+     /*----------------------------------------------------------------------*/
+{
+  unsigned long s1, s2;
+
+  s1 = seed % STREAM_M1;
+  if (s1 == 0) s1 = 1;
+  s2 = seed % STREAM_M2;
+  if (s2 == 0) s2 = 1;
+
+  state[0] = state[1] = state[2] = s1;
+  state[3] = state[4] = state[5] = s2;
+} /* end of _stream_urng_seed() */
+
+/*---------------------------------------------------------------------------*/
+
+int
+_stream_uses_R_urng (const struct unur_gen *gen)
+     /*----------------------------------------------------------------------*/
+     /* Check whether generator object (or one of its auxiliary generators,  */
+     /* e.g., components of a mixture) is an external generator that uses    */
+     /* the R built-in URNG.                                                 */
+     /*                                                                      */
+     /* Parameters:                                                          */
+     /*   gen ... pointer to UNU.RAN generator object                        */
+     /*                                                                      */
+     /* Return:                                                              */
+     /*   TRUE if the R built-in URNG is used, FALSE otherwise               */
+     /*----------------------------------------------------------------------*/
+{
+  int i;
+
+  if (gen == NULL)
+    return FALSE;
+
+  if (_Runuran_is_cext(gen))
+    return TRUE;
+
+  if (_stream_uses_R_urng(gen->gen_aux))
+    return TRUE;
+
+  if (gen->gen_aux_list != NULL)
+    for (i=0; i<gen->n_gen_aux_list; i++)
+      if (_stream_uses_R_urng(gen->gen_aux_list[i]))
+	return TRUE;
+
+  return FALSE;
+} /* end of _stream_uses_R_urng() */
+
+/*---------------------------------------------------------------------------*/
+
+#ifdef RUNURAN_STREAM_THREADS
+
+/*---------------------------------------------------------------------------*/
+
+int
+_stream_is_threadsafe (const struct unur_gen *gen)
+     /*----------------------------------------------------------------------*/
+     /* Check whether sampling routine can run in background thread,         */
+     /* i.e., it uses neither R functions nor any other global data.         */
+     /*                                                                      */
+     /* Parameters:                                                          */
+     /*   gen ... pointer to UNU.RAN generator object                        */
+     /*                                                                      */
+     /* Return:                                                              */
+     /*   TRUE if sampling routine is thread-safe, FALSE otherwise           */
+     /*----------------------------------------------------------------------*/
+{
+  switch (unur_get_method(gen)) {
+  case UNUR_METH_PINV:
+    /* segments of lazy setup are created during sampling */
+    return (! _Runuran_pinv_is_lazy(gen));
+  case UNUR_METH_HINV:
+  case UNUR_METH_DGT:
+  case UNUR_METH_DAU:
+    return TRUE;
+  case UNUR_METH_CSTD:
+    /* inversion calls quantile functions of Rmath which may raise warnings */
+    return (! ((struct unur_cstd_gen*)gen->datap)->is_inversion);
+  case UNUR_METH_DSTD:
+    return (! ((struct unur_dstd_gen*)gen->datap)->is_inversion);
+  case UNUR_METH_DEXT:
+    return _Runuran_is_dinv(gen);
+  default:
+    return FALSE;
+  }
+} /* end of _stream_is_threadsafe() */
+
+/*---------------------------------------------------------------------------*/
+
+int
+_stream_start (struct Runuran_stream *stream)
+     /*----------------------------------------------------------------------*/
+     /* Start producer thread.                                               */
+     /*                                                                      */
+     /* Parameters:                                                          */
+     /*   stream ... pointer to stream object                                */
+     /*                                                                      */
+     /* Return:                                                              */
+     /*   TRUE  ... on success                                               */
+     /*   FALSE ... if thread cannot be started                              */
+     /*----------------------------------------------------------------------*/
+{
+  sigset_t all_signals, old_signals;
+  int rcode;
+
+  /* key for thread specific data (created once in main thread) */
+  if (!_stream_key_created) {
+    if (pthread_key_create(&_stream_key, NULL) != 0)
+      return FALSE;
+    _stream_key_created = TRUE;
+  }
+
+  if (pthread_mutex_init(&stream->lock, NULL) != 0)
+    return FALSE;
+  if (pthread_cond_init(&stream->cond, NULL) != 0) {
+    pthread_mutex_destroy(&stream->lock);
+    return FALSE;
+  }
+
+  /* signals (e.g., user interrupts) must be handled by the main thread */
+  sigfillset(&all_signals);
+  pthread_sigmask(SIG_SETMASK, &all_signals, &old_signals);
+  rcode = pthread_create(&stream->thread, NULL, _stream_producer, stream);
+  pthread_sigmask(SIG_SETMASK, &old_signals, NULL);
+
+  if (rcode != 0) {
+    pthread_cond_destroy(&stream->cond);
+    pthread_mutex_destroy(&stream->lock);
+    return FALSE;
+  }
+
+  return TRUE;
+} /* end of _stream_start() */
+
+/*---------------------------------------------------------------------------*/
+
+void
+_stream_stop (struct Runuran_stream *stream)
+     /*----------------------------------------------------------------------*/
+     /* Stop producer thread.                                                */
+     /*                                                                      */
+     /* Parameters:                                                          */
+     /*   stream ... pointer to stream object                                */
+     /*                                                                      */
+     /* Return:                                                              */
+     /*   (void)                                                             */
+     /*----------------------------------------------------------------------*/
+{
+  atomic_store(&stream->stop, TRUE);
+
+  /* wake up sleeping producer */
+  pthread_mutex_lock(&stream->lock);
+  pthread_cond_broadcast(&stream->cond);
+  pthread_mutex_unlock(&stream->lock);
+
+  pthread_join(stream->thread, NULL);
+  pthread_cond_destroy(&stream->cond);
+  pthread_mutex_destroy(&stream->lock);
+  stream->threaded = FALSE;
+} /* end of _stream_stop() */
+
+/*---------------------------------------------------------------------------*/
+
+void *
+_stream_producer (void *arg)
+     /*----------------------------------------------------------------------*/
+     /* Producer thread: fill ring buffer with random variates.              */
+     /* The producer sleeps while the buffer is full.                        */
+     /*                                                                      */
+     /* Parameters:                                                          */
+     /*   arg ... pointer to stream object                                   */
+     /*                                                                      */
+     /* Return:                                                              */
+     /*   NULL                                                               */
+     /*----------------------------------------------------------------------*/
+{
+  struct Runuran_stream *stream = arg;
+  size_t mask = stream->size - 1;
+  size_t head, tail, n, i;
+
+  /* messages of error handler are dropped in this thread */
+  pthread_setspecific(_stream_key, stream);
+
+  head = atomic_load_explicit(&stream->head, memory_order_relaxed);
+
+  while (!atomic_load(&stream->stop)) {
+
+    /* free space in ring buffer */
+    tail = atomic_load_explicit(&stream->tail, memory_order_acquire);
+    n = stream->size - (head - tail);
+
+    if (n == 0) {
+      /* buffer full: sleep until consumer has read some random variates */
+      pthread_mutex_lock(&stream->lock);
+      atomic_store(&stream->producer_waiting, TRUE);
+      while (!atomic_load(&stream->stop) &&
+	     atomic_load(&stream->tail) == tail)
+	pthread_cond_wait(&stream->cond, &stream->lock);
+      atomic_store(&stream->producer_waiting, FALSE);
+      pthread_mutex_unlock(&stream->lock);
+      continue;
+    }
+
+    /* generate next chunk of random variates */
+    if (n > STREAM_CHUNK) n = STREAM_CHUNK;
+    if (stream->is_discr)
+      for (i=0; i<n; i++)
+	stream->ring[(head+i) & mask] = (double) unur_sample_discr(stream->gen);
+    else
+      for (i=0; i<n; i++)
+	stream->ring[(head+i) & mask] = unur_sample_cont(stream->gen);
+
+    /* publish random variates */
+    head += n;
+    atomic_store(&stream->head, head);
+
+    /* wake up waiting consumer */
+    if (atomic_load(&stream->consumer_waiting)) {
+      pthread_mutex_lock(&stream->lock);
+      pthread_cond_broadcast(&stream->cond);
+      pthread_mutex_unlock(&stream->lock);
+    }
+  }
+
+  return NULL;
+} /* end of _stream_producer() */
+
+/*---------------------------------------------------------------------------*/
+
+void
+_stream_read (struct Runuran_stream *stream, double *X, size_t n)
+     /*----------------------------------------------------------------------*/
+     /* Consumer: copy next n random variates from ring buffer into X.       */
+     /* While the buffer is empty the consumer sleeps and checks for user    */
+     /* interrupts periodically.                                             */
+     /*                                                                      */
+     /* Parameters:                                                          */
+     /*   stream ... pointer to stream object                                */
+     /*   X      ... array for storing random variates [n]                   */
+     /*   n      ... sample size                                             */
+     /*                                                                      */
+     /* Return:                                                              */
+     /*   (void)                                                             */
+     /*----------------------------------------------------------------------*/
+{
+  size_t mask = stream->size - 1;
+  size_t head, tail, k, pos;
+  struct timespec deadline;
+
+  tail = atomic_load_explicit(&stream->tail, memory_order_relaxed);
+
+  while (n > 0) {
+
+    /* available random variates */
+    head = atomic_load_explicit(&stream->head, memory_order_acquire);
+    k = head - tail;
+
+    if (k == 0) {
+      /* buffer empty: sleep until producer has generated random variates */
+      pthread_mutex_lock(&stream->lock);
+      atomic_store(&stream->consumer_waiting, TRUE);
+      if (atomic_load(&stream->head) == tail) {
+	clock_gettime(CLOCK_REALTIME, &deadline);
+	deadline.tv_nsec += STREAM_WAIT_NSEC;
+	if (deadline.tv_nsec >= 1000000000L) {
+	  deadline.tv_sec += 1;
+	  deadline.tv_nsec -= 1000000000L;
+	}
+	pthread_cond_timedwait(&stream->cond, &stream->lock, &deadline);
+      }
+      atomic_store(&stream->consumer_waiting, FALSE);
+      pthread_mutex_unlock(&stream->lock);
+      R_CheckUserInterrupt();
+      continue;
+    }
+
+    /* copy block (with wrap around) */
+    if (k > n) k = n;
+    pos = tail & mask;
+    if (pos + k <= stream->size)
+      memcpy(X, stream->ring + pos, k * sizeof(double));
+    else {
+      memcpy(X, stream->ring + pos, (stream->size - pos) * sizeof(double));
+      memcpy(X + (stream->size - pos), stream->ring, (k - stream->size + pos) * sizeof(double));
+    }
+    X += k;
+    n -= k;
+
+    /* release space in ring buffer */
+    tail += k;
+    atomic_store(&stream->tail, tail);
+
+    /* wake up waiting producer */
+    if (atomic_load(&stream->producer_waiting)) {
+      pthread_mutex_lock(&stream->lock);
+      pthread_cond_broadcast(&stream->cond);
+      pthread_mutex_unlock(&stream->lock);
+    }
+  }
+} /* end of _stream_read() */
+
+/*---------------------------------------------------------------------------*/
+
+#endif
+
+/*---------------------------------------------------------------------------*/
@@ -25,23 +25,43 @@
 /* List of functions to be registered as native routines */
 static const R_CallMethodDef CallEntries[] = {
     {"Runuran_CDF",            (DL_FUNC) &Runuran_CDF,            2},
+    {"Runuran_chg_params",     (DL_FUNC) &Runuran_chg_params,     2},
+    {"Runuran_chg_truncated",  (DL_FUNC) &Runuran_chg_truncated,  3},
     {"Runuran_PDF",            (DL_FUNC) &Runuran_PDF,            3},
-    {"Runuran_cmv_init",       (DL_FUNC) &Runuran_cmv_init,       9},
-    {"Runuran_cont_init",      (DL_FUNC) &Runuran_cont_init,     11},
+    {"Runuran_autotune",       (DL_FUNC) &Runuran_autotune,       4},
+    {"Runuran_cext",           (DL_FUNC) &Runuran_cext,           4},
+    {"Runuran_cmv_init",       (DL_FUNC) &Runuran_cmv_init,      10},
+    {"Runuran_cont_init",      (DL_FUNC) &Runuran_cont_init,     12},
+    {"Runuran_dari_eager",     (DL_FUNC) &Runuran_dari_eager,     1},
+    {"Runuran_dinv",           (DL_FUNC) &Runuran_dinv,           4},
     {"Runuran_discr_init",     (DL_FUNC) &Runuran_discr_init,     9},
+    {"Runuran_errlog",         (DL_FUNC) &Runuran_errlog,         1},
+    {"Runuran_hinv_adapt",     (DL_FUNC) &Runuran_hinv_adapt,     6},
+    {"Runuran_get_lobatto",    (DL_FUNC) &Runuran_get_lobatto,    1},
     {"Runuran_init",           (DL_FUNC) &Runuran_init,           3},
+    {"Runuran_mcorr",          (DL_FUNC) &Runuran_mcorr,          3},
     {"Runuran_mixt",           (DL_FUNC) &Runuran_mixt,           4},
-    {"Runuran_pack",           (DL_FUNC) &Runuran_pack,           1},
+    {"Runuran_pack",           (DL_FUNC) &Runuran_pack,           2},
+    {"Runuran_pinv_lazy",      (DL_FUNC) &Runuran_pinv_lazy,      4},
     {"Runuran_performance",    (DL_FUNC) &Runuran_performance,    2},
     {"Runuran_print",          (DL_FUNC) &Runuran_print,          2},
+    {"Runuran_qmc",            (DL_FUNC) &Runuran_qmc,            5},
+    {"Runuran_qrng",           (DL_FUNC) &Runuran_qrng,           5},
     {"Runuran_quantile",       (DL_FUNC) &Runuran_quantile,       2},
+    {"Runuran_registry_info",  (DL_FUNC) &Runuran_registry_info,  0},
     {"Runuran_sample",         (DL_FUNC) &Runuran_sample,         2},
+    {"Runuran_sample_std",     (DL_FUNC) &Runuran_sample_std,     6},
+    {"Runuran_sample_str",     (DL_FUNC) &Runuran_sample_str,     3},
+    {"Runuran_sample_vr",      (DL_FUNC) &Runuran_sample_vr,      4},
     {"Runuran_set_aux_seed",   (DL_FUNC) &Runuran_set_aux_seed,   1},
+    {"Runuran_set_lobatto",    (DL_FUNC) &Runuran_set_lobatto,    2},
     {"Runuran_std_cont",       (DL_FUNC) &Runuran_std_cont,       4},
     {"Runuran_std_discr",      (DL_FUNC) &Runuran_std_discr,      4},
+    {"Runuran_stream",         (DL_FUNC) &Runuran_stream,         3},
     {"Runuran_use_aux_urng",   (DL_FUNC) &Runuran_use_aux_urng,   2},
     {"Runuran_verify_hat",     (DL_FUNC) &Runuran_verify_hat,     2},
     {"Runuran_set_error_level",(DL_FUNC) &Runuran_set_error_level,1},
+    {"Runuran_set_registry_memory",(DL_FUNC) &Runuran_set_registry_memory,1},
     {NULL, NULL, 0}
 };
 
@@ -92,6 +112,12 @@ R_init_Runuran (DllInfo *info  ATTRIBUTE__UNUSED)
   R_RegisterCCallable("Runuran", "cont_init",   (DL_FUNC) Runuran_ext_cont_init);
   R_RegisterCCallable("Runuran", "cont_params", (DL_FUNC) unur_distr_cont_get_pdfparams);
 
+  /* Batch routines for generator objects: */
+  R_RegisterCCallable("Runuran", "sample_array",   (DL_FUNC) Runuran_ext_sample_array);
+  R_RegisterCCallable("Runuran", "quantile_array", (DL_FUNC) Runuran_ext_quantile_array);
+  R_RegisterCCallable("Runuran", "pdf_array",      (DL_FUNC) Runuran_ext_pdf_array);
+  R_RegisterCCallable("Runuran", "cdf_array",      (DL_FUNC) Runuran_ext_cdf_array);
+
   /* For project 'rvgtdist': */
 
 #define RREGDEF(name)  R_RegisterCCallable("Runuran", #name, (DL_FUNC) name)
@@ -150,6 +176,8 @@ R_unload_Runuran (DllInfo *info  ATTRIBUTE__UNUSED)
      /*   (void)                                                             */
      /*----------------------------------------------------------------------*/
 {
+  _Runuran_cache_clear();
+  _Runuran_registry_clear();
   unur_urng_free(unur_get_default_urng());
   unur_urng_free(unur_get_default_urng_aux());
 } /* end of R_unload_Runuran() */
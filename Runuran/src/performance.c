@@ -54,11 +54,15 @@
 #include <methods/tabl_struct.h>
 #include <methods/tdr_struct.h>
 
+/* structures used by auxiliary tools */
+#include <utils/lobatto_source.h>
+#include <utils/lobatto_struct.h>
+
 
 /*****************************************************************************/
 /* array for storing list elements                                           */
 
-#define MAX_LIST  (11)       /* maximum number of list entries */
+#define MAX_LIST  (12)       /* maximum number of list entries */
 
 struct Rlist {
   int len;                   /* length of list (depends on method) */
@@ -73,6 +77,9 @@ static void add_numeric_vec(struct Rlist *list, char *key, double *num, int n_nu
 static void add_integer(struct Rlist *list, char *key, int inum);
 static void add_integer_vec(struct Rlist *list, char *key, int *inum, int n_num);
 
+/* size of data list of packed generator object */
+static double packed_size(SEXP sexp_data);
+
 /*****************************************************************************/
 /* add list elements                                                         */
 
@@ -158,6 +165,29 @@ void add_integer_vec(struct Rlist *list, char *key, int *inum, int n_num)
 
 /* ------------------------------------------------------------------------- */
 
+double packed_size(SEXP sexp_data)
+{
+  double size = 0.;
+  SEXP val;
+  int i;
+
+  for (i=0; i<Rf_length(sexp_data); i++) {
+    val = VECTOR_ELT(sexp_data, i);
+    switch (TYPEOF(val)) {
+    case REALSXP:
+      size += Rf_length(val) * sizeof(double); break;
+    case INTSXP:
+      size += Rf_length(val) * sizeof(int); break;
+    default:
+      break;
+    }
+  }
+
+  return size;
+} /* end of packed_size() */
+
+/* ------------------------------------------------------------------------- */
+
 /*****************************************************************************/
 
 SEXP
@@ -189,11 +219,11 @@ Runuran_performance (SEXP sexp_unur, SEXP sexp_debug)
   /* debug or not debug */
   debug = *(LOGICAL( Rf_coerceVector(sexp_debug, LGLSXP)));
 
-  /* slot 'data' should not be pesent */
+  /* slot 'data' is only present for packed objects */
   sexp_data = R_do_slot(sexp_unur, Rf_install("data"));
   if (! Rf_isNull(sexp_data)) {
     Rprintf("Object is PACKED !\n\n");
-    return R_NilValue;
+    return _Runuran_performance_packed(sexp_data);
   }
 
   /* Extract pointer to UNU.RAN generator */
@@ -234,6 +264,7 @@ Runuran_performance (SEXP sexp_unur, SEXP sexp_debug)
 #define AREA_HAT(num)        add_numeric(&list,"area.hat",(num))
 #define AREA_SQUEEZE(num)    add_numeric(&list,"area.squeeze",(num))
 #define NINTS(inum)          add_integer(&list,"intervals",(inum))
+#define MEMORY(num)          add_numeric(&list,"memory",(num))
 
   /* (approximate) inversion method */
 #define TRUNC(left,right)    {				\
@@ -242,6 +273,7 @@ Runuran_performance (SEXP sexp_unur, SEXP sexp_debug)
     add_numeric_vec(&list,"truncated.domain",(tmp),2);	\
   } 
 #define AREA_PDF(num)        add_numeric(&list,"area.pdf",(num))
+#define URESOLUTION(num)     add_numeric(&list,"u.resolution",(num))
 
 
   /* get data */
@@ -338,7 +370,9 @@ Runuran_performance (SEXP sexp_unur, SEXP sexp_debug)
 #define GEN ((struct unur_hinv_gen*)gen->datap)
     METHOD("HINV"); KIND_INV; CLASS_CONT;
     TRUNC(GEN->bleft,GEN->bright);
+    URESOLUTION(GEN->u_resolution);
     NINTS (GEN->N-1);
+    MEMORY (GEN->N * (GEN->order+2) * sizeof(double) + GEN->guide_size * sizeof(int));
 #undef GEN
     break;
     /* ..................................................................... */
@@ -382,6 +416,10 @@ Runuran_performance (SEXP sexp_unur, SEXP sexp_debug)
     TRUNC(GEN->bleft,GEN->bright);
     AREA_PDF(GEN->area);
     NINTS (GEN->n_ivs);
+    MEMORY ((GEN->n_ivs+1) * (sizeof(struct unur_pinv_interval) + 2*GEN->order*sizeof(double))
+	    + GEN->guide_size * sizeof(int)
+	    + ((GEN->aCDF) ? sizeof(struct unur_lobatto_table)
+	       + GEN->aCDF->size * sizeof(struct unur_lobatto_nodes) : 0));
 
     if (debug) {
       int j,n;
@@ -591,3 +629,71 @@ Runuran_performance (SEXP sexp_unur, SEXP sexp_debug)
 } /* end of Runuran_performance() */
 
 /*---------------------------------------------------------------------------*/
+
+SEXP
+_Runuran_performance_packed (SEXP sexp_data)
+     /*----------------------------------------------------------------------*/
+     /* Get some informations about packed generator object in an R list.    */
+     /*                                                                      */
+     /* Parameters:                                                          */
+     /*   data ... data list of packed 'Runuran' object                      */ 
+     /*                                                                      */
+     /* Return:                                                              */
+     /*   R list                                                             */
+     /*----------------------------------------------------------------------*/
+{
+  SEXP sexp_list;              /* pointer to R list */
+  SEXP sexp_names;             /* array of keywords */
+  int mid;                     /* method ID */
+  int i;                       /* aux loop variable */
+
+  /* array of list elements */
+  struct Rlist list;
+
+  /* create temporary R list */
+  PROTECT(list.values = Rf_allocVector(VECSXP, MAX_LIST));
+  list.len = 0;
+
+  /* method ID */
+  mid = INTEGER(VECTOR_ELT(sexp_data,0))[0];
+
+  switch (mid) {
+  case UNUR_METH_HINV:
+    add_string(&list,"method","HINV"); break;
+  case UNUR_METH_PINV:
+    add_string(&list,"method","PINV"); break;
+  default:
+    add_string(&list,"method","NA");
+  }
+  add_string(&list,"type","inv");
+  add_string(&list,"distr.class","cont");
+
+  /* compact mode is indicated by entry 'cf' */
+  add_string(&list,"packed",
+	     (strcmp(CHAR(STRING_ELT(Rf_getAttrib(sexp_data, R_NamesSymbol),
+				     Rf_length(sexp_data)-1)), "cf"))
+	     ? "full" : "compact");
+
+  /* memory used for tables */
+  add_numeric(&list,"memory",packed_size(sexp_data));
+
+  /* create final list */
+  PROTECT(sexp_list = Rf_allocVector(VECSXP, list.len)); 
+  for(i = 0; i < list.len; i++)
+    SET_VECTOR_ELT(sexp_list, i, VECTOR_ELT(list.values, i));
+    
+  /* an array of the "names" attribute of the objects in our list */
+  PROTECT(sexp_names = Rf_allocVector(STRSXP, list.len));
+  for(i = 0; i < list.len; i++)
+    SET_STRING_ELT(sexp_names, i,  Rf_mkChar(list.names[i]));
+ 
+  /* attach attribute names */
+  Rf_setAttrib(sexp_list, R_NamesSymbol, sexp_names);
+
+  /* return list */
+  UNPROTECT(3);
+  return sexp_list;
+
+} /* end of _Runuran_performance_packed() */
+
+/*---------------------------------------------------------------------------*/
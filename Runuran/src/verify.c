@@ -130,6 +130,10 @@ Runuran_verify_hat (SEXP sexp_unur, SEXP sexp_n)
   INTEGER(sexp_failed)[0] = run_verify_hat(gen,n);
   chg_verify(gen,FALSE);
 
+  /* switching off verify mode restores sampling routine of UNU.RAN */
+  if (_Runuran_dari_is_eager(gen))
+    _Runuran_dari_make_table(gen);
+
   /* return ratio 'failed' / 'sample size' to R */
   UNPROTECT(1);
   return sexp_failed;
@@ -161,37 +165,45 @@ run_verify_hat(struct unur_gen *gen, int n)
   /* switch off error messages */
   old_error_handler = _Runuran_set_error_handler(0);
 
-  /* run generator */
-  for (i=0; i<n; i++) {
+  if (unur_get_method(gen) == UNUR_METH_VNROU) {
+    /* method VNROU: test blocks of candidates (uses array PDF) */
+    x = (double*) R_alloc((size_t) n * dim, sizeof(double) );
+    failed = _Runuran_vnrou_sample_array(gen, x, n);
+  }
 
-    /* reset errno */
-    unur_reset_errno();
-    switch(unur_distr_get_type(unur_get_distr(gen))) {
-    case UNUR_DISTR_CONT:   /* univariate continuous distribution */
-      unur_sample_cont(gen);
-      break;
-    
-    case UNUR_DISTR_DISCR:  /* discrete univariate distribution */
-      unur_sample_discr(gen);
-      break;
-
-    case UNUR_DISTR_CVEC:   /* continuous mulitvariate distribution */
-      unur_sample_vec(gen,x);
-      break;
-
-    case UNUR_DISTR_CEMP:   /* empirical continuous univariate distribution */
-    case UNUR_DISTR_CVEMP:  /* empirical continuous multivariate distribution */
-    case UNUR_DISTR_MATR:   /* matrix distribution */
-    default:
-      _Runuran_set_error_handler(old_error_handler);
-      Rf_error("[UNU.RAN - error] '%s': Distribution type not support",
-	       unur_distr_get_name(unur_get_distr(gen)) );
-    }
+  else {
+    /* run generator */
+    for (i=0; i<n; i++) {
 
-    /* check for sampling error */
-    if (unur_get_errno()) {
-      /* == UNUR_ERR_GEN_CONDITION */
-      failed++;
+      /* reset errno */
+      unur_reset_errno();
+      switch(unur_distr_get_type(unur_get_distr(gen))) {
+      case UNUR_DISTR_CONT:   /* univariate continuous distribution */
+	unur_sample_cont(gen);
+	break;
+    
+      case UNUR_DISTR_DISCR:  /* discrete univariate distribution */
+	unur_sample_discr(gen);
+	break;
+
+      case UNUR_DISTR_CVEC:   /* continuous mulitvariate distribution */
+	unur_sample_vec(gen,x);
+	break;
+
+      case UNUR_DISTR_CEMP:   /* empirical continuous univariate distribution */
+      case UNUR_DISTR_CVEMP:  /* empirical continuous multivariate distribution */
+      case UNUR_DISTR_MATR:   /* matrix distribution */
+      default:
+	_Runuran_set_error_handler(old_error_handler);
+	Rf_error("[UNU.RAN - error] '%s': Distribution type not support",
+		 unur_distr_get_name(unur_get_distr(gen)) );
+      }
+
+      /* check for sampling error */
+      if (unur_get_errno()) {
+	/* == UNUR_ERR_GEN_CONDITION */
+	failed++;
+      }
     }
   }
 